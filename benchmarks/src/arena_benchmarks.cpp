@@ -0,0 +1,138 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Compares parsing into, reading and destroying json values allocated
+// with std::allocator (json) and with an arena (arena_json).
+//
+// Usage: arena_benchmarks [max_records]
+
+#include <jsoncons/json.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "benchmark_timing.hpp"
+
+using namespace jsoncons;
+using namespace benchmarks;
+
+namespace {
+
+    struct timings
+    {
+        double parse;
+        double read;
+        double destroy;
+    };
+
+    template <class Json>
+    std::size_t read_all(const Json& j)
+    {
+        std::size_t check = 0;
+        for (const auto& record : j.array_range())
+        {
+            check += record["id"].template as<std::size_t>();
+            check += record["name"].as_string_view().size();
+            check += record["tags"].size();
+        }
+        return check;
+    }
+
+    timings run_std(const std::string& text, std::size_t repeat)
+    {
+        timings t = {0, 0, 0};
+        std::size_t check = 0;
+
+        for (std::size_t r = 0; r < repeat; ++r)
+        {
+            auto start = clock_type::now();
+            json* j = new json(json::parse(text));
+            t.parse += elapsed_ms(start);
+
+            start = clock_type::now();
+            check += read_all(*j);
+            t.read += elapsed_ms(start);
+
+            start = clock_type::now();
+            delete j;
+            t.destroy += elapsed_ms(start);
+        }
+        keep(check);
+        t.parse /= repeat;
+        t.read /= repeat;
+        t.destroy /= repeat;
+        return t;
+    }
+
+    timings run_arena(const std::string& text, std::size_t repeat)
+    {
+        timings t = {0, 0, 0};
+        std::size_t check = 0;
+
+        for (std::size_t r = 0; r < repeat; ++r)
+        {
+            auto start = clock_type::now();
+            arena* a = new arena(64*1024);
+            arena_json* j = new arena_json(arena_json::parse(result_allocator_arg, *a, text));
+            t.parse += elapsed_ms(start);
+
+            start = clock_type::now();
+            check += read_all(*j);
+            t.read += elapsed_ms(start);
+
+            start = clock_type::now();
+            delete j;
+            delete a;
+            t.destroy += elapsed_ms(start);
+        }
+        keep(check);
+        t.parse /= repeat;
+        t.read /= repeat;
+        t.destroy /= repeat;
+        return t;
+    }
+
+    void print(const char* name, std::size_t size, const timings& t)
+    {
+        std::cout << std::setw(12) << name
+                  << std::setw(10) << size
+                  << std::setw(12) << t.parse
+                  << std::setw(12) << t.read
+                  << std::setw(12) << t.destroy << "\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t max_records = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+    std::cout << "Times in milliseconds\n\n" << std::fixed << std::setprecision(4);
+    std::cout << std::setw(12) << "allocator"
+              << std::setw(10) << "records"
+              << std::setw(12) << "parse"
+              << std::setw(12) << "read"
+              << std::setw(12) << "destroy" << "\n";
+
+    for (std::size_t size = 10; size <= max_records; size *= 10)
+    {
+        std::string text = "[";
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (i > 0)
+            {
+                text.push_back(',');
+            }
+            text += "{\"id\":" + std::to_string(i) 
+                  + ",\"name\":\"A name that is too long to be stored inline " + std::to_string(i) + "\""
+                  + ",\"tags\":[\"a\",\"b\",\"c\"],\"price\":" + std::to_string(i) + ".25}";
+        }
+        text.push_back(']');
+
+        std::size_t repeat = (std::max)(std::size_t(1), std::size_t(100000) / size);
+
+        print("std", size, run_std(text, repeat));
+        print("arena", size, run_arena(text, repeat));
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Timing helpers shared by the benchmarks.
+
+#ifndef JSONCONS_BENCHMARKS_BENCHMARK_TIMING_HPP
+#define JSONCONS_BENCHMARKS_BENCHMARK_TIMING_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace benchmarks {
+
+    using clock_type = std::chrono::steady_clock;
+
+    template <class T>
+    struct sink
+    {
+        static volatile T value;
+    };
+
+    template <class T>
+    volatile T sink<T>::value;
+
+    // Keeps the results of the timed loops from being optimized away
+    template <class T>
+    void keep(T value)
+    {
+        sink<T>::value = value;
+    }
+
+    inline double elapsed_ms(clock_type::time_point start, clock_type::time_point end = clock_type::now())
+    {
+        return std::chrono::duration<double,std::milli>(end - start).count();
+    }
+
+    // Average time of repeat calls to f
+    template <class F>
+    double time_ms(F f, std::size_t repeat)
+    {
+        auto start = clock_type::now();
+        for (std::size_t r = 0; r < repeat; ++r)
+        {
+            f();
+        }
+        return elapsed_ms(start) / repeat;
+    }
+
+} // namespace benchmarks
+
+#endif
@@ -0,0 +1,208 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Compares json with json with compact_value_policy, which holds a value in 8 bytes
+// instead of 16. Reports, for documents of numbers, records and strings, the memory
+// held by the decoded value and the number of allocations made decoding it, counted
+// by replacing operator new, and the times to parse, to visit every value and to dump.
+//
+// Usage: compact_value_benchmarks [size]
+
+#include <jsoncons/json.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include "benchmark_timing.hpp"
+
+using namespace jsoncons;
+using namespace benchmarks;
+
+namespace {
+
+    std::size_t allocation_count = 0;
+    std::size_t allocated_bytes = 0;
+
+    // Each block starts with its size, so that operator delete can subtract it
+    constexpr std::size_t header_size = alignof(std::max_align_t);
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocation_count;
+    allocated_bytes += size;
+    void* p = std::malloc(size + header_size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(p) = size;
+    return static_cast<char*>(p) + header_size;
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p != nullptr)
+    {
+        void* block = static_cast<char*>(p) - header_size;
+        allocated_bytes -= *static_cast<std::size_t*>(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+namespace {
+
+    using compact_json = basic_json<char,compact_value_policy<sorted_policy>>;
+
+    struct result
+    {
+        double bytes;
+        double allocations;
+        double parse;
+        double visit;
+        double dump;
+    };
+
+    template <class Json>
+    double visit(const Json& j)
+    {
+        double sum = 0;
+        switch (j.type())
+        {
+            case json_type::array_value:
+                for (const auto& item : j.array_range())
+                {
+                    sum += visit(item);
+                }
+                break;
+            case json_type::object_value:
+                for (const auto& member : j.object_range())
+                {
+                    sum += visit(member.value());
+                }
+                break;
+            case json_type::string_value:
+                sum += static_cast<double>(j.as_string_view().size());
+                break;
+            case json_type::int64_value:
+            case json_type::uint64_value:
+            case json_type::double_value:
+                sum += j.template as<double>();
+                break;
+            default:
+                break;
+        }
+        return sum;
+    }
+
+    template <class Json>
+    result run(const std::string& text, std::size_t repeat)
+    {
+        result res = {0, 0, 0, 0, 0};
+        double check = 0;
+
+        for (std::size_t r = 0; r < repeat; ++r)
+        {
+            std::size_t count = allocation_count;
+            std::size_t bytes = allocated_bytes;
+            auto start = clock_type::now();
+            Json j = Json::parse(text);
+            auto parsed = clock_type::now();
+            res.bytes += static_cast<double>(allocated_bytes - bytes);
+            res.allocations += static_cast<double>(allocation_count - count);
+
+            check += visit(j);
+            auto visited = clock_type::now();
+
+            std::string s;
+            j.dump(s);
+            auto dumped = clock_type::now();
+            check += static_cast<double>(s.size());
+
+            res.parse += elapsed_ms(start, parsed);
+            res.visit += elapsed_ms(parsed, visited);
+            res.dump += elapsed_ms(visited, dumped);
+        }
+        keep(check);
+        res.bytes /= repeat;
+        res.allocations /= repeat;
+        res.parse /= repeat;
+        res.visit /= repeat;
+        res.dump /= repeat;
+        return res;
+    }
+
+    void print(const char* document, const char* name, const result& res)
+    {
+        std::cout << std::setw(10) << document
+                  << std::setw(10) << name
+                  << std::setw(12) << res.bytes / 1024
+                  << std::setw(14) << res.allocations
+                  << std::setw(10) << res.parse
+                  << std::setw(10) << res.visit
+                  << std::setw(10) << res.dump << "\n";
+    }
+
+    template <class Generate>
+    std::string make_array(std::size_t size, Generate generate)
+    {
+        std::string text = "[";
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (i > 0)
+            {
+                text.push_back(',');
+            }
+            text += generate(i);
+        }
+        text.push_back(']');
+        return text;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const std::size_t repeat = 5;
+
+    // Integers and doubles, like sensor readings
+    std::string numbers = make_array(size * 10, [](std::size_t i)
+    {
+        return i % 2 == 0 ? std::to_string(i * 7) : std::to_string(i) + ".25";
+    });
+    // Small records with short and long strings
+    std::string records = make_array(size, [](std::size_t i)
+    {
+        return "{\"id\":" + std::to_string(i) + ",\"x\":" + std::to_string(i) + ".5,\"ok\":true,\"tag\":\"ab\""
+             + ",\"name\":\"user" + std::to_string(i) + "\",\"values\":[1,2,3]}";
+    });
+    // Strings too long to be held in place
+    std::string strings = make_array(size * 3, [](std::size_t i)
+    {
+        return "\"item number " + std::to_string(i) + "\"";
+    });
+
+    std::cout << "Memory held by the decoded value in KiB, allocations per parse, times in milliseconds\n\n"
+              << std::fixed << std::setprecision(2);
+    std::cout << std::setw(10) << "document"
+              << std::setw(10) << "policy"
+              << std::setw(12) << "memory"
+              << std::setw(14) << "allocations"
+              << std::setw(10) << "parse"
+              << std::setw(10) << "visit"
+              << std::setw(10) << "dump" << "\n";
+
+    print("numbers", "sorted", run<json>(numbers, repeat));
+    print("numbers", "compact", run<compact_json>(numbers, repeat));
+    print("records", "sorted", run<json>(records, repeat));
+    print("records", "compact", run<compact_json>(records, repeat));
+    print("strings", "sorted", run<json>(strings, repeat));
+    print("strings", "compact", run<compact_json>(strings, repeat));
+}
@@ -0,0 +1,116 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Times reading the ids of records whose other members are nested objects and arrays,
+// passing over those with the cursor's skip, and with the event by event skip of
+// basic_staj_reader that the cursors override, for JSON, CBOR and MessagePack.
+//
+// Usage: cursor_skip_benchmarks [size]
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "benchmark_timing.hpp"
+
+using namespace jsoncons;
+using namespace benchmarks;
+
+namespace {
+
+    // Sums the "id" members of the records in the top level array, skipping the values of
+    // the other members
+    template <class Cursor>
+    uint64_t sum_ids(Cursor& cursor, bool fast)
+    {
+        uint64_t sum = 0;
+        for (; !cursor.done(); cursor.next())
+        {
+            if (cursor.current().event_type() != staj_event_type::key)
+            {
+                continue;
+            }
+            bool is_id = cursor.current().template get<string_view>() == "id";
+            cursor.next();
+            const auto& event = cursor.current();
+            if (event.event_type() == staj_event_type::begin_object || event.event_type() == staj_event_type::begin_array)
+            {
+                if (fast)
+                {
+                    cursor.skip();
+                }
+                else
+                {
+                    std::error_code ec;
+                    cursor.basic_staj_reader<char>::skip(ec);
+                }
+            }
+            else if (is_id)
+            {
+                sum += event.template get<uint64_t>();
+            }
+        }
+        return sum;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const std::size_t repeat = 5;
+
+    std::string text = "[";
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        text += i == 0 ? "" : ",";
+        text += "{\"id\":" + std::to_string(i) + ",\"tags\":[\"alpha\",\"beta\",\"gamma\"],"
+              + "\"address\":{\"street\":\"" + std::to_string(i) + " Main Street\",\"city\":\"Springfield\","
+              + "\"location\":{\"lat\":39.78,\"lon\":-89.65}},"
+              + "\"history\":[{\"date\":\"2020-01-01\",\"amount\":12.5,\"items\":[1,2,3,4,5]},"
+              + "{\"date\":\"2020-02-01\",\"amount\":7.25,\"items\":[6,7,8]}],"
+              + "\"notes\":\"a longer note with \\\"quotes\\\" and [brackets] and {braces}\"}";
+    }
+    text += "]";
+
+    ojson j = ojson::parse(text);
+    std::vector<uint8_t> cbor_data;
+    cbor::encode_cbor(j, cbor_data);
+    std::vector<uint8_t> msgpack_data;
+    msgpack::encode_msgpack(j, msgpack_data);
+
+    std::cout << std::fixed << std::setprecision(2) << size << " records, times in milliseconds\n\n";
+    std::cout << std::setw(12) << "format" << std::setw(12) << "events" << std::setw(12) << "skip" << "\n";
+
+    auto run = [&](const char* name, std::function<uint64_t(bool)> f)
+    {
+        double events = time_ms([&](){keep(f(false));}, repeat);
+        double skip = time_ms([&](){keep(f(true));}, repeat);
+        std::cout << std::setw(12) << name << std::setw(12) << events << std::setw(12) << skip << "\n";
+        if (f(false) != f(true))
+        {
+            std::cout << "The sums differ\n";
+        }
+    };
+
+    run("json", [&](bool fast)
+    {
+        json_cursor cursor(text);
+        return sum_ids(cursor, fast);
+    });
+    run("cbor", [&](bool fast)
+    {
+        cbor::cbor_bytes_cursor cursor(cbor_data);
+        return sum_ids(cursor, fast);
+    });
+    run("msgpack", [&](bool fast)
+    {
+        msgpack::msgpack_bytes_cursor cursor(msgpack_data);
+        return sum_ids(cursor, fast);
+    });
+}
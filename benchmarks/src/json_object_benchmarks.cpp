@@ -0,0 +1,133 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Compares building, searching and iterating objects with the
+// sorted_policy (json), preserve_order_policy (ojson) and
+// unordered_policy implementations of json_object.
+//
+// Usage: json_object_benchmarks [max_size]
+
+#include <jsoncons/json.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "benchmark_timing.hpp"
+
+using namespace jsoncons;
+using namespace benchmarks;
+
+namespace {
+
+    using ujson = basic_json<char,unordered_policy>;
+
+    struct timings
+    {
+        double insert;
+        double parse;
+        double find;
+        double iterate;
+    };
+
+    template <class Json>
+    timings run(const std::vector<std::string>& keys, const std::string& text, std::size_t repeat)
+    {
+        timings t = {0, 0, 0, 0};
+        std::size_t check = 0;
+
+        for (std::size_t r = 0; r < repeat; ++r)
+        {
+            auto start = clock_type::now();
+            Json j(json_object_arg);
+            for (std::size_t i = 0; i < keys.size(); ++i)
+            {
+                j.insert_or_assign(keys[i], i);
+            }
+            t.insert += elapsed_ms(start);
+
+            start = clock_type::now();
+            Json k = Json::parse(text);
+            t.parse += elapsed_ms(start);
+            check += k.size();
+
+            start = clock_type::now();
+            for (const auto& key : keys)
+            {
+                auto it = j.find(key);
+                check += it->value().template as<std::size_t>();
+            }
+            t.find += elapsed_ms(start);
+
+            start = clock_type::now();
+            for (const auto& member : j.object_range())
+            {
+                check += member.key().size() + member.value().template as<std::size_t>();
+            }
+            t.iterate += elapsed_ms(start);
+        }
+        keep(check);
+        t.insert /= repeat;
+        t.parse /= repeat;
+        t.find /= repeat;
+        t.iterate /= repeat;
+        return t;
+    }
+
+    void print(const char* name, std::size_t size, const timings& t)
+    {
+        std::cout << std::setw(8) << name
+                  << std::setw(10) << size
+                  << std::setw(12) << t.insert
+                  << std::setw(12) << t.parse
+                  << std::setw(12) << t.find
+                  << std::setw(12) << t.iterate << "\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t max_size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+
+    std::cout << "Times in milliseconds\n\n" << std::fixed << std::setprecision(4);
+    std::cout << std::setw(8) << "policy"
+              << std::setw(10) << "members"
+              << std::setw(12) << "insert"
+              << std::setw(12) << "parse"
+              << std::setw(12) << "find"
+              << std::setw(12) << "iterate" << "\n";
+
+    std::mt19937 gen(1);
+    for (std::size_t size = 10; size <= max_size; size *= 10)
+    {
+        // Keys in random order, so that neither the sorted nor the
+        // insertion ordered object gets its best case
+        std::vector<std::string> keys;
+        keys.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            keys.push_back("key-" + std::to_string(i) + "-" + std::to_string(gen() % 1000));
+        }
+        std::shuffle(keys.begin(), keys.end(), gen);
+
+        std::string text = "{";
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (i > 0)
+            {
+                text.push_back(',');
+            }
+            text += "\"" + keys[i] + "\":" + std::to_string(i);
+        }
+        text.push_back('}');
+
+        std::size_t repeat = (std::max)(std::size_t(1), std::size_t(100000) / size);
+
+        print("json", size, run<json>(keys, text, repeat));
+        print("ojson", size, run<ojson>(keys, text, repeat));
+        print("ujson", size, run<ujson>(keys, text, repeat));
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,121 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Times decoding records with 40 members, straight from JSON text with decode_json and
+// from a json value with as, and encoding them with encode_json. Keys in the text are
+// in reverse declaration order, so that each is looked up by name.
+//
+// Usage: member_dispatch_benchmarks [size]
+
+#include <jsoncons/json.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "benchmark_timing.hpp"
+
+namespace ns {
+
+    struct record
+    {
+        int64_t order_id;
+        int64_t order_name;
+        int64_t order_code;
+        int64_t order_status;
+        int64_t order_count;
+        int64_t order_amount;
+        int64_t order_created;
+        int64_t order_updated;
+        int64_t order_note;
+        int64_t order_flag;
+        int64_t customer_id;
+        int64_t customer_name;
+        int64_t customer_code;
+        int64_t customer_status;
+        int64_t customer_count;
+        int64_t customer_amount;
+        int64_t customer_created;
+        int64_t customer_updated;
+        int64_t customer_note;
+        int64_t customer_flag;
+        int64_t shipping_id;
+        int64_t shipping_name;
+        int64_t shipping_code;
+        int64_t shipping_status;
+        int64_t shipping_count;
+        int64_t shipping_amount;
+        int64_t shipping_created;
+        int64_t shipping_updated;
+        int64_t shipping_note;
+        int64_t shipping_flag;
+        int64_t billing_id;
+        int64_t billing_name;
+        int64_t billing_code;
+        int64_t billing_status;
+        int64_t billing_count;
+        int64_t billing_amount;
+        int64_t billing_created;
+        int64_t billing_updated;
+        int64_t billing_note;
+        int64_t billing_flag;
+    };
+}
+
+JSONCONS_ALL_MEMBER_TRAITS(ns::record,
+                           order_id,order_name,order_code,order_status,order_count,
+                           order_amount,order_created,order_updated,order_note,order_flag,
+                           customer_id,customer_name,customer_code,customer_status,customer_count,
+                           customer_amount,customer_created,customer_updated,customer_note,customer_flag,
+                           shipping_id,shipping_name,shipping_code,shipping_status,shipping_count,
+                           shipping_amount,shipping_created,shipping_updated,shipping_note,shipping_flag,
+                           billing_id,billing_name,billing_code,billing_status,billing_count,
+                           billing_amount,billing_created,billing_updated,billing_note,billing_flag)
+
+using namespace jsoncons;
+using namespace benchmarks;
+
+int main(int argc, char** argv)
+{
+    std::size_t size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50000;
+    const std::size_t repeat = 5;
+    const std::vector<std::string> names = {"order_id", "order_name", "order_code", "order_status", "order_count", "order_amount", "order_created", "order_updated", "order_note", "order_flag", "customer_id", "customer_name", "customer_code", "customer_status", "customer_count", "customer_amount", "customer_created", "customer_updated", "customer_note", "customer_flag", "shipping_id", "shipping_name", "shipping_code", "shipping_status", "shipping_count", "shipping_amount", "shipping_created", "shipping_updated", "shipping_note", "shipping_flag", "billing_id", "billing_name", "billing_code", "billing_status", "billing_count", "billing_amount", "billing_created", "billing_updated", "billing_note", "billing_flag"};
+
+    std::string text = "[";
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        text += i == 0 ? "{" : ",{";
+        for (std::size_t k = names.size(); k-- > 0; )
+        {
+            text += "\"" + names[k] + "\":" + std::to_string(i + k);
+            text += k == 0 ? "}" : ",";
+        }
+    }
+    text += "]";
+    json j = json::parse(text);
+
+    std::cout << std::fixed << std::setprecision(2) << size << " records, times in milliseconds\n\n";
+
+    double decode = time_ms([&]()
+    {
+        auto v = decode_json<std::vector<ns::record>>(text);
+        keep(v.back().billing_flag);
+    }, repeat);
+    std::cout << std::setw(16) << "decode_json" << std::setw(12) << decode << "\n";
+
+    double as = time_ms([&]()
+    {
+        auto v = j.as<std::vector<ns::record>>();
+        keep(v.back().billing_flag);
+    }, repeat);
+    std::cout << std::setw(16) << "as" << std::setw(12) << as << "\n";
+
+    auto records = decode_json<std::vector<ns::record>>(text);
+    double encode = time_ms([&]()
+    {
+        std::string s;
+        encode_json(records, s);
+        keep(s.size());
+    }, repeat);
+    std::cout << std::setw(16) << "encode_json" << std::setw(12) << encode << "\n";
+}
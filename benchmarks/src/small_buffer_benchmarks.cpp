@@ -0,0 +1,124 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Compares decoding into json and into json with small_buffer_policy, which keeps
+// the elements of tiny arrays and objects in place. Reports the time per parse
+// and the number of heap allocations per parse, counted by replacing operator new.
+//
+// Usage: small_buffer_benchmarks [max_records]
+
+#include <jsoncons/json.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include "benchmark_timing.hpp"
+
+using namespace jsoncons;
+using namespace benchmarks;
+
+namespace {
+
+    std::size_t allocation_count = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocation_count;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+    using small_json = basic_json<char,small_buffer_policy<sorted_policy>>;
+    using small_ojson = basic_json<char,small_buffer_policy<preserve_order_policy>>;
+
+    struct result
+    {
+        double parse;
+        double allocations;
+    };
+
+    template <class Json>
+    result run(const std::string& text, std::size_t repeat)
+    {
+        result res = {0, 0};
+        std::size_t check = 0;
+
+        for (std::size_t r = 0; r < repeat; ++r)
+        {
+            std::size_t count = allocation_count;
+            auto start = clock_type::now();
+            Json j = Json::parse(text);
+            res.parse += elapsed_ms(start);
+            res.allocations += static_cast<double>(allocation_count - count);
+            check += j.size();
+        }
+        keep(check);
+        res.parse /= repeat;
+        res.allocations /= repeat;
+        return res;
+    }
+
+    void print(const char* name, std::size_t size, const result& res)
+    {
+        std::cout << std::setw(12) << name
+                  << std::setw(10) << size
+                  << std::setw(12) << res.parse
+                  << std::setw(14) << res.allocations << "\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t max_records = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+    std::cout << "Parse times in milliseconds, allocations per parse\n\n" << std::fixed << std::setprecision(4);
+    std::cout << std::setw(12) << "policy"
+              << std::setw(10) << "records"
+              << std::setw(12) << "parse"
+              << std::setw(14) << "allocations" << "\n";
+
+    // Records made mostly of tiny arrays and objects, like geometry data
+    for (std::size_t size = 10; size <= max_records; size *= 10)
+    {
+        std::string text = "[";
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (i > 0)
+            {
+                text.push_back(',');
+            }
+            text += "{\"id\":" + std::to_string(i) 
+                  + ",\"point\":[" + std::to_string(i) + ".5," + std::to_string(i) + ".25]"
+                  + ",\"bbox\":[[0,0],[" + std::to_string(i) + ",1]]"
+                  + ",\"tags\":[\"a\"],\"style\":{\"color\":\"red\"}}";
+        }
+        text.push_back(']');
+
+        std::size_t repeat = (std::max)(std::size_t(1), std::size_t(100000) / size);
+
+        print("sorted", size, run<json>(text, repeat));
+        print("small", size, run<small_json>(text, repeat));
+        print("ordered", size, run<ojson>(text, repeat));
+        print("small order", size, run<small_ojson>(text, repeat));
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Times selecting a few values from a large document with json_query, which needs the
+// document in memory, and with staj_query over a json_cursor, which reads only the values
+// it selects.
+//
+// Usage: staj_query_benchmarks [size]
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons_ext/jsonpath/json_query.hpp>
+#include <jsoncons_ext/jsonpath/staj_query.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "benchmark_timing.hpp"
+
+using namespace jsoncons;
+using namespace benchmarks;
+
+int main(int argc, char** argv)
+{
+    std::size_t size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const std::size_t repeat = 5;
+
+    std::string text = "{\"meta\":{\"count\":" + std::to_string(size) + "},\"records\":[";
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        text += i == 0 ? "" : ",";
+        text += "{\"id\":" + std::to_string(i) + ",\"status\":\"" + (i % 100 == 0 ? "error" : "ok") + "\","
+              + "\"tags\":[\"alpha\",\"beta\",\"gamma\"],"
+              + "\"address\":{\"street\":\"" + std::to_string(i) + " Main Street\",\"city\":\"Springfield\"},"
+              + "\"history\":[{\"date\":\"2020-01-01\",\"amount\":12.5,\"items\":[1,2,3,4,5]}]}";
+    }
+    text += "]}";
+
+    std::vector<std::string> paths = {
+        "$.meta.count",
+        "$.records[10:20].id",
+        "$.records[*].id",
+        "$.records[?(@.status == 'error')].id",
+        "$..city"
+    };
+
+    std::cout << std::fixed << std::setprecision(2) << size << " records, times in milliseconds\n\n";
+    std::cout << std::left << std::setw(40) << "path" << std::right << std::setw(12) << "json_query" << std::setw(12) << "staj_query" << "\n";
+
+    for (const auto& path : paths)
+    {
+        double dom = time_ms([&]()
+        {
+            json j = json::parse(text);
+            keep(jsonpath::json_query(j, path).size());
+        }, repeat);
+
+        jsonpath::staj_query<json> query(path);
+        double stream = time_ms([&]()
+        {
+            json_cursor cursor(text);
+            keep(query.evaluate(cursor).size());
+        }, repeat);
+
+        json_cursor cursor(text);
+        if (query.evaluate(cursor).size() != jsonpath::json_query(json::parse(text), path).size())
+        {
+            std::cout << "The results differ\n";
+        }
+        std::cout << std::left << std::setw(40) << path << std::right << std::setw(12) << dom << std::setw(12) << stream << "\n";
+    }
+}
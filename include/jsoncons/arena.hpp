@@ -0,0 +1,233 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_ARENA_HPP
+#define JSONCONS_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits> // std::numeric_limits
+#include <new> // ::operator new, std::bad_alloc
+#include <type_traits> // std::true_type
+#include <jsoncons/config/jsoncons_config.hpp>
+
+namespace jsoncons {
+
+// A monotonic memory resource. Memory is handed out from blocks obtained from operator new,
+// each block larger than the last, or from a buffer supplied by the caller. Deallocation
+// does nothing, all the memory is reclaimed at once by release() or by the destructor.
+// An arena is not thread safe.
+
+class arena
+{
+    struct block
+    {
+        block* next;
+        std::size_t size;
+    };
+
+    char* initial_buffer_;
+    std::size_t initial_size_;
+    block* blocks_;
+    char* current_;
+    char* end_;
+    std::size_t next_block_size_;
+    std::size_t bytes_allocated_;
+public:
+    static constexpr std::size_t default_block_size = 4096;
+    static constexpr std::size_t max_block_size = 16*1024*1024;
+
+    arena()
+        : arena(default_block_size)
+    {
+    }
+
+    // The first block will have at least initial_block_size bytes
+
+    explicit arena(std::size_t initial_block_size)
+        : initial_buffer_(nullptr), initial_size_(0), blocks_(nullptr),
+          current_(nullptr), end_(nullptr),
+          next_block_size_(initial_block_size != 0 ? initial_block_size : 1),
+          bytes_allocated_(0)
+    {
+    }
+
+    // Memory is handed out from buffer before any block is allocated. The buffer must outlive the arena.
+
+    arena(void* buffer, std::size_t size)
+        : initial_buffer_(static_cast<char*>(buffer)), initial_size_(size), blocks_(nullptr),
+          current_(initial_buffer_), end_(initial_buffer_ + size),
+          next_block_size_(default_block_size),
+          bytes_allocated_(0)
+    {
+        if (next_block_size_ < size)
+        {
+            next_block_size_ = size;
+        }
+    }
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena() noexcept
+    {
+        free_blocks();
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+    {
+        if (current_ == nullptr || !fits(bytes, alignment))
+        {
+            // The block size is doubled up to bytes + alignment and must leave room for the header
+            if (bytes > (std::numeric_limits<std::size_t>::max)()/2 - sizeof(block) - alignment)
+            {
+                JSONCONS_THROW(std::bad_alloc());
+            }
+            add_block(bytes + alignment);
+        }
+        char* p = align(current_, alignment);
+        current_ = p + bytes;
+        bytes_allocated_ += bytes;
+        return p;
+    }
+
+    // Frees all the blocks, and starts again from the initial buffer, if any
+
+    void release() noexcept
+    {
+        free_blocks();
+        current_ = initial_buffer_;
+        end_ = initial_buffer_ + initial_size_;
+        bytes_allocated_ = 0;
+    }
+
+    // Total of the sizes passed to allocate since construction or the last release
+
+    std::size_t bytes_allocated() const noexcept
+    {
+        return bytes_allocated_;
+    }
+
+private:
+    bool fits(std::size_t bytes, std::size_t alignment) const noexcept
+    {
+        std::size_t padding = static_cast<std::size_t>(align(current_, alignment) - current_);
+        std::size_t available = static_cast<std::size_t>(end_ - current_);
+        return padding <= available && bytes <= available - padding;
+    }
+
+    static char* align(char* p, std::size_t alignment) noexcept
+    {
+        std::uintptr_t n = reinterpret_cast<std::uintptr_t>(p);
+        std::uintptr_t aligned = (n + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+        return p + (aligned - n);
+    }
+
+    void add_block(std::size_t min_size)
+    {
+        std::size_t size = next_block_size_;
+        while (size < min_size)
+        {
+            size *= 2;
+        }
+        if (next_block_size_ < max_block_size)
+        {
+            next_block_size_ *= 2;
+        }
+        block* b = static_cast<block*>(::operator new(sizeof(block) + size));
+        b->next = blocks_;
+        b->size = size;
+        blocks_ = b;
+        current_ = reinterpret_cast<char*>(b + 1);
+        end_ = current_ + size;
+    }
+
+    void free_blocks() noexcept
+    {
+        while (blocks_ != nullptr)
+        {
+            block* next = blocks_->next;
+            ::operator delete(blocks_);
+            blocks_ = next;
+        }
+    }
+};
+
+// An allocator that allocates from an arena. Copies, including rebound copies,
+// allocate from the same arena, and compare equal. A default constructed
+// arena_allocator has no arena, and allocates and deallocates with operator new
+// and operator delete, like std::allocator.
+
+template <class T>
+class arena_allocator
+{
+    template <class U> friend class arena_allocator;
+
+    arena* arena_;
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    arena_allocator() noexcept
+        : arena_(nullptr)
+    {
+    }
+
+    arena_allocator(arena& a) noexcept
+        : arena_(&a)
+    {
+    }
+
+    template <class U>
+    arena_allocator(const arena_allocator<U>& other) noexcept
+        : arena_(other.arena_)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > (std::numeric_limits<std::size_t>::max)()/sizeof(T))
+        {
+            JSONCONS_THROW(std::bad_alloc());
+        }
+        if (arena_ == nullptr)
+        {
+            return static_cast<T*>(::operator new(n*sizeof(T)));
+        }
+        return static_cast<T*>(arena_->allocate(n*sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept
+    {
+        if (arena_ == nullptr)
+        {
+            ::operator delete(p);
+        }
+    }
+
+    // The arena, or nullptr if default constructed
+    arena* resource() const noexcept
+    {
+        return arena_;
+    }
+
+    template <class U>
+    friend bool operator==(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept
+    {
+        return lhs.resource() == rhs.resource();
+    }
+
+    template <class U>
+    friend bool operator!=(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept
+    {
+        return lhs.resource() != rhs.resource();
+    }
+};
+
+} // namespace jsoncons
+
+#endif
@@ -22,6 +22,7 @@
 #include <type_traits> // std::enable_if
 #include <istream> // std::basic_istream
 #include <jsoncons/json_fwd.hpp>
+#include <jsoncons/arena.hpp>
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/config/version.hpp>
 #include <jsoncons/json_type.hpp>
@@ -33,9 +34,16 @@
 #include <jsoncons/json_encoder.hpp>
 #include <jsoncons/json_decoder.hpp>
 #include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_tape_parser.hpp>
 #include <jsoncons/json_type_traits.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/heap_only_string.hpp>
+#include <jsoncons/detail/storage_node.hpp>
+#include <jsoncons/detail/hash.hpp>
+#include <jsoncons/detail/endian.hpp>
+#include <jsoncons/detail/small_vector.hpp>
+#include <jsoncons/detail/shared_key.hpp>
+#include <jsoncons/typed_array_view.hpp>
 
 namespace jsoncons { 
 namespace detail {
@@ -224,6 +232,10 @@ struct sorted_policy
     using key_storage = std::basic_string<CharT, CharTraits,Allocator>;
 
     using parse_error_handler_type = default_json_parsing;
+
+    // With preserve_order_policy and unordered_policy, objects with more members 
+    // than this are indexed by a hash table, smaller ones are searched linearly
+    static constexpr std::size_t hash_index_threshold = 16;
 };
 
 struct preserve_order_policy : public sorted_policy
@@ -231,6 +243,88 @@ struct preserve_order_policy : public sorted_policy
     using key_order = preserve_key_order;
 };
 
+struct unordered_policy : public sorted_policy
+{
+    using key_order = unordered_key_order;
+};
+
+// Arrays, objects and long strings are reference counted, copies share them, and
+// a shared array or object is copied when it is accessed through a non-const path 
+template <class Policy>
+struct copy_on_write_policy : public Policy
+{
+    static constexpr bool copy_on_write = true;
+};
+
+// Arrays and objects with up to N elements keep them in the container, saving the
+// allocation for the elements
+template <class Policy, std::size_t N = 4>
+struct small_buffer_policy : public Policy
+{
+    template <class T,class Allocator>
+    using sequence_container_type = jsoncons::detail::small_vector<T,N,Allocator>;
+};
+
+// Object keys are immutable strings the size of a pointer, shared by copies, and
+// json_decoder stores each distinct key once
+template <class Policy>
+struct shared_key_policy : public Policy
+{
+    template <class CharT, class CharTraits, class Allocator>
+    using key_storage = jsoncons::detail::shared_key<CharT,CharTraits,Allocator>;
+};
+
+// Arrays and objects keep their hash once it has been computed, when the hash took more than
+// a few values to compute, until they are accessed through a non-const path
+template <class Policy>
+struct cached_hash_policy : public Policy
+{
+    static constexpr bool cached_hash = true;
+};
+
+// A value is held in 8 bytes instead of 16. Doubles, null, bool, integers that fit in 45 bits 
+// and strings of up to 4 bytes are held in place, long strings, arrays and objects through a 
+// pointer, other values in a 16 byte value on the heap
+template <class Policy>
+struct compact_value_policy : public Policy
+{
+    static constexpr bool compact_values = true;
+};
+
+namespace detail {
+
+    template <class Policy, class Enable = void>
+    struct is_copy_on_write : std::false_type
+    {
+    };
+
+    template <class Policy>
+    struct is_copy_on_write<Policy, typename std::enable_if<Policy::copy_on_write>::type> : std::true_type
+    {
+    };
+
+    template <class Policy, class Enable = void>
+    struct is_cached_hash : std::false_type
+    {
+    };
+
+    template <class Policy>
+    struct is_cached_hash<Policy, typename std::enable_if<Policy::cached_hash>::type> : std::true_type
+    {
+    };
+
+    template <class Policy, class Enable = void>
+    struct is_compact_values : std::false_type
+    {
+    };
+
+    template <class Policy>
+    struct is_compact_values<Policy, typename std::enable_if<Policy::compact_values>::type> : std::true_type
+    {
+    };
+
+} // namespace detail
+
 template <typename IteratorT>
 class range 
 {
@@ -270,7 +364,7 @@ public:
 
     using char_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<char_type>;
 
-    using key_type = std::basic_string<char_type,char_traits_type,char_allocator_type>;
+    using key_type = typename implementation_policy::template key_storage<char_type,char_traits_type,char_allocator_type>;
 
 
     using reference = basic_json&;
@@ -296,1522 +390,3330 @@ public:
 
     using object = json_object<key_type,basic_json>;
 
-    using object_iterator = jsoncons::detail::random_access_iterator_wrapper<typename object::iterator>;              
-    using const_object_iterator = jsoncons::detail::random_access_iterator_wrapper<typename object::const_iterator>;                    
-    using array_iterator = typename array::iterator;
-    using const_array_iterator = typename array::const_iterator;
+private:
+    // The iterator types are taken from the containers without instantiating array and object,
+    // which a container that holds elements in place cannot be while basic_json is incomplete
+    using value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<basic_json>;
+    using array_iterator_traits = jsoncons::detail::sequence_iterator_traits<
+        typename implementation_policy::template sequence_container_type<basic_json,value_allocator_type>>;
+    using object_iterator_traits = jsoncons::detail::sequence_iterator_traits<
+        typename implementation_policy::template sequence_container_type<key_value_type,key_value_allocator_type>>;
+public:
+    using object_iterator = jsoncons::detail::random_access_iterator_wrapper<typename object_iterator_traits::iterator>;              
+    using const_object_iterator = jsoncons::detail::random_access_iterator_wrapper<typename object_iterator_traits::const_iterator>;                    
+    using array_iterator = typename array_iterator_traits::iterator;
+    using const_array_iterator = typename array_iterator_traits::const_iterator;
 
-    struct variant
+    // The operations on a value that are the same for each layout, in terms of the storage(), tag()
+    // and cast<T>() of the Variant
+    template <class Variant>
+    struct variant_base
     {
-        static constexpr uint8_t major_type_shift = 0x04;
-        static constexpr uint8_t additional_information_mask = (1U << 4) - 1;
+        // Destroying an array or object first destroys the nonempty arrays and objects it holds,
+        // deepest first, so that no destructor has nested containers left to destroy. The recursion
+        // stops at max_destroy_depth, deeper values are moved onto a work stack and destroyed from there.
+        // So destroying a deeply nested value does not exhaust the call stack. If the work stack cannot
+        // grow, the values not yet moved are destroyed recursively.
 
-        static constexpr uint8_t from_storage_and_tag(storage_kind storage, semantic_tag tag)
-        {
-            return (static_cast<uint8_t>(storage) << major_type_shift) | static_cast<uint8_t>(tag);
-        }
+        static constexpr std::size_t max_destroy_depth = 64;
 
-        static storage_kind to_storage(uint8_t ext_type) 
+        static basic_json& nested_value(basic_json& val) noexcept
         {
-            uint8_t value = ext_type >> major_type_shift;
-            return static_cast<storage_kind>(value);
+            return val;
         }
 
-        static semantic_tag to_tag(uint8_t ext_type)
+        static basic_json& nested_value(key_value_type& member) noexcept
         {
-            uint8_t value = ext_type & additional_information_mask;
-            return static_cast<semantic_tag>(value);
+            return member.value();
         }
 
-        class common_storage final
+        // An array or object shared with other values is left for its last owner to destroy
+        static bool is_unshared_container(const basic_json& val) noexcept
         {
-        public:
-            uint8_t ext_type_;
-        };
+            switch (val.storage())
+            {
+                case storage_kind::array_value:
+                    return !val.var_.template cast<typename variant::array_storage>().is_shared();
+                case storage_kind::object_value:
+                    return !val.var_.template cast<typename variant::object_storage>().is_shared();
+                default:
+                    return false;
+            }
+        }
 
-        class null_storage final
+        template <class Container>
+        static void destroy_nested(Container& c, std::size_t depth, std::vector<basic_json>& stack) noexcept
         {
-        public:
-            uint8_t ext_type_;
-
-            null_storage()
-                : ext_type_(from_storage_and_tag(storage_kind::null_value, semantic_tag::none))
+            for (auto& item : c)
             {
+                basic_json& val = nested_value(item);
+                if (is_unshared_container(val) && !val.empty())
+                {
+                    if (depth < max_destroy_depth)
+                    {
+                        // Clearing leaves an empty container, whose destructor has nothing to visit
+                        if (val.storage() == storage_kind::array_value)
+                        {
+                            destroy_nested(val.array_value(), depth+1, stack);
+                            val.array_value().clear();
+                        }
+                        else
+                        {
+                            destroy_nested(val.object_value(), depth+1, stack);
+                            val.object_value().clear();
+                        }
+                    }
+                    else
+                    {
+                        JSONCONS_TRY
+                        {
+                            stack.push_back(std::move(val));
+                        }
+                        JSONCONS_CATCH(...)
+                        {
+                        }
+                    }
+                }
             }
-            null_storage(semantic_tag tag)
-                : ext_type_(from_storage_and_tag(storage_kind::null_value, tag))
+        }
+
+        template <class Container>
+        static void destroy_nested(Container& c) noexcept
+        {
+            std::vector<basic_json> stack;
+            destroy_nested(c, 0, stack);
+            while (!stack.empty())
             {
+                basic_json current(std::move(stack.back()));
+                stack.pop_back();
+                if (current.storage() == storage_kind::array_value)
+                {
+                    destroy_nested(current.array_value(), 0, stack);
+                }
+                else
+                {
+                    destroy_nested(current.object_value(), 0, stack);
+                }
             }
-        };
+        }
 
-        class empty_object_storage final
+        storage_kind storage() const
         {
-        public:
-            uint8_t ext_type_;
+            return static_cast<const Variant*>(this)->storage();
+        }
 
-            empty_object_storage(semantic_tag tag)
-                : ext_type_(from_storage_and_tag(storage_kind::empty_object_value, tag))
+        semantic_tag tag() const
+        {
+            return static_cast<const Variant*>(this)->tag();
+        }
+
+        template <class T>
+        auto cast() const -> decltype(std::declval<const Variant&>().template cast<T>())
+        {
+            return static_cast<const Variant*>(this)->template cast<T>();
+        }
+
+        std::size_t size() const
+        {
+            switch (storage())
             {
+                case storage_kind::array_value:
+                    return cast<typename Variant::array_storage>().value().size();
+                case storage_kind::typed_array_value:
+                    return cast<typename Variant::typed_array_storage>().size();
+                case storage_kind::object_value:
+                    return cast<typename Variant::object_storage>().value().size();
+                default:
+                    return 0;
             }
-        };  
+        }
 
-        class bool_storage final
+        string_view_type as_string_view() const
         {
-        public:
-            uint8_t ext_type_;
-        private:
-            bool val_;
-        public:
-            bool_storage(bool val, semantic_tag tag)
-                : ext_type_(from_storage_and_tag(storage_kind::bool_value, tag)),
-                  val_(val)
+            switch (storage())
             {
+                case storage_kind::short_string_value:
+                    return string_view_type(cast<typename Variant::short_string_storage>().data(),cast<typename Variant::short_string_storage>().length());
+                case storage_kind::long_string_value:
+                    return string_view_type(cast<typename Variant::long_string_storage>().data(),cast<typename Variant::long_string_storage>().length());
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
             }
+        }
 
-            bool_storage(const bool_storage& val)
-                : ext_type_(val.ext_type_),
-                  val_(val.val_)
+        template <typename BAllocator=std::allocator<uint8_t>>
+        basic_byte_string<BAllocator> as_byte_string() const
+        {
+            switch (storage())
             {
+                case storage_kind::short_string_value:
+                case storage_kind::long_string_value:
+                {
+                    switch (tag())
+                    {
+                        case semantic_tag::base16:
+                        {
+                            basic_byte_string<BAllocator> bytes;
+                            auto s = as_string_view();
+                            decode_base16(s.begin(), s.end(), bytes);
+                            return bytes;
+                        }
+                        case semantic_tag::base64:
+                        {
+                            basic_byte_string<BAllocator> bytes;
+                            auto s = as_string_view();
+                            decode_base64(s.begin(), s.end(), bytes);
+                            return bytes;
+                        }
+                        case semantic_tag::base64url:
+                        {
+                            basic_byte_string<BAllocator> bytes;
+                            auto s = as_string_view();
+                            decode_base64url(s.begin(), s.end(), bytes);
+                            return bytes;
+                        }
+                        default:
+                            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
+                    }
+                    break;
+                }
+                case storage_kind::byte_string_value:
+                    return basic_byte_string<BAllocator>(cast<typename Variant::byte_string_storage>().data(),cast<typename Variant::byte_string_storage>().length());
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
             }
+        }
 
-            bool value() const
+        byte_string_view as_byte_string_view() const
+        {
+            switch (storage())
             {
-                return val_;
+            case storage_kind::byte_string_value:
+                return byte_string_view(cast<typename Variant::byte_string_storage>().data(),cast<typename Variant::byte_string_storage>().length());
+            default:
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
             }
+        }
 
-        };
+        bool is_array() const
+        {
+            return storage() == storage_kind::array_value || storage() == storage_kind::typed_array_value;
+        }
 
-        class int64_storage final
+        // The element at i of an array. The element of a typed array is built into temp, so that
+        // comparing typed arrays does not build all their elements
+        const basic_json& array_element(std::size_t i, basic_json& temp) const
         {
-        public:
-            uint8_t ext_type_;
-        private:
-            int64_t val_;
-        public:
-            int64_storage(int64_t val, 
-                       semantic_tag tag = semantic_tag::none)
-                : ext_type_(from_storage_and_tag(storage_kind::int64_value, tag)),
-                  val_(val)
+            if (storage() == storage_kind::typed_array_value)
             {
+                temp = cast<typename Variant::typed_array_storage>().value_at(i);
+                return temp;
             }
+            return cast<typename Variant::array_storage>().value()[i];
+        }
 
-            int64_storage(const int64_storage& val)
-                : ext_type_(val.ext_type_),
-                  val_(val.val_)
-            {
-            }
+        bool is_double_text() const
+        {
+            return storage() == storage_kind::short_double_text_value || storage() == storage_kind::long_double_text_value;
+        }
 
-            int64_t value() const
+        string_view_type double_text() const
+        {
+            switch (storage())
             {
-                return val_;
+                case storage_kind::short_double_text_value:
+                    return string_view_type(cast<typename Variant::short_string_storage>().data(),cast<typename Variant::short_string_storage>().length());
+                case storage_kind::long_double_text_value:
+                    return string_view_type(cast<typename Variant::long_string_storage>().data(),cast<typename Variant::long_string_storage>().length());
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a double"));
             }
-        };
+        }
 
-        class uint64_storage final
+        // Converts the text of a number kept unconverted. The text is not replaced by
+        // the result, so that a const value can be read concurrently and written back as is.
+        double double_text_value() const
         {
-        public:
-            uint8_t ext_type_;
-        private:
-            uint64_t val_;
-        public:
-            uint64_storage(uint64_t val, 
-                        semantic_tag tag = semantic_tag::none)
-                : ext_type_(from_storage_and_tag(storage_kind::uint64_value, tag)),
-                  val_(val)
+            string_view_type text = double_text();
+            double value;
+            if (!jsoncons::detail::decimal_to_double(text.data(), text.length(), static_cast<char_type>('.'), value))
             {
+                JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
             }
+            return value;
+        }
 
-            uint64_storage(const uint64_storage& val)
-                : ext_type_(val.ext_type_),
-                  val_(val.val_)
+        bool operator==(const Variant& rhs) const
+        {
+            if (this ==&rhs)
             {
+                return true;
             }
-
-            uint64_t value() const
+            if (is_double_text())
             {
-                return val_;
+                return Variant(double_text_value(), tag()) == rhs;
             }
-        };
-
-        class half_storage final
-        {
-        public:
-            uint8_t ext_type_;
-        private:
-            uint16_t val_;
-        public:
-            half_storage(uint16_t val, semantic_tag tag = semantic_tag::none)
-                : ext_type_(from_storage_and_tag(storage_kind::half_value, tag)), 
-                  val_(val)
+            if (rhs.is_double_text())
             {
+                return *this == Variant(rhs.double_text_value(), rhs.tag());
             }
-
-            half_storage(const half_storage& val)
-                : ext_type_(val.ext_type_),
-                  val_(val.val_)
+            if (storage() == storage_kind::typed_array_value || rhs.storage() == storage_kind::typed_array_value)
             {
+                if (storage() == storage_kind::typed_array_value && rhs.storage() == storage_kind::typed_array_value &&
+                    cast<typename Variant::typed_array_storage>().type() == rhs.template cast<typename Variant::typed_array_storage>().type())
+                {
+                    return cast<typename Variant::typed_array_storage>().same_elements(rhs.template cast<typename Variant::typed_array_storage>());
+                }
+                if (!is_array() || !rhs.is_array() || size() != rhs.size())
+                {
+                    return false;
+                }
+                basic_json temp1;
+                basic_json temp2;
+                for (std::size_t i = 0; i < size(); ++i)
+                {
+                    if (!(array_element(i, temp1) == rhs.array_element(i, temp2)))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            switch (storage())
+            {
+                case storage_kind::null_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::null_value:
+                            return true;
+                        default:
+                            return false;
+                    }
+                    break;
+                case storage_kind::empty_object_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::empty_object_value:
+                            return true;
+                        case storage_kind::object_value:
+                            return rhs.size() == 0;
+                        default:
+                            return false;
+                    }
+                    break;
+                case storage_kind::bool_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::bool_value:
+                            return cast<typename Variant::bool_storage>().value() == rhs.template cast<typename Variant::bool_storage>().value();
+                        default:
+                            return false;
+                    }
+                    break;
+                case storage_kind::int64_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::int64_value:
+                            return cast<typename Variant::int64_storage>().value() == rhs.template cast<typename Variant::int64_storage>().value();
+                        case storage_kind::uint64_value:
+                            return cast<typename Variant::int64_storage>().value() >= 0 ? static_cast<uint64_t>(cast<typename Variant::int64_storage>().value()) == rhs.template cast<typename Variant::uint64_storage>().value() : false;
+                        case storage_kind::half_value:
+                            return static_cast<double>(cast<typename Variant::int64_storage>().value()) == jsoncons::detail::decode_half(rhs.template cast<typename Variant::half_storage>().value());
+                        case storage_kind::double_value:
+                            return static_cast<double>(cast<typename Variant::int64_storage>().value()) == rhs.template cast<typename Variant::double_storage>().value();
+                        default:
+                            return false;
+                    }
+                    break;
+                case storage_kind::uint64_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::int64_value:
+                            return rhs.template cast<typename Variant::int64_storage>().value() >= 0 ? cast<typename Variant::uint64_storage>().value() == static_cast<uint64_t>(rhs.template cast<typename Variant::int64_storage>().value()) : false;
+                        case storage_kind::uint64_value:
+                            return cast<typename Variant::uint64_storage>().value() == rhs.template cast<typename Variant::uint64_storage>().value();
+                        case storage_kind::half_value:
+                            return static_cast<double>(cast<typename Variant::uint64_storage>().value()) == jsoncons::detail::decode_half(rhs.template cast<typename Variant::half_storage>().value());
+                        case storage_kind::double_value:
+                            return static_cast<double>(cast<typename Variant::uint64_storage>().value()) == rhs.template cast<typename Variant::double_storage>().value();
+                        default:
+                            return false;
+                    }
+                    break;
+                case storage_kind::half_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::half_value:
+                            return cast<typename Variant::half_storage>().value() == rhs.template cast<typename Variant::half_storage>().value();
+                        default:
+                            return Variant(jsoncons::detail::decode_half(cast<typename Variant::half_storage>().value()),semantic_tag::none) == rhs;
+                    }
+                    break;
+                case storage_kind::double_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::int64_value:
+                            return cast<typename Variant::double_storage>().value() == static_cast<double>(rhs.template cast<typename Variant::int64_storage>().value());
+                        case storage_kind::uint64_value:
+                            return cast<typename Variant::double_storage>().value() == static_cast<double>(rhs.template cast<typename Variant::uint64_storage>().value());
+                        case storage_kind::half_value:
+                            return cast<typename Variant::double_storage>().value() == jsoncons::detail::decode_half(rhs.template cast<typename Variant::half_storage>().value());
+                        case storage_kind::double_value:
+                            return cast<typename Variant::double_storage>().value() == rhs.template cast<typename Variant::double_storage>().value();
+                        default:
+                            return false;
+                    }
+                    break;
+                case storage_kind::short_string_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::short_string_value:
+                            return as_string_view() == rhs.as_string_view();
+                        case storage_kind::long_string_value:
+                            return as_string_view() == rhs.as_string_view();
+                        default:
+                            return false;
+                    }
+                    break;
+                case storage_kind::long_string_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::short_string_value:
+                            return as_string_view() == rhs.as_string_view();
+                        case storage_kind::long_string_value:
+                            return as_string_view() == rhs.as_string_view();
+                        default:
+                            return false;
+                    }
+                    break;
+                case storage_kind::byte_string_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::byte_string_value:
+                        {
+                            return as_byte_string_view() == rhs.as_byte_string_view();
+                        }
+                        default:
+                            return false;
+                    }
+                    break;
+                case storage_kind::array_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::array_value:
+                            return cast<typename Variant::array_storage>().value() == rhs.template cast<typename Variant::array_storage>().value();
+                        default:
+                            return false;
+                    }
+                    break;
+                case storage_kind::object_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::empty_object_value:
+                            return size() == 0;
+                        case storage_kind::object_value:
+                            return cast<typename Variant::object_storage>().value() == rhs.template cast<typename Variant::object_storage>().value();
+                        default:
+                            return false;
+                    }
+                    break;
+                default:
+                    JSONCONS_UNREACHABLE();
+                    break;
+            }
+        }
+
+        bool operator!=(const Variant& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+        bool operator<(const Variant& rhs) const
+        {
+            if (this == &rhs)
+            {
+                return false;
+            }
+            if (is_double_text())
+            {
+                return Variant(double_text_value(), tag()) < rhs;
+            }
+            if (rhs.is_double_text())
+            {
+                return *this < Variant(rhs.double_text_value(), rhs.tag());
+            }
+            if (storage() == storage_kind::typed_array_value || rhs.storage() == storage_kind::typed_array_value)
+            {
+                if (is_array() && rhs.is_array())
+                {
+                    std::size_t n = size() < rhs.size() ? size() : rhs.size();
+                    basic_json temp1;
+                    basic_json temp2;
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        const basic_json& a = array_element(i, temp1);
+                        const basic_json& b = rhs.array_element(i, temp2);
+                        if (a < b)
+                        {
+                            return true;
+                        }
+                        if (b < a)
+                        {
+                            return false;
+                        }
+                    }
+                    return size() < rhs.size();
+                }
+                return (int)(is_array() ? storage_kind::array_value : storage()) < (int)(rhs.is_array() ? storage_kind::array_value : rhs.storage());
+            }
+            switch (storage())
+            {
+                case storage_kind::null_value:
+                    return (int)storage() < (int)rhs.storage();
+                case storage_kind::empty_object_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::empty_object_value:
+                            return false;
+                        case storage_kind::object_value:
+                            return rhs.size() != 0;
+                        default:
+                            return (int)storage() < (int)rhs.storage();
+                    }
+                    break;
+                case storage_kind::bool_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::bool_value:
+                            return cast<typename Variant::bool_storage>().value() < rhs.template cast<typename Variant::bool_storage>().value();
+                        default:
+                            return (int)storage() < (int)rhs.storage();
+                    }
+                    break;
+                case storage_kind::int64_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::int64_value:
+                            return cast<typename Variant::int64_storage>().value() < rhs.template cast<typename Variant::int64_storage>().value();
+                        case storage_kind::uint64_value:
+                            return cast<typename Variant::int64_storage>().value() >= 0 ? static_cast<uint64_t>(cast<typename Variant::int64_storage>().value()) < rhs.template cast<typename Variant::uint64_storage>().value() : true;
+                        case storage_kind::double_value:
+                            return static_cast<double>(cast<typename Variant::int64_storage>().value()) < rhs.template cast<typename Variant::double_storage>().value();
+                        default:
+                            return (int)storage() < (int)rhs.storage();
+                    }
+                    break;
+                case storage_kind::uint64_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::int64_value:
+                            return rhs.template cast<typename Variant::int64_storage>().value() >= 0 ? cast<typename Variant::uint64_storage>().value() < static_cast<uint64_t>(rhs.template cast<typename Variant::int64_storage>().value()) : true;
+                        case storage_kind::uint64_value:
+                            return cast<typename Variant::uint64_storage>().value() < rhs.template cast<typename Variant::uint64_storage>().value();
+                        case storage_kind::double_value:
+                            return static_cast<double>(cast<typename Variant::uint64_storage>().value()) < rhs.template cast<typename Variant::double_storage>().value();
+                        default:
+                            return (int)storage() < (int)rhs.storage();
+                    }
+                    break;
+                case storage_kind::double_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::int64_value:
+                            return cast<typename Variant::double_storage>().value() < static_cast<double>(rhs.template cast<typename Variant::int64_storage>().value());
+                        case storage_kind::uint64_value:
+                            return cast<typename Variant::double_storage>().value() < static_cast<double>(rhs.template cast<typename Variant::uint64_storage>().value());
+                        case storage_kind::double_value:
+                            return cast<typename Variant::double_storage>().value() < rhs.template cast<typename Variant::double_storage>().value();
+                        default:
+                            return (int)storage() < (int)rhs.storage();
+                    }
+                    break;
+                case storage_kind::short_string_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::short_string_value:
+                            return as_string_view() < rhs.as_string_view();
+                        case storage_kind::long_string_value:
+                            return as_string_view() < rhs.as_string_view();
+                        default:
+                            return (int)storage() < (int)rhs.storage();
+                    }
+                    break;
+                case storage_kind::long_string_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::short_string_value:
+                            return as_string_view() < rhs.as_string_view();
+                        case storage_kind::long_string_value:
+                            return as_string_view() < rhs.as_string_view();
+                        default:
+                            return (int)storage() < (int)rhs.storage();
+                    }
+                    break;
+                case storage_kind::byte_string_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::byte_string_value:
+                        {
+                            return as_byte_string_view() < rhs.as_byte_string_view();
+                        }
+                        default:
+                            return (int)storage() < (int)rhs.storage();
+                    }
+                    break;
+                case storage_kind::array_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::array_value:
+                            return cast<typename Variant::array_storage>().value() < rhs.template cast<typename Variant::array_storage>().value();
+                        default:
+                            return (int)storage() < (int)rhs.storage();
+                    }
+                    break;
+                case storage_kind::object_value:
+                    switch (rhs.storage())
+                    {
+                        case storage_kind::empty_object_value:
+                            return false;
+                        case storage_kind::object_value:
+                            return cast<typename Variant::object_storage>().value() < rhs.template cast<typename Variant::object_storage>().value();
+                        default:
+                            return (int)storage() < (int)rhs.storage();
+                    }
+                    break;
+                default:
+                    JSONCONS_UNREACHABLE();
+                    break;
+            }
+        }
+    };
+
+    struct default_variant : variant_base<default_variant>
+    {
+        static constexpr bool copy_on_write = jsoncons::detail::is_copy_on_write<ImplementationPolicy>::value;
+        static constexpr bool keep_hash = jsoncons::detail::is_cached_hash<ImplementationPolicy>::value;
+
+        static constexpr uint8_t major_type_shift = 0x04;
+        static constexpr uint8_t additional_information_mask = (1U << 4) - 1;
+
+        static constexpr uint8_t from_storage_and_tag(storage_kind storage, semantic_tag tag)
+        {
+            return (static_cast<uint8_t>(storage) << major_type_shift) | static_cast<uint8_t>(tag);
+        }
+
+        static storage_kind to_storage(uint8_t ext_type) 
+        {
+            uint8_t value = ext_type >> major_type_shift;
+            return static_cast<storage_kind>(value);
+        }
+
+        static semantic_tag to_tag(uint8_t ext_type)
+        {
+            uint8_t value = ext_type & additional_information_mask;
+            return static_cast<semantic_tag>(value);
+        }
+
+        class common_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        };
+
+        class null_storage final
+        {
+        public:
+            uint8_t ext_type_;
+
+            null_storage()
+                : ext_type_(from_storage_and_tag(storage_kind::null_value, semantic_tag::none))
+            {
+            }
+            null_storage(semantic_tag tag)
+                : ext_type_(from_storage_and_tag(storage_kind::null_value, tag))
+            {
+            }
+        };
+
+        class empty_object_storage final
+        {
+        public:
+            uint8_t ext_type_;
+
+            empty_object_storage(semantic_tag tag)
+                : ext_type_(from_storage_and_tag(storage_kind::empty_object_value, tag))
+            {
+            }
+        };  
+
+        class bool_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            bool val_;
+        public:
+            bool_storage(bool val, semantic_tag tag)
+                : ext_type_(from_storage_and_tag(storage_kind::bool_value, tag)),
+                  val_(val)
+            {
+            }
+
+            bool_storage(const bool_storage& val)
+                : ext_type_(val.ext_type_),
+                  val_(val.val_)
+            {
+            }
+
+            bool value() const
+            {
+                return val_;
+            }
+
+        };
+
+        class int64_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            int64_t val_;
+        public:
+            int64_storage(int64_t val, 
+                       semantic_tag tag = semantic_tag::none)
+                : ext_type_(from_storage_and_tag(storage_kind::int64_value, tag)),
+                  val_(val)
+            {
+            }
+
+            int64_storage(const int64_storage& val)
+                : ext_type_(val.ext_type_),
+                  val_(val.val_)
+            {
+            }
+
+            int64_t value() const
+            {
+                return val_;
+            }
+        };
+
+        class uint64_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            uint64_t val_;
+        public:
+            uint64_storage(uint64_t val, 
+                        semantic_tag tag = semantic_tag::none)
+                : ext_type_(from_storage_and_tag(storage_kind::uint64_value, tag)),
+                  val_(val)
+            {
+            }
+
+            uint64_storage(const uint64_storage& val)
+                : ext_type_(val.ext_type_),
+                  val_(val.val_)
+            {
+            }
+
+            uint64_t value() const
+            {
+                return val_;
+            }
+        };
+
+        class half_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            uint16_t val_;
+        public:
+            half_storage(uint16_t val, semantic_tag tag = semantic_tag::none)
+                : ext_type_(from_storage_and_tag(storage_kind::half_value, tag)), 
+                  val_(val)
+            {
+            }
+
+            half_storage(const half_storage& val)
+                : ext_type_(val.ext_type_),
+                  val_(val.val_)
+            {
+            }
+
+            uint16_t value() const
+            {
+                return val_;
+            }
+        };
+
+        class double_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            double val_;
+        public:
+            double_storage(double val, 
+                        semantic_tag tag = semantic_tag::none)
+                : ext_type_(from_storage_and_tag(storage_kind::double_value, tag)), 
+                  val_(val)
+            {
+            }
+
+            double_storage(const double_storage& val)
+                : ext_type_(val.ext_type_),
+                  val_(val.val_)
+            {
+            }
+
+            double value() const
+            {
+                return val_;
+            }
+        };
+
+        class short_string_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            static constexpr size_t capacity = (2*sizeof(uint64_t) - 2*sizeof(uint8_t))/sizeof(char_type);
+            uint8_t length_;
+            char_type data_[capacity];
+        public:
+            static constexpr size_t max_length = capacity - 1;
+
+            short_string_storage(semantic_tag tag, const char_type* p, uint8_t length)
+                : short_string_storage(storage_kind::short_string_value, tag, p, length)
+            {
+            }
+
+            short_string_storage(storage_kind storage, semantic_tag tag, const char_type* p, uint8_t length)
+                : ext_type_(from_storage_and_tag(storage, tag)), 
+                  length_(length)
+            {
+                JSONCONS_ASSERT(length <= max_length);
+                std::memcpy(data_,p,length*sizeof(char_type));
+                data_[length] = 0;
+            }
+
+            short_string_storage(const short_string_storage& val)
+                : ext_type_(val.ext_type_), 
+                  length_(val.length_)
+            {
+                std::memcpy(data_,val.data_,val.length_*sizeof(char_type));
+                data_[length_] = 0;
+            }
+
+            uint8_t length() const
+            {
+                return length_;
+            }
+
+            const char_type* data() const
+            {
+                return data_;
+            }
+
+            const char_type* c_str() const
+            {
+                return data_;
+            }
+        };
+
+        // long_string_storage
+        class long_string_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            using string_wrapper_type = typename std::conditional<copy_on_write,
+                jsoncons::detail::shared_heap_only_string_wrapper<char_type,Allocator>,
+                jsoncons::detail::heap_only_string_wrapper<char_type,Allocator>>::type;
+
+            string_wrapper_type s_;
+        public:
+
+            long_string_storage(semantic_tag tag, const char_type* data, std::size_t length, const Allocator& a)
+                : long_string_storage(storage_kind::long_string_value, tag, data, length, a)
+            {
+            }
+
+            long_string_storage(storage_kind storage, semantic_tag tag, const char_type* data, std::size_t length, const Allocator& a)
+                : ext_type_(from_storage_and_tag(storage, tag)),
+                  s_(data, length, a)
+            {
+            }
+
+            long_string_storage(const long_string_storage& val)
+                : ext_type_(val.ext_type_), s_(val.s_)
+            {
+            }
+
+            long_string_storage(long_string_storage&& val) noexcept
+                : ext_type_(val.ext_type_), 
+                  s_(nullptr)
+            {
+                swap(val);
+            }
+
+            long_string_storage(const long_string_storage& val, const Allocator& a)
+                : ext_type_(val.ext_type_), s_(val.s_, a)
+            {
+            }
+
+            ~long_string_storage() noexcept
+            {
+            }
+
+            void swap(long_string_storage& val) noexcept
+            {
+                s_.swap(val.s_);
+            }
+
+            const char_type* data() const
+            {
+                return s_.data();
+            }
+
+            const char_type* c_str() const
+            {
+                return s_.c_str();
+            }
+
+            std::size_t length() const
+            {
+                return s_.length();
+            }
+
+            allocator_type get_allocator() const
+            {
+                return s_.get_allocator();
+            }
+        };
+
+        // byte_string_storage
+        class byte_string_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            using byte_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<byte_string_storage_type>;                  
+            using pointer = typename std::allocator_traits<byte_allocator_type>::pointer;
+
+            pointer ptr_;
+
+            template <typename... Args>
+            void create(byte_allocator_type alloc, Args&& ... args)
+            {
+                ptr_ = std::allocator_traits<byte_allocator_type>::allocate(alloc, 1);
+                JSONCONS_TRY
+                {
+                    std::allocator_traits<byte_allocator_type>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    std::allocator_traits<byte_allocator_type>::deallocate(alloc, ptr_,1);
+                    JSONCONS_RETHROW;
+                }
+            }
+        public:
+
+            byte_string_storage(semantic_tag semantic_type, 
+                             const uint8_t* data, std::size_t length, 
+                             const Allocator& a)
+                : ext_type_(from_storage_and_tag(storage_kind::byte_string_value, semantic_type))
+            {
+                create(byte_allocator_type(a), data, data+length, a);
+            }
+
+            byte_string_storage(const byte_string_storage& val)
+                : ext_type_(val.ext_type_)
+            {
+                create(val.ptr_->get_allocator(), *(val.ptr_));
+            }
+
+            byte_string_storage(byte_string_storage&& val) noexcept
+                : ext_type_(val.ext_type_), 
+                  ptr_(nullptr)
+            {
+                std::swap(val.ptr_,ptr_);
+            }
+
+            byte_string_storage(const byte_string_storage& val, const Allocator& a)
+                : ext_type_(val.ext_type_)
+            { 
+                create(byte_allocator_type(a), *(val.ptr_), a);
+            }
+
+            ~byte_string_storage() noexcept
+            {
+                if (ptr_ != nullptr)
+                {
+                    byte_allocator_type alloc(ptr_->get_allocator());
+                    std::allocator_traits<byte_allocator_type>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
+                    std::allocator_traits<byte_allocator_type>::deallocate(alloc, ptr_,1);
+                }
+            }
+
+            void swap(byte_string_storage& val) noexcept
+            {
+                std::swap(val.ptr_,ptr_);
+            }
+
+            const uint8_t* data() const
+            {
+                return ptr_->data();
+            }
+
+            std::size_t length() const
+            {
+                return ptr_->size();
+            }
+
+            const uint8_t* begin() const
+            {
+                return ptr_->data();
+            }
+
+            const uint8_t* end() const
+            {
+                return ptr_->data() + ptr_->size();
+            }
+
+            allocator_type get_allocator() const
+            {
+                return ptr_->get_allocator();
+            }
+        };
+
+        // The numbers of a typed array are held in 64 bit words, so that any element type is aligned.
+        // Elements are read in place. A const access that needs a reference to an element, such as at(i),
+        // builds the block of block_size elements that holds it, and one that needs iterators builds
+        // them all. Either is built once, the first thread to finish keeps its result.
+        class typed_array_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            using word_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<uint64_t>;
+            using word_container_type = typename implementation_policy::template sequence_container_type<uint64_t,word_allocator_type>;
+            using array_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<array>;
+            using array_pointer = typename std::allocator_traits<array_allocator_type>::pointer;
+            using block_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<std::atomic<array*>>;
+            using block_pointer = typename std::allocator_traits<block_allocator_type>::pointer;
+
+            static constexpr std::size_t block_size = 256;
+
+            struct node_type
+            {
+                typed_array_type type_;
+                std::size_t size_;
+                word_container_type words_;
+                mutable std::atomic<array*> elements_;
+                mutable std::atomic<std::atomic<array*>*> blocks_;
+
+                node_type(const typed_array_view& view, const Allocator& a)
+                    : type_(view.type()), size_(view.size()), words_(a), elements_(nullptr), blocks_(nullptr)
+                {
+                    switch (type_)
+                    {
+                        case typed_array_type::uint8_value:
+                            assign(view.data(uint8_array_arg).data());
+                            break;
+                        case typed_array_type::uint16_value:
+                            assign(view.data(uint16_array_arg).data());
+                            break;
+                        case typed_array_type::uint32_value:
+                            assign(view.data(uint32_array_arg).data());
+                            break;
+                        case typed_array_type::uint64_value:
+                            assign(view.data(uint64_array_arg).data());
+                            break;
+                        case typed_array_type::int8_value:
+                            assign(view.data(int8_array_arg).data());
+                            break;
+                        case typed_array_type::int16_value:
+                            assign(view.data(int16_array_arg).data());
+                            break;
+                        case typed_array_type::int32_value:
+                            assign(view.data(int32_array_arg).data());
+                            break;
+                        case typed_array_type::int64_value:
+                            assign(view.data(int64_array_arg).data());
+                            break;
+                        case typed_array_type::half_value:
+                            assign(view.data(half_array_arg).data());
+                            break;
+                        case typed_array_type::float_value:
+                            assign(view.data(float_array_arg).data());
+                            break;
+                        case typed_array_type::double_value:
+                            assign(view.data(double_array_arg).data());
+                            break;
+                        default:
+                            JSONCONS_UNREACHABLE();
+                            break;
+                    }
+                }
+
+                node_type(const node_type& other, const Allocator& a)
+                    : type_(other.type_), size_(other.size_), words_(other.words_.begin(), other.words_.end(), a), elements_(nullptr), blocks_(nullptr)
+                {
+                }
+
+                node_type(const node_type&) = delete;
+                node_type& operator=(const node_type&) = delete;
+
+                ~node_type() noexcept
+                {
+                    array* p = elements_.load(std::memory_order_acquire);
+                    if (p != nullptr)
+                    {
+                        destroy_elements(get_allocator(), p);
+                    }
+                    std::atomic<array*>* blocks = blocks_.load(std::memory_order_acquire);
+                    if (blocks != nullptr)
+                    {
+                        destroy_blocks(get_allocator(), blocks, block_count());
+                    }
+                }
+
+                std::size_t block_count() const
+                {
+                    return (size_ + block_size - 1)/block_size;
+                }
+
+                Allocator get_allocator() const
+                {
+                    return words_.get_allocator();
+                }
+
+                template <class T>
+                void assign(const T* data)
+                {
+                    std::size_t length = size_*sizeof(T);
+                    words_.resize((length + sizeof(uint64_t) - 1)/sizeof(uint64_t));
+                    if (length > 0)
+                    {
+                        std::memcpy(words_.data(), data, length);
+                    }
+                }
+
+                template <class T>
+                const T* data() const
+                {
+                    return reinterpret_cast<const T*>(words_.data());
+                }
+            };
+
+            using node_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<node_type>;
+            using pointer = typename std::allocator_traits<node_allocator>::pointer;
+
+            pointer ptr_;
+
+            template <typename... Args>
+            void create(node_allocator alloc, Args&& ... args)
+            {
+                ptr_ = std::allocator_traits<node_allocator>::allocate(alloc, 1);
+                JSONCONS_TRY
+                {
+                    std::allocator_traits<node_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    std::allocator_traits<node_allocator>::deallocate(alloc, ptr_,1);
+                    JSONCONS_RETHROW;
+                }
+            }
+
+            static void destroy_elements(const Allocator& a, array* p) noexcept
+            {
+                array_allocator_type alloc(a);
+                std::allocator_traits<array_allocator_type>::destroy(alloc, p);
+                std::allocator_traits<array_allocator_type>::deallocate(alloc, std::pointer_traits<array_pointer>::pointer_to(*p), 1);
+            }
+
+            static void destroy_blocks(const Allocator& a, std::atomic<array*>* blocks, std::size_t n) noexcept
+            {
+                for (std::size_t k = 0; k < n; ++k)
+                {
+                    array* p = blocks[k].load(std::memory_order_acquire);
+                    if (p != nullptr)
+                    {
+                        destroy_elements(a, p);
+                    }
+                }
+                block_allocator_type alloc(a);
+                for (std::size_t k = 0; k < n; ++k)
+                {
+                    std::allocator_traits<block_allocator_type>::destroy(alloc, blocks + k);
+                }
+                std::allocator_traits<block_allocator_type>::deallocate(alloc, std::pointer_traits<block_pointer>::pointer_to(*blocks), n);
+            }
+
+            template <class T>
+            static basic_json make_element(T value, std::true_type)
+            {
+                return basic_json(static_cast<int64_t>(value), semantic_tag::none);
+            }
+
+            template <class T>
+            static basic_json make_element(T value, std::false_type)
+            {
+                return basic_json(static_cast<uint64_t>(value), semantic_tag::none);
+            }
+
+            template <class T>
+            static basic_json make_element(T value)
+            {
+                return make_element(value, std::is_signed<T>());
+            }
+
+            static basic_json make_element(float value)
+            {
+                return basic_json(static_cast<double>(value), semantic_tag::none);
+            }
+
+            static basic_json make_element(double value)
+            {
+                return basic_json(value, semantic_tag::none);
+            }
+
+            template <class T>
+            void append_elements(array& elements, std::size_t first, std::size_t last) const
+            {
+                const T* data = ptr_->template data<T>();
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    elements.push_back(make_element(data[i]));
+                }
+            }
+
+            // Builds elements [first,last) into slot, unless another thread gets there first
+            const array& build_elements(std::atomic<array*>& slot, std::size_t first, std::size_t last) const
+            {
+                array* p = slot.load(std::memory_order_acquire);
+                if (p == nullptr)
+                {
+                    array_allocator_type alloc(ptr_->get_allocator());
+                    array_pointer q = std::allocator_traits<array_allocator_type>::allocate(alloc, 1);
+                    JSONCONS_TRY
+                    {
+                        std::allocator_traits<array_allocator_type>::construct(alloc, jsoncons::detail::to_plain_pointer(q), to_array(first, last));
+                    }
+                    JSONCONS_CATCH(...)
+                    {
+                        std::allocator_traits<array_allocator_type>::deallocate(alloc, q, 1);
+                        JSONCONS_RETHROW;
+                    }
+                    array* expected = nullptr;
+                    if (slot.compare_exchange_strong(expected, jsoncons::detail::to_plain_pointer(q), std::memory_order_acq_rel))
+                    {
+                        p = jsoncons::detail::to_plain_pointer(q);
+                    }
+                    else
+                    {
+                        destroy_elements(ptr_->get_allocator(), jsoncons::detail::to_plain_pointer(q));
+                        p = expected;
+                    }
+                }
+                return *p;
+            }
+
+            std::atomic<array*>* blocks() const
+            {
+                std::atomic<array*>* p = ptr_->blocks_.load(std::memory_order_acquire);
+                if (p == nullptr)
+                {
+                    block_allocator_type alloc(ptr_->get_allocator());
+                    std::size_t n = ptr_->block_count();
+                    std::atomic<array*>* q = jsoncons::detail::to_plain_pointer(std::allocator_traits<block_allocator_type>::allocate(alloc, n));
+                    for (std::size_t k = 0; k < n; ++k)
+                    {
+                        std::allocator_traits<block_allocator_type>::construct(alloc, q + k, nullptr);
+                    }
+                    std::atomic<array*>* expected = nullptr;
+                    if (ptr_->blocks_.compare_exchange_strong(expected, q, std::memory_order_acq_rel))
+                    {
+                        p = q;
+                    }
+                    else
+                    {
+                        destroy_blocks(ptr_->get_allocator(), q, n);
+                        p = expected;
+                    }
+                }
+                return p;
+            }
+        public:
+            typed_array_storage(const typed_array_view& view, semantic_tag tag, const Allocator& a)
+                : ext_type_(from_storage_and_tag(storage_kind::typed_array_value, tag))
+            {
+                create(node_allocator(a), view, a);
+            }
+
+            typed_array_storage(const typed_array_storage& val)
+                : ext_type_(val.ext_type_)
+            {
+                create(node_allocator(val.get_allocator()), *(val.ptr_), val.get_allocator());
+            }
+
+            typed_array_storage(typed_array_storage&& val) noexcept
+                : ext_type_(val.ext_type_), 
+                  ptr_(nullptr)
+            {
+                std::swap(val.ptr_,ptr_);
+            }
+
+            typed_array_storage(const typed_array_storage& val, const Allocator& a)
+                : ext_type_(val.ext_type_)
+            { 
+                create(node_allocator(a), *(val.ptr_), a);
+            }
+
+            ~typed_array_storage() noexcept
+            {
+                if (ptr_ != nullptr)
+                {
+                    node_allocator alloc(ptr_->get_allocator());
+                    std::allocator_traits<node_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
+                    std::allocator_traits<node_allocator>::deallocate(alloc, ptr_,1);
+                }
+            }
+
+            void swap(typed_array_storage& val) noexcept
+            {
+                std::swap(val.ptr_,ptr_);
+            }
+
+            typed_array_type type() const
+            {
+                return ptr_->type_;
+            }
+
+            std::size_t size() const
+            {
+                return ptr_->size_;
+            }
+
+            typed_array_view view() const
+            {
+                switch (ptr_->type_)
+                {
+                    case typed_array_type::uint8_value:
+                        return typed_array_view(ptr_->template data<uint8_t>(), ptr_->size_);
+                    case typed_array_type::uint16_value:
+                        return typed_array_view(ptr_->template data<uint16_t>(), ptr_->size_);
+                    case typed_array_type::uint32_value:
+                        return typed_array_view(ptr_->template data<uint32_t>(), ptr_->size_);
+                    case typed_array_type::uint64_value:
+                        return typed_array_view(ptr_->template data<uint64_t>(), ptr_->size_);
+                    case typed_array_type::int8_value:
+                        return typed_array_view(ptr_->template data<int8_t>(), ptr_->size_);
+                    case typed_array_type::int16_value:
+                        return typed_array_view(ptr_->template data<int16_t>(), ptr_->size_);
+                    case typed_array_type::int32_value:
+                        return typed_array_view(ptr_->template data<int32_t>(), ptr_->size_);
+                    case typed_array_type::int64_value:
+                        return typed_array_view(ptr_->template data<int64_t>(), ptr_->size_);
+                    case typed_array_type::half_value:
+                        return typed_array_view(half_array_arg, ptr_->template data<uint16_t>(), ptr_->size_);
+                    case typed_array_type::float_value:
+                        return typed_array_view(ptr_->template data<float>(), ptr_->size_);
+                    case typed_array_type::double_value:
+                        return typed_array_view(ptr_->template data<double>(), ptr_->size_);
+                    default:
+                        JSONCONS_UNREACHABLE();
+                        break;
+                }
+            }
+
+            // True if both hold the same element type and the same numbers
+            bool same_elements(const typed_array_storage& other) const
+            {
+                if (ptr_->type_ != other.ptr_->type_ || ptr_->size_ != other.ptr_->size_)
+                {
+                    return false;
+                }
+                switch (ptr_->type_)
+                {
+                    case typed_array_type::float_value:
+                        return std::equal(ptr_->template data<float>(), ptr_->template data<float>() + ptr_->size_, 
+                                          other.ptr_->template data<float>());
+                    case typed_array_type::double_value:
+                        return std::equal(ptr_->template data<double>(), ptr_->template data<double>() + ptr_->size_, 
+                                          other.ptr_->template data<double>());
+                    case typed_array_type::half_value:
+                        // By value, the bytes of +0 and -0 differ
+                        return std::equal(ptr_->template data<uint16_t>(), ptr_->template data<uint16_t>() + ptr_->size_,
+                                          other.ptr_->template data<uint16_t>(),
+                                          [](uint16_t x, uint16_t y) {return jsoncons::detail::decode_half(x) == jsoncons::detail::decode_half(y);});
+                    default:
+                    {
+                        // Integer elements compare equal when their bytes do, the unused bytes of the last word are zero
+                        return ptr_->words_.size() == other.ptr_->words_.size() && 
+                               std::equal(ptr_->words_.begin(), ptr_->words_.end(), other.ptr_->words_.begin());
+                    }
+                }
+            }
+
+            // Builds elements [first,last) as basic_json values
+            array to_array(std::size_t first, std::size_t last) const
+            {
+                array elements(ptr_->get_allocator());
+                elements.reserve(last - first);
+                switch (ptr_->type_)
+                {
+                    case typed_array_type::uint8_value:
+                        append_elements<uint8_t>(elements, first, last);
+                        break;
+                    case typed_array_type::uint16_value:
+                        append_elements<uint16_t>(elements, first, last);
+                        break;
+                    case typed_array_type::uint32_value:
+                        append_elements<uint32_t>(elements, first, last);
+                        break;
+                    case typed_array_type::uint64_value:
+                        append_elements<uint64_t>(elements, first, last);
+                        break;
+                    case typed_array_type::int8_value:
+                        append_elements<int8_t>(elements, first, last);
+                        break;
+                    case typed_array_type::int16_value:
+                        append_elements<int16_t>(elements, first, last);
+                        break;
+                    case typed_array_type::int32_value:
+                        append_elements<int32_t>(elements, first, last);
+                        break;
+                    case typed_array_type::int64_value:
+                        append_elements<int64_t>(elements, first, last);
+                        break;
+                    case typed_array_type::half_value:
+                    {
+                        const uint16_t* data = ptr_->template data<uint16_t>();
+                        for (std::size_t i = first; i < last; ++i)
+                        {
+                            elements.emplace_back(half_arg, data[i], semantic_tag::none);
+                        }
+                        break;
+                    }
+                    case typed_array_type::float_value:
+                        append_elements<float>(elements, first, last);
+                        break;
+                    case typed_array_type::double_value:
+                        append_elements<double>(elements, first, last);
+                        break;
+                    default:
+                        JSONCONS_UNREACHABLE();
+                        break;
+                }
+                return elements;
+            }
+
+            array to_array() const
+            {
+                return to_array(0, ptr_->size_);
+            }
+
+            // The element at i, built on its own and not kept
+            basic_json value_at(std::size_t i) const
+            {
+                switch (ptr_->type_)
+                {
+                    case typed_array_type::uint8_value:
+                        return make_element(ptr_->template data<uint8_t>()[i]);
+                    case typed_array_type::uint16_value:
+                        return make_element(ptr_->template data<uint16_t>()[i]);
+                    case typed_array_type::uint32_value:
+                        return make_element(ptr_->template data<uint32_t>()[i]);
+                    case typed_array_type::uint64_value:
+                        return make_element(ptr_->template data<uint64_t>()[i]);
+                    case typed_array_type::int8_value:
+                        return make_element(ptr_->template data<int8_t>()[i]);
+                    case typed_array_type::int16_value:
+                        return make_element(ptr_->template data<int16_t>()[i]);
+                    case typed_array_type::int32_value:
+                        return make_element(ptr_->template data<int32_t>()[i]);
+                    case typed_array_type::int64_value:
+                        return make_element(ptr_->template data<int64_t>()[i]);
+                    case typed_array_type::half_value:
+                        return basic_json(half_arg, ptr_->template data<uint16_t>()[i], semantic_tag::none);
+                    case typed_array_type::float_value:
+                        return make_element(ptr_->template data<float>()[i]);
+                    case typed_array_type::double_value:
+                        return make_element(ptr_->template data<double>()[i]);
+                    default:
+                        JSONCONS_UNREACHABLE();
+                        break;
+                }
+            }
+
+            // The element at i, from the elements built by elements() if there are any, 
+            // otherwise from its block, built on first use
+            const basic_json& element(std::size_t i) const
+            {
+                array* p = ptr_->elements_.load(std::memory_order_acquire);
+                if (p != nullptr)
+                {
+                    return (*p)[i];
+                }
+                std::size_t first = i - i % block_size;
+                std::size_t last = ptr_->size_ - first < block_size ? ptr_->size_ : first + block_size;
+                return build_elements(blocks()[i / block_size], first, last)[i - first];
+            }
+
+            // All the elements as basic_json values, built on first use
+            const array& elements() const
+            {
+                return build_elements(ptr_->elements_, 0, ptr_->size_);
+            }
+
+            // Moves out the elements built by elements(), or builds them
+            array release_elements()
+            {
+                array* p = ptr_->elements_.exchange(nullptr, std::memory_order_acq_rel);
+                if (p == nullptr)
+                {
+                    return to_array();
+                }
+                array elements(std::move(*p));
+                destroy_elements(ptr_->get_allocator(), p);
+                return elements;
+            }
+
+            allocator_type get_allocator() const
+            {
+                return ptr_->get_allocator();
+            }
+        };
+
+        // array_storage
+        class array_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            using node_type = jsoncons::detail::storage_node<array,copy_on_write,keep_hash>;
+            using node_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<node_type>;
+            using pointer = typename std::allocator_traits<node_allocator>::pointer;
+
+            pointer ptr_;
+
+            template <typename... Args>
+            void create(node_allocator alloc, Args&& ... args)
+            {
+                ptr_ = std::allocator_traits<node_allocator>::allocate(alloc, 1);
+                JSONCONS_TRY
+                {
+                    std::allocator_traits<node_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    std::allocator_traits<node_allocator>::deallocate(alloc, ptr_,1);
+                    JSONCONS_RETHROW;
+                }
+            }
+
+            static void release(pointer ptr) noexcept
+            {
+                if (ptr->release())
+                {
+                    variant_base<default_variant>::destroy_nested(ptr->value);
+                    node_allocator alloc(ptr->value.get_allocator());
+                    std::allocator_traits<node_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr));
+                    std::allocator_traits<node_allocator>::deallocate(alloc, ptr,1);
+                }
+            }
+
+            void share(const array_storage& val) noexcept
+            {
+                ptr_ = val.ptr_;
+                ptr_->add_ref();
+            }
+
+            // Gives this value its own copy of a shared array
+            void unshare()
+            {
+                pointer ptr = ptr_;
+                JSONCONS_TRY
+                {
+                    create(ptr->value.get_allocator(), ptr->value);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    ptr_ = ptr;
+                    JSONCONS_RETHROW;
+                }
+                release(ptr);
+            }
+        public:
+            array_storage(const array& val, semantic_tag tag)
+                : ext_type_(from_storage_and_tag(storage_kind::array_value, tag))
+            {
+                create(val.get_allocator(), val);
+            }
+
+            array_storage(const array& val, semantic_tag tag, const Allocator& a)
+                : ext_type_(from_storage_and_tag(storage_kind::array_value, tag))
+            {
+                create(node_allocator(a), val, a);
+            }
+
+            array_storage(array&& val, semantic_tag tag)
+                : ext_type_(from_storage_and_tag(storage_kind::array_value, tag))
+            {
+                create(val.get_allocator(), std::move(val));
+            }
+
+            array_storage(const array_storage& val)
+                : ext_type_(val.ext_type_)
+            {
+                if (copy_on_write)
+                {
+                    share(val);
+                }
+                else
+                {
+                    create(val.ptr_->value.get_allocator(), val.ptr_->value);
+                }
+            }
+
+            array_storage(array_storage&& val) noexcept
+                : ext_type_(val.ext_type_), 
+                  ptr_(nullptr)
+            {
+                std::swap(val.ptr_, ptr_);
+            }
+
+            array_storage(const array_storage& val, const Allocator& a)
+                : ext_type_(val.ext_type_)
+            {
+                if (copy_on_write && a == val.get_allocator())
+                {
+                    share(val);
+                }
+                else
+                {
+                    create(node_allocator(a), val.ptr_->value, a);
+                }
+            }
+
+            ~array_storage() noexcept
+            {
+                if (ptr_ != nullptr)
+                {
+                    release(ptr_);
+                }
+            }
+
+            allocator_type get_allocator() const
+            {
+                return ptr_->value.get_allocator();
+            }
+
+            void swap(array_storage& val) noexcept
+            {
+                std::swap(val.ptr_,ptr_);
+            }
+
+            // True if other values share the array
+            bool is_shared() const noexcept
+            {
+                return ptr_->is_shared();
+            }
+
+            array& value()
+            {
+                if (ptr_->is_shared())
+                {
+                    unshare();
+                }
+                ptr_->reset_hash();
+                return ptr_->value;
+            }
+
+            // The hash kept by cached_hash_policy, or zero
+            uint64_t cached_hash() const noexcept
+            {
+                return ptr_->cached_hash();
+            }
+
+            void cache_hash(uint64_t hash) const noexcept
+            {
+                ptr_->cache_hash(hash);
+            }
+
+            const array& value() const
+            {
+                return ptr_->value;
+            }
+        };
+
+        // object_storage
+        class object_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            using node_type = jsoncons::detail::storage_node<object,copy_on_write,keep_hash>;
+            using node_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<node_type>;
+            using pointer = typename std::allocator_traits<node_allocator>::pointer;
+
+            pointer ptr_;
+
+            template <typename... Args>
+            void create(node_allocator alloc, Args&& ... args)
+            {
+                ptr_ = std::allocator_traits<node_allocator>::allocate(alloc, 1);
+                JSONCONS_TRY
+                {
+                    std::allocator_traits<node_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    std::allocator_traits<node_allocator>::deallocate(alloc, ptr_,1);
+                    JSONCONS_RETHROW;
+                }
+            }
+
+            static void release(pointer ptr) noexcept
+            {
+                if (ptr->release())
+                {
+                    variant_base<default_variant>::destroy_nested(ptr->value);
+                    node_allocator alloc(ptr->value.get_allocator());
+                    std::allocator_traits<node_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr));
+                    std::allocator_traits<node_allocator>::deallocate(alloc, ptr,1);
+                }
+            }
+
+            void share(const object_storage& val) noexcept
+            {
+                ptr_ = val.ptr_;
+                ptr_->add_ref();
+            }
+
+            // Gives this value its own copy of a shared object
+            void unshare()
+            {
+                pointer ptr = ptr_;
+                JSONCONS_TRY
+                {
+                    create(ptr->value.get_allocator(), ptr->value);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    ptr_ = ptr;
+                    JSONCONS_RETHROW;
+                }
+                release(ptr);
+            }
+        public:
+            explicit object_storage(const object& val, semantic_tag tag)
+                : ext_type_(from_storage_and_tag(storage_kind::object_value, tag))
+            {
+                create(val.get_allocator(), val);
+            }
+
+            explicit object_storage(const object& val, semantic_tag tag, const Allocator& a)
+                : ext_type_(from_storage_and_tag(storage_kind::object_value, tag))
+            {
+                create(node_allocator(a), val, a);
+            }
+
+            explicit object_storage(const object_storage& val)
+                : ext_type_(val.ext_type_)
+            {
+                if (copy_on_write)
+                {
+                    share(val);
+                }
+                else
+                {
+                    create(val.ptr_->value.get_allocator(), val.ptr_->value);
+                }
+            }
+
+            explicit object_storage(object_storage&& val) noexcept
+                : ext_type_(val.ext_type_), 
+                  ptr_(nullptr)
+            {
+                std::swap(val.ptr_,ptr_);
+            }
+
+            explicit object_storage(const object_storage& val, const Allocator& a)
+                : ext_type_(val.ext_type_)
+            {
+                if (copy_on_write && a == val.get_allocator())
+                {
+                    share(val);
+                }
+                else
+                {
+                    create(node_allocator(a), val.ptr_->value, a);
+                }
+            }
+
+            ~object_storage() noexcept
+            {
+                if (ptr_ != nullptr)
+                {
+                    release(ptr_);
+                }
+            }
+
+            void swap(object_storage& val) noexcept
+            {
+                std::swap(val.ptr_,ptr_);
+            }
+
+            // True if other values share the object
+            bool is_shared() const noexcept
+            {
+                return ptr_->is_shared();
+            }
+
+            object& value()
+            {
+                if (ptr_->is_shared())
+                {
+                    unshare();
+                }
+                ptr_->reset_hash();
+                return ptr_->value;
+            }
+
+            // The hash kept by cached_hash_policy, or zero
+            uint64_t cached_hash() const noexcept
+            {
+                return ptr_->cached_hash();
+            }
+
+            void cache_hash(uint64_t hash) const noexcept
+            {
+                ptr_->cache_hash(hash);
+            }
+
+            const object& value() const
+            {
+                return ptr_->value;
+            }
+
+            allocator_type get_allocator() const
+            {
+                return ptr_->value.get_allocator();
+            }
+        };
+
+    private:
+        union 
+        {
+            common_storage common_stor_;
+            null_storage null_stor_;
+            bool_storage bool_stor_;
+            int64_storage int64_stor_;
+            uint64_storage uint64_stor_;
+            half_storage half_stor_;
+            double_storage double_stor_;
+            short_string_storage short_string_stor_;
+            long_string_storage long_string_stor_;
+            byte_string_storage byte_string_stor_;
+            typed_array_storage typed_array_stor_;
+            array_storage array_stor_;
+            object_storage object_stor_;
+            empty_object_storage empty_object_stor_;
+        };
+    public:
+        default_variant(semantic_tag tag)
+        {
+            construct_var<empty_object_storage>(tag);
+        }
+
+        explicit default_variant(null_type, semantic_tag tag)
+        {
+            construct_var<null_storage>(tag);
+        }
+
+        explicit default_variant(bool val, semantic_tag tag)
+        {
+            construct_var<bool_storage>(val,tag);
+        }
+        explicit default_variant(int64_t val, semantic_tag tag)
+        {
+            construct_var<int64_storage>(val, tag);
+        }
+        explicit default_variant(uint64_t val, semantic_tag tag)
+        {
+            construct_var<uint64_storage>(val, tag);
+        }
+
+        default_variant(half_arg_t, uint16_t val, semantic_tag tag)
+        {
+            construct_var<half_storage>(val, tag);
+        }
+
+        default_variant(double val, semantic_tag tag)
+        {
+            construct_var<double_storage>(val, tag);
+        }
+
+        default_variant(const char_type* s, std::size_t length, semantic_tag tag)
+        {
+            if (length <= short_string_storage::max_length)
+            {
+                construct_var<short_string_storage>(tag, s, static_cast<uint8_t>(length));
+            }
+            else
+            {
+                construct_var<long_string_storage>(tag, s, length, char_allocator_type());
+            }
+        }
+
+        default_variant(const char_type* s, std::size_t length, semantic_tag tag, const Allocator& alloc)
+        {
+            if (length <= short_string_storage::max_length)
+            {
+                construct_var<short_string_storage>(tag, s, static_cast<uint8_t>(length));
+            }
+            else
+            {
+                construct_var<long_string_storage>(tag, s, length, char_allocator_type(alloc));
+            }
+        }
+
+        // The text of a number with a fraction or exponent, kept unconverted
+        default_variant(double_text_arg_t, const char_type* s, std::size_t length, semantic_tag tag, const Allocator& alloc)
+        {
+            if (length <= short_string_storage::max_length)
+            {
+                construct_var<short_string_storage>(storage_kind::short_double_text_value, tag, s, static_cast<uint8_t>(length));
+            }
+            else
+            {
+                construct_var<long_string_storage>(storage_kind::long_double_text_value, tag, s, length, char_allocator_type(alloc));
+            }
+        }
+
+        default_variant(const byte_string_view& bytes, semantic_tag tag)
+        {
+            construct_var<byte_string_storage>(tag, bytes.data(), bytes.size(), byte_allocator_type());
+        }
+
+        default_variant(const byte_string_view& bytes, semantic_tag tag, const Allocator& alloc)
+        {
+            construct_var<byte_string_storage>(tag, bytes.data(), bytes.size(), alloc);
+        }
+
+        default_variant(byte_string_arg_t, const span<const uint8_t>& bytes, semantic_tag tag, const Allocator& alloc)
+        {
+            construct_var<byte_string_storage>(tag, bytes.data(), bytes.size(), alloc);
+        }
+
+        default_variant(typed_array_arg_t, const typed_array_view& view, semantic_tag tag, const Allocator& alloc)
+        {
+            construct_var<typed_array_storage>(view, tag, alloc);
+        }
+
+        default_variant(const object& val, semantic_tag tag)
+        {
+            construct_var<object_storage>(val, tag);
+        }
+        default_variant(const object& val, semantic_tag tag, const Allocator& alloc)
+        {
+            construct_var<object_storage>(val, tag, alloc);
+        }
+        default_variant(const array& val, semantic_tag tag)
+        {
+            construct_var<array_storage>(val, tag);
+        }
+        default_variant(const array& val, semantic_tag tag, const Allocator& alloc)
+        {
+            construct_var<array_storage>(val, tag, alloc);
+        }
+        default_variant(array&& val, semantic_tag tag)
+        {
+            construct_var<array_storage>(std::move(val), tag);
+        }
+
+        default_variant(const default_variant& val)
+        {
+            Init_(val);
+        }
+
+        default_variant(const default_variant& val, const Allocator& alloc)
+        {
+            Init_(val,alloc);
+        }
+
+        default_variant(default_variant&& val) noexcept
+        {
+            Init_rv_(std::forward<default_variant>(val));
+        }
+
+        default_variant(default_variant&& val, const Allocator& alloc) noexcept
+        {
+            Init_rv_(std::forward<default_variant>(val), alloc,
+                     typename std::allocator_traits<Allocator>::propagate_on_container_move_assignment());
+        }
+
+        ~default_variant() noexcept
+        {
+            Destroy_();
+        }
+
+        void Destroy_()
+        {
+            switch (storage())
+            {
+                case storage_kind::long_string_value:
+                case storage_kind::long_double_text_value:
+                    destroy_var<long_string_storage>();
+                    break;
+                case storage_kind::byte_string_value:
+                    destroy_var<byte_string_storage>();
+                    break;
+                case storage_kind::typed_array_value:
+                    destroy_var<typed_array_storage>();
+                    break;
+                case storage_kind::array_value:
+                    destroy_var<array_storage>();
+                    break;
+                case storage_kind::object_value:
+                    destroy_var<object_storage>();
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        default_variant& operator=(const default_variant& val)
+        {
+            if (this != &val)
+            {
+                Destroy_();
+                Init_(val);
+            }
+            return *this;
+        }
+
+        default_variant& operator=(default_variant&& val) noexcept
+        {
+            if (this !=&val)
+            {
+                swap(val);
             }
+            return *this;
+        }
+
+        storage_kind storage() const
+        {
+            // It is legal to access 'common_stor_.ext_type_' even though 
+            // common_stor_ is not the active member of the union because 'ext_type_' 
+            // is a part of the common initial sequence of all union members
+            // as defined in 11.4-25 of the Standard.
+            return to_storage(common_stor_.ext_type_);
+        }
+
+        semantic_tag tag() const
+        {
+            // It is legal to access 'common_stor_.ext_type_' even though 
+            // common_stor_ is not the active member of the union because 'ext_type_' 
+            // is a part of the common initial sequence of all union members
+            // as defined in 11.4-25 of the Standard.
+            return to_tag(common_stor_.ext_type_);
+        }
+
+        template <class VariantType, class... Args>
+        void construct_var(Args&&... args)
+        {
+            ::new (&cast<VariantType>()) VariantType(std::forward<Args>(args)...);
+        }
+
+        template <class T>
+        void destroy_var()
+        {
+            cast<T>().~T();
+        }
+
+        template <class T>
+        struct identity { using type = T*; };
+
+        template <class T> 
+        T& cast()
+        {
+            return cast(identity<T>());
+        }
+
+        template <class T> 
+        const T& cast() const
+        {
+            return cast(identity<T>());
+        }
+
+        null_storage& cast(identity<null_storage>) 
+        {
+            return null_stor_;
+        }
+
+        const null_storage& cast(identity<null_storage>) const
+        {
+            return null_stor_;
+        }
+
+        empty_object_storage& cast(identity<empty_object_storage>) 
+        {
+            return empty_object_stor_;
+        }
+
+        const empty_object_storage& cast(identity<empty_object_storage>) const
+        {
+            return empty_object_stor_;
+        }
+
+        bool_storage& cast(identity<bool_storage>) 
+        {
+            return bool_stor_;
+        }
+
+        const bool_storage& cast(identity<bool_storage>) const
+        {
+            return bool_stor_;
+        }
+
+        int64_storage& cast(identity<int64_storage>) 
+        {
+            return int64_stor_;
+        }
+
+        const int64_storage& cast(identity<int64_storage>) const
+        {
+            return int64_stor_;
+        }
+
+        uint64_storage& cast(identity<uint64_storage>) 
+        {
+            return uint64_stor_;
+        }
+
+        const uint64_storage& cast(identity<uint64_storage>) const
+        {
+            return uint64_stor_;
+        }
+
+        half_storage& cast(identity<half_storage>)
+        {
+            return half_stor_;
+        }
+
+        const half_storage& cast(identity<half_storage>) const
+        {
+            return half_stor_;
+        }
+
+        double_storage& cast(identity<double_storage>) 
+        {
+            return double_stor_;
+        }
 
-            uint16_t value() const
-            {
-                return val_;
-            }
-        };
+        const double_storage& cast(identity<double_storage>) const
+        {
+            return double_stor_;
+        }
 
-        class double_storage final
+        short_string_storage& cast(identity<short_string_storage>)
         {
-        public:
-            uint8_t ext_type_;
-        private:
-            double val_;
-        public:
-            double_storage(double val, 
-                        semantic_tag tag = semantic_tag::none)
-                : ext_type_(from_storage_and_tag(storage_kind::double_value, tag)), 
-                  val_(val)
-            {
-            }
+            return short_string_stor_;
+        }
 
-            double_storage(const double_storage& val)
-                : ext_type_(val.ext_type_),
-                  val_(val.val_)
-            {
-            }
+        const short_string_storage& cast(identity<short_string_storage>) const
+        {
+            return short_string_stor_;
+        }
 
-            double value() const
-            {
-                return val_;
-            }
-        };
+        long_string_storage& cast(identity<long_string_storage>)
+        {
+            return long_string_stor_;
+        }
 
-        class short_string_storage final
+        const long_string_storage& cast(identity<long_string_storage>) const
         {
-        public:
-            uint8_t ext_type_;
-        private:
-            static constexpr size_t capacity = (2*sizeof(uint64_t) - 2*sizeof(uint8_t))/sizeof(char_type);
-            uint8_t length_;
-            char_type data_[capacity];
-        public:
-            static constexpr size_t max_length = capacity - 1;
+            return long_string_stor_;
+        }
 
-            short_string_storage(semantic_tag tag, const char_type* p, uint8_t length)
-                : ext_type_(from_storage_and_tag(storage_kind::short_string_value, tag)), 
-                  length_(length)
-            {
-                JSONCONS_ASSERT(length <= max_length);
-                std::memcpy(data_,p,length*sizeof(char_type));
-                data_[length] = 0;
-            }
+        byte_string_storage& cast(identity<byte_string_storage>)
+        {
+            return byte_string_stor_;
+        }
 
-            short_string_storage(const short_string_storage& val)
-                : ext_type_(val.ext_type_), 
-                  length_(val.length_)
-            {
-                std::memcpy(data_,val.data_,val.length_*sizeof(char_type));
-                data_[length_] = 0;
-            }
+        const byte_string_storage& cast(identity<byte_string_storage>) const
+        {
+            return byte_string_stor_;
+        }
 
-            uint8_t length() const
+        typed_array_storage& cast(identity<typed_array_storage>)
+        {
+            return typed_array_stor_;
+        }
+
+        const typed_array_storage& cast(identity<typed_array_storage>) const
+        {
+            return typed_array_stor_;
+        }
+
+        object_storage& cast(identity<object_storage>)
+        {
+            return object_stor_;
+        }
+
+        const object_storage& cast(identity<object_storage>) const
+        {
+            return object_stor_;
+        }
+
+        array_storage& cast(identity<array_storage>)
+        {
+            return array_stor_;
+        }
+
+        const array_storage& cast(identity<array_storage>) const
+        {
+            return array_stor_;
+        }
+
+        template <class TypeA, class TypeB>
+        void swap_a_b(default_variant& other)
+        {
+            TypeA& curA = cast<TypeA>();
+            TypeB& curB = other.cast<TypeB>();
+            TypeB tmpB(std::move(curB));
+            other.construct_var<TypeA>(std::move(curA));
+            construct_var<TypeB>(std::move(tmpB));
+        }
+
+        template <class TypeA>
+        void swap_a(default_variant& other)
+        {
+            switch (other.storage())
             {
-                return length_;
+                case storage_kind::null_value         : swap_a_b<TypeA, null_storage>(other); break;
+                case storage_kind::empty_object_value : swap_a_b<TypeA, empty_object_storage>(other); break;
+                case storage_kind::bool_value         : swap_a_b<TypeA, bool_storage>(other); break;
+                case storage_kind::int64_value      : swap_a_b<TypeA, int64_storage>(other); break;
+                case storage_kind::uint64_value     : swap_a_b<TypeA, uint64_storage>(other); break;
+                case storage_kind::half_value       : swap_a_b<TypeA, half_storage>(other); break;
+                case storage_kind::double_value       : swap_a_b<TypeA, double_storage>(other); break;
+                case storage_kind::short_string_value : swap_a_b<TypeA, short_string_storage>(other); break;
+                case storage_kind::long_string_value       : swap_a_b<TypeA, long_string_storage>(other); break;
+                case storage_kind::short_double_text_value : swap_a_b<TypeA, short_string_storage>(other); break;
+                case storage_kind::long_double_text_value  : swap_a_b<TypeA, long_string_storage>(other); break;
+                case storage_kind::byte_string_value  : swap_a_b<TypeA, byte_string_storage>(other); break;
+                case storage_kind::typed_array_value  : swap_a_b<TypeA, typed_array_storage>(other); break;
+                case storage_kind::array_value        : swap_a_b<TypeA, array_storage>(other); break;
+                case storage_kind::object_value       : swap_a_b<TypeA, object_storage>(other); break;
+                default:
+                    JSONCONS_UNREACHABLE();
+                    break;
             }
+        }
+    public:
 
-            const char_type* data() const
+        void swap(default_variant& other) noexcept
+        {
+            if (this == &other)
             {
-                return data_;
+                return;
             }
 
-            const char_type* c_str() const
+            switch (storage())
             {
-                return data_;
+                case storage_kind::null_value: swap_a<null_storage>(other); break;
+                case storage_kind::empty_object_value : swap_a<empty_object_storage>(other); break;
+                case storage_kind::bool_value: swap_a<bool_storage>(other); break;
+                case storage_kind::int64_value: swap_a<int64_storage>(other); break;
+                case storage_kind::uint64_value: swap_a<uint64_storage>(other); break;
+                case storage_kind::half_value: swap_a<half_storage>(other); break;
+                case storage_kind::double_value: swap_a<double_storage>(other); break;
+                case storage_kind::short_string_value: swap_a<short_string_storage>(other); break;
+                case storage_kind::long_string_value: swap_a<long_string_storage>(other); break;
+                case storage_kind::short_double_text_value: swap_a<short_string_storage>(other); break;
+                case storage_kind::long_double_text_value: swap_a<long_string_storage>(other); break;
+                case storage_kind::byte_string_value: swap_a<byte_string_storage>(other); break;
+                case storage_kind::typed_array_value: swap_a<typed_array_storage>(other); break;
+                case storage_kind::array_value: swap_a<array_storage>(other); break;
+                case storage_kind::object_value: swap_a<object_storage>(other); break;
+                default:
+                    JSONCONS_UNREACHABLE();
+                    break;
             }
-        };
+        }
 
-        // long_string_storage
-        class long_string_storage final
-        {
-        public:
-            uint8_t ext_type_;
-        private:
-            jsoncons::detail::heap_only_string_wrapper<char_type,Allocator> s_;
-        public:
+    private:
 
-            long_string_storage(semantic_tag tag, const char_type* data, std::size_t length, const Allocator& a)
-                : ext_type_(from_storage_and_tag(storage_kind::long_string_value, tag)),
-                  s_(data, length, a)
+        void Init_(const default_variant& val)
+        {
+            switch (val.storage())
             {
+                case storage_kind::null_value:
+                    construct_var<null_storage>(val.cast<null_storage>());
+                    break;
+                case storage_kind::empty_object_value:
+                    construct_var<empty_object_storage>(val.cast<empty_object_storage>());
+                    break;
+                case storage_kind::bool_value:
+                    construct_var<bool_storage>(val.cast<bool_storage>());
+                    break;
+                case storage_kind::int64_value:
+                    construct_var<int64_storage>(val.cast<int64_storage>());
+                    break;
+                case storage_kind::uint64_value:
+                    construct_var<uint64_storage>(val.cast<uint64_storage>());
+                    break;
+                case storage_kind::half_value:
+                    construct_var<half_storage>(val.cast<half_storage>());
+                    break;
+                case storage_kind::double_value:
+                    construct_var<double_storage>(val.cast<double_storage>());
+                    break;
+                case storage_kind::short_string_value:
+                case storage_kind::short_double_text_value:
+                    construct_var<short_string_storage>(val.cast<short_string_storage>());
+                    break;
+                case storage_kind::long_string_value:
+                case storage_kind::long_double_text_value:
+                    construct_var<long_string_storage>(val.cast<long_string_storage>());
+                    break;
+                case storage_kind::byte_string_value:
+                    construct_var<byte_string_storage>(val.cast<byte_string_storage>());
+                    break;
+                case storage_kind::typed_array_value:
+                    construct_var<typed_array_storage>(val.cast<typed_array_storage>());
+                    break;
+                case storage_kind::object_value:
+                    construct_var<object_storage>(val.cast<object_storage>());
+                    break;
+                case storage_kind::array_value:
+                    construct_var<array_storage>(val.cast<array_storage>());
+                    break;
+                default:
+                    break;
             }
+        }
 
-            long_string_storage(const long_string_storage& val)
-                : ext_type_(val.ext_type_), s_(val.s_)
+        void Init_(const default_variant& val, const Allocator& a)
+        {
+            switch (val.storage())
             {
+            case storage_kind::null_value:
+            case storage_kind::empty_object_value:
+            case storage_kind::bool_value:
+            case storage_kind::int64_value:
+            case storage_kind::uint64_value:
+            case storage_kind::half_value:
+            case storage_kind::double_value:
+            case storage_kind::short_string_value:
+            case storage_kind::short_double_text_value:
+                Init_(val);
+                break;
+            case storage_kind::long_string_value:
+            case storage_kind::long_double_text_value:
+                construct_var<long_string_storage>(val.cast<long_string_storage>(),a);
+                break;
+            case storage_kind::byte_string_value:
+                construct_var<byte_string_storage>(val.cast<byte_string_storage>(),a);
+                break;
+            case storage_kind::typed_array_value:
+                construct_var<typed_array_storage>(val.cast<typed_array_storage>(),a);
+                break;
+            case storage_kind::array_value:
+                construct_var<array_storage>(val.cast<array_storage>(),a);
+                break;
+            case storage_kind::object_value:
+                construct_var<object_storage>(val.cast<object_storage>(),a);
+                break;
+            default:
+                break;
             }
+        }
 
-            long_string_storage(long_string_storage&& val) noexcept
-                : ext_type_(val.ext_type_), 
-                  s_(nullptr)
+        void Init_rv_(default_variant&& val) noexcept
+        {
+            switch (val.storage())
             {
-                swap(val);
+                case storage_kind::null_value:
+                case storage_kind::empty_object_value:
+                case storage_kind::half_value:
+                case storage_kind::double_value:
+                case storage_kind::int64_value:
+                case storage_kind::uint64_value:
+                case storage_kind::bool_value:
+                case storage_kind::short_string_value:
+                case storage_kind::short_double_text_value:
+                    Init_(val);
+                    break;
+                case storage_kind::long_string_value:
+                case storage_kind::long_double_text_value:
+                case storage_kind::byte_string_value:
+                case storage_kind::typed_array_value:
+                case storage_kind::array_value:
+                case storage_kind::object_value:
+                {
+                    construct_var<null_storage>();
+                    swap(val);
+                    break;
+                }
+                default:
+                    JSONCONS_UNREACHABLE();
+                    break;
             }
+        }
 
-            long_string_storage(const long_string_storage& val, const Allocator& a)
-                : ext_type_(val.ext_type_), s_(val.s_, a)
-            {
-            }
+        void Init_rv_(default_variant&& val, const Allocator&, std::true_type) noexcept
+        {
+            Init_rv_(std::forward<default_variant>(val));
+        }
 
-            ~long_string_storage() noexcept
+        void Init_rv_(default_variant&& val, const Allocator& a, std::false_type) noexcept
+        {
+            switch (val.storage())
             {
+                case storage_kind::null_value:
+                case storage_kind::empty_object_value:
+                case storage_kind::half_value:
+                case storage_kind::double_value:
+                case storage_kind::int64_value:
+                case storage_kind::uint64_value:
+                case storage_kind::bool_value:
+                case storage_kind::short_string_value:
+                case storage_kind::short_double_text_value:
+                    Init_(std::forward<default_variant>(val));
+                    break;
+                case storage_kind::long_string_value:
+                case storage_kind::long_double_text_value:
+                {
+                    if (a == val.cast<long_string_storage>().get_allocator())
+                    {
+                        Init_rv_(std::forward<default_variant>(val), a, std::true_type());
+                    }
+                    else
+                    {
+                        Init_(val,a);
+                    }
+                    break;
+                }
+                case storage_kind::byte_string_value:
+                {
+                    if (a == val.cast<byte_string_storage>().get_allocator())
+                    {
+                        Init_rv_(std::forward<default_variant>(val), a, std::true_type());
+                    }
+                    else
+                    {
+                        Init_(val,a);
+                    }
+                    break;
+                }
+                case storage_kind::typed_array_value:
+                {
+                    if (a == val.cast<typed_array_storage>().get_allocator())
+                    {
+                        Init_rv_(std::forward<default_variant>(val), a, std::true_type());
+                    }
+                    else
+                    {
+                        Init_(val,a);
+                    }
+                    break;
+                }
+                case storage_kind::object_value:
+                {
+                    if (a == val.cast<object_storage>().get_allocator())
+                    {
+                        Init_rv_(std::forward<default_variant>(val), a, std::true_type());
+                    }
+                    else
+                    {
+                        Init_(val,a);
+                    }
+                    break;
+                }
+                case storage_kind::array_value:
+                {
+                    if (a == val.cast<array_storage>().get_allocator())
+                    {
+                        Init_rv_(std::forward<default_variant>(val), a, std::true_type());
+                    }
+                    else
+                    {
+                        Init_(val,a);
+                    }
+                    break;
+                }
+            default:
+                break;
             }
+        }
+    };
 
-            void swap(long_string_storage& val) noexcept
-            {
-                s_.swap(val.s_);
-            }
+    // Holds a value in 8 bytes, for compact_value_policy. A double without a tag is held as is. Any other
+    // value is held in the bits of a negative NaN: the top 12 bits are set, followed by a 3 bit kind, the
+    // 4 bit tag and a 45 bit payload. Null, bool, half, integers that fit in 45 bits and strings of up to 
+    // 4 chars are held in the payload. Long strings, arrays and objects are held on the heap, the payload 
+    // is their address shifted right by 3, which requires 8 byte aligned addresses below 2^48. Other values, 
+    // such as larger integers, doubles with a tag, byte strings and typed arrays, are boxed, held in a 
+    // default_variant on the heap. Addresses are checked as they are allocated, one that cannot be held, 
+    // such as a tagged pointer or one above 2^48, is deallocated and an exception thrown.
+    struct compact_variant : variant_base<compact_variant>
+    {
+        static constexpr bool copy_on_write = jsoncons::detail::is_copy_on_write<ImplementationPolicy>::value;
+        static constexpr bool keep_hash = jsoncons::detail::is_cached_hash<ImplementationPolicy>::value;
+
+        static_assert(std::is_pointer<typename std::allocator_traits<Allocator>::pointer>::value,
+                      "compact_value_policy requires an allocator with plain pointers");
+        static_assert(sizeof(void*) <= sizeof(uint64_t), "compact_value_policy requires addresses of at most 64 bits");
+    private:
+        static constexpr uint64_t nan_bits = 0xfff0000000000000ull;
+        static constexpr int kind_shift = 49;
+        static constexpr int tag_shift = 45;
+        static constexpr uint64_t payload_mask = (uint64_t(1) << 45) - 1;
+
+        // multi_dim_column_major is the largest semantic_tag, a new one must be checked here too
+        static_assert(static_cast<uint64_t>(semantic_tag::multi_dim_column_major) < (uint64_t(1) << (kind_shift - tag_shift)),
+                      "semantic_tag does not fit in the 4 bit tag of compact_variant");
+
+        enum class value_kind : uint8_t
+        {
+            simple = 0,
+            int64 = 1,
+            uint64 = 2,
+            short_string = 3,
+            long_string = 4,
+            array = 5,
+            object = 6,
+            boxed = 7
+        };
 
-            const char_type* data() const
-            {
-                return s_.data();
-            }
+        // The payload of a null, empty object, bool or half value, a half keeps its bits above.
+        // None of them is zero, so that no value has the bits of negative infinity.
+        static constexpr uint64_t null_payload = 1;
+        static constexpr uint64_t empty_object_payload = 2;
+        static constexpr uint64_t false_payload = 3;
+        static constexpr uint64_t true_payload = 4;
+        static constexpr uint64_t half_payload = 5;
+        static constexpr uint64_t simple_mask = 7;
+        static constexpr int half_shift = 3;
+
+        static constexpr int64_t min_int64 = -(int64_t(1) << 44);
+        static constexpr int64_t max_int64 = (int64_t(1) << 44) - 1;
+        static constexpr uint64_t max_uint64 = payload_mask;
+
+        // A short string keeps its chars, and a terminating zero, in the low 5 bytes of the payload, 
+        // followed by its length and a flag for double text
+        static constexpr std::size_t short_string_capacity = sizeof(char_type) == 1 ? 5 : 0;
+        static constexpr std::size_t short_string_offset = jsoncons::detail::endian::native == jsoncons::detail::endian::little ? 0 : 3;
+        static constexpr int short_length_shift = 40;
+        static constexpr uint64_t double_text_flag = uint64_t(1) << 43;
+
+        using string_wrapper_type = jsoncons::detail::heap_only_string_wrapper<char_type,Allocator>;
+        using string_type = typename std::pointer_traits<typename string_wrapper_type::pointer>::element_type;
 
-            const char_type* c_str() const
-            {
-                return s_.c_str();
-            }
+        template <class T>
+        using node_type = jsoncons::detail::storage_node<T,copy_on_write,keep_hash>;
 
-            std::size_t length() const
-            {
-                return s_.length();
-            }
+        struct boxed_value
+        {
+            allocator_type alloc;
+            default_variant value;
 
-            allocator_type get_allocator() const
+            template <class... Args>
+            boxed_value(const Allocator& a, Args&& ... args)
+                : alloc(a), value(std::forward<Args>(args)...)
             {
-                return s_.get_allocator();
             }
         };
 
-        // byte_string_storage
-        class byte_string_storage final
+        uint64_t bits_;
+
+        static constexpr uint64_t to_bits(value_kind kind, semantic_tag tag, uint64_t payload)
         {
-        public:
-            uint8_t ext_type_;
-        private:
-            using byte_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<byte_string_storage_type>;                  
-            using pointer = typename std::allocator_traits<byte_allocator_type>::pointer;
+            return nan_bits | (static_cast<uint64_t>(kind) << kind_shift) | (static_cast<uint64_t>(tag) << tag_shift) | payload;
+        }
 
-            pointer ptr_;
+        static bool is_representable(const void* ptr) noexcept
+        {
+            uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+            return (address & 7) == 0 && (address >> 48) == 0;
+        }
 
-            template <typename... Args>
-            void create(byte_allocator_type alloc, Args&& ... args)
-            {
-                ptr_ = std::allocator_traits<byte_allocator_type>::allocate(alloc, 1);
-                JSONCONS_TRY
-                {
-                    std::allocator_traits<byte_allocator_type>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
-                }
-                JSONCONS_CATCH(...)
-                {
-                    std::allocator_traits<byte_allocator_type>::deallocate(alloc, ptr_,1);
-                    JSONCONS_RETHROW;
-                }
-            }
-        public:
+        // ptr must be representable, create_node and init_string check the addresses they allocate
+        static uint64_t to_payload(const void* ptr) noexcept
+        {
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) >> 3;
+        }
 
-            byte_string_storage(semantic_tag semantic_type, 
-                             const uint8_t* data, std::size_t length, 
-                             const Allocator& a)
-                : ext_type_(from_storage_and_tag(storage_kind::byte_string_value, semantic_type))
-            {
-                create(byte_allocator_type(a), data, data+length, a);
-            }
+        static void throw_not_representable()
+        {
+            JSONCONS_THROW(json_runtime_error<std::runtime_error>("Address cannot be held by compact_value_policy"));
+        }
 
-            byte_string_storage(const byte_string_storage& val)
-                : ext_type_(val.ext_type_)
-            {
-                create(val.ptr_->get_allocator(), *(val.ptr_));
-            }
+        bool is_double() const
+        {
+            return (bits_ & nan_bits) != nan_bits || bits_ == nan_bits;
+        }
 
-            byte_string_storage(byte_string_storage&& val) noexcept
-                : ext_type_(val.ext_type_), 
-                  ptr_(nullptr)
-            {
-                std::swap(val.ptr_,ptr_);
-            }
+        value_kind kind() const
+        {
+            return static_cast<value_kind>((bits_ >> kind_shift) & 7);
+        }
 
-            byte_string_storage(const byte_string_storage& val, const Allocator& a)
-                : ext_type_(val.ext_type_)
-            { 
-                create(byte_allocator_type(a), *(val.ptr_), a);
-            }
+        bool is_in_place() const
+        {
+            return is_double() || kind() <= value_kind::short_string;
+        }
 
-            ~byte_string_storage() noexcept
-            {
-                if (ptr_ != nullptr)
-                {
-                    byte_allocator_type alloc(ptr_->get_allocator());
-                    std::allocator_traits<byte_allocator_type>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
-                    std::allocator_traits<byte_allocator_type>::deallocate(alloc, ptr_,1);
-                }
-            }
+        uint64_t payload() const
+        {
+            return bits_ & payload_mask;
+        }
 
-            void swap(byte_string_storage& val) noexcept
-            {
-                std::swap(val.ptr_,ptr_);
-            }
+        template <class T>
+        T* to_pointer() const
+        {
+            return reinterpret_cast<T*>(static_cast<uintptr_t>(payload() << 3));
+        }
 
-            const uint8_t* data() const
-            {
-                return ptr_->data();
-            }
+        boxed_value* boxed() const
+        {
+            return to_pointer<boxed_value>();
+        }
 
-            std::size_t length() const
-            {
-                return ptr_->size();
-            }
+        template <class T, class Alloc, class... Args>
+        static T* create_node(const Alloc& a, Args&& ... args)
+        {
+            using node_allocator = typename std::allocator_traits<Alloc>:: template rebind_alloc<T>;
 
-            const uint8_t* begin() const
+            node_allocator alloc(a);
+            T* ptr = std::allocator_traits<node_allocator>::allocate(alloc, 1);
+            if (!is_representable(ptr))
             {
-                return ptr_->data();
+                std::allocator_traits<node_allocator>::deallocate(alloc, ptr, 1);
+                throw_not_representable();
             }
-
-            const uint8_t* end() const
+            JSONCONS_TRY
             {
-                return ptr_->data() + ptr_->size();
+                std::allocator_traits<node_allocator>::construct(alloc, ptr, std::forward<Args>(args)...);
             }
-
-            allocator_type get_allocator() const
+            JSONCONS_CATCH(...)
             {
-                return ptr_->get_allocator();
+                std::allocator_traits<node_allocator>::deallocate(alloc, ptr, 1);
+                JSONCONS_RETHROW;
             }
-        };
-
-        // array_storage
-        class array_storage final
+            return ptr;
+        }
+        template <class T, class Alloc>
+        static void destroy_node(Alloc a, T* ptr) noexcept
         {
-        public:
-            uint8_t ext_type_;
-        private:
-            using array_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<array>;
-            using pointer = typename std::allocator_traits<array_allocator>::pointer;
+            using node_allocator = typename std::allocator_traits<Alloc>:: template rebind_alloc<T>;
 
-            pointer ptr_;
+            node_allocator alloc(a);
+            std::allocator_traits<node_allocator>::destroy(alloc, ptr);
+            std::allocator_traits<node_allocator>::deallocate(alloc, ptr, 1);
+        }
 
-            template <typename... Args>
-            void create(array_allocator alloc, Args&& ... args)
+        template <class T>
+        static void release_node(node_type<T>* ptr) noexcept
+        {
+            if (ptr->release())
             {
-                ptr_ = std::allocator_traits<array_allocator>::allocate(alloc, 1);
-                JSONCONS_TRY
-                {
-                    std::allocator_traits<array_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
-                }
-                JSONCONS_CATCH(...)
-                {
-                    std::allocator_traits<array_allocator>::deallocate(alloc, ptr_,1);
-                    JSONCONS_RETHROW;
-                }
+                variant_base<compact_variant>::destroy_nested(ptr->value);
+                destroy_node(ptr->value.get_allocator(), ptr);
             }
+        }
 
-            void destroy() noexcept
-            {
-                array_allocator alloc(ptr_->get_allocator());
-                std::allocator_traits<array_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
-                std::allocator_traits<array_allocator>::deallocate(alloc, ptr_,1);
-            }
-        public:
-            array_storage(const array& val, semantic_tag tag)
-                : ext_type_(from_storage_and_tag(storage_kind::array_value, tag))
-            {
-                create(val.get_allocator(), val);
-            }
+        template <class... Args>
+        void box(const Allocator& a, Args&& ... args)
+        {
+            bits_ = to_bits(value_kind::boxed, semantic_tag::none, to_payload(create_node<boxed_value>(a, a, std::forward<Args>(args)...)));
+        }
 
-            array_storage(const array& val, semantic_tag tag, const Allocator& a)
-                : ext_type_(from_storage_and_tag(storage_kind::array_value, tag))
+        void init_short_string(uint64_t flags, const char_type* s, std::size_t length, semantic_tag tag)
+        {
+            bits_ = to_bits(value_kind::short_string, tag, flags | (static_cast<uint64_t>(length) << short_length_shift));
+            if (length > 0)
             {
-                create(array_allocator(a), val, a);
+                std::memcpy(reinterpret_cast<char*>(&bits_) + short_string_offset, s, length*sizeof(char_type));
             }
+        }
 
-            array_storage(const array_storage& val)
-                : ext_type_(val.ext_type_)
+        void init_string(const char_type* s, std::size_t length, semantic_tag tag, const Allocator& alloc)
+        {
+            if (length < short_string_capacity)
             {
-                create(val.ptr_->get_allocator(), *(val.ptr_));
+                init_short_string(0, s, length, tag);
             }
-
-            array_storage(array_storage&& val) noexcept
-                : ext_type_(val.ext_type_), 
-                  ptr_(nullptr)
+            else
             {
-                std::swap(val.ptr_, ptr_);
+                string_wrapper_type str(s, length, alloc);
+                string_type* ptr = str.release();
+                if (!is_representable(ptr))
+                {
+                    string_wrapper_type owner(ptr); // frees it
+                    throw_not_representable();
+                }
+                bits_ = to_bits(value_kind::long_string, tag, to_payload(ptr));
             }
+        }
+    public:
 
-            array_storage(const array_storage& val, const Allocator& a)
-                : ext_type_(val.ext_type_)
+        template <class T>
+        class scalar_storage final
+        {
+            T val_;
+        public:
+            explicit scalar_storage(T val)
+                : val_(val)
             {
-                create(array_allocator(a), *(val.ptr_), a);
             }
-            ~array_storage() noexcept
+
+            T value() const
             {
-                if (ptr_ != nullptr)
-                {
-                    destroy();
-                }
+                return val_;
             }
+        };
 
-            allocator_type get_allocator() const
+        using bool_storage = scalar_storage<bool>;
+        using int64_storage = scalar_storage<int64_t>;
+        using uint64_storage = scalar_storage<uint64_t>;
+        using half_storage = scalar_storage<uint16_t>;
+        using double_storage = scalar_storage<double>;
+
+        class short_string_storage final
+        {
+            const char_type* data_;
+            std::size_t length_;
+        public:
+            short_string_storage(const char_type* data, std::size_t length)
+                : data_(data), length_(length)
             {
-                return ptr_->get_allocator();
             }
 
-            void swap(array_storage& val) noexcept
+            std::size_t length() const
             {
-                std::swap(val.ptr_,ptr_);
+                return length_;
             }
 
-            array& value()
+            const char_type* data() const
             {
-                return *ptr_;
+                return data_;
             }
 
-            const array& value() const
+            const char_type* c_str() const
             {
-                return *ptr_;
+                return data_;
             }
         };
 
-        // object_storage
-        class object_storage final
+        class long_string_storage final
         {
+            const char_type* data_;
+            std::size_t length_;
+            allocator_type alloc_;
         public:
-            uint8_t ext_type_;
-        private:
-            using object_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<object>;
-            using pointer = typename std::allocator_traits<object_allocator>::pointer;
-
-            pointer ptr_;
+            template <class String>
+            explicit long_string_storage(const String& s)
+                : data_(s.data()), length_(s.length()), alloc_(s.get_allocator())
+            {
+            }
 
-            template <typename... Args>
-            void create(object_allocator alloc, Args&& ... args)
+            std::size_t length() const
             {
-                ptr_ = std::allocator_traits<object_allocator>::allocate(alloc, 1);
-                JSONCONS_TRY
-                {
-                    std::allocator_traits<object_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
-                }
-                JSONCONS_CATCH(...)
-                {
-                    std::allocator_traits<object_allocator>::deallocate(alloc, ptr_,1);
-                    JSONCONS_RETHROW;
-                }
+                return length_;
             }
-        public:
-            explicit object_storage(const object& val, semantic_tag tag)
-                : ext_type_(from_storage_and_tag(storage_kind::object_value, tag))
+
+            const char_type* data() const
             {
-                create(val.get_allocator(), val);
+                return data_;
             }
 
-            explicit object_storage(const object& val, semantic_tag tag, const Allocator& a)
-                : ext_type_(from_storage_and_tag(storage_kind::object_value, tag))
+            const char_type* c_str() const
             {
-                create(object_allocator(a), val, a);
+                return data_;
             }
 
-            explicit object_storage(const object_storage& val)
-                : ext_type_(val.ext_type_)
+            allocator_type get_allocator() const
             {
-                create(val.ptr_->get_allocator(), *(val.ptr_));
+                return alloc_;
             }
+        };
 
-            explicit object_storage(object_storage&& val) noexcept
-                : ext_type_(val.ext_type_), 
-                  ptr_(nullptr)
+        // An array or object, a non-const access gives the value its own copy if the node is shared
+        template <class T>
+        class container_storage final
+        {
+            node_type<T>* ptr_;
+            compact_variant* owner_;
+        public:
+            container_storage(node_type<T>* ptr, compact_variant* owner)
+                : ptr_(ptr), owner_(owner)
             {
-                std::swap(val.ptr_,ptr_);
             }
 
-            explicit object_storage(const object_storage& val, const Allocator& a)
-                : ext_type_(val.ext_type_)
+            bool is_shared() const noexcept
             {
-                create(object_allocator(a), *(val.ptr_), a);
+                return ptr_->is_shared();
             }
 
-            ~object_storage() noexcept
+            T& value()
             {
-                if (ptr_ != nullptr)
+                if (ptr_->is_shared())
                 {
-                    destroy();
+                    node_type<T>* ptr = create_node<node_type<T>>(ptr_->value.get_allocator(), ptr_->value);
+                    release_node(ptr_);
+                    ptr_ = ptr;
+                    owner_->bits_ = (owner_->bits_ & ~payload_mask) | to_payload(ptr);
                 }
+                ptr_->reset_hash();
+                return ptr_->value;
             }
 
-            void swap(object_storage& val) noexcept
+            const T& value() const
             {
-                std::swap(val.ptr_,ptr_);
+                return ptr_->value;
             }
 
-            object& value()
+            // The hash kept by cached_hash_policy, or zero
+            uint64_t cached_hash() const noexcept
             {
-                return *ptr_;
+                return ptr_->cached_hash();
             }
 
-            const object& value() const
+            void cache_hash(uint64_t hash) const noexcept
             {
-                return *ptr_;
+                ptr_->cache_hash(hash);
             }
 
             allocator_type get_allocator() const
             {
-                return ptr_->get_allocator();
-            }
-        private:
-
-            void destroy() noexcept
-            {
-                object_allocator alloc(ptr_->get_allocator());
-                std::allocator_traits<object_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
-                std::allocator_traits<object_allocator>::deallocate(alloc, ptr_,1);
+                return ptr_->value.get_allocator();
             }
         };
 
-    private:
-        union 
-        {
-            common_storage common_stor_;
-            null_storage null_stor_;
-            bool_storage bool_stor_;
-            int64_storage int64_stor_;
-            uint64_storage uint64_stor_;
-            half_storage half_stor_;
-            double_storage double_stor_;
-            short_string_storage short_string_stor_;
-            long_string_storage long_string_stor_;
-            byte_string_storage byte_string_stor_;
-            array_storage array_stor_;
-            object_storage object_stor_;
-            empty_object_storage empty_object_stor_;
-        };
-    public:
-        variant(semantic_tag tag)
-        {
-            construct_var<empty_object_storage>(tag);
-        }
-
-        explicit variant(null_type, semantic_tag tag)
-        {
-            construct_var<null_storage>(tag);
-        }
+        using array_storage = container_storage<array>;
+        using object_storage = container_storage<object>;
+        using byte_string_storage = typename default_variant::byte_string_storage;
+        using typed_array_storage = typename default_variant::typed_array_storage;
 
-        explicit variant(bool val, semantic_tag tag)
-        {
-            construct_var<bool_storage>(val,tag);
-        }
-        explicit variant(int64_t val, semantic_tag tag)
+        compact_variant(semantic_tag tag)
+            : bits_(to_bits(value_kind::simple, tag, empty_object_payload))
         {
-            construct_var<int64_storage>(val, tag);
-        }
-        explicit variant(uint64_t val, semantic_tag tag)
-        {
-            construct_var<uint64_storage>(val, tag);
         }
 
-        variant(half_arg_t, uint16_t val, semantic_tag tag)
+        explicit compact_variant(null_type, semantic_tag tag)
+            : bits_(to_bits(value_kind::simple, tag, null_payload))
         {
-            construct_var<half_storage>(val, tag);
         }
 
-        variant(double val, semantic_tag tag)
+        explicit compact_variant(bool val, semantic_tag tag)
+            : bits_(to_bits(value_kind::simple, tag, val ? true_payload : false_payload))
         {
-            construct_var<double_storage>(val, tag);
         }
 
-        variant(const char_type* s, std::size_t length, semantic_tag tag)
+        explicit compact_variant(int64_t val, semantic_tag tag)
         {
-            if (length <= short_string_storage::max_length)
+            if (val >= min_int64 && val <= max_int64)
             {
-                construct_var<short_string_storage>(tag, s, static_cast<uint8_t>(length));
+                bits_ = to_bits(value_kind::int64, tag, static_cast<uint64_t>(val) & payload_mask);
             }
             else
             {
-                construct_var<long_string_storage>(tag, s, length, char_allocator_type());
+                box(Allocator(), val, tag);
             }
         }
 
-        variant(const char_type* s, std::size_t length, semantic_tag tag, const Allocator& alloc)
+        explicit compact_variant(uint64_t val, semantic_tag tag)
         {
-            if (length <= short_string_storage::max_length)
+            if (val <= max_uint64)
             {
-                construct_var<short_string_storage>(tag, s, static_cast<uint8_t>(length));
+                bits_ = to_bits(value_kind::uint64, tag, val);
             }
             else
             {
-                construct_var<long_string_storage>(tag, s, length, char_allocator_type(alloc));
+                box(Allocator(), val, tag);
             }
         }
 
-        variant(const byte_string_view& bytes, semantic_tag tag)
-        {
-            construct_var<byte_string_storage>(tag, bytes.data(), bytes.size(), byte_allocator_type());
-        }
-
-        variant(const byte_string_view& bytes, semantic_tag tag, const Allocator& alloc)
+        compact_variant(half_arg_t, uint16_t val, semantic_tag tag)
+            : bits_(to_bits(value_kind::simple, tag, half_payload | (static_cast<uint64_t>(val) << half_shift)))
         {
-            construct_var<byte_string_storage>(tag, bytes.data(), bytes.size(), alloc);
-        }
-
-        variant(byte_string_arg_t, const span<const uint8_t>& bytes, semantic_tag tag, const Allocator& alloc)
-        {
-            construct_var<byte_string_storage>(tag, bytes.data(), bytes.size(), alloc);
-        }
-
-        variant(const object& val, semantic_tag tag)
-        {
-            construct_var<object_storage>(val, tag);
-        }
-        variant(const object& val, semantic_tag tag, const Allocator& alloc)
-        {
-            construct_var<object_storage>(val, tag, alloc);
-        }
-        variant(const array& val, semantic_tag tag)
-        {
-            construct_var<array_storage>(val, tag);
-        }
-        variant(const array& val, semantic_tag tag, const Allocator& alloc)
-        {
-            construct_var<array_storage>(val, tag, alloc);
-        }
-
-        variant(const variant& val)
-        {
-            Init_(val);
-        }
-
-        variant(const variant& val, const Allocator& alloc)
-        {
-            Init_(val,alloc);
-        }
-
-        variant(variant&& val) noexcept
-        {
-            Init_rv_(std::forward<variant>(val));
         }
 
-        variant(variant&& val, const Allocator& alloc) noexcept
+        compact_variant(double val, semantic_tag tag)
         {
-            Init_rv_(std::forward<variant>(val), alloc,
-                     typename std::allocator_traits<Allocator>::propagate_on_container_move_assignment());
+            std::memcpy(&bits_, &val, sizeof(double));
+            if (tag != semantic_tag::none || !is_double())
+            {
+                box(Allocator(), val, tag);
+            }
         }
 
-        ~variant() noexcept
+        compact_variant(const char_type* s, std::size_t length, semantic_tag tag)
         {
-            Destroy_();
+            init_string(s, length, tag, Allocator());
         }
 
-        void Destroy_()
+        compact_variant(const char_type* s, std::size_t length, semantic_tag tag, const Allocator& alloc)
         {
-            switch (storage())
-            {
-                case storage_kind::long_string_value:
-                    destroy_var<long_string_storage>();
-                    break;
-                case storage_kind::byte_string_value:
-                    destroy_var<byte_string_storage>();
-                    break;
-                case storage_kind::array_value:
-                    destroy_var<array_storage>();
-                    break;
-                case storage_kind::object_value:
-                    destroy_var<object_storage>();
-                    break;
-                default:
-                    break;
-            }
+            init_string(s, length, tag, alloc);
         }
 
-        variant& operator=(const variant& val)
+        // The text of a number with a fraction or exponent, kept unconverted
+        compact_variant(double_text_arg_t, const char_type* s, std::size_t length, semantic_tag tag, const Allocator& alloc)
         {
-            if (this != &val)
+            if (length < short_string_capacity)
             {
-                Destroy_();
-                Init_(val);
+                init_short_string(double_text_flag, s, length, tag);
             }
-            return *this;
-        }
-
-        variant& operator=(variant&& val) noexcept
-        {
-            if (this !=&val)
+            else
             {
-                swap(val);
+                box(alloc, double_text_arg, s, length, tag, alloc);
             }
-            return *this;
-        }
-
-        storage_kind storage() const
-        {
-            // It is legal to access 'common_stor_.ext_type_' even though 
-            // common_stor_ is not the active member of the union because 'ext_type_' 
-            // is a part of the common initial sequence of all union members
-            // as defined in 11.4-25 of the Standard.
-            return to_storage(common_stor_.ext_type_);
-        }
-
-        semantic_tag tag() const
-        {
-            // It is legal to access 'common_stor_.ext_type_' even though 
-            // common_stor_ is not the active member of the union because 'ext_type_' 
-            // is a part of the common initial sequence of all union members
-            // as defined in 11.4-25 of the Standard.
-            return to_tag(common_stor_.ext_type_);
         }
 
-        template <class VariantType, class... Args>
-        void construct_var(Args&&... args)
+        compact_variant(const byte_string_view& bytes, semantic_tag tag)
         {
-            ::new (&cast<VariantType>()) VariantType(std::forward<Args>(args)...);
+            box(Allocator(), bytes, tag);
         }
 
-        template <class T>
-        void destroy_var()
+        compact_variant(const byte_string_view& bytes, semantic_tag tag, const Allocator& alloc)
         {
-            cast<T>().~T();
+            box(alloc, bytes, tag, alloc);
         }
 
-        template <class T>
-        struct identity { using type = T*; };
-
-        template <class T> 
-        T& cast()
+        compact_variant(byte_string_arg_t, const span<const uint8_t>& bytes, semantic_tag tag, const Allocator& alloc)
         {
-            return cast(identity<T>());
+            box(alloc, byte_string_arg, bytes, tag, alloc);
         }
 
-        template <class T> 
-        const T& cast() const
+        compact_variant(typed_array_arg_t, const typed_array_view& view, semantic_tag tag, const Allocator& alloc)
         {
-            return cast(identity<T>());
+            box(alloc, typed_array_arg, view, tag, alloc);
         }
 
-        null_storage& cast(identity<null_storage>) 
+        compact_variant(const object& val, semantic_tag tag)
+            : bits_(to_bits(value_kind::object, tag, to_payload(create_node<node_type<object>>(val.get_allocator(), val))))
         {
-            return null_stor_;
         }
 
-        const null_storage& cast(identity<null_storage>) const
+        compact_variant(const object& val, semantic_tag tag, const Allocator& alloc)
+            : bits_(to_bits(value_kind::object, tag, to_payload(create_node<node_type<object>>(alloc, val, alloc))))
         {
-            return null_stor_;
         }
 
-        empty_object_storage& cast(identity<empty_object_storage>) 
+        compact_variant(const array& val, semantic_tag tag)
+            : bits_(to_bits(value_kind::array, tag, to_payload(create_node<node_type<array>>(val.get_allocator(), val))))
         {
-            return empty_object_stor_;
         }
 
-        const empty_object_storage& cast(identity<empty_object_storage>) const
+        compact_variant(const array& val, semantic_tag tag, const Allocator& alloc)
+            : bits_(to_bits(value_kind::array, tag, to_payload(create_node<node_type<array>>(alloc, val, alloc))))
         {
-            return empty_object_stor_;
         }
 
-        bool_storage& cast(identity<bool_storage>) 
+        compact_variant(array&& val, semantic_tag tag)
+            : bits_(to_bits(value_kind::array, tag, to_payload(create_node<node_type<array>>(val.get_allocator(), std::move(val)))))
         {
-            return bool_stor_;
         }
 
-        const bool_storage& cast(identity<bool_storage>) const
+        compact_variant(const compact_variant& val)
         {
-            return bool_stor_;
+            Init_(val);
         }
 
-        int64_storage& cast(identity<int64_storage>) 
+        compact_variant(const compact_variant& val, const Allocator& alloc)
         {
-            return int64_stor_;
+            Init_(val, alloc);
         }
 
-        const int64_storage& cast(identity<int64_storage>) const
+        // As with default_variant, a value held in place is copied, and one on the heap is taken 
+        // leaving null behind
+        compact_variant(compact_variant&& val) noexcept
+            : bits_(val.bits_)
         {
-            return int64_stor_;
+            if (!val.is_in_place())
+            {
+                val.bits_ = to_bits(value_kind::simple, semantic_tag::none, null_payload);
+            }
         }
 
-        uint64_storage& cast(identity<uint64_storage>) 
+        compact_variant(compact_variant&& val, const Allocator& alloc) noexcept
+            : bits_(to_bits(value_kind::simple, semantic_tag::none, null_payload))
         {
-            return uint64_stor_;
+            if (val.is_in_place())
+            {
+                bits_ = val.bits_;
+            }
+            else if (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value || val.uses_allocator(alloc))
+            {
+                swap(val);
+            }
+            else
+            {
+                Init_(val, alloc);
+            }
         }
 
-        const uint64_storage& cast(identity<uint64_storage>) const
+        ~compact_variant() noexcept
         {
-            return uint64_stor_;
+            Destroy_();
         }
 
-        half_storage& cast(identity<half_storage>)
+        compact_variant& operator=(const compact_variant& val)
         {
-            return half_stor_;
+            if (this != &val)
+            {
+                compact_variant temp(val);
+                swap(temp);
+            }
+            return *this;
         }
 
-        const half_storage& cast(identity<half_storage>) const
+        compact_variant& operator=(compact_variant&& val) noexcept
         {
-            return half_stor_;
+            if (this != &val)
+            {
+                swap(val);
+            }
+            return *this;
         }
 
-        double_storage& cast(identity<double_storage>) 
+        void swap(compact_variant& other) noexcept
         {
-            return double_stor_;
+            std::swap(bits_, other.bits_);
         }
 
-        const double_storage& cast(identity<double_storage>) const
+        storage_kind storage() const
         {
-            return double_stor_;
+            if (is_double())
+            {
+                return storage_kind::double_value;
+            }
+            switch (kind())
+            {
+                case value_kind::simple:
+                    switch (payload() & simple_mask)
+                    {
+                        case null_payload:
+                            return storage_kind::null_value;
+                        case empty_object_payload:
+                            return storage_kind::empty_object_value;
+                        case half_payload:
+                            return storage_kind::half_value;
+                        default:
+                            return storage_kind::bool_value;
+                    }
+                case value_kind::int64:
+                    return storage_kind::int64_value;
+                case value_kind::uint64:
+                    return storage_kind::uint64_value;
+                case value_kind::short_string:
+                    return (bits_ & double_text_flag) ? storage_kind::short_double_text_value : storage_kind::short_string_value;
+                case value_kind::long_string:
+                    return storage_kind::long_string_value;
+                case value_kind::array:
+                    return storage_kind::array_value;
+                case value_kind::object:
+                    return storage_kind::object_value;
+                default:
+                    return boxed()->value.storage();
+            }
         }
 
-        short_string_storage& cast(identity<short_string_storage>)
+        semantic_tag tag() const
         {
-            return short_string_stor_;
+            if (is_double())
+            {
+                return semantic_tag::none;
+            }
+            if (kind() == value_kind::boxed)
+            {
+                return boxed()->value.tag();
+            }
+            return static_cast<semantic_tag>((bits_ >> tag_shift) & 0x0f);
         }
 
-        const short_string_storage& cast(identity<short_string_storage>) const
+        template <class T>
+        struct identity { using type = T*; };
+
+        bool_storage cast(identity<bool_storage>) const
         {
-            return short_string_stor_;
+            return bool_storage((payload() & simple_mask) == true_payload);
         }
 
-        long_string_storage& cast(identity<long_string_storage>)
+        int64_storage cast(identity<int64_storage>) const
         {
-            return long_string_stor_;
+            if (kind() == value_kind::boxed)
+            {
+                return int64_storage(boxed()->value.template cast<typename default_variant::int64_storage>().value());
+            }
+            // Extends the sign of the 45 bit payload
+            const uint64_t sign_bit = uint64_t(1) << 44;
+            return int64_storage(static_cast<int64_t>(payload() ^ sign_bit) - static_cast<int64_t>(sign_bit));
         }
 
-        const long_string_storage& cast(identity<long_string_storage>) const
+        uint64_storage cast(identity<uint64_storage>) const
         {
-            return long_string_stor_;
+            if (kind() == value_kind::boxed)
+            {
+                return uint64_storage(boxed()->value.template cast<typename default_variant::uint64_storage>().value());
+            }
+            return uint64_storage(payload());
         }
 
-        byte_string_storage& cast(identity<byte_string_storage>)
+        half_storage cast(identity<half_storage>) const
         {
-            return byte_string_stor_;
+            return half_storage(static_cast<uint16_t>(payload() >> half_shift));
         }
 
-        const byte_string_storage& cast(identity<byte_string_storage>) const
+        double_storage cast(identity<double_storage>) const
         {
-            return byte_string_stor_;
+            if (!is_double())
+            {
+                return double_storage(boxed()->value.template cast<typename default_variant::double_storage>().value());
+            }
+            double val;
+            std::memcpy(&val, &bits_, sizeof(double));
+            return double_storage(val);
         }
 
-        object_storage& cast(identity<object_storage>)
+        short_string_storage cast(identity<short_string_storage>) const
         {
-            return object_stor_;
+            if (kind() == value_kind::boxed)
+            {
+                const auto& s = boxed()->value.template cast<typename default_variant::short_string_storage>();
+                return short_string_storage(s.data(), s.length());
+            }
+            return short_string_storage(reinterpret_cast<const char_type*>(reinterpret_cast<const char*>(&bits_) + short_string_offset),
+                                        static_cast<std::size_t>((payload() >> short_length_shift) & 7));
         }
 
-        const object_storage& cast(identity<object_storage>) const
+        long_string_storage cast(identity<long_string_storage>) const
         {
-            return object_stor_;
+            if (kind() == value_kind::boxed)
+            {
+                return long_string_storage(boxed()->value.template cast<typename default_variant::long_string_storage>());
+            }
+            return long_string_storage(*to_pointer<string_type>());
         }
 
-        array_storage& cast(identity<array_storage>)
+        byte_string_storage& cast(identity<byte_string_storage>)
         {
-            return array_stor_;
+            return boxed()->value.template cast<byte_string_storage>();
         }
 
-        const array_storage& cast(identity<array_storage>) const
+        const byte_string_storage& cast(identity<byte_string_storage>) const
         {
-            return array_stor_;
+            return boxed()->value.template cast<byte_string_storage>();
         }
 
-        std::size_t size() const
+        typed_array_storage& cast(identity<typed_array_storage>)
         {
-            switch (storage())
-            {
-                case storage_kind::array_value:
-                    return cast<array_storage>().value().size();
-                case storage_kind::object_value:
-                    return cast<object_storage>().value().size();
-                default:
-                    return 0;
-            }
+            return boxed()->value.template cast<typed_array_storage>();
         }
 
-        string_view_type as_string_view() const
+        const typed_array_storage& cast(identity<typed_array_storage>) const
         {
-            switch (storage())
-            {
-                case storage_kind::short_string_value:
-                    return string_view_type(cast<short_string_storage>().data(),cast<short_string_storage>().length());
-                case storage_kind::long_string_value:
-                    return string_view_type(cast<long_string_storage>().data(),cast<long_string_storage>().length());
-                default:
-                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
-            }
+            return boxed()->value.template cast<typed_array_storage>();
         }
 
-        template <typename BAllocator=std::allocator<uint8_t>>
-        basic_byte_string<BAllocator> as_byte_string() const
+        array_storage cast(identity<array_storage>)
         {
-            switch (storage())
-            {
-                case storage_kind::short_string_value:
-                case storage_kind::long_string_value:
-                {
-                    switch (tag())
-                    {
-                        case semantic_tag::base16:
-                        {
-                            basic_byte_string<BAllocator> bytes;
-                            auto s = as_string_view();
-                            decode_base16(s.begin(), s.end(), bytes);
-                            return bytes;
-                        }
-                        case semantic_tag::base64:
-                        {
-                            basic_byte_string<BAllocator> bytes;
-                            auto s = as_string_view();
-                            decode_base64(s.begin(), s.end(), bytes);
-                            return bytes;
-                        }
-                        case semantic_tag::base64url:
-                        {
-                            basic_byte_string<BAllocator> bytes;
-                            auto s = as_string_view();
-                            decode_base64url(s.begin(), s.end(), bytes);
-                            return bytes;
-                        }
-                        default:
-                            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
-                    }
-                    break;
-                }
-                case storage_kind::byte_string_value:
-                    return basic_byte_string<BAllocator>(cast<byte_string_storage>().data(),cast<byte_string_storage>().length());
-                default:
-                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
-            }
+            return array_storage(to_pointer<node_type<array>>(), this);
         }
 
-        byte_string_view as_byte_string_view() const
+        const array_storage cast(identity<array_storage>) const
         {
-            switch (storage())
-            {
-            case storage_kind::byte_string_value:
-                return byte_string_view(cast<byte_string_storage>().data(),cast<byte_string_storage>().length());
-            default:
-                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
-            }
+            return array_storage(to_pointer<node_type<array>>(), nullptr);
         }
 
-        bool operator==(const variant& rhs) const
+        object_storage cast(identity<object_storage>)
         {
-            if (this ==&rhs)
-            {
-                return true;
-            }
-            switch (storage())
-            {
-                case storage_kind::null_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::null_value:
-                            return true;
-                        default:
-                            return false;
-                    }
-                    break;
-                case storage_kind::empty_object_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::empty_object_value:
-                            return true;
-                        case storage_kind::object_value:
-                            return rhs.size() == 0;
-                        default:
-                            return false;
-                    }
-                    break;
-                case storage_kind::bool_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::bool_value:
-                            return cast<bool_storage>().value() == rhs.cast<bool_storage>().value();
-                        default:
-                            return false;
-                    }
-                    break;
-                case storage_kind::int64_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::int64_value:
-                            return cast<int64_storage>().value() == rhs.cast<int64_storage>().value();
-                        case storage_kind::uint64_value:
-                            return cast<int64_storage>().value() >= 0 ? static_cast<uint64_t>(cast<int64_storage>().value()) == rhs.cast<uint64_storage>().value() : false;
-                        case storage_kind::half_value:
-                            return static_cast<double>(cast<int64_storage>().value()) == jsoncons::detail::decode_half(rhs.cast<half_storage>().value());
-                        case storage_kind::double_value:
-                            return static_cast<double>(cast<int64_storage>().value()) == rhs.cast<double_storage>().value();
-                        default:
-                            return false;
-                    }
-                    break;
-                case storage_kind::uint64_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::int64_value:
-                            return rhs.cast<int64_storage>().value() >= 0 ? cast<uint64_storage>().value() == static_cast<uint64_t>(rhs.cast<int64_storage>().value()) : false;
-                        case storage_kind::uint64_value:
-                            return cast<uint64_storage>().value() == rhs.cast<uint64_storage>().value();
-                        case storage_kind::half_value:
-                            return static_cast<double>(cast<uint64_storage>().value()) == jsoncons::detail::decode_half(rhs.cast<half_storage>().value());
-                        case storage_kind::double_value:
-                            return static_cast<double>(cast<uint64_storage>().value()) == rhs.cast<double_storage>().value();
-                        default:
-                            return false;
-                    }
-                    break;
-                case storage_kind::half_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::half_value:
-                            return cast<half_storage>().value() == rhs.cast<half_storage>().value();
-                        default:
-                            return variant(jsoncons::detail::decode_half(cast<half_storage>().value()),semantic_tag::none) == rhs;
-                    }
-                    break;
-                case storage_kind::double_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::int64_value:
-                            return cast<double_storage>().value() == static_cast<double>(rhs.cast<int64_storage>().value());
-                        case storage_kind::uint64_value:
-                            return cast<double_storage>().value() == static_cast<double>(rhs.cast<uint64_storage>().value());
-                        case storage_kind::half_value:
-                            return cast<double_storage>().value() == jsoncons::detail::decode_half(rhs.cast<half_storage>().value());
-                        case storage_kind::double_value:
-                            return cast<double_storage>().value() == rhs.cast<double_storage>().value();
-                        default:
-                            return false;
-                    }
-                    break;
-                case storage_kind::short_string_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::short_string_value:
-                            return as_string_view() == rhs.as_string_view();
-                        case storage_kind::long_string_value:
-                            return as_string_view() == rhs.as_string_view();
-                        default:
-                            return false;
-                    }
-                    break;
-                case storage_kind::long_string_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::short_string_value:
-                            return as_string_view() == rhs.as_string_view();
-                        case storage_kind::long_string_value:
-                            return as_string_view() == rhs.as_string_view();
-                        default:
-                            return false;
-                    }
-                    break;
-                case storage_kind::byte_string_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::byte_string_value:
-                        {
-                            return as_byte_string_view() == rhs.as_byte_string_view();
-                        }
-                        default:
-                            return false;
-                    }
-                    break;
-                case storage_kind::array_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::array_value:
-                            return cast<array_storage>().value() == rhs.cast<array_storage>().value();
-                        default:
-                            return false;
-                    }
-                    break;
-                case storage_kind::object_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::empty_object_value:
-                            return size() == 0;
-                        case storage_kind::object_value:
-                            return cast<object_storage>().value() == rhs.cast<object_storage>().value();
-                        default:
-                            return false;
-                    }
-                    break;
-                default:
-                    JSONCONS_UNREACHABLE();
-                    break;
-            }
+            return object_storage(to_pointer<node_type<object>>(), this);
         }
 
-        bool operator!=(const variant& rhs) const
+        const object_storage cast(identity<object_storage>) const
         {
-            return !(*this == rhs);
+            return object_storage(to_pointer<node_type<object>>(), nullptr);
         }
 
-        bool operator<(const variant& rhs) const
+        template <class T> 
+        auto cast() -> decltype(std::declval<compact_variant&>().cast(identity<T>()))
         {
-            if (this == &rhs)
+            return cast(identity<T>());
+        }
+
+        template <class T> 
+        auto cast() const -> decltype(std::declval<const compact_variant&>().cast(identity<T>()))
+        {
+            return cast(identity<T>());
+        }
+
+    private:
+        // True if the value holds nothing on the heap, or what it holds was allocated with alloc
+        bool uses_allocator(const Allocator& alloc) const
+        {
+            if (is_double())
             {
-                return false;
+                return true;
             }
-            switch (storage())
+            switch (kind())
             {
-                case storage_kind::null_value:
-                    return (int)storage() < (int)rhs.storage();
-                case storage_kind::empty_object_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::empty_object_value:
-                            return false;
-                        case storage_kind::object_value:
-                            return rhs.size() != 0;
-                        default:
-                            return (int)storage() < (int)rhs.storage();
-                    }
-                    break;
-                case storage_kind::bool_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::bool_value:
-                            return cast<bool_storage>().value() < rhs.cast<bool_storage>().value();
-                        default:
-                            return (int)storage() < (int)rhs.storage();
-                    }
-                    break;
-                case storage_kind::int64_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::int64_value:
-                            return cast<int64_storage>().value() < rhs.cast<int64_storage>().value();
-                        case storage_kind::uint64_value:
-                            return cast<int64_storage>().value() >= 0 ? static_cast<uint64_t>(cast<int64_storage>().value()) < rhs.cast<uint64_storage>().value() : true;
-                        case storage_kind::double_value:
-                            return static_cast<double>(cast<int64_storage>().value()) < rhs.cast<double_storage>().value();
-                        default:
-                            return (int)storage() < (int)rhs.storage();
-                    }
-                    break;
-                case storage_kind::uint64_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::int64_value:
-                            return rhs.cast<int64_storage>().value() >= 0 ? cast<uint64_storage>().value() < static_cast<uint64_t>(rhs.cast<int64_storage>().value()) : true;
-                        case storage_kind::uint64_value:
-                            return cast<uint64_storage>().value() < rhs.cast<uint64_storage>().value();
-                        case storage_kind::double_value:
-                            return static_cast<double>(cast<uint64_storage>().value()) < rhs.cast<double_storage>().value();
-                        default:
-                            return (int)storage() < (int)rhs.storage();
-                    }
-                    break;
-                case storage_kind::double_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::int64_value:
-                            return cast<double_storage>().value() < static_cast<double>(rhs.cast<int64_storage>().value());
-                        case storage_kind::uint64_value:
-                            return cast<double_storage>().value() < static_cast<double>(rhs.cast<uint64_storage>().value());
-                        case storage_kind::double_value:
-                            return cast<double_storage>().value() < rhs.cast<double_storage>().value();
-                        default:
-                            return (int)storage() < (int)rhs.storage();
-                    }
-                    break;
-                case storage_kind::short_string_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::short_string_value:
-                            return as_string_view() < rhs.as_string_view();
-                        case storage_kind::long_string_value:
-                            return as_string_view() < rhs.as_string_view();
-                        default:
-                            return (int)storage() < (int)rhs.storage();
-                    }
-                    break;
-                case storage_kind::long_string_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::short_string_value:
-                            return as_string_view() < rhs.as_string_view();
-                        case storage_kind::long_string_value:
-                            return as_string_view() < rhs.as_string_view();
-                        default:
-                            return (int)storage() < (int)rhs.storage();
-                    }
-                    break;
-                case storage_kind::byte_string_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::byte_string_value:
-                        {
-                            return as_byte_string_view() < rhs.as_byte_string_view();
-                        }
-                        default:
-                            return (int)storage() < (int)rhs.storage();
-                    }
-                    break;
-                case storage_kind::array_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::array_value:
-                            return cast<array_storage>().value() < rhs.cast<array_storage>().value();
-                        default:
-                            return (int)storage() < (int)rhs.storage();
-                    }
-                    break;
-                case storage_kind::object_value:
-                    switch (rhs.storage())
-                    {
-                        case storage_kind::empty_object_value:
-                            return false;
-                        case storage_kind::object_value:
-                            return cast<object_storage>().value() < rhs.cast<object_storage>().value();
-                        default:
-                            return (int)storage() < (int)rhs.storage();
-                    }
-                    break;
+                case value_kind::long_string:
+                    return alloc == to_pointer<string_type>()->get_allocator();
+                case value_kind::array:
+                    return alloc == cast<array_storage>().get_allocator();
+                case value_kind::object:
+                    return alloc == cast<object_storage>().get_allocator();
+                case value_kind::boxed:
+                    return alloc == boxed()->alloc;
                 default:
-                    JSONCONS_UNREACHABLE();
-                    break;
+                    return true;
             }
         }
-        template <class TypeA, class TypeB>
-        void swap_a_b(variant& other)
-        {
-            TypeA& curA = cast<TypeA>();
-            TypeB& curB = other.cast<TypeB>();
-            TypeB tmpB(std::move(curB));
-            other.construct_var<TypeA>(std::move(curA));
-            construct_var<TypeB>(std::move(tmpB));
-        }
 
-        template <class TypeA>
-        void swap_a(variant& other)
+        template <class T>
+        void copy_container(const compact_variant& val)
         {
-            switch (other.storage())
+            node_type<T>* ptr = val.template to_pointer<node_type<T>>();
+            if (copy_on_write)
             {
-                case storage_kind::null_value         : swap_a_b<TypeA, null_storage>(other); break;
-                case storage_kind::empty_object_value : swap_a_b<TypeA, empty_object_storage>(other); break;
-                case storage_kind::bool_value         : swap_a_b<TypeA, bool_storage>(other); break;
-                case storage_kind::int64_value      : swap_a_b<TypeA, int64_storage>(other); break;
-                case storage_kind::uint64_value     : swap_a_b<TypeA, uint64_storage>(other); break;
-                case storage_kind::half_value       : swap_a_b<TypeA, half_storage>(other); break;
-                case storage_kind::double_value       : swap_a_b<TypeA, double_storage>(other); break;
-                case storage_kind::short_string_value : swap_a_b<TypeA, short_string_storage>(other); break;
-                case storage_kind::long_string_value       : swap_a_b<TypeA, long_string_storage>(other); break;
-                case storage_kind::byte_string_value  : swap_a_b<TypeA, byte_string_storage>(other); break;
-                case storage_kind::array_value        : swap_a_b<TypeA, array_storage>(other); break;
-                case storage_kind::object_value       : swap_a_b<TypeA, object_storage>(other); break;
-                default:
-                    JSONCONS_UNREACHABLE();
-                    break;
+                ptr->add_ref();
+                bits_ = val.bits_;
+            }
+            else
+            {
+                bits_ = (val.bits_ & ~payload_mask) | to_payload(create_node<node_type<T>>(ptr->value.get_allocator(), ptr->value));
             }
         }
-    public:
 
-        void swap(variant& other) noexcept
+        template <class T>
+        void copy_container(const compact_variant& val, const Allocator& alloc)
         {
-            if (this == &other)
+            node_type<T>* ptr = val.template to_pointer<node_type<T>>();
+            if (copy_on_write && alloc == allocator_type(ptr->value.get_allocator()))
             {
-                return;
+                ptr->add_ref();
+                bits_ = val.bits_;
             }
-
-            switch (storage())
+            else
             {
-                case storage_kind::null_value: swap_a<null_storage>(other); break;
-                case storage_kind::empty_object_value : swap_a<empty_object_storage>(other); break;
-                case storage_kind::bool_value: swap_a<bool_storage>(other); break;
-                case storage_kind::int64_value: swap_a<int64_storage>(other); break;
-                case storage_kind::uint64_value: swap_a<uint64_storage>(other); break;
-                case storage_kind::half_value: swap_a<half_storage>(other); break;
-                case storage_kind::double_value: swap_a<double_storage>(other); break;
-                case storage_kind::short_string_value: swap_a<short_string_storage>(other); break;
-                case storage_kind::long_string_value: swap_a<long_string_storage>(other); break;
-                case storage_kind::byte_string_value: swap_a<byte_string_storage>(other); break;
-                case storage_kind::array_value: swap_a<array_storage>(other); break;
-                case storage_kind::object_value: swap_a<object_storage>(other); break;
-                default:
-                    JSONCONS_UNREACHABLE();
-                    break;
+                bits_ = (val.bits_ & ~payload_mask) | to_payload(create_node<node_type<T>>(alloc, ptr->value, alloc));
             }
         }
 
-    private:
-
-        void Init_(const variant& val)
+        void Init_(const compact_variant& val)
         {
-            switch (val.storage())
+            if (val.is_double())
             {
-                case storage_kind::null_value:
-                    construct_var<null_storage>(val.cast<null_storage>());
-                    break;
-                case storage_kind::empty_object_value:
-                    construct_var<empty_object_storage>(val.cast<empty_object_storage>());
-                    break;
-                case storage_kind::bool_value:
-                    construct_var<bool_storage>(val.cast<bool_storage>());
-                    break;
-                case storage_kind::int64_value:
-                    construct_var<int64_storage>(val.cast<int64_storage>());
-                    break;
-                case storage_kind::uint64_value:
-                    construct_var<uint64_storage>(val.cast<uint64_storage>());
-                    break;
-                case storage_kind::half_value:
-                    construct_var<half_storage>(val.cast<half_storage>());
-                    break;
-                case storage_kind::double_value:
-                    construct_var<double_storage>(val.cast<double_storage>());
-                    break;
-                case storage_kind::short_string_value:
-                    construct_var<short_string_storage>(val.cast<short_string_storage>());
-                    break;
-                case storage_kind::long_string_value:
-                    construct_var<long_string_storage>(val.cast<long_string_storage>());
+                bits_ = val.bits_;
+                return;
+            }
+            switch (val.kind())
+            {
+                case value_kind::long_string:
+                {
+                    const string_type* s = val.template to_pointer<string_type>();
+                    init_string(s->data(), s->length(), val.tag(), s->get_allocator());
                     break;
-                case storage_kind::byte_string_value:
-                    construct_var<byte_string_storage>(val.cast<byte_string_storage>());
+                }
+                case value_kind::array:
+                    copy_container<array>(val);
                     break;
-                case storage_kind::object_value:
-                    construct_var<object_storage>(val.cast<object_storage>());
+                case value_kind::object:
+                    copy_container<object>(val);
                     break;
-                case storage_kind::array_value:
-                    construct_var<array_storage>(val.cast<array_storage>());
+                case value_kind::boxed:
+                    box(val.boxed()->alloc, val.boxed()->value);
                     break;
                 default:
+                    bits_ = val.bits_;
                     break;
             }
         }
 
-        void Init_(const variant& val, const Allocator& a)
+        void Init_(const compact_variant& val, const Allocator& alloc)
         {
-            switch (val.storage())
+            if (val.is_double())
             {
-            case storage_kind::null_value:
-            case storage_kind::empty_object_value:
-            case storage_kind::bool_value:
-            case storage_kind::int64_value:
-            case storage_kind::uint64_value:
-            case storage_kind::half_value:
-            case storage_kind::double_value:
-            case storage_kind::short_string_value:
-                Init_(val);
-                break;
-            case storage_kind::long_string_value:
-                construct_var<long_string_storage>(val.cast<long_string_storage>(),a);
-                break;
-            case storage_kind::byte_string_value:
-                construct_var<byte_string_storage>(val.cast<byte_string_storage>(),a);
-                break;
-            case storage_kind::array_value:
-                construct_var<array_storage>(val.cast<array_storage>(),a);
-                break;
-            case storage_kind::object_value:
-                construct_var<object_storage>(val.cast<object_storage>(),a);
-                break;
-            default:
-                break;
+                bits_ = val.bits_;
+                return;
             }
-        }
-
-        void Init_rv_(variant&& val) noexcept
-        {
-            switch (val.storage())
-            {
-                case storage_kind::null_value:
-                case storage_kind::empty_object_value:
-                case storage_kind::half_value:
-                case storage_kind::double_value:
-                case storage_kind::int64_value:
-                case storage_kind::uint64_value:
-                case storage_kind::bool_value:
-                case storage_kind::short_string_value:
-                    Init_(val);
-                    break;
-                case storage_kind::long_string_value:
-                case storage_kind::byte_string_value:
-                case storage_kind::array_value:
-                case storage_kind::object_value:
+            switch (val.kind())
+            {
+                case value_kind::long_string:
                 {
-                    construct_var<null_storage>();
-                    swap(val);
+                    const string_type* s = val.template to_pointer<string_type>();
+                    init_string(s->data(), s->length(), val.tag(), alloc);
                     break;
                 }
+                case value_kind::array:
+                    copy_container<array>(val, alloc);
+                    break;
+                case value_kind::object:
+                    copy_container<object>(val, alloc);
+                    break;
+                case value_kind::boxed:
+                    box(alloc, val.boxed()->value, alloc);
+                    break;
                 default:
-                    JSONCONS_UNREACHABLE();
+                    bits_ = val.bits_;
                     break;
             }
         }
 
-        void Init_rv_(variant&& val, const Allocator&, std::true_type) noexcept
+        template <class T>
+        void destroy_container() noexcept
         {
-            Init_rv_(std::forward<variant>(val));
+            release_node(to_pointer<node_type<T>>());
         }
 
-        void Init_rv_(variant&& val, const Allocator& a, std::false_type) noexcept
+        void Destroy_() noexcept
         {
-            switch (val.storage())
+            if (is_double())
             {
-                case storage_kind::null_value:
-                case storage_kind::empty_object_value:
-                case storage_kind::half_value:
-                case storage_kind::double_value:
-                case storage_kind::int64_value:
-                case storage_kind::uint64_value:
-                case storage_kind::bool_value:
-                case storage_kind::short_string_value:
-                    Init_(std::forward<variant>(val));
-                    break;
-                case storage_kind::long_string_value:
+                return;
+            }
+            switch (kind())
+            {
+                case value_kind::long_string:
                 {
-                    if (a == val.cast<long_string_storage>().get_allocator())
-                    {
-                        Init_rv_(std::forward<variant>(val), a, std::true_type());
-                    }
-                    else
-                    {
-                        Init_(val,a);
-                    }
+                    string_wrapper_type s(to_pointer<string_type>());
                     break;
                 }
-                case storage_kind::byte_string_value:
-                {
-                    if (a == val.cast<byte_string_storage>().get_allocator())
-                    {
-                        Init_rv_(std::forward<variant>(val), a, std::true_type());
-                    }
-                    else
-                    {
-                        Init_(val,a);
-                    }
+                case value_kind::array:
+                    destroy_container<array>();
                     break;
-                }
-                case storage_kind::object_value:
-                {
-                    if (a == val.cast<object_storage>().get_allocator())
-                    {
-                        Init_rv_(std::forward<variant>(val), a, std::true_type());
-                    }
-                    else
-                    {
-                        Init_(val,a);
-                    }
+                case value_kind::object:
+                    destroy_container<object>();
                     break;
-                }
-                case storage_kind::array_value:
+                case value_kind::boxed:
                 {
-                    if (a == val.cast<array_storage>().get_allocator())
-                    {
-                        Init_rv_(std::forward<variant>(val), a, std::true_type());
-                    }
-                    else
-                    {
-                        Init_(val,a);
-                    }
+                    boxed_value* ptr = boxed();
+                    destroy_node(allocator_type(ptr->alloc), ptr);
                     break;
                 }
-            default:
-                break;
+                default:
+                    break;
             }
         }
     };
 
+    using variant = typename std::conditional<jsoncons::detail::is_compact_values<ImplementationPolicy>::value,
+                                              compact_variant,
+                                              default_variant>::type;
+
     template <class ParentT>
     class proxy 
     {
@@ -2084,6 +3986,15 @@ public:
             return evaluate().is_array();
         }
 
+        bool is_typed_array() const noexcept
+        {
+            if (!parent_.contains(key_))
+            {
+                return false;
+            }
+            return evaluate().is_typed_array();
+        }
+
         bool is_int64() const noexcept
         {
             if (!parent_.contains(key_))
@@ -2130,6 +4041,11 @@ public:
             return evaluate().as_byte_string_view();
         }
 
+        typed_array_view as_typed_array_view() const 
+        {
+            return evaluate().as_typed_array_view();
+        }
+
         template <class SAllocator=std::allocator<char_type>>
         std::basic_string<char_type,char_traits_type,SAllocator> as_string() const 
         {
@@ -2277,6 +4193,12 @@ public:
             return evaluate().at(index);
         }
 
+        template <class T>
+        T at(std::size_t index) const
+        {
+            return evaluate().template at<T>(index);
+        }
+
         object_iterator find(const string_view_type& name)
         {
             return evaluate().find(name);
@@ -2990,15 +4912,73 @@ public:
 
     static basic_json parse(const string_view_type& s, const basic_json_decode_options<char_type>& options, std::function<bool(json_errc,const ser_context&)> err_handler)
     {
+        auto result = unicons::skip_bom(s.begin(), s.end());
+        if (result.ec != unicons::encoding_errc())
+        {
+            JSONCONS_THROW(ser_error(result.ec));
+        }
+        std::size_t offset = result.it - s.begin();
+
+        if (options.use_tape_parser())
+        {
+            json_decoder<basic_json> decoder;
+            basic_json_tape_parser<char_type> tape_parser(options,strict_json_parsing());
+            std::error_code ec;
+            tape_parser.parse(string_view_type(s.data()+offset,s.size()-offset), decoder, ec);
+            if (!ec && decoder.is_valid())
+            {
+                return decoder.get_result();
+            }
+            // The tape parser does not recover from errors, reparse to get the
+            // same error handler calls and error positions as basic_json_parser
+        }
+
         json_decoder<basic_json> decoder;
         basic_json_parser<char_type> parser(options,err_handler);
+        parser.update(s.data()+offset,s.size()-offset);
+        parser.parse_some(decoder);
+        parser.finish_parse(decoder);
+        parser.check_done();
+        if (!decoder.is_valid())
+        {
+            JSONCONS_THROW(json_runtime_error<std::runtime_error>("Failed to parse json string"));
+        }
+        return decoder.get_result();
+    }
+
+    // Parses into values allocated with alloc, e.g. an arena_allocator. The parse is sequential,
+    // options.use_tape_parser() is not used.
+
+    static basic_json parse(result_allocator_arg_t, const allocator_type& alloc,
+                            std::basic_istream<char_type>& is, 
+                            const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(), 
+                            std::function<bool(json_errc,const ser_context&)> err_handler = parse_error_handler_type())
+    {
+        json_decoder<basic_json> visitor(result_allocator_arg, alloc);
+        basic_json_reader<char_type,stream_source<char_type>> reader(is, visitor, options, err_handler);
+        reader.read_next();
+        reader.check_done();
+        if (!visitor.is_valid())
+        {
+            JSONCONS_THROW(json_runtime_error<std::runtime_error>("Failed to parse json stream"));
+        }
+        return visitor.get_result();
+    }
 
+    static basic_json parse(result_allocator_arg_t, const allocator_type& alloc,
+                            const string_view_type& s, 
+                            const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(), 
+                            std::function<bool(json_errc,const ser_context&)> err_handler = parse_error_handler_type())
+    {
         auto result = unicons::skip_bom(s.begin(), s.end());
         if (result.ec != unicons::encoding_errc())
         {
             JSONCONS_THROW(ser_error(result.ec));
         }
         std::size_t offset = result.it - s.begin();
+
+        json_decoder<basic_json> decoder(result_allocator_arg, alloc);
+        basic_json_parser<char_type> parser(options,err_handler);
         parser.update(s.data()+offset,s.size()-offset);
         parser.parse_some(decoder);
         parser.finish_parse(decoder);
@@ -3266,6 +5246,12 @@ public:
     {
     }
 
+    basic_json(double_text_arg_t, const string_view_type& text, 
+               semantic_tag tag = semantic_tag::none, const Allocator& alloc = Allocator())
+        : var_(double_text_arg, text.data(), text.length(), tag, alloc)
+    {
+    }
+
     basic_json(const char_type *s, std::size_t length, 
                semantic_tag tag, const Allocator& alloc)
         : var_(s, length, tag, alloc)
@@ -3286,6 +5272,13 @@ public:
     {
     }
 
+    basic_json(typed_array_arg_t, const typed_array_view& view, 
+               semantic_tag tag = semantic_tag::none,
+               const Allocator& alloc = Allocator())
+        : var_(typed_array_arg, view, tag, alloc)
+    {
+    }
+
     ~basic_json() noexcept
     {
     }
@@ -3351,6 +5344,15 @@ public:
         return !(lhs < rhs);
     }
 
+    // Values that compare equal have the same hash. Numbers are hashed by their value as a double,
+    // so an int64, uint64, half or double that equals another number hashes alike, and the members
+    // of an object are combined in any order. Tags are not hashed.
+    std::size_t hash_code() const
+    {
+        std::size_t count = 0;
+        return static_cast<std::size_t>(hash_value(count));
+    }
+
     std::size_t size() const noexcept
     {
         switch (var_.storage())
@@ -3361,6 +5363,8 @@ public:
             return object_value().size();
         case storage_kind::array_value:
             return array_value().size();
+        case storage_kind::typed_array_value:
+            return var_.template cast<typename variant::typed_array_storage>().size();
         default:
             return 0;
         }
@@ -3571,6 +5575,7 @@ public:
         switch (var_.storage())
         {
             case storage_kind::long_string_value:
+            case storage_kind::long_double_text_value:
             {
                 return var_.template cast<typename variant::long_string_storage>().get_allocator();
             }
@@ -3578,6 +5583,10 @@ public:
             {
                 return var_.template cast<typename variant::byte_string_storage>().get_allocator();
             }
+            case storage_kind::typed_array_value:
+            {
+                return var_.template cast<typename variant::typed_array_storage>().get_allocator();
+            }
             case storage_kind::array_value:
             {
                 return var_.template cast<typename variant::array_storage>().get_allocator();
@@ -3684,7 +5693,12 @@ public:
 
     bool is_array() const noexcept
     {
-        return var_.storage() == storage_kind::array_value;
+        return var_.storage() == storage_kind::array_value || var_.storage() == storage_kind::typed_array_value;
+    }
+
+    bool is_typed_array() const noexcept
+    {
+        return var_.storage() == storage_kind::typed_array_value;
     }
 
     bool is_int64() const noexcept
@@ -3704,7 +5718,7 @@ public:
 
     bool is_double() const noexcept
     {
-        return var_.storage() == storage_kind::double_value;
+        return var_.storage() == storage_kind::double_value || var_.is_double_text();
     }
 
     bool is_number() const noexcept
@@ -3715,6 +5729,8 @@ public:
             case storage_kind::uint64_value:
             case storage_kind::half_value:
             case storage_kind::double_value:
+            case storage_kind::short_double_text_value:
+            case storage_kind::long_double_text_value:
                 return true;
             case storage_kind::short_string_value:
             case storage_kind::long_string_value:
@@ -3739,6 +5755,8 @@ public:
                 return var_.template cast<typename variant::long_string_storage>().length() == 0;
             case storage_kind::array_value:
                 return array_value().size() == 0;
+            case storage_kind::typed_array_value:
+                return var_.template cast<typename variant::typed_array_storage>().size() == 0;
             case storage_kind::empty_object_value:
                 return true;
             case storage_kind::object_value:
@@ -3754,6 +5772,8 @@ public:
         {
         case storage_kind::array_value:
             return array_value().capacity();
+        case storage_kind::typed_array_value:
+            return var_.template cast<typename variant::typed_array_storage>().size();
         case storage_kind::object_value:
             return object_value().capacity();
         default:
@@ -3783,6 +5803,7 @@ public:
         {
             switch (var_.storage())
             {
+            case storage_kind::typed_array_value:
             case storage_kind::array_value:
                 array_value().reserve(n);
                 break;
@@ -3807,6 +5828,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().resize(n);
             break;
@@ -3820,6 +5842,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().resize(n, val);
             break;
@@ -3951,6 +5974,9 @@ public:
                 return static_cast<T>(var_.template cast<typename variant::half_storage>().value());
             case storage_kind::double_value:
                 return static_cast<T>(var_.template cast<typename variant::double_storage>().value());
+            case storage_kind::short_double_text_value:
+            case storage_kind::long_double_text_value:
+                return static_cast<T>(var_.double_text_value());
             case storage_kind::int64_value:
                 return static_cast<T>(var_.template cast<typename variant::int64_storage>().value());
             case storage_kind::uint64_value:
@@ -3977,6 +6003,9 @@ public:
                 return jsoncons::detail::decode_half(var_.template cast<typename variant::half_storage>().value());
             case storage_kind::double_value:
                 return var_.template cast<typename variant::double_storage>().value();
+            case storage_kind::short_double_text_value:
+            case storage_kind::long_double_text_value:
+                return var_.double_text_value();
             case storage_kind::int64_value:
                 return static_cast<double>(var_.template cast<typename variant::int64_storage>().value());
             case storage_kind::uint64_value:
@@ -3996,6 +6025,17 @@ public:
         return var_.as_byte_string_view();
     }
 
+    typed_array_view as_typed_array_view() const
+    {
+        switch (var_.storage())
+        {
+            case storage_kind::typed_array_value:
+                return var_.template cast<typename variant::typed_array_storage>().view();
+            default:
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a typed array"));
+        }
+    }
+
     template <typename BAllocator=std::allocator<uint8_t>>
     basic_byte_string<BAllocator> as_byte_string() const
     {
@@ -4042,6 +6082,7 @@ public:
                 }
                 return s;
             }
+            case storage_kind::typed_array_value:
             case storage_kind::array_value:
             {
                 string_type s(alloc);
@@ -4148,6 +6189,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             if (i >= array_value().size())
             {
@@ -4165,6 +6207,12 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
+            if (i >= var_.template cast<typename variant::typed_array_storage>().size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return var_.template cast<typename variant::typed_array_storage>().element(i);
         case storage_kind::array_value:
             if (i >= array_value().size())
             {
@@ -4178,6 +6226,23 @@ public:
         }
     }
 
+    // The element at i converted to T. The element of a typed array is read in place,
+    // without building the elements as basic_json values
+    template <class T>
+    T at(std::size_t i) const
+    {
+        if (var_.storage() == storage_kind::typed_array_value)
+        {
+            const auto& stor = var_.template cast<typename variant::typed_array_storage>();
+            if (i >= stor.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return stor.value_at(i).template as<T>();
+        }
+        return at(i).template as<T>();
+    }
+
     object_iterator find(const string_view_type& name)
     {
         switch (var_.storage())
@@ -4290,6 +6355,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().clear();
             break;
@@ -4335,6 +6401,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().erase(pos);
             break;
@@ -4348,6 +6415,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().erase(first, last);
             break;
@@ -4593,6 +6661,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return array_value().insert(pos, std::forward<T>(val));
             break;
@@ -4608,6 +6677,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return array_value().insert(pos, first, last);
             break;
@@ -4655,6 +6725,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return array_value().emplace(pos, std::forward<Args>(args)...);
             break;
@@ -4670,6 +6741,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return array_value().emplace_back(std::forward<Args>(args)...);
         default:
@@ -4704,12 +6776,15 @@ public:
             case storage_kind::half_value:
                 return json_type::half_value;
             case storage_kind::double_value:
+            case storage_kind::short_double_text_value:
+            case storage_kind::long_double_text_value:
                 return json_type::double_value;
             case storage_kind::short_string_value:
             case storage_kind::long_string_value:
                 return json_type::string_value;
             case storage_kind::byte_string_value:
                 return json_type::byte_string_value;
+            case storage_kind::typed_array_value:
             case storage_kind::array_value:
                 return json_type::array_value;
             case storage_kind::empty_object_value:
@@ -4736,6 +6811,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().push_back(std::forward<T>(val));
             break;
@@ -5334,6 +7410,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().remove_range(from_index, to_index);
             break;
@@ -5429,6 +7506,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return range<array_iterator>(array_value().begin(),array_value().end());
         default:
@@ -5440,6 +7518,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return range<const_array_iterator>(array_value().begin(),array_value().end());
         default:
@@ -5453,6 +7532,12 @@ public:
         {
         case storage_kind::array_value:
             return var_.template cast<typename variant::array_storage>().value();
+        case storage_kind::typed_array_value:
+        {
+            // A typed array accessed through a non-const path becomes an ordinary array
+            var_ = variant(var_.template cast<typename variant::typed_array_storage>().release_elements(), var_.tag());
+            return var_.template cast<typename variant::array_storage>().value();
+        }
         default:
             JSONCONS_THROW(json_runtime_error<std::domain_error>("Bad array cast"));
             break;
@@ -5465,6 +7550,8 @@ public:
         {
         case storage_kind::array_value:
             return var_.template cast<typename variant::array_storage>().value();
+        case storage_kind::typed_array_value:
+            return var_.template cast<typename variant::typed_array_storage>().elements();
         default:
             JSONCONS_THROW(json_runtime_error<std::domain_error>("Bad array cast"));
             break;
@@ -5503,6 +7590,182 @@ public:
 
 private:
 
+    struct hash_seed
+    {
+        static constexpr uint64_t null_value = 1;
+        static constexpr uint64_t bool_value = 2;
+        static constexpr uint64_t number_value = 3;
+        static constexpr uint64_t string_value = 4;
+        static constexpr uint64_t byte_string_value = 5;
+        static constexpr uint64_t array_value = 6;
+        static constexpr uint64_t object_value = 7;
+    };
+
+    // An array or object keeps its hash, with cached_hash_policy, if computing it visited
+    // at least this many values
+    static constexpr std::size_t min_cached_hash_count = 32;
+
+    static uint64_t hash_number(double val) noexcept
+    {
+        if (val == 0)
+        {
+            val = 0; // -0.0 equals 0.0
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &val, sizeof(bits));
+        return jsoncons::detail::hash_uint64(bits, hash_seed::number_value);
+    }
+
+    template <class T>
+    static uint64_t hash_numbers(uint64_t h, const span<const T>& s) noexcept
+    {
+        for (auto val : s)
+        {
+            h = jsoncons::detail::hash_combine(h, hash_number(static_cast<double>(val)));
+        }
+        return h;
+    }
+
+    static uint64_t hash_numbers(uint64_t h, half_arg_t, const span<const uint16_t>& s) noexcept
+    {
+        for (auto val : s)
+        {
+            h = jsoncons::detail::hash_combine(h, hash_number(jsoncons::detail::decode_half(val)));
+        }
+        return h;
+    }
+
+    static uint64_t hash_typed_array(const typed_array_view& view) noexcept
+    {
+        uint64_t h = hash_seed::array_value;
+        switch (view.type())
+        {
+            case typed_array_type::uint8_value:
+                h = hash_numbers(h, view.data(uint8_array_arg));
+                break;
+            case typed_array_type::uint16_value:
+                h = hash_numbers(h, view.data(uint16_array_arg));
+                break;
+            case typed_array_type::uint32_value:
+                h = hash_numbers(h, view.data(uint32_array_arg));
+                break;
+            case typed_array_type::uint64_value:
+                h = hash_numbers(h, view.data(uint64_array_arg));
+                break;
+            case typed_array_type::int8_value:
+                h = hash_numbers(h, view.data(int8_array_arg));
+                break;
+            case typed_array_type::int16_value:
+                h = hash_numbers(h, view.data(int16_array_arg));
+                break;
+            case typed_array_type::int32_value:
+                h = hash_numbers(h, view.data(int32_array_arg));
+                break;
+            case typed_array_type::int64_value:
+                h = hash_numbers(h, view.data(int64_array_arg));
+                break;
+            case typed_array_type::half_value:
+                h = hash_numbers(h, half_arg, view.data(half_array_arg));
+                break;
+            case typed_array_type::float_value:
+                h = hash_numbers(h, view.data(float_array_arg));
+                break;
+            case typed_array_type::double_value:
+                h = hash_numbers(h, view.data(double_array_arg));
+                break;
+            default:
+                break;
+        }
+        return jsoncons::detail::hash_avalanche(h + view.size());
+    }
+
+    // count is the number of values hashed so far
+    uint64_t hash_value(std::size_t& count) const
+    {
+        ++count;
+        switch (var_.storage())
+        {
+            case storage_kind::null_value:
+                return jsoncons::detail::hash_uint64(0, hash_seed::null_value);
+            case storage_kind::bool_value:
+                return jsoncons::detail::hash_uint64(var_.template cast<typename variant::bool_storage>().value() ? 1 : 0, hash_seed::bool_value);
+            case storage_kind::int64_value:
+                return hash_number(static_cast<double>(var_.template cast<typename variant::int64_storage>().value()));
+            case storage_kind::uint64_value:
+                return hash_number(static_cast<double>(var_.template cast<typename variant::uint64_storage>().value()));
+            case storage_kind::half_value:
+                return hash_number(jsoncons::detail::decode_half(var_.template cast<typename variant::half_storage>().value()));
+            case storage_kind::double_value:
+                return hash_number(var_.template cast<typename variant::double_storage>().value());
+            case storage_kind::short_double_text_value:
+            case storage_kind::long_double_text_value:
+                return hash_number(var_.double_text_value());
+            case storage_kind::short_string_value:
+            case storage_kind::long_string_value:
+            {
+                string_view_type sv = as_string_view();
+                return jsoncons::detail::hash_bytes(sv.data(), sv.length()*sizeof(char_type), hash_seed::string_value);
+            }
+            case storage_kind::byte_string_value:
+            {
+                const auto& stor = var_.template cast<typename variant::byte_string_storage>();
+                return jsoncons::detail::hash_bytes(stor.data(), stor.length(), hash_seed::byte_string_value);
+            }
+            case storage_kind::typed_array_value:
+                return hash_typed_array(var_.template cast<typename variant::typed_array_storage>().view());
+            case storage_kind::array_value:
+            {
+                const auto& stor = var_.template cast<typename variant::array_storage>();
+                uint64_t h = stor.cached_hash();
+                if (h != 0)
+                {
+                    return h;
+                }
+                std::size_t first = count;
+                h = hash_seed::array_value;
+                for (const auto& item : stor.value())
+                {
+                    h = jsoncons::detail::hash_combine(h, item.hash_value(count));
+                }
+                h = jsoncons::detail::hash_avalanche(h + stor.value().size());
+                if (count - first >= min_cached_hash_count)
+                {
+                    stor.cache_hash(h);
+                }
+                return h;
+            }
+            case storage_kind::empty_object_value:
+                return jsoncons::detail::hash_avalanche(hash_seed::object_value);
+            case storage_kind::object_value:
+            {
+                const auto& stor = var_.template cast<typename variant::object_storage>();
+                uint64_t h = stor.cached_hash();
+                if (h != 0)
+                {
+                    return h;
+                }
+                std::size_t first = count;
+                // The sum does not depend on the order of the members
+                h = hash_seed::object_value;
+                for (const auto& member : stor.value())
+                {
+                    uint64_t key_hash = jsoncons::detail::hash_bytes(member.key().data(), member.key().length()*sizeof(char_type), 
+                                                                     hash_seed::string_value);
+                    h += jsoncons::detail::hash_combine(key_hash, member.value().hash_value(count));
+                }
+                h = jsoncons::detail::hash_avalanche(h + stor.value().size());
+                if (count - first >= min_cached_hash_count)
+                {
+                    stor.cache_hash(h);
+                }
+                return h;
+            }
+            default:
+                JSONCONS_UNREACHABLE();
+                break;
+        }
+    }
+
     void dump_noflush(basic_json_visitor<char_type>& visitor, std::error_code& ec) const
     {
         const ser_context context{};
@@ -5523,6 +7786,10 @@ private:
                 visitor.double_value(var_.template cast<typename variant::double_storage>().value(), 
                                      var_.tag(), context, ec);
                 break;
+            case storage_kind::short_double_text_value:
+            case storage_kind::long_double_text_value:
+                visitor.double_text_value(var_.double_text(), var_.tag(), context, ec);
+                break;
             case storage_kind::int64_value:
                 visitor.int64_value(var_.template cast<typename variant::int64_storage>().value(), var_.tag(), context, ec);
                 break;
@@ -5568,6 +7835,50 @@ private:
                 }
                 break;
             }
+            case storage_kind::typed_array_value:
+            {
+                typed_array_view view = var_.template cast<typename variant::typed_array_storage>().view();
+                switch (view.type())
+                {
+                    case typed_array_type::uint8_value:
+                        visitor.typed_array(view.data(uint8_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::uint16_value:
+                        visitor.typed_array(view.data(uint16_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::uint32_value:
+                        visitor.typed_array(view.data(uint32_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::uint64_value:
+                        visitor.typed_array(view.data(uint64_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::int8_value:
+                        visitor.typed_array(view.data(int8_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::int16_value:
+                        visitor.typed_array(view.data(int16_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::int32_value:
+                        visitor.typed_array(view.data(int32_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::int64_value:
+                        visitor.typed_array(view.data(int64_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::half_value:
+                        visitor.typed_array(half_arg, view.data(half_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::float_value:
+                        visitor.typed_array(view.data(float_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::double_value:
+                        visitor.typed_array(view.data(double_array_arg), var_.tag(), context, ec);
+                        break;
+                    default:
+                        JSONCONS_UNREACHABLE();
+                        break;
+                }
+                break;
+            }
             default:
                 break;
         }
@@ -5605,6 +7916,10 @@ using wjson = basic_json<wchar_t,sorted_policy,std::allocator<char>>;
 using ojson = basic_json<char, preserve_order_policy, std::allocator<char>>;
 using wojson = basic_json<wchar_t, preserve_order_policy, std::allocator<char>>;
 
+// Values allocated from an arena, destroying them destroys the elements but skips the deallocations
+using arena_json = basic_json<char,sorted_policy,arena_allocator<char>>;
+using arena_ojson = basic_json<char,preserve_order_policy,arena_allocator<char>>;
+
 #if !defined(JSONCONS_NO_DEPRECATED)
 JSONCONS_DEPRECATED_MSG("Instead, use wojson") typedef basic_json<wchar_t, preserve_order_policy, std::allocator<wchar_t>> owjson;
 JSONCONS_DEPRECATED_MSG("Instead, use json_decoder<json>") typedef json_decoder<json> json_deserializer;
@@ -5651,4 +7966,15 @@ struct is_basic_json<basic_json<CharT,ImplementationPolicy,Allocator>> : std::tr
 
 } // namespace jsoncons
 
+namespace std {
+    template <class CharT, class ImplementationPolicy, class Allocator>
+    struct hash<jsoncons::basic_json<CharT,ImplementationPolicy,Allocator>>
+    {
+        std::size_t operator()(const jsoncons::basic_json<CharT,ImplementationPolicy,Allocator>& val) const
+        {
+            return val.hash_code();
+        }
+    };
+}
+
 #endif
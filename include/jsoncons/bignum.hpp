@@ -505,7 +505,7 @@ public:
                     for ( jA=0; jA < x.length(); jA++ )
                     {
                         jB = i - jA;
-                        if ( jB >= 0 && jB < y.length() )
+                        if ( jB < y.length() ) // jB wraps around when jA > i
                         {
                             DDproduct( x.data_[jA], y.data_[jB], hi, lo );
                             sumLo_old = sumLo;
@@ -553,7 +553,7 @@ public:
         if ( k )  // 0 < k < basic_type_bits:
         {
             uint64_t k1 = basic_type_bits - k;
-            uint64_t mask = (1 << k) - 1;
+            uint64_t mask = (uint64_t(1) << k) - 1;
             incr_length( length() + 1 );
             for (std::size_t i = length(); i-- > 0; )
             {
@@ -588,7 +588,7 @@ public:
 
         std::size_t n = (std::size_t)(length() - 1);
         int64_t k1 = basic_type_bits - k;
-        uint64_t mask = (1 << k) - 1;
+        uint64_t mask = (uint64_t(1) << k) - 1;
         for (std::size_t i = 0; i <= n; i++)
         {
             data_[i] >>= k;
@@ -18,7 +18,8 @@ namespace jsoncons {
         json_not_vector,
         json_not_array,
         json_not_map,
-        json_not_pair
+        json_not_pair,
+        json_not_typed_array
     };
 }
 
@@ -52,6 +53,8 @@ namespace detail {
                     return "json cannot be converted to map";
                 case convert_errc::json_not_pair:
                     return "json cannot be converted to std::pair";
+                case convert_errc::json_not_typed_array:
+                    return "json cannot be converted to a span over a typed array";
                 default:
                     return "Unknown conversion error";
             }
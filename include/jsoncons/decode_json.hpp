@@ -14,6 +14,7 @@
 #include <istream> // std::basic_istream
 #include <jsoncons/deser_traits.hpp>
 #include <jsoncons/json_cursor.hpp>
+#include <jsoncons/mmap_source.hpp>
 
 namespace jsoncons {
 
@@ -74,6 +75,38 @@ namespace jsoncons {
         return val;
     }
 
+    // From a file, which is memory mapped and parsed in one pass
+
+    template <class T>
+    typename std::enable_if<is_basic_json<T>::value,T>::type
+    decode_json(file_path_arg_t, const std::string& path,
+                const basic_json_decode_options<typename T::char_type>& options = basic_json_decode_options<typename T::char_type>())
+    {
+        using char_type = typename T::char_type;
+
+        jsoncons::json_decoder<T> decoder;
+        basic_json_reader<char_type, mmap_source<char_type>> reader(mmap_source<char_type>(path), decoder, options);
+        reader.read();
+        return decoder.get_result();
+    }
+
+    template <class T, class CharT = char>
+    typename std::enable_if<!is_basic_json<T>::value,T>::type
+    decode_json(file_path_arg_t, const std::string& path,
+                const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
+    {
+        basic_json_cursor<CharT,mmap_source<CharT>> cursor(mmap_source<CharT>(path), options, default_json_parsing());
+        json_decoder<basic_json<CharT>> decoder{};
+
+        std::error_code ec;
+        T val = deser_traits<T,CharT>::deserialize(cursor, decoder, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec, cursor.context().line(), cursor.context().column()));
+        }
+        return val;
+    }
+
     // With leading allocator parameter
 
     template <class T,class CharT,class TempAllocator>
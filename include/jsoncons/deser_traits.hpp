@@ -142,6 +142,64 @@ namespace jsoncons {
         }
     };
 
+    // std::shared_ptr, std::unique_ptr and jsoncons::optional, null reads as an empty one
+
+    template <class T, class CharT>
+    struct deser_traits<std::shared_ptr<T>,CharT,
+        typename std::enable_if<!is_json_type_traits_declared<std::shared_ptr<T>>::value &&
+                                !std::is_polymorphic<T>::value
+    >::type>
+    {
+        template <class Json,class TempAllocator>
+        static std::shared_ptr<T> deserialize(basic_staj_reader<CharT>& reader, 
+                                              json_decoder<Json,TempAllocator>& decoder, 
+                                              std::error_code& ec)
+        {
+            if (reader.current().event_type() == staj_event_type::null_value)
+            {
+                return std::shared_ptr<T>(nullptr);
+            }
+            return std::make_shared<T>(deser_traits<T,CharT>::deserialize(reader, decoder, ec));
+        }
+    };
+
+    template <class T, class CharT>
+    struct deser_traits<std::unique_ptr<T>,CharT,
+        typename std::enable_if<!is_json_type_traits_declared<std::unique_ptr<T>>::value &&
+                                !std::is_polymorphic<T>::value
+    >::type>
+    {
+        template <class Json,class TempAllocator>
+        static std::unique_ptr<T> deserialize(basic_staj_reader<CharT>& reader, 
+                                              json_decoder<Json,TempAllocator>& decoder, 
+                                              std::error_code& ec)
+        {
+            if (reader.current().event_type() == staj_event_type::null_value)
+            {
+                return std::unique_ptr<T>(nullptr);
+            }
+            return jsoncons::make_unique<T>(deser_traits<T,CharT>::deserialize(reader, decoder, ec));
+        }
+    };
+
+    template <class T, class CharT>
+    struct deser_traits<jsoncons::optional<T>,CharT,
+        typename std::enable_if<!is_json_type_traits_declared<jsoncons::optional<T>>::value
+    >::type>
+    {
+        template <class Json,class TempAllocator>
+        static jsoncons::optional<T> deserialize(basic_staj_reader<CharT>& reader, 
+                                                 json_decoder<Json,TempAllocator>& decoder, 
+                                                 std::error_code& ec)
+        {
+            if (reader.current().event_type() == staj_event_type::null_value)
+            {
+                return jsoncons::optional<T>();
+            }
+            return jsoncons::optional<T>(deser_traits<T,CharT>::deserialize(reader, decoder, ec));
+        }
+    };
+
     // vector like
     template <class T, class CharT>
     struct deser_traits<T,CharT,
@@ -0,0 +1,391 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_DECIMAL_TO_DOUBLE_HPP
+#define JSONCONS_DETAIL_DECIMAL_TO_DOUBLE_HPP
+
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <cmath> // std::nextafter, std::frexp, std::ldexp
+#include <limits> // std::numeric_limits
+#include <algorithm> // std::min
+#include <string>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/bignum.hpp>
+#include <jsoncons/detail/powers_of_five.hpp>
+
+namespace jsoncons { 
+namespace detail {
+
+    inline
+    int count_leading_zeros64(uint64_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(x);
+    #else
+        int n = 0;
+        while ((x & (uint64_t(1) << 63)) == 0)
+        {
+            x <<= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    inline
+    double make_double(uint64_t mantissa, int64_t biased_exponent, bool negative)
+    {
+        uint64_t bits = mantissa | (static_cast<uint64_t>(biased_exponent) << 52) | (static_cast<uint64_t>(negative) << 63);
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+
+    // Computes the double nearest to w * 10^q, ties to even, with the algorithm of Clinger 
+    // when w and 10^q are exact doubles, and otherwise with the algorithm of Eisel and Lemire.
+    // Returns false in the rare cases where the 128-bit approximation of 5^q is not precise
+    // enough to decide the rounding.
+
+    inline
+    bool eisel_lemire(uint64_t w, int64_t q, bool negative, double& d)
+    {
+        static const double exact_powers_of_ten[] = {1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+                                                     1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+        if (w == 0 || q < powers_of_five_128<>::smallest_power)
+        {
+            d = negative ? -0.0 : 0.0;
+            return true;
+        }
+        if (q > 308)
+        {
+            d = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+            return true;
+        }
+        if (q >= -22 && q <= 22 && w <= (uint64_t(1) << 53))
+        {
+            d = static_cast<double>(w);
+            d = q < 0 ? d / exact_powers_of_ten[-q] : d * exact_powers_of_ten[q];
+            d = negative ? -d : d;
+            return true;
+        }
+
+        std::size_t index = 2*static_cast<std::size_t>(q - powers_of_five_128<>::smallest_power);
+        int lz = count_leading_zeros64(w);
+        w <<= lz;
+        uint64_t lower;
+        uint64_t upper = full_multiplication(w, powers_of_five_128<>::values[index], lower);
+        if ((upper & 0x1ff) == 0x1ff)
+        {
+            uint64_t second_lower;
+            uint64_t second_upper = full_multiplication(w, powers_of_five_128<>::values[index + 1], second_lower);
+            lower += second_upper;
+            if (second_upper > lower)
+            {
+                ++upper;
+            }
+            if (lower == 0xffffffffffffffff)
+            {
+                return false;
+            }
+        }
+
+        uint64_t upperbit = upper >> 63;
+        uint64_t mantissa = upper >> (upperbit + 9);
+        lz += static_cast<int>(1 ^ upperbit);
+
+        // floor(q * log2(10)) + 63 - lz, biased
+        int64_t real_exponent = (((152170 + 65536) * q) >> 16) + 1024 + 63 - lz;
+        if (real_exponent <= 0) // subnormal
+        {
+            if (-real_exponent + 1 >= 64)
+            {
+                d = negative ? -0.0 : 0.0;
+                return true;
+            }
+            mantissa >>= -real_exponent + 1;
+            mantissa += (mantissa & 1);
+            mantissa >>= 1;
+            real_exponent = (mantissa < (uint64_t(1) << 52)) ? 0 : 1;
+            d = make_double(mantissa & ~(uint64_t(1) << 52), real_exponent, negative);
+            return true;
+        }
+
+        // Exactly halfway between two doubles, round to even
+        if (lower <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1)
+        {
+            if ((mantissa << (upperbit + 64 - 53 - 2)) == upper)
+            {
+                mantissa &= ~uint64_t(1);
+            }
+        }
+
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= (uint64_t(1) << 53))
+        {
+            mantissa = uint64_t(1) << 52;
+            ++real_exponent;
+        }
+        mantissa &= ~(uint64_t(1) << 52);
+        if (real_exponent > 2046)
+        {
+            d = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+            return true;
+        }
+        d = make_double(mantissa, real_exponent, negative);
+        return true;
+    }
+
+    // Compares digits * 10^exponent with the point halfway between the non-negative 
+    // finite double a and the next larger double, returns -1, 0 or 1
+
+    inline
+    int compare_with_halfway(const bignum& digits, int64_t exponent, double a)
+    {
+        // twice the halfway point is ma*2^ka + mb*2^kb
+        uint64_t ma;
+        int ka;
+        if (a == 0)
+        {
+            ma = 0;
+            ka = -1074;
+        }
+        else
+        {
+            int e;
+            double f = std::frexp(a, &e);
+            ma = static_cast<uint64_t>(std::ldexp(f, 53));
+            ka = e - 53;
+        }
+        uint64_t mb;
+        int kb;
+        if (a == (std::numeric_limits<double>::max)())
+        {
+            mb = uint64_t(1) << 53;
+            kb = 1024 - 53;
+        }
+        else
+        {
+            int e;
+            double f = std::frexp(std::nextafter(a, std::numeric_limits<double>::infinity()), &e);
+            mb = static_cast<uint64_t>(std::ldexp(f, 53));
+            kb = e - 53;
+        }
+        int kc = (std::min)(ka, kb);
+        bignum rhs = (ma << (ka - kc)) + (mb << (kb - kc));
+        bignum lhs = digits;
+        lhs *= uint64_t(2);
+
+        bignum power = 1;
+        for (int64_t n = exponent >= 0 ? exponent : -exponent; n > 0; n -= 19)
+        {
+            power *= n >= 19 ? uint64_t(10000000000000000000u) : static_cast<uint64_t>(std::pow(10.0, static_cast<double>(n)));
+        }
+        if (exponent >= 0)
+        {
+            lhs *= power;
+        }
+        else
+        {
+            rhs *= power;
+        }
+        if (kc >= 0)
+        {
+            rhs <<= static_cast<uint64_t>(kc);
+        }
+        else
+        {
+            lhs <<= static_cast<uint64_t>(-kc);
+        }
+        return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+    }
+
+    inline
+    bool rounds_above(const bignum& digits, int64_t exponent, double a)
+    {
+        int cmp = compare_with_halfway(digits, exponent, a);
+        if (cmp != 0)
+        {
+            return cmp > 0;
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &a, sizeof(bits));
+        return (bits & 1) != 0; // ties to even
+    }
+
+    // Correctly rounds digits * 10^exponent, starting from a candidate within a few ulps,
+    // by comparing with the halfway points between neighbouring doubles exactly
+
+    inline
+    double decimal_to_double_slow(const bignum& digits, int64_t exponent, double candidate)
+    {
+        const double max_value = (std::numeric_limits<double>::max)();
+        const double inf = std::numeric_limits<double>::infinity();
+
+        double z = candidate > max_value ? max_value : candidate;
+        while (rounds_above(digits, exponent, z))
+        {
+            if (z == max_value)
+            {
+                return inf;
+            }
+            z = std::nextafter(z, inf);
+        }
+        while (z > 0 && !rounds_above(digits, exponent, std::nextafter(z, 0.0)))
+        {
+            z = std::nextafter(z, 0.0);
+        }
+        return z;
+    }
+
+    // Converts a decimal number in the span [s, s+length) to the nearest double, ties to even,
+    // without regard to the current locale. The syntax is an optional sign, digits with an optional
+    // decimal point, and an optional exponent. Returns false if the span does not match it.
+
+    template <class CharT>
+    bool decimal_to_double(const CharT* s, std::size_t length, CharT decimal_point, double& result)
+    {
+        const CharT* p = s;
+        const CharT* last = s + length;
+
+        bool negative = false;
+        if (p < last && (*p == '-' || *p == '+'))
+        {
+            negative = *p == '-';
+            ++p;
+        }
+
+        const CharT* digits_begin = p;
+        uint64_t w = 0;
+        int64_t q = 0;
+        std::size_t significant_digits = 0;
+        std::size_t digit_count = 0;
+        bool truncated = false;
+
+        for (; p < last && *p >= '0' && *p <= '9'; ++p, ++digit_count)
+        {
+            if (significant_digits < 19)
+            {
+                w = 10*w + static_cast<uint64_t>(*p - '0');
+                if (w != 0)
+                {
+                    ++significant_digits;
+                }
+            }
+            else
+            {
+                ++q;
+                truncated = truncated || *p != '0';
+            }
+        }
+        const CharT* decimal_point_position = last;
+        int64_t fraction_digits = 0;
+        if (p < last && (*p == decimal_point || *p == '.'))
+        {
+            decimal_point_position = p;
+            ++p;
+            for (; p < last && *p >= '0' && *p <= '9'; ++p, ++digit_count, ++fraction_digits)
+            {
+                if (significant_digits < 19)
+                {
+                    w = 10*w + static_cast<uint64_t>(*p - '0');
+                    --q;
+                    if (w != 0)
+                    {
+                        ++significant_digits;
+                    }
+                }
+                else
+                {
+                    truncated = truncated || *p != '0';
+                }
+            }
+        }
+        if (digit_count == 0)
+        {
+            return false;
+        }
+        const CharT* digits_end = p;
+        int64_t explicit_exponent = 0;
+        if (p < last && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            bool negative_exponent = false;
+            if (p < last && (*p == '-' || *p == '+'))
+            {
+                negative_exponent = *p == '-';
+                ++p;
+            }
+            if (!(p < last && *p >= '0' && *p <= '9'))
+            {
+                return false;
+            }
+            int64_t e = 0;
+            for (; p < last && *p >= '0' && *p <= '9'; ++p)
+            {
+                if (e < 100000)
+                {
+                    e = 10*e + (*p - '0');
+                }
+            }
+            explicit_exponent = negative_exponent ? -e : e;
+            q += explicit_exponent;
+        }
+        if (p != last)
+        {
+            return false;
+        }
+
+        if (!truncated)
+        {
+            if (eisel_lemire(w, q, negative, result))
+            {
+                return true;
+            }
+        }
+        else
+        {
+            double lower;
+            double upper;
+            if (eisel_lemire(w, q, negative, lower) && eisel_lemire(w + 1, q, negative, upper) && lower == upper)
+            {
+                result = lower;
+                return true;
+            }
+        }
+
+        // Slow path: all the digits as a big integer, and a candidate within a few ulps
+        std::string digits;
+        digits.reserve(digit_count);
+        for (const CharT* it = digits_begin; it < digits_end; ++it)
+        {
+            if (it != decimal_point_position)
+            {
+                digits.push_back(static_cast<char>(*it));
+            }
+        }
+        int64_t exponent = explicit_exponent - fraction_digits;
+        if (exponent < 2*powers_of_five_128<>::smallest_power - static_cast<int64_t>(digit_count))
+        {
+            result = negative ? -0.0 : 0.0;
+            return true;
+        }
+
+        double candidate;
+        if (!eisel_lemire(w, q, false, candidate))
+        {
+            candidate = static_cast<double>(w) * std::pow(10.0, static_cast<double>(q/2)) * std::pow(10.0, static_cast<double>(q - q/2));
+        }
+        result = decimal_to_double_slow(bignum(digits.data(), digits.size()), exponent, candidate);
+        result = negative ? -result : result;
+        return true;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
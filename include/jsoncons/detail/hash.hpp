@@ -0,0 +1,145 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_HASH_HPP
+#define JSONCONS_DETAIL_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+
+namespace jsoncons {
+namespace detail {
+
+    // 64 bit hashing with the rounds and constants of XXH64. The results depend on
+    // the byte order of the platform, and are not meant to be stored.
+
+    struct hash_primes
+    {
+        static constexpr uint64_t p1 = 11400714785074694791ull;
+        static constexpr uint64_t p2 = 14029467366897019727ull;
+        static constexpr uint64_t p3 = 1609587929392839161ull;
+        static constexpr uint64_t p4 = 9650029242287828579ull;
+        static constexpr uint64_t p5 = 2870177450012600261ull;
+    };
+
+    inline uint64_t hash_rotl(uint64_t x, int r) noexcept
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    inline uint64_t hash_read64(const unsigned char* p) noexcept
+    {
+        uint64_t val;
+        std::memcpy(&val, p, sizeof(val));
+        return val;
+    }
+
+    inline uint64_t hash_read32(const unsigned char* p) noexcept
+    {
+        uint32_t val;
+        std::memcpy(&val, p, sizeof(val));
+        return val;
+    }
+
+    inline uint64_t hash_round(uint64_t acc, uint64_t input) noexcept
+    {
+        acc += input * hash_primes::p2;
+        acc = hash_rotl(acc, 31);
+        return acc * hash_primes::p1;
+    }
+
+    inline uint64_t hash_merge_round(uint64_t acc, uint64_t val) noexcept
+    {
+        acc ^= hash_round(0, val);
+        return acc * hash_primes::p1 + hash_primes::p4;
+    }
+
+    inline uint64_t hash_avalanche(uint64_t h) noexcept
+    {
+        h ^= h >> 33;
+        h *= hash_primes::p2;
+        h ^= h >> 29;
+        h *= hash_primes::p3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    inline uint64_t hash_bytes(const void* data, std::size_t length, uint64_t seed) noexcept
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        const unsigned char* last = p + length;
+        uint64_t h;
+
+        if (length >= 32)
+        {
+            uint64_t v1 = seed + hash_primes::p1 + hash_primes::p2;
+            uint64_t v2 = seed + hash_primes::p2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - hash_primes::p1;
+            const unsigned char* limit = last - 32;
+            do
+            {
+                v1 = hash_round(v1, hash_read64(p));
+                v2 = hash_round(v2, hash_read64(p + 8));
+                v3 = hash_round(v3, hash_read64(p + 16));
+                v4 = hash_round(v4, hash_read64(p + 24));
+                p += 32;
+            }
+            while (p <= limit);
+
+            h = hash_rotl(v1, 1) + hash_rotl(v2, 7) + hash_rotl(v3, 12) + hash_rotl(v4, 18);
+            h = hash_merge_round(h, v1);
+            h = hash_merge_round(h, v2);
+            h = hash_merge_round(h, v3);
+            h = hash_merge_round(h, v4);
+        }
+        else
+        {
+            h = seed + hash_primes::p5;
+        }
+
+        h += static_cast<uint64_t>(length);
+
+        for (; p + 8 <= last; p += 8)
+        {
+            h ^= hash_round(0, hash_read64(p));
+            h = hash_rotl(h, 27) * hash_primes::p1 + hash_primes::p4;
+        }
+        if (p + 4 <= last)
+        {
+            h ^= hash_read32(p) * hash_primes::p1;
+            h = hash_rotl(h, 23) * hash_primes::p2 + hash_primes::p3;
+            p += 4;
+        }
+        for (; p < last; ++p)
+        {
+            h ^= (*p) * hash_primes::p5;
+            h = hash_rotl(h, 11) * hash_primes::p1;
+        }
+        return hash_avalanche(h);
+    }
+
+    // Hashes a 64 bit value
+    inline uint64_t hash_uint64(uint64_t val, uint64_t seed) noexcept
+    {
+        uint64_t h = seed + hash_primes::p5 + sizeof(uint64_t);
+        h ^= hash_round(0, val);
+        h = hash_rotl(h, 27) * hash_primes::p1 + hash_primes::p4;
+        return hash_avalanche(h);
+    }
+
+    // Adds a value to a hash of a sequence, the order of the values matters
+    inline uint64_t hash_combine(uint64_t h, uint64_t val) noexcept
+    {
+        h ^= hash_round(0, val);
+        return hash_rotl(h, 27) * hash_primes::p1 + hash_primes::p4;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,310 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_HASH_INDEX_HPP
+#define JSONCONS_DETAIL_HASH_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator_traits
+#include <type_traits> // std::make_unsigned
+#include <utility> // std::move, std::swap
+#include <vector>
+
+namespace jsoncons {
+namespace detail {
+
+    // FNV-1a over the code units of a key
+
+    template <class CharT>
+    std::size_t hash_chars(const CharT* s, std::size_t length) noexcept
+    {
+        using unsigned_type = typename std::make_unsigned<CharT>::type;
+
+        uint64_t h = 14695981039346656037ull;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            h ^= static_cast<uint64_t>(static_cast<unsigned_type>(s[i]));
+            h *= 1099511628211ull;
+        }
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
+    // An open addressing hash table, with linear probing, that maps the hash of a key
+    // to the position of its member in a separate container. The table does not hold
+    // the keys, so lookups are passed a function that compares the key at a position.
+    // The hashes are kept, so that the table can grow without rehashing the keys.
+
+    template <class Allocator>
+    class hash_index
+    {
+    public:
+        static constexpr std::size_t npos = (std::numeric_limits<std::size_t>::max)();
+    private:
+        struct slot
+        {
+            std::size_t hash;
+            std::size_t pos; // npos if empty
+        };
+        using slot_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<slot>;
+        using slot_container_type = std::vector<slot,slot_allocator_type>;
+
+        static constexpr std::size_t min_capacity = 16;
+
+        slot_container_type slots_;
+        std::size_t size_;
+    public:
+        hash_index()
+            : size_(0)
+        {
+        }
+
+        explicit hash_index(const Allocator& alloc)
+            : slots_(slot_allocator_type(alloc)), size_(0)
+        {
+        }
+
+        hash_index(const hash_index& other) = default;
+
+        hash_index(const hash_index& other, const Allocator& alloc)
+            : slots_(other.slots_, slot_allocator_type(alloc)), size_(other.size_)
+        {
+        }
+
+        hash_index(hash_index&& other) noexcept
+            : slots_(std::move(other.slots_)), size_(other.size_)
+        {
+            other.size_ = 0;
+        }
+
+        hash_index(hash_index&& other, const Allocator& alloc)
+            : slots_(std::move(other.slots_), slot_allocator_type(alloc)), size_(other.size_)
+        {
+            other.slots_.clear();
+            other.size_ = 0;
+        }
+
+        hash_index& operator=(const hash_index&) = default;
+
+        hash_index& operator=(hash_index&& other) noexcept
+        {
+            slots_.swap(other.slots_);
+            std::swap(size_, other.size_);
+            return *this;
+        }
+
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        void swap(hash_index& other) noexcept
+        {
+            slots_.swap(other.slots_);
+            std::swap(size_, other.size_);
+        }
+
+        // Removes all entries, keeping the table
+
+        void clear() noexcept
+        {
+            for (auto& s : slots_)
+            {
+                s.pos = npos;
+            }
+            size_ = 0;
+        }
+
+        // Makes room for n entries
+
+        void reserve(std::size_t n)
+        {
+            std::size_t capacity = capacity_for(n);
+            if (capacity > slots_.size())
+            {
+                rehash(capacity);
+            }
+        }
+
+        void shrink_to_fit()
+        {
+            if (size_ == 0)
+            {
+                slot_container_type empty(slots_.get_allocator());
+                slots_.swap(empty);
+            }
+            else
+            {
+                std::size_t capacity = capacity_for(size_);
+                if (capacity < slots_.size())
+                {
+                    rehash(capacity);
+                }
+            }
+        }
+
+        // Returns the position of the entry with this hash for which equal(pos) is true, or npos
+
+        template <class Equal>
+        std::size_t find(std::size_t hash, Equal equal) const
+        {
+            if (size_ == 0)
+            {
+                return npos;
+            }
+            const std::size_t mask = slots_.size() - 1;
+            for (std::size_t i = hash & mask; ; i = (i + 1) & mask)
+            {
+                const slot& s = slots_[i];
+                if (s.pos == npos)
+                {
+                    return npos;
+                }
+                if (s.hash == hash && equal(s.pos))
+                {
+                    return s.pos;
+                }
+            }
+        }
+
+        // Adds an entry for a key that is not in the index
+
+        void insert(std::size_t hash, std::size_t pos)
+        {
+            // Maximum load factor of 3/4
+            if ((size_ + 1)*4 > slots_.size()*3)
+            {
+                rehash(capacity_for(size_ + 1));
+            }
+            place(hash, pos);
+            ++size_;
+        }
+
+        // Removes the entry for the member at pos, whose key has this hash
+
+        void erase(std::size_t hash, std::size_t pos)
+        {
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t i = locate(hash, pos);
+            // Shift back the entries that follow in the same cluster, so that
+            // no probe sequence is broken by the empty slot
+            std::size_t j = i;
+            while (true)
+            {
+                j = (j + 1) & mask;
+                if (slots_[j].pos == npos)
+                {
+                    break;
+                }
+                std::size_t k = slots_[j].hash & mask;
+                bool movable = i <= j ? (k <= i || k > j) : (k <= i && k > j);
+                if (movable)
+                {
+                    slots_[i] = slots_[j];
+                    i = j;
+                }
+            }
+            slots_[i].pos = npos;
+            --size_;
+        }
+
+        // Records that the member at old_pos, whose key has this hash, has moved to new_pos
+
+        void replace(std::size_t hash, std::size_t old_pos, std::size_t new_pos)
+        {
+            slots_[locate(hash, old_pos)].pos = new_pos;
+        }
+
+        // Records that n members have been inserted before the member at first
+
+        void increment_positions(std::size_t first, std::size_t n) noexcept
+        {
+            for (auto& s : slots_)
+            {
+                if (s.pos != npos && s.pos >= first)
+                {
+                    s.pos += n;
+                }
+            }
+        }
+
+        // Records that the n members before the member at first have been erased
+
+        void decrement_positions(std::size_t first, std::size_t n) noexcept
+        {
+            for (auto& s : slots_)
+            {
+                if (s.pos != npos && s.pos >= first)
+                {
+                    s.pos -= n;
+                }
+            }
+        }
+
+    private:
+        static std::size_t capacity_for(std::size_t n)
+        {
+            std::size_t capacity = min_capacity;
+            while (capacity*3 < n*4)
+            {
+                capacity *= 2;
+            }
+            return capacity;
+        }
+
+        std::size_t locate(std::size_t hash, std::size_t pos) const
+        {
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t i = hash & mask;
+            while (slots_[i].pos != pos)
+            {
+                i = (i + 1) & mask;
+            }
+            return i;
+        }
+
+        void place(std::size_t hash, std::size_t pos)
+        {
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t i = hash & mask;
+            while (slots_[i].pos != npos)
+            {
+                i = (i + 1) & mask;
+            }
+            slots_[i].hash = hash;
+            slots_[i].pos = pos;
+        }
+
+        void rehash(std::size_t capacity)
+        {
+            slot_container_type slots(capacity, slot{0,npos}, slots_.get_allocator());
+            slots_.swap(slots);
+            for (const auto& s : slots)
+            {
+                if (s.pos != npos)
+                {
+                    place(s.hash, s.pos);
+                }
+            }
+        }
+    };
+
+    template <class Allocator>
+    constexpr std::size_t hash_index<Allocator>::npos;
+
+    template <class Allocator>
+    constexpr std::size_t hash_index<Allocator>::min_capacity;
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
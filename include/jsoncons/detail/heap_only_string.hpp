@@ -14,6 +14,7 @@
 #include <cstring> // std::memcpy
 #include <memory> // std::allocator
 #include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/detail/storage_node.hpp>
 
 namespace jsoncons { namespace detail {
 
@@ -125,6 +126,8 @@ class heap_only_string_wrapper
 
     string_pointer ptr_;
 public:
+    using pointer = string_pointer;
+
     heap_only_string_wrapper() = default;
 
     heap_only_string_wrapper(string_pointer ptr)
@@ -160,6 +163,14 @@ public:
         std::swap(ptr_,other.ptr_);
     }
 
+    // Gives up ownership of the string, it can be given back to a wrapper constructed from the pointer
+    pointer release() noexcept
+    {
+        pointer ptr = ptr_;
+        ptr_ = nullptr;
+        return ptr;
+    }
+
     const char_type* data() const
     {
         return ptr_->data();
@@ -219,6 +230,101 @@ private:
 };
 
 
+
+// A heap_only_string_wrapper whose copies share the string, through a reference counted node
+
+template <class CharT,class Allocator>
+class shared_heap_only_string_wrapper
+{
+    using char_type = CharT;
+    using wrapper_type = heap_only_string_wrapper<CharT,Allocator>;
+    using node_type = storage_node<wrapper_type,true>;
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<node_type> node_allocator_type;  
+    using node_pointer = typename std::allocator_traits<node_allocator_type>::pointer;
+
+    node_pointer ptr_;
+public:
+    shared_heap_only_string_wrapper(std::nullptr_t)
+        : ptr_(nullptr)
+    {
+    }
+
+    shared_heap_only_string_wrapper(const char_type* data, std::size_t length, const Allocator& a) 
+        : ptr_(create(data, length, a))
+    {
+    }
+
+    shared_heap_only_string_wrapper(const shared_heap_only_string_wrapper& val) 
+        : ptr_(val.ptr_)
+    {
+        ptr_->add_ref();
+    }
+
+    shared_heap_only_string_wrapper(const shared_heap_only_string_wrapper& val, const Allocator& a) 
+    {
+        if (a == val.get_allocator())
+        {
+            ptr_ = val.ptr_;
+            ptr_->add_ref();
+        }
+        else
+        {
+            ptr_ = create(val.data(), val.length(), a);
+        }
+    }
+
+    ~shared_heap_only_string_wrapper() noexcept
+    {
+        if (ptr_ != nullptr && ptr_->release())
+        {
+            node_allocator_type alloc(ptr_->value.get_allocator());
+            std::allocator_traits<node_allocator_type>::destroy(alloc, to_plain_pointer(ptr_));
+            std::allocator_traits<node_allocator_type>::deallocate(alloc, ptr_, 1);
+        }
+    }
+
+    void swap(shared_heap_only_string_wrapper& other) noexcept
+    {
+        std::swap(ptr_,other.ptr_);
+    }
+
+    const char_type* data() const
+    {
+        return ptr_->value.data();
+    }
+
+    const char_type* c_str() const
+    {
+        return ptr_->value.c_str();
+    }
+
+    std::size_t length() const
+    {
+        return ptr_->value.length();
+    }
+
+    Allocator get_allocator() const
+    {
+        return ptr_->value.get_allocator();
+    }
+private:
+    static node_pointer create(const char_type* data, std::size_t length, const Allocator& a)
+    {
+        node_allocator_type alloc(a);
+        node_pointer ptr = std::allocator_traits<node_allocator_type>::allocate(alloc, 1);
+        JSONCONS_TRY
+        {
+            std::allocator_traits<node_allocator_type>::construct(alloc, to_plain_pointer(ptr), data, length, a);
+        }
+        JSONCONS_CATCH(...)
+        {
+            std::allocator_traits<node_allocator_type>::deallocate(alloc, ptr, 1);
+            JSONCONS_RETHROW;
+        }
+        return ptr;
+    }
+};
+
 }}
 
 #endif
@@ -0,0 +1,171 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_ORDERED_TASK_POOL_HPP
+#define JSONCONS_DETAIL_ORDERED_TASK_POOL_HPP
+
+#include <cstddef>
+#include <deque>
+#include <exception> // std::exception_ptr
+#include <functional> // std::function
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // Runs tasks on a fixed pool of worker threads and hands their results back
+    // in the order the tasks were submitted. Each worker thread obtains its own
+    // worker function from the factory, so per-thread state (a parser, a decoder)
+    // can live in the function object and be reused from task to task.
+    //
+    // The pool does not limit the number of pending tasks, callers apply back-pressure
+    // by checking pending() before submitting more.
+
+    template <class Task,class Result>
+    class ordered_task_pool
+    {
+    public:
+        using worker_function = std::function<void(Task&,Result&)>;
+        using worker_factory = std::function<worker_function()>;
+    private:
+        struct slot
+        {
+            Task task;
+            Result result;
+            bool done;
+            std::exception_ptr exception;
+
+            slot(Task&& t)
+                : task(std::move(t)), result(), done(false)
+            {
+            }
+        };
+
+        std::mutex mutex_;
+        std::condition_variable task_available_;
+        std::condition_variable result_available_;
+        // Tasks not yet taken, oldest first. Elements of a deque are not relocated
+        // by push_back or pop_front, so workers can fill in a slot without holding the lock.
+        std::deque<slot> slots_;
+        std::size_t started_; // number of tasks in slots_ handed to a worker
+        bool stop_;
+        std::vector<std::thread> threads_;
+
+        // Noncopyable and nonmoveable
+        ordered_task_pool(const ordered_task_pool&) = delete;
+        ordered_task_pool& operator=(const ordered_task_pool&) = delete;
+    public:
+        ordered_task_pool(std::size_t num_threads, worker_factory factory)
+            : started_(0), stop_(false)
+        {
+            if (num_threads == 0)
+            {
+                num_threads = 1;
+            }
+            threads_.reserve(num_threads);
+            for (std::size_t i = 0; i < num_threads; ++i)
+            {
+                threads_.emplace_back([this,factory]() {run(factory());});
+            }
+        }
+
+        ~ordered_task_pool() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            task_available_.notify_all();
+            for (auto& t : threads_)
+            {
+                t.join();
+            }
+        }
+
+        std::size_t num_threads() const
+        {
+            return threads_.size();
+        }
+
+        // Number of submitted tasks whose results have not yet been taken
+
+        std::size_t pending()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return slots_.size();
+        }
+
+        void submit(Task&& task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                slots_.emplace_back(std::move(task));
+            }
+            task_available_.notify_one();
+        }
+
+        // Waits for the oldest pending task to finish and returns its result.
+        // If the worker function threw, the exception is rethrown here.
+        // Requires pending() > 0.
+
+        Result take()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            result_available_.wait(lock, [this]() {return slots_.front().done;});
+
+            std::exception_ptr e = slots_.front().exception;
+            Result result = std::move(slots_.front().result);
+            slots_.pop_front();
+            --started_;
+            lock.unlock();
+
+            if (e)
+            {
+                std::rethrow_exception(e);
+            }
+            return result;
+        }
+
+    private:
+        void run(worker_function work)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                task_available_.wait(lock, [this]() {return stop_ || started_ < slots_.size();});
+                if (stop_)
+                {
+                    return;
+                }
+                slot& s = slots_[started_++];
+                lock.unlock();
+
+                JSONCONS_TRY
+                {
+                    work(s.task, s.result);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    s.exception = std::current_exception();
+                }
+                s.task = Task();
+
+                lock.lock();
+                s.done = true;
+                result_available_.notify_all();
+            }
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
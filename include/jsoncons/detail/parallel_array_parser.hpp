@@ -0,0 +1,256 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_PARALLEL_ARRAY_PARSER_HPP
+#define JSONCONS_DETAIL_PARALLEL_ARRAY_PARSER_HPP
+
+#include <algorithm> // std::lower_bound
+#include <atomic>
+#include <cstddef>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // Finds the elements of the top level array that starts at first. On success, element i
+    // is the text from offsets[i] up to offsets[i+1]-1 (the offset following a comma or the
+    // opening bracket, up to the comma or the closing bracket), and end points past the closing
+    // bracket. Strings are skipped with their escapes, so brackets and commas inside them are
+    // not counted. Returns false if the brackets do not balance or nest deeper than max_depth,
+    // leaving the diagnosis to the parser.
+
+    template <class CharT>
+    bool find_array_elements(const CharT* first, const CharT* last, int max_depth,
+                             std::vector<std::size_t>& offsets, const CharT*& end)
+    {
+        if (first == last || *first != '[' || max_depth < 1)
+        {
+            return false;
+        }
+        const CharT* p = first + 1;
+        offsets.push_back(p - first);
+        int depth = 1;
+        while (p < last)
+        {
+            switch (*p)
+            {
+                case '\"':
+                    ++p;
+                    while (true)
+                    {
+                        p = find_string_special(p, last);
+                        if (p == last)
+                        {
+                            return false;
+                        }
+                        if (*p == '\"')
+                        {
+                            ++p;
+                            break;
+                        }
+                        if (*p == '\\')
+                        {
+                            if (last - p < 2)
+                            {
+                                return false;
+                            }
+                            p += 2;
+                        }
+                        else
+                        {
+                            ++p; // a control character, which the parser will reject
+                        }
+                    }
+                    break;
+                case '[':
+                case '{':
+                    if (++depth > max_depth)
+                    {
+                        return false;
+                    }
+                    ++p;
+                    break;
+                case ']':
+                case '}':
+                    if (--depth == 0)
+                    {
+                        if (*p != ']')
+                        {
+                            return false;
+                        }
+                        ++p;
+                        offsets.push_back(p - first);
+                        end = p;
+                        return true;
+                    }
+                    ++p;
+                    break;
+                case ',':
+                    ++p;
+                    if (depth == 1)
+                    {
+                        offsets.push_back(p - first);
+                    }
+                    break;
+                default:
+                    ++p;
+                    break;
+            }
+        }
+        return false;
+    }
+
+    // Parses a top level array, optionally preceded by a byte order mark, by splitting it into its elements and parsing those on
+    // num_threads threads, the calling thread being one of them. Each element is decoded
+    // straight into its slot in the result, so nothing is copied or moved afterwards.
+    //
+    // Returns false, leaving result unspecified, if the text is not an array, if it is too
+    // short to give each thread at least min_segment_length characters, or if anything fails
+    // to parse. The caller then parses sequentially, which gives the same errors, positions
+    // and error handler calls as if the parallel parse had never been tried.
+
+    template <class Json>
+    bool parse_array_in_parallel(const typename Json::char_type* data, std::size_t length,
+                                 const basic_json_decode_options<typename Json::char_type>& options,
+                                 std::size_t num_threads,
+                                 Json& result,
+                                 std::size_t min_segment_length = 64*1024)
+    {
+        using char_type = typename Json::char_type;
+
+        if (num_threads == 0)
+        {
+            num_threads = std::thread::hardware_concurrency();
+        }
+        num_threads = (std::min)(num_threads, length / (min_segment_length != 0 ? min_segment_length : 1));
+        if (num_threads < 2)
+        {
+            return false;
+        }
+
+        const char_type* last = data + length;
+        auto bom = unicons::skip_bom(data, last);
+        if (bom.ec != unicons::encoding_errc())
+        {
+            return false;
+        }
+        const char_type* first = bom.it;
+        while (first < last && (*first == ' ' || *first == '\t' || *first == '\n' || *first == '\r'))
+        {
+            ++first;
+        }
+        std::vector<std::size_t> offsets;
+        const char_type* end;
+        if (!find_array_elements(first, last, options.max_nesting_depth(), offsets, end))
+        {
+            return false;
+        }
+        for (const char_type* p = end; p < last; ++p)
+        {
+            if (!(*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+            {
+                return false;
+            }
+        }
+        const std::size_t count = offsets.size() - 1;
+        if (count < 2)
+        {
+            return false;
+        }
+
+        // Several segments per thread, balanced by length, so that a thread that
+        // finishes early can take another
+        const std::size_t num_segments = (std::min)(count, 4*num_threads);
+        std::vector<std::size_t> segment_first(num_segments + 1);
+        const std::size_t text_length = end - first;
+        for (std::size_t k = 0; k < num_segments; ++k)
+        {
+            std::size_t offset = text_length / num_segments * k;
+            segment_first[k] = std::lower_bound(offsets.begin(), offsets.end() - 1, offset) - offsets.begin();
+        }
+        segment_first[num_segments] = count;
+
+        Json value(json_array_arg);
+        value.resize(count);
+        auto& elements = value.array_value();
+
+        std::atomic<std::size_t> next_segment(0);
+        std::atomic<bool> failed(false);
+
+        auto work = [&]()
+        {
+            JSONCONS_TRY
+            {
+                json_decoder<Json> decoder;
+                basic_json_parser<char_type> parser(options, strict_json_parsing());
+                std::size_t k;
+                while (!failed.load(std::memory_order_relaxed) && (k = next_segment++) < num_segments)
+                {
+                    for (std::size_t i = segment_first[k]; i < segment_first[k+1]; ++i)
+                    {
+                        std::error_code ec;
+                        parser.reset();
+                        parser.update(first + offsets[i], offsets[i+1] - 1 - offsets[i]);
+                        parser.finish_parse(decoder, ec);
+                        if (!ec)
+                        {
+                            parser.check_done(ec);
+                        }
+                        if (ec || !decoder.is_valid())
+                        {
+                            failed = true;
+                            return;
+                        }
+                        elements[i] = decoder.get_result();
+                    }
+                }
+            }
+            JSONCONS_CATCH(...)
+            {
+                failed = true;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        JSONCONS_TRY
+        {
+            threads.reserve(num_threads - 1);
+            for (std::size_t i = 1; i < num_threads; ++i)
+            {
+                threads.emplace_back(work);
+            }
+        }
+        JSONCONS_CATCH(...)
+        {
+            // Threads are unavailable, fall back to the sequential parser
+            failed = true;
+        }
+        work();
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        if (failed)
+        {
+            return false;
+        }
+        result.swap(value);
+        return true;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -16,6 +16,7 @@
 #include <type_traits> // std::enable_if
 #include <exception>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/decimal_to_double.hpp>
 #include <cctype>
 
 namespace jsoncons { namespace detail {
@@ -964,8 +965,13 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>('.'), result))
+        {
+            return result;
+        }
         CharT *end = nullptr;
         double val = _strtod_l(s, &end, locale_);
         if (s == end)
@@ -977,8 +983,13 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>('.'), result))
+        {
+            return result;
+        }
         CharT *end = nullptr;
         double val = _wcstod_l(s, &end, locale_);
         if (s == end)
@@ -1018,6 +1029,11 @@ public:
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
     operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>('.'), result))
+        {
+            return result;
+        }
         char *end = nullptr;
         double val = strtold_l(s, &end, locale_);
         if (s == end)
@@ -1031,6 +1047,11 @@ public:
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
     operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>('.'), result))
+        {
+            return result;
+        }
         CharT *end = nullptr;
         double val = wcstold_l(s, &end, locale_);
         if (s == end)
@@ -1075,8 +1096,13 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>(decimal_point_), result))
+        {
+            return result;
+        }
         CharT *end = nullptr;
         double val = strtod(s, &end);
         if (s == end)
@@ -1088,8 +1114,13 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>(decimal_point_), result))
+        {
+            return result;
+        }
         CharT *end = nullptr;
         double val = wcstod(s, &end);
         if (s == end)
@@ -0,0 +1,113 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_PERFECT_HASH_HPP
+#define JSONCONS_DETAIL_PERFECT_HASH_HPP
+
+#include <algorithm> // std::fill
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string> // std::char_traits
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/hash.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // Maps each of a fixed set of distinct names to its position in the set. The seed and
+    // the size of the table are chosen so that no two names share a slot, a lookup takes
+    // one hash, and one comparison with the name in the slot.
+
+    template <class CharT>
+    class perfect_hash_index
+    {
+        std::vector<const CharT*> names_;
+        std::vector<std::size_t> lengths_;
+        std::vector<uint8_t> slots_; // The position of the name in the slot plus one, or zero
+        std::size_t mask_;
+        uint64_t seed_;
+    public:
+        // The names must remain valid for the lifetime of the index
+        perfect_hash_index(std::initializer_list<const CharT*> names)
+            : mask_(0), seed_(0)
+        {
+            JSONCONS_ASSERT(names.size() < 255);
+            for (const CharT* name : names)
+            {
+                names_.push_back(name);
+                lengths_.push_back(std::char_traits<CharT>::length(name));
+            }
+
+            std::size_t size = 4;
+            while (size < 2*names_.size())
+            {
+                size *= 2;
+            }
+            while (!build(size))
+            {
+                size *= 2;
+            }
+        }
+
+        std::size_t size() const
+        {
+            return names_.size();
+        }
+
+        // The position of the name, or size() if it is not one of the names
+        std::size_t find(const CharT* data, std::size_t length) const
+        {
+            std::size_t slot = static_cast<std::size_t>(hash(data, length, seed_)) & mask_;
+            std::size_t index = slots_[slot];
+            if (index != 0 && lengths_[--index] == length &&
+                std::char_traits<CharT>::compare(names_[index], data, length) == 0)
+            {
+                return index;
+            }
+            return names_.size();
+        }
+    private:
+        static uint64_t hash(const CharT* data, std::size_t length, uint64_t seed)
+        {
+            return hash_bytes(data, length*sizeof(CharT), seed);
+        }
+
+        // Tries a few seeds with a table of the given size
+        bool build(std::size_t size)
+        {
+            slots_.resize(size);
+            mask_ = size - 1;
+            for (seed_ = 0; seed_ < 16; ++seed_)
+            {
+                std::fill(slots_.begin(), slots_.end(), uint8_t(0));
+                bool collision = false;
+                for (std::size_t i = 0; i < names_.size() && !collision; ++i)
+                {
+                    std::size_t slot = static_cast<std::size_t>(hash(names_[i], lengths_[i], seed_)) & mask_;
+                    if (slots_[slot] != 0)
+                    {
+                        collision = true;
+                    }
+                    else
+                    {
+                        slots_[slot] = static_cast<uint8_t>(i + 1);
+                    }
+                }
+                if (!collision)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,188 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SCHUBFACH_HPP
+#define JSONCONS_DETAIL_SCHUBFACH_HPP
+
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/powers_of_five.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // Shortest round-trip decimal representation of a double, after Raffaello Giulietti,
+    // The Schubfach way to render doubles, 2020. Like Ryu it always succeeds, and unlike
+    // grisu3 it needs no fallback. Of the shortest decimals that round to v, the one
+    // closest to v is chosen.
+
+    inline
+    int floor_log10_pow2(int e)
+    {
+        return (e * 315653) >> 20;
+    }
+
+    inline
+    int floor_log10_three_quarters_pow2(int e)
+    {
+        return (e * 315653 - 131237) >> 20;
+    }
+
+    inline
+    int floor_log2_pow10(int e)
+    {
+        return (e * 1741647) >> 19;
+    }
+
+    // Returns g*cp/2^128 rounded to odd, where g is the 128-bit significand of 10^k
+
+    inline
+    uint64_t schubfach_round_to_odd(uint64_t g_hi, uint64_t g_lo, uint64_t cp)
+    {
+        uint64_t x_lo;
+        uint64_t x_hi = full_multiplication(g_lo, cp, x_lo);
+        uint64_t y_lo;
+        uint64_t y_hi = full_multiplication(g_hi, cp, y_lo);
+        uint64_t z = y_lo + x_hi;
+        uint64_t z_hi = y_hi + (z < y_lo ? 1 : 0);
+        return z_hi | (z > 1 ? 1 : 0);
+    }
+
+    // Computes the shortest decimal significand and exponent of the positive finite double v,
+    // v == significand * 10^exponent after rounding to nearest
+
+    inline
+    void schubfach_to_decimal(double v, uint64_t& significand, int& exponent)
+    {
+        const int significand_bits = 52;
+        const int exponent_bias = 1023 + significand_bits;
+        const uint64_t hidden_bit = uint64_t(1) << significand_bits;
+
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        const uint64_t ieee_significand = bits & (hidden_bit - 1);
+        const int ieee_exponent = static_cast<int>((bits >> significand_bits) & 0x7ff);
+
+        uint64_t c;
+        int q;
+        if (ieee_exponent != 0)
+        {
+            c = hidden_bit | ieee_significand;
+            q = ieee_exponent - exponent_bias;
+            // Small integers
+            if (q <= 0 && -q <= significand_bits)
+            {
+                const uint64_t m = c >> -q;
+                if ((m << -q) == c)
+                {
+                    significand = m;
+                    exponent = 0;
+                    return;
+                }
+            }
+        }
+        else
+        {
+            c = ieee_significand;
+            q = 1 - exponent_bias;
+        }
+
+        const bool is_even = (c % 2) == 0;
+        const bool lower_boundary_is_closer = ieee_significand == 0 && ieee_exponent > 1;
+
+        const uint64_t cbl = 4 * c - 2 + (lower_boundary_is_closer ? 1 : 0);
+        const uint64_t cb = 4 * c;
+        const uint64_t cbr = 4 * c + 2;
+
+        const int k = lower_boundary_is_closer ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+        const int h = q + floor_log2_pow10(-k) + 1;
+
+        // The table holds 5^-k, which has the same significand as 10^-k. The significand
+        // must not be smaller than the exact value, so truncated entries are bumped by one.
+        const std::size_t index = 2*static_cast<std::size_t>(-k - powers_of_five_128<>::smallest_power);
+        uint64_t g_hi = powers_of_five_128<>::values[index];
+        uint64_t g_lo = powers_of_five_128<>::values[index + 1];
+        if (-k < -27 || -k > 55)
+        {
+            ++g_lo;
+            g_hi += (g_lo == 0) ? 1 : 0;
+        }
+
+        const uint64_t vbl = schubfach_round_to_odd(g_hi, g_lo, cbl << h);
+        const uint64_t vb = schubfach_round_to_odd(g_hi, g_lo, cb << h);
+        const uint64_t vbr = schubfach_round_to_odd(g_hi, g_lo, cbr << h);
+
+        const uint64_t lower = vbl + (is_even ? 0 : 1);
+        const uint64_t upper = vbr - (is_even ? 0 : 1);
+
+        const uint64_t s = vb / 4;
+        if (s >= 10)
+        {
+            const uint64_t sp = s / 10;
+            const bool up_inside = lower <= 40 * sp;
+            const bool wp_inside = 40 * sp + 40 <= upper;
+            if (up_inside != wp_inside)
+            {
+                significand = sp + (wp_inside ? 1 : 0);
+                exponent = k + 1;
+                return;
+            }
+        }
+
+        const bool u_inside = lower <= 4 * s;
+        const bool w_inside = 4 * s + 4 <= upper;
+        if (u_inside != w_inside)
+        {
+            significand = s + (w_inside ? 1 : 0);
+            exponent = k;
+            return;
+        }
+
+        const uint64_t mid = 4 * s + 2;
+        const bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+        significand = s + (round_up ? 1 : 0);
+        exponent = k;
+    }
+
+    // Same contract as grisu3: writes the shortest digits of the positive finite double v
+    // to buffer, and sets K so that v == buffer * 10^K. Always succeeds.
+
+    inline
+    bool schubfach(double v, char *buffer, int *length, int *K)
+    {
+        uint64_t significand;
+        int exponent;
+        schubfach_to_decimal(v, significand, exponent);
+
+        // Strip trailing zeros, from integers and from the two-candidate search
+        while (significand % 10 == 0)
+        {
+            significand /= 10;
+            ++exponent;
+        }
+
+        char digits[20];
+        int n = 0;
+        do
+        {
+            digits[n++] = static_cast<char>('0' + significand % 10);
+            significand /= 10;
+        }
+        while (significand != 0);
+        for (int i = 0; i < n; ++i)
+        {
+            buffer[i] = digits[n - 1 - i];
+        }
+        *length = n;
+        *K = exponent;
+        return true;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,477 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SHARED_KEY_HPP
+#define JSONCONS_DETAIL_SHARED_KEY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstring> // std::memcpy
+#include <memory> // std::allocator_traits
+#include <ostream>
+#include <string>
+#include <type_traits> // std::aligned_storage
+#include <utility> // std::swap
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/detail/hash_index.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // An immutable string whose copies share one reference counted allocation, holding
+    // the count, the length, the allocator and the characters. It is the size of a pointer,
+    // and two keys that share an allocation compare equal without comparing characters.
+    // An empty key holds no allocation, and returns a default constructed allocator.
+
+    template <class CharT, class CharTraits = std::char_traits<CharT>, class Allocator = std::allocator<CharT>>
+    class shared_key
+    {
+    public:
+        using value_type = CharT;
+        using traits_type = CharTraits;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using const_iterator = const CharT*;
+        using iterator = const_iterator;
+        using string_view_type = jsoncons::basic_string_view<CharT,CharTraits>;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+    private:
+        struct header
+        {
+            std::atomic<std::size_t> count;
+            std::size_t length;
+            allocator_type alloc;
+
+            header(std::size_t n, const allocator_type& a)
+                : count(1), length(n), alloc(a)
+            {
+            }
+        };
+
+        // The block is allocated in units aligned for the header, an allocator rebound to char
+        // need not align it
+        typedef typename std::aligned_storage<sizeof(header), alignof(header)>::type storage_kind;
+        using storage_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<storage_kind>;
+        using storage_pointer = typename std::allocator_traits<storage_allocator_type>::pointer;
+
+        header* ptr_;
+    public:
+        shared_key() noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        explicit shared_key(const allocator_type&) noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        shared_key(const CharT* s, std::size_t length, const allocator_type& alloc = allocator_type())
+            : ptr_(create(s, length, alloc))
+        {
+        }
+
+        shared_key(const CharT* s, const allocator_type& alloc = allocator_type())
+            : ptr_(create(s, CharTraits::length(s), alloc))
+        {
+        }
+
+        shared_key(const CharT* first, const CharT* last, const allocator_type& alloc = allocator_type())
+            : ptr_(create(first, static_cast<std::size_t>(last - first), alloc))
+        {
+        }
+
+        template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value && !std::is_pointer<InputIt>::value>::type>
+        shared_key(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : ptr_(nullptr)
+        {
+            std::basic_string<CharT,CharTraits> s(first, last);
+            ptr_ = create(s.data(), s.size(), alloc);
+        }
+
+        template <class Alloc>
+        shared_key(const std::basic_string<CharT,CharTraits,Alloc>& s, const allocator_type& alloc = allocator_type())
+            : ptr_(create(s.data(), s.size(), alloc))
+        {
+        }
+
+        explicit shared_key(const string_view_type& sv, const allocator_type& alloc = allocator_type())
+            : ptr_(create(sv.data(), sv.size(), alloc))
+        {
+        }
+
+        shared_key(const shared_key& other) noexcept
+            : ptr_(other.ptr_)
+        {
+            add_ref();
+        }
+
+        // Shares other's allocation if the allocators are equal
+        shared_key(const shared_key& other, const allocator_type& alloc)
+            : ptr_(nullptr)
+        {
+            if (other.ptr_ == nullptr || other.ptr_->alloc == alloc)
+            {
+                ptr_ = other.ptr_;
+                add_ref();
+            }
+            else
+            {
+                ptr_ = create(other.data(), other.size(), alloc);
+            }
+        }
+
+        shared_key(shared_key&& other) noexcept
+            : ptr_(other.ptr_)
+        {
+            other.ptr_ = nullptr;
+        }
+
+        shared_key(shared_key&& other, const allocator_type& alloc)
+            : ptr_(nullptr)
+        {
+            if (other.ptr_ == nullptr || other.ptr_->alloc == alloc)
+            {
+                std::swap(ptr_, other.ptr_);
+            }
+            else
+            {
+                ptr_ = create(other.data(), other.size(), alloc);
+            }
+        }
+
+        ~shared_key() noexcept
+        {
+            release();
+        }
+
+        shared_key& operator=(const shared_key& other) noexcept
+        {
+            if (ptr_ != other.ptr_)
+            {
+                release();
+                ptr_ = other.ptr_;
+                add_ref();
+            }
+            return *this;
+        }
+
+        shared_key& operator=(shared_key&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                ptr_ = other.ptr_;
+                other.ptr_ = nullptr;
+            }
+            return *this;
+        }
+
+        void swap(shared_key& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+        }
+
+        allocator_type get_allocator() const
+        {
+            return ptr_ == nullptr ? allocator_type() : ptr_->alloc;
+        }
+
+        const CharT* data() const noexcept
+        {
+            return ptr_ == nullptr ? empty_data() : reinterpret_cast<const CharT*>(ptr_ + 1);
+        }
+
+        const CharT* c_str() const noexcept
+        {
+            return data();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return ptr_ == nullptr ? 0 : ptr_->length;
+        }
+
+        std::size_t length() const noexcept
+        {
+            return size();
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return data() + size();
+        }
+
+        const CharT& operator[](std::size_t i) const noexcept
+        {
+            return data()[i];
+        }
+
+        // True if the two keys share one allocation
+        bool shares_with(const shared_key& other) const noexcept
+        {
+            return ptr_ == other.ptr_;
+        }
+
+        int compare(const shared_key& other) const noexcept
+        {
+            return ptr_ == other.ptr_ ? 0 : string_view_type(*this).compare(string_view_type(other));
+        }
+
+        int compare(const string_view_type& sv) const noexcept
+        {
+            return string_view_type(*this).compare(sv);
+        }
+
+        operator string_view_type() const noexcept
+        {
+            return string_view_type(data(), size());
+        }
+
+        template <class Traits, class Alloc>
+        explicit operator std::basic_string<CharT,Traits,Alloc>() const
+        {
+            return std::basic_string<CharT,Traits,Alloc>(data(), size());
+        }
+
+        friend bool operator==(const shared_key& lhs, const shared_key& rhs) noexcept
+        {
+            return lhs.ptr_ == rhs.ptr_ || (lhs.size() == rhs.size() && lhs.compare(rhs) == 0);
+        }
+        friend bool operator==(const shared_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) == 0;
+        }
+        friend bool operator==(const string_view_type& lhs, const shared_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) == 0;
+        }
+        friend bool operator==(const shared_key& lhs, const CharT* rhs) noexcept
+        {
+            return lhs.compare(string_view_type(rhs)) == 0;
+        }
+        friend bool operator==(const CharT* lhs, const shared_key& rhs) noexcept
+        {
+            return rhs.compare(string_view_type(lhs)) == 0;
+        }
+
+        template <class Alloc>
+        friend bool operator==(const shared_key& lhs, const std::basic_string<CharT,CharTraits,Alloc>& rhs) noexcept
+        {
+            return lhs.compare(string_view_type(rhs)) == 0;
+        }
+        template <class Alloc>
+        friend bool operator==(const std::basic_string<CharT,CharTraits,Alloc>& lhs, const shared_key& rhs) noexcept
+        {
+            return rhs.compare(string_view_type(lhs)) == 0;
+        }
+
+        friend bool operator!=(const shared_key& lhs, const shared_key& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator!=(const shared_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator!=(const string_view_type& lhs, const shared_key& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator!=(const shared_key& lhs, const CharT* rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator!=(const CharT* lhs, const shared_key& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        template <class Alloc>
+        friend bool operator!=(const shared_key& lhs, const std::basic_string<CharT,CharTraits,Alloc>& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        template <class Alloc>
+        friend bool operator!=(const std::basic_string<CharT,CharTraits,Alloc>& lhs, const shared_key& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const shared_key& lhs, const shared_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+        friend bool operator<(const shared_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+        friend bool operator<(const string_view_type& lhs, const shared_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) > 0;
+        }
+
+        template <class Alloc>
+        friend bool operator<(const shared_key& lhs, const std::basic_string<CharT,CharTraits,Alloc>& rhs) noexcept
+        {
+            return lhs.compare(string_view_type(rhs)) < 0;
+        }
+        template <class Alloc>
+        friend bool operator<(const std::basic_string<CharT,CharTraits,Alloc>& lhs, const shared_key& rhs) noexcept
+        {
+            return rhs.compare(string_view_type(lhs)) > 0;
+        }
+
+        friend bool operator<=(const shared_key& lhs, const shared_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) <= 0;
+        }
+        friend bool operator>(const shared_key& lhs, const shared_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) > 0;
+        }
+        friend bool operator>=(const shared_key& lhs, const shared_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) >= 0;
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const shared_key& key)
+        {
+            os.write(key.data(), key.size());
+            return os;
+        }
+
+    private:
+        static const CharT* empty_data() noexcept
+        {
+            static const CharT s[1] = {0};
+            return s;
+        }
+
+        // The number of storage units for the header and the characters
+        static std::size_t storage_size(std::size_t length) noexcept
+        {
+            std::size_t bytes = sizeof(header) + (length + 1)*sizeof(CharT);
+            return (bytes + sizeof(storage_kind) - 1) / sizeof(storage_kind);
+        }
+
+        static header* create(const CharT* s, std::size_t length, const allocator_type& alloc)
+        {
+            if (length == 0)
+            {
+                return nullptr;
+            }
+            storage_allocator_type storage_alloc(alloc);
+            storage_kind* p = to_plain_pointer(std::allocator_traits<storage_allocator_type>::allocate(storage_alloc, storage_size(length)));
+            header* h = ::new(p) header(length, alloc);
+            CharT* chars = reinterpret_cast<CharT*>(h + 1);
+            std::memcpy(chars, s, length*sizeof(CharT));
+            chars[length] = 0;
+            return h;
+        }
+
+        void add_ref() noexcept
+        {
+            if (ptr_ != nullptr)
+            {
+                ptr_->count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void release() noexcept
+        {
+            if (ptr_ != nullptr && ptr_->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                storage_allocator_type storage_alloc(ptr_->alloc);
+                std::size_t n = storage_size(ptr_->length);
+                ptr_->~header();
+                std::allocator_traits<storage_allocator_type>::deallocate(storage_alloc,
+                    std::pointer_traits<storage_pointer>::pointer_to(*reinterpret_cast<storage_kind*>(ptr_)), n);
+            }
+            ptr_ = nullptr;
+        }
+    };
+
+    template <class CharT, class CharTraits, class Allocator>
+    constexpr typename shared_key<CharT,CharTraits,Allocator>::size_type shared_key<CharT,CharTraits,Allocator>::npos;
+
+    // Makes the keys for a decoder. This one makes a new key every time.
+
+    template <class Key, class TempAllocator>
+    class key_pool
+    {
+    public:
+        key_pool(const TempAllocator&)
+        {
+        }
+
+        template <class CharT>
+        Key get(const CharT* s, std::size_t length, const typename Key::allocator_type& alloc)
+        {
+            return Key(s, length, alloc);
+        }
+    };
+
+    // Interns shared keys, so that all the occurrences of a key in the decoded value share
+    // one allocation. Stops adding keys when it holds max_size of them, e.g. while decoding
+    // an object used as a dictionary.
+
+    template <class CharT, class CharTraits, class Allocator, class TempAllocator>
+    class key_pool<shared_key<CharT,CharTraits,Allocator>,TempAllocator>
+    {
+        using key_type = shared_key<CharT,CharTraits,Allocator>;
+        using key_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<key_type>;
+
+        static constexpr std::size_t max_size = 1024;
+
+        std::vector<key_type,key_allocator_type> keys_;
+        hash_index<TempAllocator> index_;
+    public:
+        key_pool(const TempAllocator& alloc)
+            : keys_(key_allocator_type(alloc)), index_(alloc)
+        {
+        }
+
+        key_type get(const CharT* s, std::size_t length, const Allocator& alloc)
+        {
+            if (length == 0)
+            {
+                return key_type();
+            }
+            std::size_t hash = hash_chars(s, length);
+            typename key_type::string_view_type sv(s, length);
+            std::size_t pos = index_.find(hash, [&](std::size_t i) {return keys_[i] == sv;});
+            if (pos != hash_index<TempAllocator>::npos)
+            {
+                return keys_[pos];
+            }
+            key_type key(s, length, alloc);
+            if (keys_.size() < max_size)
+            {
+                keys_.push_back(key);
+                index_.insert(hash, keys_.size() - 1);
+            }
+            return key;
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,295 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SIMD_SCAN_HPP
+#define JSONCONS_DETAIL_SIMD_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits> // std::enable_if
+#include <jsoncons/config/jsoncons_config.hpp>
+
+// Define JSONCONS_NO_SIMD to disable the vectorized scanners
+
+#if !defined(JSONCONS_NO_SIMD)
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define JSONCONS_HAS_SSE2 1
+#    include <emmintrin.h>
+#  endif
+#  if defined(JSONCONS_HAS_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    define JSONCONS_HAS_AVX2_DISPATCH 1
+#    include <immintrin.h>
+#  endif
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+    // Characters that end a run of plain string content: the closing quote,
+    // a backslash, or any control character (0x00-0x1f)
+
+    template <class CharT>
+    bool is_string_special(CharT c)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+        return c == '\"' || c == '\\' || static_cast<uchar_type>(c) < 0x20;
+    }
+
+    template <class CharT>
+    const CharT* scalar_find_string_special(const CharT* first, const CharT* last)
+    {
+        while (first < last && !is_string_special(*first))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    // Skips a run of JSON whitespace (space, tab, line feed, carriage return) starting at first.
+    // Adds the number of line breaks to lines, counting a carriage return followed by a line feed 
+    // once, and sets line_begin to the position following the last line break. A carriage return
+    // that is the last character in the range is not consumed, because a line feed that follows 
+    // in the next buffer belongs to it.
+
+    template <class CharT>
+    const CharT* scalar_skip_whitespace_run(const CharT* first, const CharT* last, 
+                                            std::size_t& lines, const CharT*& line_begin)
+    {
+        while (first < last)
+        {
+            switch (*first)
+            {
+                case ' ':
+                case '\t':
+                    ++first;
+                    break;
+                case '\n':
+                    ++first;
+                    ++lines;
+                    line_begin = first;
+                    break;
+                case '\r':
+                    if (first + 1 == last)
+                    {
+                        return first;
+                    }
+                    ++first;
+                    if (*first == '\n')
+                    {
+                        ++first;
+                    }
+                    ++lines;
+                    line_begin = first;
+                    break;
+                default:
+                    return first;
+            }
+        }
+        return first;
+    }
+
+#if defined(JSONCONS_HAS_SSE2)
+
+    inline
+    int count_trailing_zeros(uint32_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(mask);
+    #else
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index);
+    #endif
+    }
+
+    inline
+    const char* sse2_find_string_special(const char* first, const char* last)
+    {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i max_control = _mm_set1_epi8(0x1f);
+
+        while (last - first >= 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            // unsigned block <= 0x1f  <=>  max(block,0x1f) == 0x1f
+            __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(block, max_control), max_control);
+            __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quote),
+                                                        _mm_cmpeq_epi8(block, backslash)),
+                                           control);
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 16;
+        }
+        return scalar_find_string_special(first, last);
+    }
+
+    inline
+    int count_set_bits(uint32_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcount(mask);
+    #else
+        mask = mask - ((mask >> 1) & 0x55555555u);
+        mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+        return static_cast<int>((((mask + (mask >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24);
+    #endif
+    }
+
+    inline
+    int highest_set_bit(uint32_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return 31 - __builtin_clz(mask);
+    #else
+        unsigned long index;
+        _BitScanReverse(&index, mask);
+        return static_cast<int>(index);
+    #endif
+    }
+
+    inline
+    const char* sse2_skip_whitespace_run(const char* first, const char* last, 
+                                         std::size_t& lines, const char*& line_begin)
+    {
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+
+        // One character of lookahead past the block is needed to pair a 
+        // trailing carriage return with a line feed
+        while (last - first > 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            uint32_t lf_mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, lf)));
+            uint32_t cr_mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, cr)));
+            uint32_t ws_mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, space),
+                                                                                   _mm_cmpeq_epi8(block, tab))))
+                               | lf_mask | cr_mask;
+
+            uint32_t other_mask = ~ws_mask & 0xffffu;
+            int n = other_mask != 0 ? count_trailing_zeros(other_mask) : 16;
+            uint32_t prefix = (1u << n) - 1;
+
+            uint32_t lf_next = (lf_mask >> 1) | (first[16] == '\n' ? 0x8000u : 0u);
+            uint32_t breaks = (lf_mask | (cr_mask & ~lf_next)) & prefix;
+            if (breaks != 0)
+            {
+                lines += count_set_bits(breaks);
+                line_begin = first + highest_set_bit(breaks) + 1;
+            }
+            if (n < 16)
+            {
+                return first + n;
+            }
+            first += 16;
+        }
+        return scalar_skip_whitespace_run(first, last, lines, line_begin);
+    }
+
+#endif // JSONCONS_HAS_SSE2
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+
+    __attribute__((target("avx2")))
+    inline
+    const char* avx2_find_string_special(const char* first, const char* last)
+    {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i max_control = _mm256_set1_epi8(0x1f);
+
+        while (last - first >= 32)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(block, max_control), max_control);
+            __m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, quote),
+                                                              _mm256_cmpeq_epi8(block, backslash)),
+                                              control);
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return first + __builtin_ctz(mask);
+            }
+            first += 32;
+        }
+        return sse2_find_string_special(first, last);
+    }
+
+    inline
+    bool cpu_has_avx2()
+    {
+        static const bool value = __builtin_cpu_supports("avx2") != 0;
+        return value;
+    }
+
+#endif // JSONCONS_HAS_AVX2_DISPATCH
+
+    // Returns a pointer to the first quote, backslash or control character in [first,last),
+    // or last if there is none
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) != sizeof(char),const CharT*>::type
+    find_string_special(const CharT* first, const CharT* last)
+    {
+        return scalar_find_string_special(first, last);
+    }
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) == sizeof(char),const CharT*>::type
+    find_string_special(const CharT* first, const CharT* last)
+    {
+    #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+        if (last - first >= 32 && cpu_has_avx2())
+        {
+            return reinterpret_cast<const CharT*>(avx2_find_string_special(reinterpret_cast<const char*>(first),
+                                                                           reinterpret_cast<const char*>(last)));
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        return reinterpret_cast<const CharT*>(sse2_find_string_special(reinterpret_cast<const char*>(first),
+                                                                       reinterpret_cast<const char*>(last)));
+    #else
+        return scalar_find_string_special(first, last);
+    #endif
+    }
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) != sizeof(char),const CharT*>::type
+    skip_whitespace_run(const CharT* first, const CharT* last, 
+                        std::size_t& lines, const CharT*& line_begin)
+    {
+        return scalar_skip_whitespace_run(first, last, lines, line_begin);
+    }
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) == sizeof(char),const CharT*>::type
+    skip_whitespace_run(const CharT* first, const CharT* last, 
+                        std::size_t& lines, const CharT*& line_begin)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        // Short runs such as the single space after a colon are cheaper to skip one by one
+        if (last - first > 16 && (first[0] == '\n' || first[0] == '\r' || first[1] == ' ' || first[1] == '\t'))
+        {
+            const char* begin = reinterpret_cast<const char*>(line_begin);
+            const char* p = sse2_skip_whitespace_run(reinterpret_cast<const char*>(first),
+                                                     reinterpret_cast<const char*>(last),
+                                                     lines, begin);
+            line_begin = reinterpret_cast<const CharT*>(begin);
+            return reinterpret_cast<const CharT*>(p);
+        }
+    #endif
+        return scalar_skip_whitespace_run(first, last, lines, line_begin);
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
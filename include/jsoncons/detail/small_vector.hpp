@@ -0,0 +1,583 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SMALL_VECTOR_HPP
+#define JSONCONS_DETAIL_SMALL_VECTOR_HPP
+
+#include <algorithm> // std::move, std::move_backward, std::rotate, std::equal, std::lexicographical_compare
+#include <cstddef>
+#include <initializer_list>
+#include <iterator> // std::reverse_iterator
+#include <memory> // std::allocator_traits
+#include <stdexcept> // std::length_error
+#include <type_traits>
+#include <utility> // std::move, std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // A sequence container with the interface of std::vector that keeps up to N elements
+    // in place, in the container itself, and moves them to the heap when it grows beyond N.
+    // Unlike std::vector, moving or swapping a small_vector that holds its elements in place
+    // moves the elements, so it invalidates iterators.
+
+    template <class T, std::size_t N, class Allocator = std::allocator<T>>
+    class small_vector
+    {
+        static_assert(N > 0, "N must be greater than 0");
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    private:
+        using element_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<T>;
+        using alloc_traits = std::allocator_traits<element_allocator_type>;
+        using buffer_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+        // Derives from the allocator so that a stateless allocator takes no space
+        struct impl : public element_allocator_type
+        {
+            T* data_;
+            size_type size_;
+            size_type capacity_;
+            buffer_type buffer_[N];
+
+            impl(const element_allocator_type& alloc) noexcept
+                : element_allocator_type(alloc), data_(reinterpret_cast<T*>(buffer_)), size_(0), capacity_(N)
+            {
+            }
+        };
+
+        impl impl_;
+    public:
+        small_vector()
+            : impl_(element_allocator_type())
+        {
+        }
+
+        explicit small_vector(const allocator_type& alloc)
+            : impl_(element_allocator_type(alloc))
+        {
+        }
+
+        small_vector(size_type n, const T& value, const allocator_type& alloc = allocator_type())
+            : impl_(element_allocator_type(alloc))
+        {
+            assign_n(n, value);
+        }
+
+        template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        small_vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : impl_(element_allocator_type(alloc))
+        {
+            JSONCONS_TRY
+            {
+                for (; first != last; ++first)
+                {
+                    emplace_back(*first);
+                }
+            }
+            JSONCONS_CATCH(...)
+            {
+                deallocate_all();
+                JSONCONS_RETHROW;
+            }
+        }
+
+        small_vector(std::initializer_list<T> init, const allocator_type& alloc = allocator_type())
+            : small_vector(init.begin(), init.end(), alloc)
+        {
+        }
+
+        small_vector(const small_vector& other)
+            : small_vector(other.begin(), other.end(),
+                           alloc_traits::select_on_container_copy_construction(other.get_element_allocator()))
+        {
+        }
+
+        small_vector(const small_vector& other, const allocator_type& alloc)
+            : small_vector(other.begin(), other.end(), alloc)
+        {
+        }
+
+        small_vector(small_vector&& other) noexcept
+            : impl_(other.get_element_allocator())
+        {
+            take(other);
+        }
+
+        small_vector(small_vector&& other, const allocator_type& alloc)
+            : impl_(element_allocator_type(alloc))
+        {
+            if (get_element_allocator() == other.get_element_allocator())
+            {
+                take(other);
+            }
+            else
+            {
+                move_elements(other);
+            }
+        }
+
+        ~small_vector() noexcept
+        {
+            deallocate_all();
+        }
+
+        small_vector& operator=(const small_vector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                reserve(other.size());
+                for (const auto& item : other)
+                {
+                    emplace_back(item);
+                }
+            }
+            return *this;
+        }
+
+        small_vector& operator=(small_vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            if (this != &other)
+            {
+                deallocate_all();
+                reset();
+                if (alloc_traits::propagate_on_container_move_assignment::value)
+                {
+                    get_element_allocator() = std::move(other.get_element_allocator());
+                }
+                if (get_element_allocator() == other.get_element_allocator())
+                {
+                    take(other);
+                }
+                else
+                {
+                    move_elements(other);
+                }
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_type(get_element_allocator());
+        }
+
+        iterator begin() noexcept {return impl_.data_;}
+        iterator end() noexcept {return impl_.data_ + impl_.size_;}
+        const_iterator begin() const noexcept {return impl_.data_;}
+        const_iterator end() const noexcept {return impl_.data_ + impl_.size_;}
+        const_iterator cbegin() const noexcept {return impl_.data_;}
+        const_iterator cend() const noexcept {return impl_.data_ + impl_.size_;}
+        reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+        reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+        const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+        const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+
+        bool empty() const noexcept {return impl_.size_ == 0;}
+        size_type size() const noexcept {return impl_.size_;}
+        size_type capacity() const noexcept {return impl_.capacity_;}
+        size_type max_size() const noexcept {return alloc_traits::max_size(get_element_allocator());}
+
+        T* data() noexcept {return impl_.data_;}
+        const T* data() const noexcept {return impl_.data_;}
+
+        reference operator[](size_type i) {return impl_.data_[i];}
+        const_reference operator[](size_type i) const {return impl_.data_[i];}
+
+        reference at(size_type i)
+        {
+            if (i >= impl_.size_)
+            {
+                JSONCONS_THROW(std::out_of_range("small_vector index out of range"));
+            }
+            return impl_.data_[i];
+        }
+
+        const_reference at(size_type i) const
+        {
+            if (i >= impl_.size_)
+            {
+                JSONCONS_THROW(std::out_of_range("small_vector index out of range"));
+            }
+            return impl_.data_[i];
+        }
+
+        reference front() {return impl_.data_[0];}
+        const_reference front() const {return impl_.data_[0];}
+        reference back() {return impl_.data_[impl_.size_-1];}
+        const_reference back() const {return impl_.data_[impl_.size_-1];}
+
+        void reserve(size_type n)
+        {
+            if (n > impl_.capacity_)
+            {
+                reallocate(n);
+            }
+        }
+
+        // Moves the elements back in place if they fit
+        void shrink_to_fit()
+        {
+            if (!is_inline() && impl_.size_ < impl_.capacity_)
+            {
+                reallocate(impl_.size_);
+            }
+        }
+
+        void clear() noexcept
+        {
+            destroy_range(impl_.data_, impl_.data_ + impl_.size_);
+            impl_.size_ = 0;
+        }
+
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        template <class... Args>
+        reference emplace_back(Args&&... args)
+        {
+            if (impl_.size_ == impl_.capacity_)
+            {
+                // The arguments may refer to an element, so construct the new element
+                // in the new buffer before moving the old ones
+                size_type new_capacity = next_capacity(impl_.size_ + 1);
+                T* p = allocate(new_capacity);
+                JSONCONS_TRY
+                {
+                    alloc_traits::construct(get_element_allocator(), p + impl_.size_, std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    deallocate(p, new_capacity);
+                    JSONCONS_RETHROW;
+                }
+                relocate_to(p, new_capacity);
+            }
+            else
+            {
+                alloc_traits::construct(get_element_allocator(), impl_.data_ + impl_.size_, std::forward<Args>(args)...);
+            }
+            ++impl_.size_;
+            return back();
+        }
+
+        void pop_back()
+        {
+            --impl_.size_;
+            alloc_traits::destroy(get_element_allocator(), impl_.data_ + impl_.size_);
+        }
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            size_type index = static_cast<size_type>(pos - begin());
+            emplace_back(std::forward<Args>(args)...);
+            std::rotate(begin() + index, end() - 1, end());
+            return begin() + index;
+        }
+
+        iterator insert(const_iterator pos, const T& value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            size_type index = static_cast<size_type>(pos - begin());
+            size_type old_size = impl_.size_;
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+            return begin() + index;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            iterator it1 = begin() + (first - begin());
+            iterator it2 = begin() + (last - begin());
+            if (it1 != it2)
+            {
+                iterator new_end = std::move(it2, end(), it1);
+                destroy_range(new_end, end());
+                impl_.size_ = static_cast<size_type>(new_end - begin());
+            }
+            return it1;
+        }
+
+        void resize(size_type n)
+        {
+            if (n < impl_.size_)
+            {
+                erase(begin() + n, end());
+            }
+            else
+            {
+                reserve(n);
+                while (impl_.size_ < n)
+                {
+                    emplace_back();
+                }
+            }
+        }
+
+        void resize(size_type n, const T& value)
+        {
+            if (n < impl_.size_)
+            {
+                erase(begin() + n, end());
+            }
+            else
+            {
+                reserve(n);
+                while (impl_.size_ < n)
+                {
+                    emplace_back(value);
+                }
+            }
+        }
+
+        void swap(small_vector& other) noexcept
+        {
+            if (this == &other)
+            {
+                return;
+            }
+            if (!is_inline() && !other.is_inline())
+            {
+                std::swap(impl_.data_, other.impl_.data_);
+                std::swap(impl_.size_, other.impl_.size_);
+                std::swap(impl_.capacity_, other.impl_.capacity_);
+            }
+            else
+            {
+                small_vector temp(std::move(other));
+                other.take(*this);
+                take(temp);
+            }
+            if (alloc_traits::propagate_on_container_swap::value)
+            {
+                using std::swap;
+                swap(get_element_allocator(), other.get_element_allocator());
+            }
+        }
+
+        friend bool operator==(const small_vector& lhs, const small_vector& rhs)
+        {
+            return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const small_vector& lhs, const small_vector& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const small_vector& lhs, const small_vector& rhs)
+        {
+            return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+    private:
+        element_allocator_type& get_element_allocator() noexcept
+        {
+            return impl_;
+        }
+
+        const element_allocator_type& get_element_allocator() const noexcept
+        {
+            return impl_;
+        }
+
+        T* inline_data() noexcept
+        {
+            return reinterpret_cast<T*>(impl_.buffer_);
+        }
+
+        bool is_inline() const noexcept
+        {
+            return impl_.data_ == reinterpret_cast<const T*>(impl_.buffer_);
+        }
+
+        size_type next_capacity(size_type n) const
+        {
+            if (n > max_size())
+            {
+                JSONCONS_THROW(std::length_error("small_vector too long"));
+            }
+            size_type capacity = impl_.capacity_*2;
+            return capacity < n ? n : capacity;
+        }
+
+        T* allocate(size_type n)
+        {
+            return alloc_traits::allocate(get_element_allocator(), n);
+        }
+
+        void deallocate(T* p, size_type n) noexcept
+        {
+            alloc_traits::deallocate(get_element_allocator(), p, n);
+        }
+
+        void destroy_range(T* first, T* last) noexcept
+        {
+            for (; first != last; ++first)
+            {
+                alloc_traits::destroy(get_element_allocator(), first);
+            }
+        }
+
+        void deallocate_all() noexcept
+        {
+            clear();
+            if (!is_inline())
+            {
+                deallocate(impl_.data_, impl_.capacity_);
+            }
+        }
+
+        void reset() noexcept
+        {
+            impl_.data_ = inline_data();
+            impl_.size_ = 0;
+            impl_.capacity_ = N;
+        }
+
+        // Moves the elements to p, a heap buffer with room for new_capacity elements,
+        // or to the inline buffer if p is null
+        void relocate_to(T* p, size_type new_capacity)
+        {
+            T* old_data = impl_.data_;
+            size_type old_capacity = impl_.capacity_;
+            bool was_inline = is_inline();
+            T* dest = p != nullptr ? p : inline_data();
+            for (size_type i = 0; i < impl_.size_; ++i)
+            {
+                alloc_traits::construct(get_element_allocator(), dest + i, std::move(old_data[i]));
+                alloc_traits::destroy(get_element_allocator(), old_data + i);
+            }
+            if (!was_inline)
+            {
+                deallocate(old_data, old_capacity);
+            }
+            impl_.data_ = dest;
+            impl_.capacity_ = p != nullptr ? new_capacity : N;
+        }
+
+        void reallocate(size_type n)
+        {
+            if (n <= N)
+            {
+                relocate_to(nullptr, N);
+            }
+            else
+            {
+                T* p = allocate(n);
+                relocate_to(p, n);
+            }
+        }
+
+        void assign_n(size_type n, const T& value)
+        {
+            JSONCONS_TRY
+            {
+                reserve(n);
+                for (size_type i = 0; i < n; ++i)
+                {
+                    emplace_back(value);
+                }
+            }
+            JSONCONS_CATCH(...)
+            {
+                deallocate_all();
+                JSONCONS_RETHROW;
+            }
+        }
+
+        // Takes the elements of other, which uses an equal allocator. Requires this to be empty and inline.
+        void take(small_vector& other) noexcept
+        {
+            if (other.is_inline())
+            {
+                for (size_type i = 0; i < other.impl_.size_; ++i)
+                {
+                    alloc_traits::construct(get_element_allocator(), inline_data() + i, std::move(other.impl_.data_[i]));
+                }
+                impl_.size_ = other.impl_.size_;
+                other.clear();
+            }
+            else
+            {
+                impl_.data_ = other.impl_.data_;
+                impl_.size_ = other.impl_.size_;
+                impl_.capacity_ = other.impl_.capacity_;
+                other.reset();
+            }
+        }
+
+        void move_elements(small_vector& other)
+        {
+            reserve(other.size());
+            for (auto& item : other)
+            {
+                emplace_back(std::move(item));
+            }
+            other.clear();
+        }
+    };
+
+    // The iterator types of a sequence container. The specialization for small_vector names them
+    // without instantiating small_vector, which needs a complete element type.
+
+    template <class Container>
+    struct sequence_iterator_traits
+    {
+        using iterator = typename Container::iterator;
+        using const_iterator = typename Container::const_iterator;
+    };
+
+    template <class T, std::size_t N, class Allocator>
+    struct sequence_iterator_traits<small_vector<T,N,Allocator>>
+    {
+        using iterator = T*;
+        using const_iterator = const T*;
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
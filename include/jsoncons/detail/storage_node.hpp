@@ -0,0 +1,136 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_STORAGE_NODE_HPP
+#define JSONCONS_DETAIL_STORAGE_NODE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility> // std::forward
+
+namespace jsoncons {
+namespace detail {
+
+    // A place to keep the hash of a json array or object, if CachedHash is true. Zero means
+    // that no hash is kept. Const values may be hashed concurrently, so the hash is atomic.
+
+    template <bool CachedHash>
+    class hash_slot
+    {
+    public:
+        uint64_t cached_hash() const noexcept
+        {
+            return 0;
+        }
+
+        void cache_hash(uint64_t) const noexcept
+        {
+        }
+
+        void reset_hash() noexcept
+        {
+        }
+    };
+
+    template <>
+    class hash_slot<true>
+    {
+        mutable std::atomic<uint64_t> hash_;
+    public:
+        hash_slot() noexcept
+            : hash_(0)
+        {
+        }
+
+        uint64_t cached_hash() const noexcept
+        {
+            return hash_.load(std::memory_order_relaxed);
+        }
+
+        void cache_hash(uint64_t hash) const noexcept
+        {
+            hash_.store(hash, std::memory_order_relaxed);
+        }
+
+        void reset_hash() noexcept
+        {
+            hash_.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    // The heap allocated part of a json array, object or long string. If Shared is false
+    // the node is just the value, and has one owner. If Shared is true the node also holds
+    // an atomic reference count, so that copies of a json value can share it. If CachedHash
+    // is true the node has a hash_slot.
+
+    template <class T, bool Shared, bool CachedHash = false>
+    class storage_node : public hash_slot<CachedHash>
+    {
+    public:
+        T value;
+
+        template <class... Args>
+        explicit storage_node(Args&& ... args)
+            : value(std::forward<Args>(args)...)
+        {
+        }
+
+        storage_node(const storage_node&) = delete;
+        storage_node& operator=(const storage_node&) = delete;
+
+        bool is_shared() const noexcept
+        {
+            return false;
+        }
+
+        void add_ref() noexcept
+        {
+        }
+
+        // Returns true if the caller held the last reference
+        bool release() noexcept
+        {
+            return true;
+        }
+    };
+
+    template <class T, bool CachedHash>
+    class storage_node<T,true,CachedHash> : public hash_slot<CachedHash>
+    {
+        std::atomic<std::size_t> count_;
+    public:
+        T value;
+
+        template <class... Args>
+        explicit storage_node(Args&& ... args)
+            : count_(1), value(std::forward<Args>(args)...)
+        {
+        }
+
+        storage_node(const storage_node&) = delete;
+        storage_node& operator=(const storage_node&) = delete;
+
+        bool is_shared() const noexcept
+        {
+            return count_.load(std::memory_order_acquire) > 1;
+        }
+
+        void add_ref() noexcept
+        {
+            count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool release() noexcept
+        {
+            return count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -16,6 +16,7 @@
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_options.hpp>
 #include <jsoncons/detail/grisu3.hpp>
+#include <jsoncons/detail/schubfach.hpp>
 #include <jsoncons/detail/parse_number.hpp>
 
 namespace jsoncons { namespace detail {
@@ -204,7 +205,7 @@ bool dtoa_scientific(double val, char decimal_point, Result& result)
     {
         return false;
     }
-    if (to_double_(buffer, sizeof(buffer)) != val)
+    if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
     {
         const int precision2 = std::numeric_limits<double>::max_digits10;
         length = snprintf(buffer, sizeof(buffer), "%1.*e", precision2, val);
@@ -237,7 +238,7 @@ bool dtoa_general(double val, char decimal_point, Result& result, std::false_typ
     {
         return false;
     }
-    if (to_double_(buffer, sizeof(buffer)) != val)
+    if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
     {
         const int precision2 = std::numeric_limits<double>::max_digits10;
         length = snprintf(buffer, sizeof(buffer), "%1.*g", precision2, val);
@@ -251,7 +252,7 @@ bool dtoa_general(double val, char decimal_point, Result& result, std::false_typ
 }
 
 template<class Result>
-bool dtoa_general(double v, char decimal_point, Result& result, std::true_type)
+bool dtoa_general(double v, char, Result& result, std::true_type)
 {
     if (v == 0)
     {
@@ -267,21 +268,15 @@ bool dtoa_general(double v, char decimal_point, Result& result, std::true_type)
     char buffer[100];
 
     double u = std::signbit(v) ? -v : v;
-    if (jsoncons::detail::grisu3(u, buffer, &length, &k))
+    jsoncons::detail::schubfach(u, buffer, &length, &k);
+    if (std::signbit(v))
     {
-        if (std::signbit(v))
-        {
-            result.push_back('-');
-        }
-        // min exp: -4 is consistent with sprintf
-        // max exp: std::numeric_limits<double>::max_digits10
-        jsoncons::detail::prettify_string(buffer, length, k, -4, std::numeric_limits<double>::max_digits10, result);
-        return true;
-    }
-    else
-    {
-        return dtoa_general(v, decimal_point, result, std::false_type());
+        result.push_back('-');
     }
+    // min exp: -4 is consistent with sprintf
+    // max exp: std::numeric_limits<double>::max_digits10
+    jsoncons::detail::prettify_string(buffer, length, k, -4, std::numeric_limits<double>::max_digits10, result);
+    return true;
 }
 
 template<class Result>
@@ -304,7 +299,7 @@ bool dtoa_fixed(double val, char decimal_point, Result& result, std::false_type)
     {
         return false;
     }
-    if (to_double_(buffer, sizeof(buffer)) != val)
+    if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
     {
         const int precision2 = std::numeric_limits<double>::max_digits10;
         length = snprintf(buffer, sizeof(buffer), "%1.*f", precision2, val);
@@ -318,7 +313,7 @@ bool dtoa_fixed(double val, char decimal_point, Result& result, std::false_type)
 }
 
 template<class Result>
-bool dtoa_fixed(double v, char decimal_point, Result& result, std::true_type)
+bool dtoa_fixed(double v, char, Result& result, std::true_type)
 {
     if (v == 0)
     {
@@ -334,19 +329,13 @@ bool dtoa_fixed(double v, char decimal_point, Result& result, std::true_type)
     char buffer[100];
 
     double u = std::signbit(v) ? -v : v;
-    if (jsoncons::detail::grisu3(u, buffer, &length, &k))
+    jsoncons::detail::schubfach(u, buffer, &length, &k);
+    if (std::signbit(v))
     {
-        if (std::signbit(v))
-        {
-            result.push_back('-');
-        }
-        jsoncons::detail::prettify_string(buffer, length, k, std::numeric_limits<int>::lowest(), (std::numeric_limits<int>::max)(), result);
-        return true;
-    }
-    else
-    {
-        return dtoa_fixed(v, decimal_point, result, std::false_type());
+        result.push_back('-');
     }
+    jsoncons::detail::prettify_string(buffer, length, k, std::numeric_limits<int>::lowest(), (std::numeric_limits<int>::max)(), result);
+    return true;
 }
 
 template<class Result>
@@ -21,6 +21,7 @@
 #include <type_traits> // std::enable_if
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/allocator_holder.hpp>
+#include <jsoncons/detail/hash_index.hpp>
 
 namespace jsoncons {
 
@@ -106,7 +107,6 @@ namespace jsoncons {
         }
         ~json_array() noexcept
         {
-            destroy();
         }
 
         reference back()
@@ -279,46 +279,6 @@ namespace jsoncons {
     private:
 
         json_array& operator=(const json_array<Json>&) = delete;
-
-        void destroy() noexcept
-        {
-            while (!elements_.empty())
-            {
-                value_type current = std::move(elements_.back());
-                elements_.pop_back();
-                switch (current.storage())
-                {
-                    case storage_kind::array_value:
-                    {
-                        for (auto& item : current.array_range())
-                        {
-                            if (item.size() > 0) // non-empty object or array
-                            {
-                                elements_.push_back(std::move(item));
-                            }
-                        }
-                        current.clear();                           
-                        break;
-                    }
-                    case storage_kind::object_value:
-                    {
-                        for (auto& kv : current.object_range())
-                        {
-                            value_type tmp;
-                            tmp.swap(kv.value());
-                            if (kv.value().size() > 0) // non-empty object or array
-                            {
-                                elements_.push_back(std::move(tmp));
-                            }
-                        }
-                        current.clear();                           
-                        break;
-                    }
-                    default:
-                        break;
-                }
-            }
-        }
     };
 
     struct sorted_unique_range_tag
@@ -516,6 +476,11 @@ namespace jsoncons {
         explicit preserve_key_order() = default; 
     };
 
+    struct unordered_key_order
+    {
+        explicit unordered_key_order() = default; 
+    };
+
     template <class KeyT,class Json,class Enable = void>
     class json_object
     {
@@ -627,7 +592,6 @@ namespace jsoncons {
 
         ~json_object() noexcept
         {
-            destroy();
         }
 
         void swap(json_object& val) noexcept
@@ -1184,53 +1148,15 @@ namespace jsoncons {
         }
     private:
 
-        void destroy() noexcept
-        {
-            if (!members_.empty())
-            {
-                key_type any_key = members_.back().key();
-                any_key.clear();
-                while (!members_.empty())
-                {
-                    Json current = std::move(members_.back().value());
-                    members_.pop_back();
-                    switch (current.storage())
-                    {
-                        case storage_kind::array_value:
-                        {
-                            for (auto& item : current.array_range())
-                            {
-                                if (item.size() > 0) // non-empty object or array
-                                {
-                                    members_.emplace_back(any_key, std::move(item));
-                                }
-                            }
-                            current.clear();                           
-                            break;
-                        }
-                        case storage_kind::object_value:
-                        {
-                            for (auto& kv : current.object_range())
-                            {
-                                if (kv.value().size() > 0) // non-empty object or array
-                                {
-                                    members_.push_back(std::move(kv));
-                                }
-                            }
-                            current.clear();                           
-                            break;
-                        }
-                        default:
-                            break;
-                    }
-                }
-            }
-        }
-
         json_object& operator=(const json_object&) = delete;
     };
 
     // Preserve order
+    //
+    // Members are kept in a vector in insertion order. Small objects are searched linearly,
+    // and objects with more than implementation_policy::hash_index_threshold members are 
+    // indexed by an open addressing hash table that maps the hash of a key to the position 
+    // of its member.
     template <class KeyT,class Json>
     class json_object<KeyT,Json,typename std::enable_if<std::is_same<typename Json::implementation_policy::key_order,preserve_key_order>::value>::type> : 
         public allocator_holder<typename Json::allocator_type>
@@ -1246,11 +1172,10 @@ namespace jsoncons {
         using implementation_policy = typename Json::implementation_policy;
         using key_value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_value_type>;                       
         using key_value_container_type = typename implementation_policy::template sequence_container_type<key_value_type,key_value_allocator_type>;
-        typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::size_t> index_allocator_type;
-        using index_container_type = typename implementation_policy::template sequence_container_type<std::size_t,index_allocator_type>;
+        using index_type = jsoncons::detail::hash_index<allocator_type>;
 
         key_value_container_type members_;
-        index_container_type index_;
+        index_type index_; // empty until the object has more than hash_index_threshold members
     public:
         using iterator = typename key_value_container_type::iterator;
         using const_iterator = typename key_value_container_type::const_iterator;
@@ -1263,7 +1188,7 @@ namespace jsoncons {
         json_object(const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
               members_(key_value_allocator_type(alloc)), 
-              index_(index_allocator_type(alloc))
+              index_(alloc)
         {
         }
 
@@ -1284,50 +1209,21 @@ namespace jsoncons {
         json_object(const json_object& val, const allocator_type& alloc) 
             : allocator_holder<allocator_type>(alloc), 
               members_(val.members_,key_value_allocator_type(alloc)),
-              index_(val.index_,index_allocator_type(alloc))
+              index_(val.index_,alloc)
         {
         }
 
         json_object(json_object&& val,const allocator_type& alloc) 
             : allocator_holder<allocator_type>(alloc), 
               members_(std::move(val.members_),key_value_allocator_type(alloc)),
-              index_(std::move(val.index_),index_allocator_type(alloc))
+              index_(std::move(val.index_),alloc)
         {
         }
 
         template<class InputIt>
         json_object(InputIt first, InputIt last)
         {
-            std::size_t count = std::distance(first,last);
-            members_.reserve(count);
-            for (auto s = first; s != last; ++s)
-            {
-                members_.emplace_back(get_key_value<KeyT,Json>()(*s));
-            }
-
-            build_index();
-            auto last_unique = std::unique(index_.begin(), index_.end(),
-                [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
-
-            if (last_unique != index_.end())
-            {
-                index_.erase(last_unique, index_.end());
-                std::sort(index_.begin(), index_.end());
-
-                auto result = index_.rbegin();
-                if (*result != members_.size())
-                {
-                    members_.erase(members_.begin() + (*result + 1), members_.end());
-                }
-                for (auto it = index_.rbegin() + 1; it != index_.rend(); ++it, ++result)
-                {
-                    if (*result - *it > 1)
-                    {
-                        members_.erase(members_.begin() + (*it + 1), members_.begin() + *result);
-                    }
-                }
-            }
-            build_index();
+            insert(first, last, get_key_value<KeyT,Json>());
         }
 
         template<class InputIt>
@@ -1335,45 +1231,16 @@ namespace jsoncons {
                     const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
               members_(key_value_allocator_type(alloc)), 
-              index_(index_allocator_type(alloc))
+              index_(alloc)
         {
-            std::size_t count = std::distance(first,last);
-            members_.reserve(count);
-            for (auto s = first; s != last; ++s)
-            {
-                members_.emplace_back(get_key_value<KeyT,Json>()(*s));
-            }
-
-            build_index();
-            auto last_unique = std::unique(index_.begin(), index_.end(),
-                [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
-
-            if (last_unique != index_.end())
-            {
-                index_.erase(last_unique, index_.end());
-                std::sort(index_.begin(), index_.end());
-
-                auto result = index_.rbegin();
-                if (*result != members_.size())
-                {
-                    members_.erase(members_.begin() + (*result + 1), members_.end());
-                }
-                for (auto it = index_.rbegin() + 1; it != index_.rend(); ++it, ++result)
-                {
-                    if (*result - *it > 1)
-                    {
-                        members_.erase(members_.begin() + (*it + 1), members_.begin() + *result);
-                    }
-                }
-            }
-            build_index();
+            insert(first, last, get_key_value<KeyT,Json>());
         }
 
         json_object(std::initializer_list<std::pair<std::basic_string<char_type>,Json>> init, 
                     const allocator_type& alloc = allocator_type())
             : allocator_holder<allocator_type>(alloc), 
               members_(key_value_allocator_type(alloc)), 
-              index_(index_allocator_type(alloc))
+              index_(alloc)
         {
             members_.reserve(init.size());
             for (auto& item : init)
@@ -1384,12 +1251,12 @@ namespace jsoncons {
 
         ~json_object() noexcept
         {
-            destroy();
         }
 
         void swap(json_object& val) noexcept
         {
             members_.swap(val.members_);
+            index_.swap(val.index_);
         }
 
         iterator begin()
@@ -1432,7 +1299,14 @@ namespace jsoncons {
             index_.shrink_to_fit();
         }
 
-        void reserve(std::size_t n) {members_.reserve(n);}
+        void reserve(std::size_t n) 
+        {
+            members_.reserve(n);
+            if (n > implementation_policy::hash_index_threshold)
+            {
+                index_.reserve(n);
+            }
+        }
 
         Json& at(std::size_t i) 
         {
@@ -1454,30 +1328,19 @@ namespace jsoncons {
 
         iterator find(const string_view_type& name) noexcept
         {
-            auto it = std::lower_bound(index_.begin(),index_.end(), name, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
-            if (it != index_.end() && members_.at(*it).key() == name)
-            {
-                return members_.begin() + *it;
-            }
-            else
-            {
-                return members_.end();
-            }
+            std::size_t pos = find_pos(name);
+            return pos == index_type::npos ? members_.end() : members_.begin() + pos;
         }
 
         const_iterator find(const string_view_type& name) const noexcept
         {
-            auto it = std::lower_bound(index_.begin(),index_.end(), name, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
-            if (it != index_.end() && members_.at(*it).key() == name)
-            {
-                return members_.begin() + *it;
-            }
-            else
-            {
-                return members_.end();
-            }
+            std::size_t pos = find_pos(name);
+            return pos == index_type::npos ? members_.end() : members_.begin() + pos;
+        }
+
+        void erase(const_iterator pos) 
+        {
+            erase(pos, pos + 1);
         }
 
         void erase(const_iterator first, const_iterator last) 
@@ -1496,25 +1359,16 @@ namespace jsoncons {
     #else
                 members_.erase(first,last);
     #endif
-                //build_index();
             }
         }
 
         void erase(const string_view_type& name) 
         {
-            auto pos = find(name);
-            if (pos != members_.end())
+            std::size_t pos = find_pos(name);
+            if (pos != index_type::npos)
             {
-                std::size_t pos1 = pos - members_.begin();
-                std::size_t pos2 = pos1 + 1;
-
-                erase_index_entries(pos1, pos2);
-    #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
-                iterator it = members_.begin() + (pos - members_.begin());
-                members_.erase(it);
-    #else
-                members_.erase(pos);
-    #endif
+                erase_index_entries(pos, pos + 1);
+                members_.erase(members_.begin() + pos);
             }
         }
 
@@ -1522,65 +1376,43 @@ namespace jsoncons {
         void insert(InputIt first, InputIt last, Convert convert)
         {
             std::size_t count = std::distance(first,last);
-            members_.reserve(members_.size() + count);
+            reserve(members_.size() + count);
             for (auto s = first; s != last; ++s)
             {
                 members_.emplace_back(convert(*s));
-            }
-
-            build_index();
-            auto last_unique = std::unique(index_.begin(), index_.end(),
-                [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
-
-            if (last_unique != index_.end())
-            {
-                index_.erase(last_unique, index_.end());
-                std::sort(index_.begin(), index_.end());
-
-                auto result = index_.rbegin();
-                if (*result != members_.size())
+                // The first of duplicate keys is kept
+                std::size_t pos = find_pos(members_.back().key());
+                if (pos != index_type::npos && pos + 1 != members_.size())
                 {
-                    members_.erase(members_.begin() + (*result + 1), members_.end());
+                    members_.pop_back();
                 }
-                for (auto it = index_.rbegin() + 1; it != index_.rend(); ++it, ++result)
+                else
                 {
-                    if (*result - *it > 1)
-                    {
-                        members_.erase(members_.begin() + (*it + 1), members_.begin() + *result);
-                    }
+                    index_back();
                 }
             }
-            build_index();
         }
 
         template<class InputIt, class Convert>
         void insert(sorted_unique_range_tag, InputIt first, InputIt last, Convert convert)
         {
-            std::size_t count = std::distance(first,last);
-
-            members_.reserve(members_.size() + count);
-            for (auto s = first; s != last; ++s)
-            {
-                members_.emplace_back(convert(*s));
-            }
-
-            build_index();
+            insert(first, last, convert);
         }
 
         template <class T, class A=allocator_type>
         typename std::enable_if<is_stateless<A>::value,std::pair<iterator,bool>>::type
         insert_or_assign(const string_view_type& name, T&& value)
         {
-            auto result = insert_index_entry(name,members_.size());
-            if (result.second)
+            std::size_t pos = find_pos(name);
+            if (pos == index_type::npos)
             {
                 members_.emplace_back(key_type(name.begin(), name.end()), std::forward<T>(value));
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,true);
+                index_back();
+                return std::make_pair(members_.begin() + (members_.size() - 1),true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
+                auto it = members_.begin() + pos;
                 it->value(Json(std::forward<T>(value)));
                 return std::make_pair(it,false);
             }
@@ -1590,17 +1422,17 @@ namespace jsoncons {
         typename std::enable_if<!is_stateless<A>::value,std::pair<iterator,bool>>::type
         insert_or_assign(const string_view_type& name, T&& value)
         {
-            auto result = insert_index_entry(name,members_.size());
-            if (result.second)
+            std::size_t pos = find_pos(name);
+            if (pos == index_type::npos)
             {
                 members_.emplace_back(key_type(name.begin(),name.end(),get_allocator()), 
                                       std::forward<T>(value),get_allocator());
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,true);
+                index_back();
+                return std::make_pair(members_.begin() + (members_.size() - 1),true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
+                auto it = members_.begin() + pos;
                 it->value(Json(std::forward<T>(value),get_allocator()));
                 return std::make_pair(it,false);
             }
@@ -1617,17 +1449,17 @@ namespace jsoncons {
             }
             else
             {
-                std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key,pos);
-
-                if (result.second)
+                std::size_t pos = find_pos(key);
+                if (pos == index_type::npos)
                 {
+                    pos = hint - members_.begin();
                     auto it = members_.emplace(hint, key_type(key.begin(), key.end()), std::forward<T>(value));
+                    index_inserted(pos);
                     return it;
                 }
                 else
                 {
-                    auto it = members_.begin() + result.first;
+                    auto it = members_.begin() + pos;
                     it->value(Json(std::forward<T>(value)));
                     return it;
                 }
@@ -1645,19 +1477,19 @@ namespace jsoncons {
             }
             else
             {
-                std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key,pos);
-
-                if (result.second)
+                std::size_t pos = find_pos(key);
+                if (pos == index_type::npos)
                 {
+                    pos = hint - members_.begin();
                     auto it = members_.emplace(hint, 
                                                key_type(key.begin(),key.end(),get_allocator()), 
                                                std::forward<T>(value),get_allocator());
+                    index_inserted(pos);
                     return it;
                 }
                 else
                 {
-                    auto it = members_.begin() + result.first;
+                    auto it = members_.begin() + pos;
                     it->value(Json(std::forward<T>(value),get_allocator()));
                     return it;
                 }
@@ -1803,17 +1635,16 @@ namespace jsoncons {
         typename std::enable_if<is_stateless<A>::value,std::pair<iterator,bool>>::type
         try_emplace(const string_view_type& name, Args&&... args)
         {
-            auto result = insert_index_entry(name,members_.size());
-            if (result.second)
+            std::size_t pos = find_pos(name);
+            if (pos == index_type::npos)
             {
                 members_.emplace_back(key_type(name.begin(), name.end()), std::forward<Args>(args)...);
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,true);
+                index_back();
+                return std::make_pair(members_.begin() + (members_.size() - 1),true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,false);
+                return std::make_pair(members_.begin() + pos,false);
             }
         }
 
@@ -1821,18 +1652,17 @@ namespace jsoncons {
         typename std::enable_if<!is_stateless<A>::value,std::pair<iterator,bool>>::type
         try_emplace(const string_view_type& key, Args&&... args)
         {
-            auto result = insert_index_entry(key,members_.size());
-            if (result.second)
+            std::size_t pos = find_pos(key);
+            if (pos == index_type::npos)
             {
                 members_.emplace_back(key_type(key.begin(),key.end(), get_allocator()), 
                                       std::forward<Args>(args)...);
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,true);
+                index_back();
+                return std::make_pair(members_.begin() + (members_.size() - 1),true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,false);
+                return std::make_pair(members_.begin() + pos,false);
             }
         }
      
@@ -1847,18 +1677,17 @@ namespace jsoncons {
             }
             else
             {
-                std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key, pos);
-
-                if (result.second)
+                std::size_t pos = find_pos(key);
+                if (pos == index_type::npos)
                 {
+                    pos = hint - members_.begin();
                     auto it = members_.emplace(hint, key_type(key.begin(), key.end()), std::forward<Args>(args)...);
+                    index_inserted(pos);
                     return it;
                 }
                 else
                 {
-                    auto it = members_.begin() + result.first;
-                    return it;
+                    return members_.begin() + pos;
                 }
             }
         }
@@ -1874,20 +1703,19 @@ namespace jsoncons {
             }
             else
             {
-                std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key, pos);
-
-                if (result.second)
+                std::size_t pos = find_pos(key);
+                if (pos == index_type::npos)
                 {
+                    pos = hint - members_.begin();
                     auto it = members_.emplace(hint, 
                                                key_type(key.begin(),key.end(), get_allocator()), 
                                                std::forward<Args>(args)...);
+                    index_inserted(pos);
                     return it;
                 }
                 else
                 {
-                    auto it = members_.begin() + result.first;
-                    return it;
+                    return members_.begin() + pos;
                 }
             }
         }
@@ -1903,129 +1731,593 @@ namespace jsoncons {
         }
     private:
 
-        void destroy() noexcept
+        static std::size_t hash_key(const string_view_type& name) noexcept
+        {
+            return jsoncons::detail::hash_chars(name.data(), name.length());
+        }
+
+        std::size_t find_pos(const string_view_type& name) const noexcept
         {
-            if (!members_.empty())
+            if (index_.empty())
             {
-                key_type any_key = members_.back().key();
-                any_key.clear();
-                while (!members_.empty())
+                for (std::size_t i = 0; i < members_.size(); ++i)
                 {
-                    Json current = std::move(members_.back().value());
-                    members_.pop_back();
-                    switch (current.storage())
+                    if (members_[i].key() == name)
                     {
-                        case storage_kind::array_value:
-                        {
-                            for (auto& item : current.array_range())
-                            {
-                                if (item.size() > 0) // non-empty object or array
-                                {
-                                    members_.emplace_back(any_key, std::move(item));
-                                }
-                            }
-                            current.clear();                           
-                            break;
-                        }
-                        case storage_kind::object_value:
-                        {
-                            for (auto& kv : current.object_range())
-                            {
-                                if (kv.value().size() > 0) // non-empty object or array
-                                {
-                                    members_.push_back(std::move(kv));
-                                }
-                            }
-                            current.clear();                           
-                            break;
-                        }
-                        default:
-                            break;
+                        return i;
                     }
                 }
+                return index_type::npos;
             }
+            return index_.find(hash_key(name), 
+                               [&](std::size_t pos) -> bool {return members_[pos].key() == name;});
         }
 
-        std::pair<std::size_t,bool> insert_index_entry(const string_view_type& key, std::size_t pos)
-        {
-            JSONCONS_ASSERT(pos <= index_.size());
-
-            auto it = std::lower_bound(index_.begin(),index_.end(), key, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
+        // Indexes the last member, whose key is not already in the object
 
-            if (it == index_.end())
+        void index_back()
+        {
+            if (!index_.empty())
             {
-                std::size_t count = index_.size() - pos;
-                for (std::size_t i = 0; count > 0 && i < index_.size(); ++i)
-                {
-                    if (index_[i] >= pos)
-                    {
-                        ++index_[i];
-                        --count;
-                    }
-                }
-                index_.push_back(pos);
-                return std::make_pair(pos,true);
+                index_.insert(hash_key(members_.back().key()), members_.size() - 1);
             }
-            else if (members_.at(*it).key() != key)
+            else if (members_.size() > implementation_policy::hash_index_threshold)
             {
-                std::size_t count = index_.size() - pos;
-                for (std::size_t i = 0; count > 0 && i < index_.size(); ++i)
-                {
-                    if (index_[i] >= pos)
-                    {
-                        ++index_[i];
-                        --count;
-                    }
-                }
-                auto it2 = index_.insert(it, pos);
-                return std::make_pair(*it2,true);
+                build_index();
             }
-            else
+        }
+
+        // Indexes the member just inserted at pos, whose key is not already in the object
+
+        void index_inserted(std::size_t pos)
+        {
+            if (!index_.empty())
+            {
+                index_.increment_positions(pos, 1);
+                index_.insert(hash_key(members_[pos].key()), pos);
+            }
+            else if (members_.size() > implementation_policy::hash_index_threshold)
             {
-                return std::make_pair(*it,false);
+                build_index();
             }
         }
 
+        // Removes the index entries for the members in [pos1,pos2), before they are erased
+
         void erase_index_entries(std::size_t pos1, std::size_t pos2)
         {
-            JSONCONS_ASSERT(pos1 <= pos2);
-            JSONCONS_ASSERT(pos2 <= index_.size());
-
-            const size_t offset = pos2 - pos1;
-            const size_t n = index_.size() - offset;
-            for (std::size_t i = 0; i < index_.size(); ++i)
+            if (!index_.empty() && pos1 < pos2)
             {
-                if (offset == index_.size())
-                {
-                    index_.erase(index_.begin()+i,index_.end());
-                    i += offset;
-                }
-                else if (index_[i] >= pos1 && index_[i] < pos2)
+                for (std::size_t i = pos1; i < pos2; ++i)
                 {
-                    index_.erase(index_.begin()+i);
+                    index_.erase(hash_key(members_[i].key()), i);
                 }
+                index_.decrement_positions(pos2, pos2 - pos1);
             }
-            for (std::size_t i = 0; i < index_.size(); ++i)
+        }
+
+        void build_index()
+        {
+            index_.clear();
+            if (members_.size() > implementation_policy::hash_index_threshold)
             {
-                if (index_[i] >= pos2)
+                index_.reserve(members_.size());
+                for (std::size_t i = 0; i < members_.size(); ++i)
                 {
-                    index_[i] -= offset;
+                    index_.insert(hash_key(members_[i].key()), i);
                 }
             }
-            JSONCONS_ASSERT(index_.size() == n);
         }
 
-        void build_index()
+        json_object& operator=(const json_object&) = delete;
+    };
+
+    // Unordered
+    //
+    // Members are kept in a vector, in insertion order until one is erased. Erasing a member
+    // moves the last member into its place. Small objects are searched linearly, and objects
+    // with more than implementation_policy::hash_index_threshold members are indexed by an
+    // open addressing hash table that maps the hash of a key to the position of its member.
+    template <class KeyT,class Json>
+    class json_object<KeyT,Json,typename std::enable_if<std::is_same<typename Json::implementation_policy::key_order,unordered_key_order>::value>::type> : 
+        public allocator_holder<typename Json::allocator_type>
+    {
+    public:
+        using allocator_type = typename Json::allocator_type;
+        using char_type = typename Json::char_type;
+        using key_type = KeyT;
+        //using mapped_type = Json;
+        using string_view_type = typename Json::string_view_type;
+        using key_value_type = key_value<KeyT,Json>;
+    private:
+        using implementation_policy = typename Json::implementation_policy;
+        using key_value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_value_type>;                       
+        using key_value_container_type = typename implementation_policy::template sequence_container_type<key_value_type,key_value_allocator_type>;
+        using index_type = jsoncons::detail::hash_index<allocator_type>;
+
+        key_value_container_type members_;
+        index_type index_; // empty until the object has more than hash_index_threshold members
+    public:
+        using iterator = typename key_value_container_type::iterator;
+        using const_iterator = typename key_value_container_type::const_iterator;
+
+        using allocator_holder<allocator_type>::get_allocator;
+
+        json_object()
         {
-            index_.clear();
-            index_.reserve(members_.size());
-            for (std::size_t i = 0; i < members_.size(); ++i)
+        }
+
+        explicit json_object(const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(alloc)
+        {
+        }
+
+        json_object(const json_object& val)
+            : allocator_holder<allocator_type>(val.get_allocator()), 
+              members_(val.members_),
+              index_(val.index_)
+        {
+        }
+
+        json_object(json_object&& val)
+            : allocator_holder<allocator_type>(val.get_allocator()), 
+              members_(std::move(val.members_)),
+              index_(std::move(val.index_))
+        {
+        }
+
+        json_object(const json_object& val, const allocator_type& alloc) 
+            : allocator_holder<allocator_type>(alloc), 
+              members_(val.members_,key_value_allocator_type(alloc)),
+              index_(val.index_,alloc)
+        {
+        }
+
+        json_object(json_object&& val,const allocator_type& alloc) 
+            : allocator_holder<allocator_type>(alloc), 
+              members_(std::move(val.members_),key_value_allocator_type(alloc)),
+              index_(std::move(val.index_),alloc)
+        {
+        }
+
+        template<class InputIt>
+        json_object(InputIt first, InputIt last)
+        {
+            insert(first, last, get_key_value<KeyT,Json>());
+        }
+
+        template<class InputIt>
+        json_object(InputIt first, InputIt last, 
+                    const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(alloc)
+        {
+            insert(first, last, get_key_value<KeyT,Json>());
+        }
+
+        json_object(std::initializer_list<std::pair<std::basic_string<char_type>,Json>> init, 
+                    const allocator_type& alloc = allocator_type())
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(alloc)
+        {
+            members_.reserve(init.size());
+            for (auto& item : init)
+            {
+                insert_or_assign(item.first, item.second);
+            }
+        }
+
+        ~json_object() noexcept
+        {
+        }
+
+        void swap(json_object& val) noexcept
+        {
+            members_.swap(val.members_);
+            index_.swap(val.index_);
+        }
+
+        iterator begin()
+        {
+            return members_.begin();
+        }
+
+        iterator end()
+        {
+            return members_.end();
+        }
+
+        const_iterator begin() const
+        {
+            return members_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return members_.end();
+        }
+
+        std::size_t size() const {return members_.size();}
+
+        std::size_t capacity() const {return members_.capacity();}
+
+        void clear() 
+        {
+            members_.clear();
+            index_.clear();
+        }
+
+        void shrink_to_fit() 
+        {
+            for (std::size_t i = 0; i < members_.size(); ++i)
+            {
+                members_[i].shrink_to_fit();
+            }
+            members_.shrink_to_fit();
+            index_.shrink_to_fit();
+        }
+
+        void reserve(std::size_t n) 
+        {
+            members_.reserve(n);
+            if (n > implementation_policy::hash_index_threshold)
+            {
+                index_.reserve(n);
+            }
+        }
+
+        Json& at(std::size_t i) 
+        {
+            if (i >= members_.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return members_[i].value();
+        }
+
+        const Json& at(std::size_t i) const 
+        {
+            if (i >= members_.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return members_[i].value();
+        }
+
+        iterator find(const string_view_type& name) noexcept
+        {
+            std::size_t pos = find_pos(name);
+            return pos == index_type::npos ? members_.end() : members_.begin() + pos;
+        }
+
+        const_iterator find(const string_view_type& name) const noexcept
+        {
+            std::size_t pos = find_pos(name);
+            return pos == index_type::npos ? members_.end() : members_.begin() + pos;
+        }
+
+        void erase(const_iterator pos) 
+        {
+            erase_member(pos - members_.begin());
+        }
+
+        void erase(const_iterator first, const_iterator last) 
+        {
+            if (first == last)
+            {
+                return;
+            }
+            if (last - first == 1)
+            {
+                erase_member(first - members_.begin());
+                return;
+            }
+    #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
+            iterator it1 = members_.begin() + (first - members_.begin());
+            iterator it2 = members_.begin() + (last - members_.begin());
+            members_.erase(it1,it2);
+    #else
+            members_.erase(first,last);
+    #endif
+            build_index();
+        }
+
+        void erase(const string_view_type& name) 
+        {
+            std::size_t pos = find_pos(name);
+            if (pos != index_type::npos)
+            {
+                erase_member(pos);
+            }
+        }
+
+        template<class InputIt, class Convert>
+        void insert(InputIt first, InputIt last, Convert convert)
+        {
+            std::size_t count = std::distance(first,last);
+            reserve(members_.size() + count);
+            for (auto s = first; s != last; ++s)
+            {
+                members_.emplace_back(convert(*s));
+                // The first of duplicate keys is kept
+                std::size_t pos = find_pos(members_.back().key());
+                if (pos != index_type::npos && pos + 1 != members_.size())
+                {
+                    members_.pop_back();
+                }
+                else
+                {
+                    index_back();
+                }
+            }
+        }
+
+        template<class InputIt, class Convert>
+        void insert(sorted_unique_range_tag, InputIt first, InputIt last, Convert convert)
+        {
+            insert(first, last, convert);
+        }
+
+        // insert_or_assign
+
+        template <class T, class A=allocator_type>
+        typename std::enable_if<is_stateless<A>::value,std::pair<iterator,bool>>::type
+        insert_or_assign(const string_view_type& name, T&& value)
+        {
+            std::size_t pos = find_pos(name);
+            if (pos == index_type::npos)
+            {
+                members_.emplace_back(key_type(name.begin(), name.end()), std::forward<T>(value));
+                index_back();
+                return std::make_pair(members_.begin() + (members_.size() - 1),true);
+            }
+            else
+            {
+                auto it = members_.begin() + pos;
+                it->value(Json(std::forward<T>(value)));
+                return std::make_pair(it,false);
+            }
+        }
+
+        template <class T, class A=allocator_type>
+        typename std::enable_if<!is_stateless<A>::value,std::pair<iterator,bool>>::type
+        insert_or_assign(const string_view_type& name, T&& value)
+        {
+            std::size_t pos = find_pos(name);
+            if (pos == index_type::npos)
+            {
+                members_.emplace_back(key_type(name.begin(),name.end(),get_allocator()), 
+                                      std::forward<T>(value),get_allocator());
+                index_back();
+                return std::make_pair(members_.begin() + (members_.size() - 1),true);
+            }
+            else
+            {
+                auto it = members_.begin() + pos;
+                it->value(Json(std::forward<T>(value),get_allocator()));
+                return std::make_pair(it,false);
+            }
+        }
+
+        // Members are always appended, so the hint is not used
+
+        template <class T>
+        iterator insert_or_assign(iterator, const string_view_type& name, T&& value)
+        {
+            return insert_or_assign(name, std::forward<T>(value)).first;
+        }
+
+        // try_emplace
+
+        template <class A=allocator_type, class... Args>
+        typename std::enable_if<is_stateless<A>::value,std::pair<iterator,bool>>::type
+        try_emplace(const string_view_type& name, Args&&... args)
+        {
+            std::size_t pos = find_pos(name);
+            if (pos == index_type::npos)
+            {
+                members_.emplace_back(key_type(name.begin(), name.end()), std::forward<Args>(args)...);
+                index_back();
+                return std::make_pair(members_.begin() + (members_.size() - 1),true);
+            }
+            else
+            {
+                return std::make_pair(members_.begin() + pos,false);
+            }
+        }
+
+        template <class A=allocator_type, class... Args>
+        typename std::enable_if<!is_stateless<A>::value,std::pair<iterator,bool>>::type
+        try_emplace(const string_view_type& name, Args&&... args)
+        {
+            std::size_t pos = find_pos(name);
+            if (pos == index_type::npos)
+            {
+                members_.emplace_back(key_type(name.begin(),name.end(), get_allocator()), 
+                                      std::forward<Args>(args)...);
+                index_back();
+                return std::make_pair(members_.begin() + (members_.size() - 1),true);
+            }
+            else
+            {
+                return std::make_pair(members_.begin() + pos,false);
+            }
+        }
+
+        template <class ... Args>
+        iterator try_emplace(iterator, const string_view_type& name, Args&&... args)
+        {
+            return try_emplace(name, std::forward<Args>(args)...).first;
+        }
+
+        // merge
+
+        void merge(const json_object& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                try_emplace(it->key(),it->value());
+            }
+        }
+
+        void merge(json_object&& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                try_emplace(it->key(),std::move(it->value()));
+            }
+        }
+
+        void merge(iterator, const json_object& source)
+        {
+            merge(source);
+        }
+
+        void merge(iterator, json_object&& source)
+        {
+            merge(std::move(source));
+        }
+
+        // merge_or_update
+
+        void merge_or_update(const json_object& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                insert_or_assign(it->key(),it->value());
+            }
+        }
+
+        void merge_or_update(json_object&& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                insert_or_assign(it->key(),std::move(it->value()));
+            }
+        }
+
+        void merge_or_update(iterator, const json_object& source)
+        {
+            merge_or_update(source);
+        }
+
+        void merge_or_update(iterator, json_object&& source)
+        {
+            merge_or_update(std::move(source));
+        }
+
+        // Objects are equal if they have the same members, in any order
+
+        bool operator==(const json_object& rhs) const
+        {
+            if (members_.size() != rhs.members_.size())
+            {
+                return false;
+            }
+            for (const auto& member : members_)
+            {
+                std::size_t pos = rhs.find_pos(member.key());
+                if (pos == index_type::npos || !(rhs.members_[pos].value() == member.value()))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Compares the members in key order, so that the ordering agrees with operator==
+     
+        bool operator<(const json_object& rhs) const
+        {
+            std::vector<const key_value_type*> a = sorted_members();
+            std::vector<const key_value_type*> b = rhs.sorted_members();
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+                                                [](const key_value_type* x, const key_value_type* y) -> bool {return *x < *y;});
+        }
+    private:
+
+        static std::size_t hash_key(const string_view_type& name) noexcept
+        {
+            return jsoncons::detail::hash_chars(name.data(), name.length());
+        }
+
+        std::size_t find_pos(const string_view_type& name) const noexcept
+        {
+            if (index_.empty())
+            {
+                for (std::size_t i = 0; i < members_.size(); ++i)
+                {
+                    if (members_[i].key() == name)
+                    {
+                        return i;
+                    }
+                }
+                return index_type::npos;
+            }
+            return index_.find(hash_key(name), 
+                               [&](std::size_t pos) -> bool {return members_[pos].key() == name;});
+        }
+
+        // Indexes the last member, whose key is not already in the object
+
+        void index_back()
+        {
+            if (!index_.empty())
+            {
+                index_.insert(hash_key(members_.back().key()), members_.size() - 1);
+            }
+            else if (members_.size() > implementation_policy::hash_index_threshold)
+            {
+                build_index();
+            }
+        }
+
+        void build_index()
+        {
+            index_.clear();
+            if (members_.size() > implementation_policy::hash_index_threshold)
+            {
+                index_.reserve(members_.size());
+                for (std::size_t i = 0; i < members_.size(); ++i)
+                {
+                    index_.insert(hash_key(members_[i].key()), i);
+                }
+            }
+        }
+
+        void erase_member(std::size_t pos)
+        {
+            const std::size_t last = members_.size() - 1;
+            if (!index_.empty())
+            {
+                index_.erase(hash_key(members_[pos].key()), pos);
+                if (pos != last)
+                {
+                    index_.replace(hash_key(members_[last].key()), last, pos);
+                }
+            }
+            if (pos != last)
+            {
+                members_[pos] = std::move(members_[last]);
+            }
+            members_.pop_back();
+        }
+
+        std::vector<const key_value_type*> sorted_members() const
+        {
+            std::vector<const key_value_type*> v;
+            v.reserve(members_.size());
+            for (const auto& member : members_)
             {
-                index_.push_back(i);
+                v.push_back(std::addressof(member));
             }
-            std::stable_sort(index_.begin(),index_.end(),
-                             [&](std::size_t a, std::size_t b) -> bool {return members_.at(a).key().compare(members_.at(b).key()) < 0;});
+            std::sort(v.begin(), v.end(),
+                      [](const key_value_type* a, const key_value_type* b) -> bool {return a->key().compare(b->key()) < 0;});
+            return v;
         }
 
         json_object& operator=(const json_object&) = delete;
@@ -72,7 +72,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
                       const Allocator& alloc = Allocator(),
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          event_handler_(filter),
          buffer_(alloc),
@@ -200,7 +200,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler,
                       std::error_code& ec,
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          event_handler_(filter),
          eof_(false),
@@ -301,12 +301,79 @@ public:
         read_next(ec);
     }
 
+    void skip() override
+    {
+        std::error_code ec;
+        skip(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    // Finds the end of the object or array by matching brackets, without parsing what is inside
+    void skip(std::error_code& ec) override
+    {
+        if (event_handler_.event().event_type() != staj_event_type::begin_object &&
+            event_handler_.event().event_type() != staj_event_type::begin_array)
+        {
+            return;
+        }
+        parser_.begin_skip();
+        while (!parser_.skip_some())
+        {
+            if (!source_.eof())
+            {
+                read_buffer(ec);
+                if (ec) return;
+            }
+            if (parser_.source_exhausted())
+            {
+                eof_ = true;
+                ec = json_errc::unexpected_eof;
+                return;
+            }
+        }
+        read_next(ec);
+    }
+
     static bool accept_all(const basic_staj_event<CharT>&, const ser_context&) 
     {
         return true;
     }
 
     void read_buffer(std::error_code& ec)
+    {
+        read_buffer(ec, has_read_buffer<Src>());
+    }
+
+    // The source holds all of its input in memory, give it to the parser without copying
+    void read_buffer(std::error_code& ec, std::true_type)
+    {
+        auto s = source_.read_buffer();
+        if (s.size() == 0)
+        {
+            eof_ = true;
+        }
+        else if (begin_)
+        {
+            auto result = unicons::skip_bom(s.data(), s.data() + s.size());
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            std::size_t offset = result.it - s.data();
+            parser_.update(s.data()+offset,s.size()-offset);
+            begin_ = false;
+        }
+        else
+        {
+            parser_.update(s.data(),s.size());
+        }
+    }
+
+    void read_buffer(std::error_code& ec, std::false_type)
     {
         buffer_.clear();
         buffer_.resize(buffer_length_);
@@ -15,6 +15,8 @@
 #include <utility> // std::move
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_visitor.hpp>
+#include <jsoncons/typed_array_view.hpp>
+#include <jsoncons/detail/shared_key.hpp>
 
 namespace jsoncons {
 
@@ -80,6 +82,7 @@ private:
 
     Json result_;
 
+    jsoncons::detail::key_pool<key_type,temp_allocator_type> key_pool_;
     key_type name_;
     std::vector<stack_item,stack_item_allocator_type> item_stack_;
     std::vector<structure_info,structure_info_allocator_type> structure_stack_;
@@ -94,6 +97,7 @@ public:
           stack_item_allocator_(temp_alloc),
           size_t_allocator_(temp_alloc),
           result_(),
+          key_pool_(temp_alloc),
           name_(string_allocator_),
           item_stack_(stack_item_allocator_),
           structure_stack_(size_t_allocator_),
@@ -114,6 +118,7 @@ public:
           stack_item_allocator_(),
           size_t_allocator_(),
           result_(),
+          key_pool_(temp_allocator_type()),
           name_(string_allocator_),
           item_stack_(),
           structure_stack_(),
@@ -135,6 +140,7 @@ public:
           stack_item_allocator_(temp_alloc),
           size_t_allocator_(temp_alloc),
           result_(),
+          key_pool_(temp_alloc),
           name_(string_allocator_),
           item_stack_(stack_item_allocator_),
           structure_stack_(size_t_allocator_),
@@ -273,7 +279,7 @@ private:
 
     bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
     {
-        name_ = key_type(name.data(),name.length(),string_allocator_);
+        name_ = key_pool_.get(name.data(),name.length(),string_allocator_);
         return true;
     }
 
@@ -388,6 +394,25 @@ private:
         return true;
     }
 
+    bool visit_double_text(const string_view_type& text, 
+                           semantic_tag tag,   
+                           const ser_context&,
+                           std::error_code&) override
+    {
+        switch (structure_stack_.back().type_)
+        {
+            case structure_type::object_t:
+            case structure_type::array_t:
+                item_stack_.emplace_back(std::forward<key_type>(name_), double_text_arg, text, tag, string_allocator_);
+                break;
+            case structure_type::root_t:
+                result_ = Json(double_text_arg, text, tag, string_allocator_);
+                is_valid_ = true;
+                return false;
+        }
+        return true;
+    }
+
     bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
     {
         switch (structure_stack_.back().type_)
@@ -419,6 +444,111 @@ private:
         }
         return true;
     }
+    bool visit_typed_array(const span<const uint8_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(s.data(), s.size()), tag);
+    }
+
+    bool visit_typed_array(const span<const uint16_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(s.data(), s.size()), tag);
+    }
+
+    bool visit_typed_array(const span<const uint32_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(s.data(), s.size()), tag);
+    }
+
+    bool visit_typed_array(const span<const uint64_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(s.data(), s.size()), tag);
+    }
+
+    bool visit_typed_array(const span<const int8_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(s.data(), s.size()), tag);
+    }
+
+    bool visit_typed_array(const span<const int16_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(s.data(), s.size()), tag);
+    }
+
+    bool visit_typed_array(const span<const int32_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(s.data(), s.size()), tag);
+    }
+
+    bool visit_typed_array(const span<const int64_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(s.data(), s.size()), tag);
+    }
+
+    bool visit_typed_array(half_arg_t, 
+                           const span<const uint16_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(half_array_arg, s.data(), s.size()), tag);
+    }
+
+    bool visit_typed_array(const span<const float>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(s.data(), s.size()), tag);
+    }
+
+    bool visit_typed_array(const span<const double>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(typed_array_view(s.data(), s.size()), tag);
+    }
+
+    // Keeps the numbers of a typed array contiguous, rather than as an array of values
+    bool typed_array_value(const typed_array_view& view, semantic_tag tag)
+    {
+        switch (structure_stack_.back().type_)
+        {
+            case structure_type::object_t:
+            case structure_type::array_t:
+                item_stack_.emplace_back(std::forward<key_type>(name_), typed_array_arg, view, tag, array_allocator_);
+                break;
+            case structure_type::root_t:
+                result_ = Json(typed_array_arg, view, tag, array_allocator_);
+                is_valid_ = true;
+                return false;
+        }
+        return true;
+    }
 };
 
 }
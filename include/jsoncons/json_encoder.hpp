@@ -817,6 +817,39 @@ private:
         return true;
     }
 
+    bool visit_double_text(const string_view_type& text, 
+                           semantic_tag tag,
+                           const ser_context& context,
+                           std::error_code& ec) override
+    {
+        // Written as is, unless a float format or precision asks for the value to be reformatted
+        if (options_.float_format() != float_chars_format::general || options_.precision() != 0)
+        {
+            double value;
+            if (!jsoncons::detail::decimal_to_double(text.data(), text.length(), static_cast<CharT>('.'), value))
+            {
+                ec = json_errc::invalid_number;
+                return false;
+            }
+            return visit_double(value, tag, context, ec);
+        }
+        if (!stack_.empty()) 
+        {
+            if (stack_.back().is_array())
+            {
+                begin_scalar_value();
+            }
+            if (!stack_.back().is_multi_line() && column_ >= options_.line_length_limit())
+            {
+                break_line();
+            }
+        }
+        sink_.append(text.data(), text.length());
+        column_ += text.length();
+        end_value();
+        return true;
+    }
+
     bool visit_int64(int64_t value, 
                         semantic_tag,
                         const ser_context&,
@@ -1418,6 +1451,34 @@ private:
         return true;
     }
 
+    bool visit_double_text(const string_view_type& text, 
+                           semantic_tag tag,
+                           const ser_context& context,
+                           std::error_code& ec) override
+    {
+        // Written as is, unless a float format or precision asks for the value to be reformatted
+        if (options_.float_format() != float_chars_format::general || options_.precision() != 0)
+        {
+            double value;
+            if (!jsoncons::detail::decimal_to_double(text.data(), text.length(), static_cast<CharT>('.'), value))
+            {
+                ec = json_errc::invalid_number;
+                return false;
+            }
+            return visit_double(value, tag, context, ec);
+        }
+        if (!stack_.empty() && stack_.back().is_array() && stack_.back().count() > 0)
+        {
+            sink_.push_back(',');
+        }
+        sink_.append(text.data(), text.length());
+        if (!stack_.empty())
+        {
+            stack_.back().increment_count();
+        }
+        return true;
+    }
+
     bool visit_int64(int64_t value, 
                         semantic_tag,
                         const ser_context&,
@@ -325,9 +325,13 @@ public:
     using typename super_type::string_type;
 private:
     bool lossless_number_:1;
+    bool lazy_number_:1;
+    bool use_tape_parser_:1;
 public:
     basic_json_decode_options()
-        : lossless_number_(false)
+        : lossless_number_(false),
+          lazy_number_(false),
+          use_tape_parser_(false)
     {
     }
 
@@ -335,7 +339,9 @@ public:
 
     basic_json_decode_options(basic_json_decode_options&& other)
         : super_type(std::forward<basic_json_decode_options>(other)),
-                     lossless_number_(other.lossless_number_)
+                     lossless_number_(other.lossless_number_),
+                     lazy_number_(other.lazy_number_),
+                     use_tape_parser_(other.use_tape_parser_)
     {
     }
 
@@ -346,6 +352,16 @@ public:
         return lossless_number_;
     }
 
+    bool lazy_number() const 
+    {
+        return lazy_number_;
+    }
+
+    bool use_tape_parser() const 
+    {
+        return use_tape_parser_;
+    }
+
 #if !defined(JSONCONS_NO_DEPRECATED)
     JSONCONS_DEPRECATED_MSG("Instead, use lossless_number()")
     bool dec_to_str() const 
@@ -544,6 +560,8 @@ public:
     using basic_json_decode_options<CharT>::neginf_to_num;
 
     using basic_json_decode_options<CharT>::lossless_number;
+    using basic_json_decode_options<CharT>::lazy_number;
+    using basic_json_decode_options<CharT>::use_tape_parser;
 
     using basic_json_encode_options<CharT>::byte_string_format;
     using basic_json_encode_options<CharT>::bigint_format;
@@ -725,6 +743,18 @@ public:
         return *this;
     }
 
+    basic_json_options& lazy_number(bool value) 
+    {
+        this->lazy_number_ = value;
+        return *this;
+    }
+
+    basic_json_options& use_tape_parser(bool value) 
+    {
+        this->use_tape_parser_ = value;
+        return *this;
+    }
+
     basic_json_options& line_length_limit(std::size_t value)
     {
         this->line_length_limit_ = value;
@@ -15,12 +15,14 @@
 #include <unordered_map>
 #include <limits> // std::numeric_limits
 #include <functional> // std::function
+#include <algorithm> // std::replace
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_filter.hpp>
 #include <jsoncons/json_options.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -145,7 +147,10 @@ private:
     uint32_t cp_;
     uint32_t cp2_;
     std::size_t line_;
-    std::size_t column_;
+    // column() is derived from input_ptr_, so that consuming a character costs nothing
+    // beyond advancing the pointer. This is the column at begin_input_, which can be
+    // less than one when the line started within the input.
+    std::ptrdiff_t column_offset_;
     const CharT* begin_input_;
     const CharT* input_end_;
     const CharT* input_ptr_;
@@ -153,6 +158,13 @@ private:
     bool more_;
     bool done_;
 
+    // State of skip_some, which may stop at the end of the input and resume after update
+    std::size_t skip_level_;
+    bool skip_in_string_;
+    bool skip_escaped_;
+    bool skip_cr_;
+    json_parse_state skip_comment_; // slash, slash_slash, slash_star or slash_star_star within a comment, otherwise start
+
     std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type> string_buffer_;
     jsoncons::detail::string_to_double to_double_;
 
@@ -191,13 +203,18 @@ public:
          cp_(0),
          cp2_(0),
          line_(1),
-         column_(1),
+         column_offset_(1),
          begin_input_(nullptr),
          input_end_(nullptr),
          input_ptr_(nullptr),
          state_(json_parse_state::start),
          more_(true),
          done_(false),
+         skip_level_(0),
+         skip_in_string_(false),
+         skip_escaped_(false),
+         skip_cr_(false),
+         skip_comment_(json_parse_state::start),
          string_buffer_(alloc),
          state_stack_(alloc)
     {
@@ -252,30 +269,23 @@ public:
 
     void skip_space()
     {
-        const CharT* local_input_end = input_end_;
-        while (input_ptr_ != local_input_end) 
+        // Consumes a whole run of whitespace, counting line breaks in bulk.
+        // A carriage return at the end of the buffer enters the cr state,
+        // since a line feed at the start of the next buffer belongs to it.
+        std::size_t lines = 0;
+        const CharT* line_begin = input_ptr_;
+        const CharT* p = jsoncons::detail::skip_whitespace_run(input_ptr_, input_end_, lines, line_begin);
+        input_ptr_ = p;
+        if (lines > 0)
         {
-            switch (*input_ptr_)
-            {
-                case ' ':
-                case '\t':
-                    ++input_ptr_;
-                    ++column_;                     
-                    break;
-                case '\r': 
-                    push_state(state_);
-                    ++input_ptr_;
-                    ++column_;
-                    state_ = json_parse_state::cr;
-                    return; 
-                case '\n': 
-                    ++input_ptr_;
-                    ++line_;
-                    column_ = 1;
-                    return;   
-                default:
-                    return;
-            }
+            line_ += lines;
+            set_column((p - line_begin) + 1);
+        }
+        if (input_ptr_ != input_end_ && *input_ptr_ == '\r')
+        {
+            push_state(state_);
+            ++input_ptr_;
+            state_ = json_parse_state::cr;
         }
     }
 
@@ -289,11 +299,12 @@ public:
             {
                 case json_parse_state::cr:
                     ++line_;
-                    column_ = 1;
+                    set_column(1);
                     switch (*input_ptr_)
                     {
                         case '\n':
                             ++input_ptr_;
+                            set_column(1);
                             state_ = pop_state();
                             break;
                         default:
@@ -439,7 +450,7 @@ public:
         more_ = true;
         done_ = false;
         line_ = 1;
-        column_ = 1;
+        set_column(1);
         nesting_depth_ = 0;
     }
 
@@ -454,7 +465,7 @@ public:
         check_done(ec);
         if (ec)
         {
-            JSONCONS_THROW(ser_error(ec,line_,column_));
+            JSONCONS_THROW(ser_error(ec,line_,column()));
         }
     }
 
@@ -494,6 +505,7 @@ public:
 
     void update(const CharT* data, std::size_t length)
     {
+        column_offset_ += (input_ptr_ - begin_input_);
         begin_input_ = data;
         input_end_ = data + length;
         input_ptr_ = begin_input_;
@@ -505,7 +517,7 @@ public:
         parse_some(visitor, ec);
         if (ec)
         {
-            JSONCONS_THROW(ser_error(ec,line_,column_));
+            JSONCONS_THROW(ser_error(ec,line_,column()));
         }
     }
 
@@ -520,7 +532,7 @@ public:
         finish_parse(visitor, ec);
         if (ec)
         {
-            JSONCONS_THROW(ser_error(ec,line_,column_));
+            JSONCONS_THROW(ser_error(ec,line_,column()));
         }
     }
 
@@ -532,6 +544,159 @@ public:
         }
     }
 
+    // Prepares to skip the object or array whose begin_object or begin_array event was the 
+    // last one reported
+    void begin_skip()
+    {
+        JSONCONS_ASSERT(state_ == json_parse_state::expect_member_name_or_end || 
+                        state_ == json_parse_state::expect_value_or_end);
+        skip_level_ = 0;
+        skip_in_string_ = false;
+        skip_escaped_ = false;
+        skip_cr_ = false;
+        skip_comment_ = json_parse_state::start;
+    }
+
+    // Consumes the members or elements of the object or array being skipped without reporting 
+    // them, stopping at its closing brace or bracket, which the next call to parse_some reports.
+    // Only brackets, quotes and comments are looked at, strings and comments are scanned for 
+    // their end and nothing is decoded or validated. Returns false if the input ran out first, 
+    // after update it continues where it left off.
+    bool skip_some()
+    {
+        const CharT* p = input_ptr_;
+        const CharT* local_input_end = input_end_;
+        const CharT* line_begin = nullptr;
+        std::size_t lines = 0;
+        bool found = false;
+
+        while (p < local_input_end && !found)
+        {
+            if (skip_in_string_)
+            {
+                if (skip_escaped_)
+                {
+                    skip_escaped_ = false;
+                    ++p;
+                    continue;
+                }
+                p = jsoncons::detail::find_string_special(p, local_input_end);
+                if (p == local_input_end)
+                {
+                    break;
+                }
+                switch (*p)
+                {
+                    case '\"':
+                        skip_in_string_ = false;
+                        break;
+                    case '\\':
+                        skip_escaped_ = true;
+                        break;
+                    default: // a control character, not allowed here but not our concern
+                        break;
+                }
+                ++p;
+                skip_cr_ = false;
+                continue;
+            }
+            bool after_cr = skip_cr_;
+            skip_cr_ = false;
+            if (skip_comment_ != json_parse_state::start)
+            {
+                switch (skip_comment_)
+                {
+                    case json_parse_state::slash:
+                        if (*p != '*' && *p != '/')
+                        {
+                            // Not a comment, the character is looked at again
+                            skip_comment_ = json_parse_state::start;
+                            continue;
+                        }
+                        skip_comment_ = *p == '*' ? json_parse_state::slash_star : json_parse_state::slash_slash;
+                        break;
+                    case json_parse_state::slash_slash:
+                        if (*p == '\r' || *p == '\n')
+                        {
+                            // The end of the line is counted outside the comment
+                            skip_comment_ = json_parse_state::start;
+                            continue;
+                        }
+                        break;
+                    default: // slash_star or slash_star_star
+                        if (*p == '/' && skip_comment_ == json_parse_state::slash_star_star)
+                        {
+                            skip_comment_ = json_parse_state::start;
+                            break;
+                        }
+                        skip_comment_ = *p == '*' ? json_parse_state::slash_star_star : json_parse_state::slash_star;
+                        if (*p == '\r')
+                        {
+                            ++lines;
+                            line_begin = p + 1;
+                            skip_cr_ = true;
+                        }
+                        else if (*p == '\n')
+                        {
+                            if (!after_cr)
+                            {
+                                ++lines;
+                            }
+                            line_begin = p + 1;
+                        }
+                        break;
+                }
+                ++p;
+                continue;
+            }
+            switch (*p)
+            {
+                case '\"':
+                    skip_in_string_ = true;
+                    break;
+                case '/':
+                    skip_comment_ = json_parse_state::slash;
+                    break;
+                case '{':
+                case '[':
+                    ++skip_level_;
+                    break;
+                case '}':
+                case ']':
+                    if (skip_level_ == 0)
+                    {
+                        found = true;
+                        continue;
+                    }
+                    --skip_level_;
+                    break;
+                case '\r':
+                    ++lines;
+                    line_begin = p + 1;
+                    skip_cr_ = true;
+                    break;
+                case '\n':
+                    if (!after_cr)
+                    {
+                        ++lines;
+                    }
+                    line_begin = p + 1;
+                    break;
+                default:
+                    break;
+            }
+            ++p;
+        }
+
+        input_ptr_ = p;
+        line_ += lines;
+        if (line_begin != nullptr)
+        {
+            set_column((p - line_begin) + 1);
+        }
+        return found;
+    }
+
     void parse_some_(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
         if (state_ == json_parse_state::before_done)
@@ -593,11 +758,12 @@ public:
                     break;
                 case json_parse_state::cr:
                     ++line_;
-                    column_ = 1;
+                    set_column(1);
                     switch (*input_ptr_)
                     {
                         case '\n':
                             ++input_ptr_;
+                            set_column(1);
                             state_ = pop_state();
                             break;
                         default:
@@ -617,23 +783,11 @@ public:
                                     return;
                                 }
                                 break;
-                            case '\r': 
-                                push_state(state_);
-                                ++input_ptr_;
-                                ++column_;
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/': 
                                 ++input_ptr_;
-                                ++column_;
                                 push_state(state_);
                                 state_ = json_parse_state::slash;
                                 break;
@@ -641,18 +795,15 @@ public:
                                 begin_object(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case '[':
                                 begin_array(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case '\"':
                                 state_ = json_parse_state::string;
                                 ++input_ptr_;
-                                ++column_;
                                 string_buffer_.clear();
                                 parse_string(visitor, ec);
                                 if (ec) return;
@@ -661,7 +812,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back('-');
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::minus;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -671,7 +821,6 @@ public:
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 state_ = json_parse_state::zero;
                                 ++input_ptr_;
-                                ++column_;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
                                 break;
@@ -679,7 +828,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::integer;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -727,25 +875,12 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
-                            case '\r': 
-                                ++input_ptr_;
-                                ++column_;
-                                push_state(state_);
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/':
                                 ++input_ptr_;
-                                ++column_;
                                 push_state(state_); 
                                 state_ = json_parse_state::slash;
                                 break;
@@ -753,19 +888,16 @@ public:
                                 end_object(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case ']':
                                 end_array(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case ',':
                                 begin_member_or_element(ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             default:
                                 if (parent() == json_parse_state::array)
@@ -787,7 +919,6 @@ public:
                                     }
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                         }
                     }
@@ -804,25 +935,12 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
-                            case '\r': 
-                                ++input_ptr_;
-                                ++column_;
-                                push_state(state_);
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/':
                                 ++input_ptr_;
-                                ++column_;
                                 push_state(state_); 
                                 state_ = json_parse_state::slash;
                                 break;
@@ -830,11 +948,9 @@ public:
                                 end_object(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case '\"':
                                 ++input_ptr_;
-                                ++column_;
                                 push_state(json_parse_state::member_name);
                                 state_ = json_parse_state::string;
                                 string_buffer_.clear();
@@ -849,7 +965,6 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             default:
                                 more_ = err_handler_(json_errc::expected_name, *this);
@@ -859,7 +974,6 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                         }
                     }
@@ -876,31 +990,17 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
-                            case '\r': 
-                                ++input_ptr_;
-                                ++column_;
-                                push_state(state_);
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/': 
                                 ++input_ptr_;
-                                ++column_;
                                 push_state(state_);
                                 state_ = json_parse_state::slash;
                                 break;
                             case '\"':
                                 ++input_ptr_;
-                                ++column_;
                                 push_state(json_parse_state::member_name);
                                 state_ = json_parse_state::string;
                                 string_buffer_.clear();
@@ -917,7 +1017,6 @@ public:
                                 end_object(visitor, ec);  // Recover
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case '\'':
                                 more_ = err_handler_(json_errc::single_quote, *this);
@@ -927,7 +1026,6 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             default:
                                 more_ = err_handler_(json_errc::expected_name, *this);
@@ -937,7 +1035,6 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                         }
                     }
@@ -954,32 +1051,18 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
-                            case '\r': 
-                                push_state(state_);
-                                state_ = json_parse_state::cr;
-                                ++input_ptr_;
-                                ++column_;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/': 
                                 push_state(state_);
                                 state_ = json_parse_state::slash;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case ':':
                                 state_ = json_parse_state::expect_value;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             default:
                                 more_ = err_handler_(json_errc::expected_colon, *this);
@@ -989,7 +1072,6 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                         }
                     }
@@ -1007,43 +1089,27 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
-                            case '\r': 
-                                push_state(state_);
-                                ++input_ptr_;
-                                ++column_;
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/': 
                                 push_state(state_);
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::slash;
                                 break;
                             case '{':
                                 begin_object(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case '[':
                                 begin_array(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case '\"':
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::string;
                                 string_buffer_.clear();
                                 parse_string(visitor, ec);
@@ -1053,7 +1119,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back('-');
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::minus;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1062,7 +1127,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::zero;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1071,7 +1135,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::integer;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1110,7 +1173,6 @@ public:
                                     }
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case '\'':
                                 more_ = err_handler_(json_errc::single_quote, *this);
@@ -1120,7 +1182,6 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             default:
                                 more_ = err_handler_(json_errc::expected_value, *this);
@@ -1130,7 +1191,6 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                         }
                     }
@@ -1147,25 +1207,12 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
-                            case '\r': 
-                                ++input_ptr_;
-                                ++column_;
-                                push_state(state_);
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/': 
                                 ++input_ptr_;
-                                ++column_;
                                 push_state(state_);
                                 state_ = json_parse_state::slash;
                                 break;
@@ -1173,23 +1220,19 @@ public:
                                 begin_object(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case '[':
                                 begin_array(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case ']':
                                 end_array(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             case '\"':
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::string;
                                 string_buffer_.clear();
                                 parse_string(visitor, ec);
@@ -1199,7 +1242,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back('-');
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::minus;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1208,7 +1250,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::zero;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1217,7 +1258,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 ++input_ptr_;
-                                ++column_;
                                 state_ = json_parse_state::integer;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1242,7 +1282,6 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             default:
                                 more_ = err_handler_(json_errc::expected_value, *this);
@@ -1252,7 +1291,6 @@ public:
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++column_;
                                 break;
                             }
                         }
@@ -1288,7 +1326,6 @@ public:
                     {
                         case 'r':
                             ++input_ptr_;
-                            ++column_;
                             state_ = json_parse_state::tr;
                             break;
                         default:
@@ -1311,7 +1348,6 @@ public:
                             return;
                     }
                     ++input_ptr_;
-                    ++column_;
                     break;
                 case json_parse_state::tru: 
                     switch (*input_ptr_)
@@ -1334,14 +1370,12 @@ public:
                             return;
                     }
                     ++input_ptr_;
-                    ++column_;
                     break;
                 case json_parse_state::f: 
                     switch (*input_ptr_)
                     {
                         case 'a':
                             ++input_ptr_;
-                            ++column_;
                             state_ = json_parse_state::fa;
                             break;
                         default:
@@ -1364,7 +1398,6 @@ public:
                             return;
                     }
                     ++input_ptr_;
-                    ++column_;
                     break;
                 case json_parse_state::fal: 
                     switch (*input_ptr_)
@@ -1379,7 +1412,6 @@ public:
                             return;
                     }
                     ++input_ptr_;
-                    ++column_;
                     break;
                 case json_parse_state::fals: 
                     switch (*input_ptr_)
@@ -1402,14 +1434,12 @@ public:
                             return;
                     }
                     ++input_ptr_;
-                    ++column_;
                     break;
                 case json_parse_state::n: 
                     switch (*input_ptr_)
                     {
                         case 'u':
                             ++input_ptr_;
-                            ++column_;
                             state_ = json_parse_state::nu;
                             break;
                         default:
@@ -1432,7 +1462,6 @@ public:
                             return;
                     }
                     ++input_ptr_;
-                    ++column_;
                     break;
                 case json_parse_state::nul: 
                     switch (*input_ptr_)
@@ -1455,7 +1484,6 @@ public:
                         return;
                     }
                     ++input_ptr_;
-                    ++column_;
                     break;
                 case json_parse_state::slash: 
                 {
@@ -1489,7 +1517,6 @@ public:
                         break;
                     }
                     ++input_ptr_;
-                    ++column_;
                     break;
                 }
                 case json_parse_state::slash_star:  
@@ -1502,14 +1529,13 @@ public:
                         break;
                     case '\n':
                         ++line_;
-                        column_ = 1;
+                        set_column(1);
                         break;
                     case '*':
                         state_ = json_parse_state::slash_star_star;
                         break;
                     }
                     ++input_ptr_;
-                    ++column_;
                     break;
                 }
                 case json_parse_state::slash_slash: 
@@ -1524,7 +1550,6 @@ public:
                         break;
                     default:
                         ++input_ptr_;
-                        ++column_;
                     }
                     break;
                 }
@@ -1540,7 +1565,6 @@ public:
                         break;
                     }
                     ++input_ptr_;
-                    ++column_;
                     break;
                 }
                 default:
@@ -1558,7 +1582,6 @@ public:
             {
                 more_ = visitor.bool_value(true, semantic_tag::none, *this, ec);
                 input_ptr_ += 4;
-                column_ += 4;
                 if (parent() == json_parse_state::root)
                 {
                     state_ = json_parse_state::before_done;
@@ -1579,7 +1602,6 @@ public:
         else
         {
             ++input_ptr_;
-            ++column_;
             state_ = json_parse_state::t;
         }
     }
@@ -1592,7 +1614,6 @@ public:
             {
                 more_ = visitor.null_value(semantic_tag::none, *this, ec);
                 input_ptr_ += 4;
-                column_ += 4;
                 if (parent() == json_parse_state::root)
                 {
                     state_ = json_parse_state::before_done;
@@ -1613,7 +1634,6 @@ public:
         else
         {
             ++input_ptr_;
-            ++column_;
             state_ = json_parse_state::n;
         }
     }
@@ -1626,7 +1646,6 @@ public:
             {
                 more_ = visitor.bool_value(false, semantic_tag::none, *this, ec);
                 input_ptr_ += 5;
-                column_ += 5;
                 if (parent() == json_parse_state::root)
                 {
                     state_ = json_parse_state::before_done;
@@ -1647,7 +1666,6 @@ public:
         else
         {
             ++input_ptr_;
-            ++column_;
             state_ = json_parse_state::f;
         }
     }
@@ -1688,12 +1706,10 @@ minus_sign:
             case '0': 
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto zero;
             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto integer;
             default:
                 err_handler_(json_errc::expected_value, *this);
@@ -1713,7 +1729,6 @@ zero:
                 end_integer_value(visitor, ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++column_;
                 push_state(state_);
                 state_ = json_parse_state::cr;
                 return; 
@@ -1722,7 +1737,7 @@ zero:
                 if (ec) return;
                 ++input_ptr_;
                 ++line_;
-                column_ = 1;
+                set_column(1);
                 return;   
             case ' ':case '\t':
                 end_integer_value(visitor, ec);
@@ -1733,7 +1748,6 @@ zero:
                 end_integer_value(visitor, ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++column_;
                 push_state(state_);
                 state_ = json_parse_state::slash;
                 return;
@@ -1750,12 +1764,10 @@ zero:
             case '.':
                 string_buffer_.push_back(to_double_.get_decimal_point());
                 ++input_ptr_;
-                ++column_;
                 goto fraction1;
             case 'e':case 'E':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto exp1;
             case ',':
                 end_integer_value(visitor, ec);
@@ -1763,7 +1775,6 @@ zero:
                 begin_member_or_element(ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++column_;
                 return;
             case '0': case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 err_handler_(json_errc::leading_zero, *this);
@@ -1791,7 +1802,6 @@ integer:
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
-                ++column_;
                 state_ = json_parse_state::cr;
                 return; 
             case '\n': 
@@ -1799,7 +1809,7 @@ integer:
                 if (ec) return;
                 ++input_ptr_;
                 ++line_;
-                column_ = 1;
+                set_column(1);
                 return;   
             case ' ':case '\t':
                 end_integer_value(visitor, ec);
@@ -1811,7 +1821,6 @@ integer:
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
-                ++column_;
                 state_ = json_parse_state::slash;
                 return;
             case '}':
@@ -1827,17 +1836,14 @@ integer:
             case '0': case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto integer;
             case '.':
                 string_buffer_.push_back(to_double_.get_decimal_point());
                 ++input_ptr_;
-                ++column_;
                 goto fraction1;
             case 'e':case 'E':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto exp1;
             case ',':
                 end_integer_value(visitor, ec);
@@ -1845,7 +1851,6 @@ integer:
                 begin_member_or_element(ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++column_;
                 return;
             default:
                 err_handler_(json_errc::invalid_number, *this);
@@ -1865,7 +1870,6 @@ fraction1:
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto fraction2;
             default:
                 err_handler_(json_errc::invalid_number, *this);
@@ -1887,7 +1891,6 @@ fraction2:
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
-                ++column_;
                 state_ = json_parse_state::cr;
                 return; 
             case '\n': 
@@ -1895,7 +1898,7 @@ fraction2:
                 if (ec) return;
                 ++input_ptr_;
                 ++line_;
-                column_ = 1;
+                set_column(1);
                 return;   
             case ' ':case '\t':
                 end_fraction_value(visitor, ec);
@@ -1907,7 +1910,6 @@ fraction2:
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
-                ++column_;
                 state_ = json_parse_state::slash;
                 return;
             case '}':
@@ -1926,17 +1928,14 @@ fraction2:
                 begin_member_or_element(ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++column_;
                 return;
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto fraction2;
             case 'e':case 'E':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto exp1;
             default:
                 err_handler_(json_errc::invalid_number, *this);
@@ -1954,18 +1953,19 @@ exp1:
         switch (*input_ptr_)
         {
             case '+':
+                if (options_.lazy_number())
+                {
+                    string_buffer_.push_back('+'); // kept so that the text is passed on as written
+                }
                 ++input_ptr_;
-                ++column_;
                 goto exp2;
             case '-':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto exp2;
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto exp3;
             default:
                 err_handler_(json_errc::expected_value, *this);
@@ -1985,7 +1985,6 @@ exp2:
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto exp3;
             default:
                 err_handler_(json_errc::expected_value, *this);
@@ -2007,7 +2006,6 @@ exp3:
                 end_fraction_value(visitor, ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++column_;
                 push_state(state_);
                 state_ = json_parse_state::cr;
                 return; 
@@ -2016,7 +2014,7 @@ exp3:
                 if (ec) return;
                 ++input_ptr_;
                 ++line_;
-                column_ = 1;
+                set_column(1);
                 return;   
             case ' ':case '\t':
                 end_fraction_value(visitor, ec);
@@ -2028,7 +2026,6 @@ exp3:
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
-                ++column_;
                 state_ = json_parse_state::slash;
                 return;
             case '}':
@@ -2047,12 +2044,10 @@ exp3:
                 begin_member_or_element(ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++column_;
                 return;
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++column_;
                 goto exp3;
             default:
                 err_handler_(json_errc::invalid_number, *this);
@@ -2103,11 +2098,17 @@ exp3:
 string_u1:
         while (input_ptr_ < local_input_end)
         {
+            // Jump over plain content to the next quote, backslash or control character
+            input_ptr_ = jsoncons::detail::find_string_special(input_ptr_, local_input_end);
+            if (input_ptr_ == local_input_end)
+            {
+                break;
+            }
             switch (*input_ptr_)
             {
                 JSONCONS_ILLEGAL_CONTROL_CHARACTER:
                 {
-                    column_ += (input_ptr_ - sb + 1);
+                    ++column_offset_; // reported one past the character
                     more_ = err_handler_(json_errc::illegal_control_character, *this);
                     if (!more_)
                     {
@@ -2116,6 +2117,7 @@ string_u1:
                         return;
                     }
                     // recovery - skip
+                    --column_offset_;
                     string_buffer_.append(sb,input_ptr_-sb);
                     ++input_ptr_;
                     state_ = json_parse_state::string;
@@ -2123,7 +2125,7 @@ string_u1:
                 }
                 case '\r':
                 {
-                    column_ += (input_ptr_ - sb + 1);
+                    ++column_offset_; // reported one past the character
                     more_ = err_handler_(json_errc::illegal_character_in_string, *this);
                     if (!more_)
                     {
@@ -2132,6 +2134,7 @@ string_u1:
                         return;
                     }
                     // recovery - keep
+                    --column_offset_;
                     string_buffer_.append(sb, input_ptr_ - sb + 1);
                     ++input_ptr_;
                     push_state(state_);
@@ -2141,7 +2144,7 @@ string_u1:
                 case '\n':
                 {
                     ++line_;
-                    column_ = 1;
+                    set_column(1);
                     more_ = err_handler_(json_errc::illegal_character_in_string, *this);
                     if (!more_)
                     {
@@ -2152,11 +2155,12 @@ string_u1:
                     // recovery - keep
                     string_buffer_.append(sb, input_ptr_ - sb + 1);
                     ++input_ptr_;
+                    set_column(1);
                     return;
                 }
                 case '\t':
                 {
-                    column_ += (input_ptr_ - sb + 1);
+                    ++column_offset_; // reported one past the character
                     more_ = err_handler_(json_errc::illegal_character_in_string, *this);
                     if (!more_)
                     {
@@ -2165,6 +2169,7 @@ string_u1:
                         return;
                     }
                     // recovery - keep
+                    --column_offset_;
                     string_buffer_.append(sb, input_ptr_ - sb + 1);
                     ++input_ptr_;
                     state_ = json_parse_state::string;
@@ -2173,12 +2178,14 @@ string_u1:
                 case '\\': 
                 {
                     string_buffer_.append(sb,input_ptr_-sb);
-                    column_ += (input_ptr_ - sb + 1);
                     ++input_ptr_;
                     goto escape;
                 }
                 case '\"':
                 {
+                    // The value is reported at the column where the text in this input began
+                    const std::ptrdiff_t length = input_ptr_ - sb;
+                    column_offset_ -= length;
                     if (string_buffer_.length() == 0)
                     {
                         end_string_value(sb,input_ptr_-sb, visitor, ec);
@@ -2190,7 +2197,7 @@ string_u1:
                         end_string_value(string_buffer_.data(),string_buffer_.length(), visitor, ec);
                         if (ec) {return;}
                     }
-                    column_ += (input_ptr_ - sb + 1);
+                    column_offset_ += length;
                     ++input_ptr_;
                     return;
                 }
@@ -2203,7 +2210,7 @@ string_u1:
         // Buffer exhausted               
         {
             string_buffer_.append(sb,input_ptr_-sb);
-            column_ += (input_ptr_ - sb + 1);
+            ++column_offset_; // one past the last character read, as always reported here
             state_ = json_parse_state::string;
             return;
         }
@@ -2219,47 +2226,38 @@ escape:
         case '\"':
             string_buffer_.push_back('\"');
             sb = ++input_ptr_;
-            ++column_;
             goto string_u1;
         case '\\': 
             string_buffer_.push_back('\\');
             sb = ++input_ptr_;
-            ++column_;
             goto string_u1;
         case '/':
             string_buffer_.push_back('/');
             sb = ++input_ptr_;
-            ++column_;
             goto string_u1;
         case 'b':
             string_buffer_.push_back('\b');
             sb = ++input_ptr_;
-            ++column_;
             goto string_u1;
         case 'f':
             string_buffer_.push_back('\f');
             sb = ++input_ptr_;
-            ++column_;
             goto string_u1;
         case 'n':
             string_buffer_.push_back('\n');
             sb = ++input_ptr_;
-            ++column_;
             goto string_u1;
         case 'r':
             string_buffer_.push_back('\r');
             sb = ++input_ptr_;
-            ++column_;
             goto string_u1;
         case 't':
             string_buffer_.push_back('\t');
             sb = ++input_ptr_;
-            ++column_;
             goto string_u1;
         case 'u':
             cp_ = 0;
             ++input_ptr_;
-            ++column_;
             goto escape_u1;
         default:    
             err_handler_(json_errc::illegal_escaped_character, *this);
@@ -2283,7 +2281,6 @@ escape_u1:
                 return;
             }
             ++input_ptr_;
-            ++column_;
             goto escape_u2;
         }
 
@@ -2301,7 +2298,6 @@ escape_u2:
                 return;
             }
             ++input_ptr_;
-            ++column_;
             goto escape_u3;
         }
 
@@ -2319,7 +2315,6 @@ escape_u3:
                 return;
             }
             ++input_ptr_;
-            ++column_;
             goto escape_u4;
         }
 
@@ -2339,14 +2334,12 @@ escape_u4:
             if (unicons::is_high_surrogate(cp_))
             {
                 ++input_ptr_;
-                ++column_;
                 goto escape_expect_surrogate_pair1;
             }
             else
             {
                 unicons::convert(&cp_, &cp_ + 1, std::back_inserter(string_buffer_));
                 sb = ++input_ptr_;
-                ++column_;
                 state_ = json_parse_state::string;
                 return;
             }
@@ -2364,7 +2357,6 @@ escape_expect_surrogate_pair1:
             case '\\': 
                 cp2_ = 0;
                 ++input_ptr_;
-                ++column_;
                 goto escape_expect_surrogate_pair2;
             default:
                 err_handler_(json_errc::expected_codepoint_surrogate_pair, *this);
@@ -2386,7 +2378,6 @@ escape_expect_surrogate_pair2:
             {
             case 'u':
                 ++input_ptr_;
-                ++column_;
                 goto escape_u6;
             default:
                 err_handler_(json_errc::expected_codepoint_surrogate_pair, *this);
@@ -2412,7 +2403,6 @@ escape_u6:
             }
         }
         ++input_ptr_;
-        ++column_;
         goto escape_u7;
 
 escape_u7:
@@ -2429,7 +2419,6 @@ escape_u7:
                 return;
             }
             ++input_ptr_;
-            ++column_;
             goto escape_u8;
         }
 
@@ -2447,7 +2436,6 @@ escape_u8:
                 return;
             }
             ++input_ptr_;
-            ++column_;
             goto escape_u9;
         }
 
@@ -2467,7 +2455,6 @@ escape_u9:
             uint32_t cp = 0x10000 + ((cp_ & 0x3FF) << 10) + (cp2_ & 0x3FF);
             unicons::convert(&cp, &cp + 1, std::back_inserter(string_buffer_));
             sb = ++input_ptr_;
-            ++column_;
             goto string_u1;
         }
 
@@ -2532,7 +2519,7 @@ escape_u9:
         finish_parse(visitor, ec);
         if (ec)
         {
-            JSONCONS_THROW(ser_error(ec,line_,column_));
+            JSONCONS_THROW(ser_error(ec,line_,column()));
         }
     }
 
@@ -2548,6 +2535,7 @@ escape_u9:
     JSONCONS_DEPRECATED_MSG("Instead, use update(const CharT*, std::size_t)")
     void set_source(const CharT* data, std::size_t length)
     {
+        column_offset_ += (input_ptr_ - begin_input_);
         begin_input_ = data;
         input_end_ = data + length;
         input_ptr_ = begin_input_;
@@ -2561,10 +2549,16 @@ escape_u9:
 
     std::size_t column() const override
     {
-        return column_;
+        return static_cast<std::size_t>((input_ptr_ - begin_input_) + column_offset_);
     }
 private:
 
+    // Sets the column of the character at input_ptr_
+    void set_column(std::size_t value)
+    {
+        column_offset_ = static_cast<std::ptrdiff_t>(value) - (input_ptr_ - begin_input_);
+    }
+
     void end_integer_value(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
         if (string_buffer_[0] == '-')
@@ -2613,6 +2607,15 @@ private:
             {
                 more_ = visitor.string_value(string_buffer_, semantic_tag::bigdec, *this, ec);
             }
+            else if (options_.lazy_number())
+            {
+                // The text is passed on with a '.' decimal point, whatever the locale
+                if (to_double_.get_decimal_point() != '.')
+                {
+                    std::replace(string_buffer_.begin(), string_buffer_.end(), static_cast<CharT>(to_double_.get_decimal_point()), static_cast<CharT>('.'));
+                }
+                more_ = visitor.double_text_value(string_buffer_, semantic_tag::none, *this, ec);
+            }
             else
             {
                 double d = to_double_(string_buffer_.c_str(), string_buffer_.length());
@@ -2683,7 +2686,7 @@ private:
         if (result.ec != unicons::conv_errc())
         {
             translate_conv_errc(result.ec,ec);
-            column_ += (result.it - s);
+            column_offset_ += (result.it - s);
             return;
         }
         switch (parent())
@@ -481,6 +481,37 @@ public:
 private:
 
     void read_buffer(std::error_code& ec)
+    {
+        read_buffer(ec, has_read_buffer<Src>());
+    }
+
+    // The source holds all of its input in memory, give it to the parser without copying
+    void read_buffer(std::error_code& ec, std::true_type)
+    {
+        auto s = source_.read_buffer();
+        if (s.size() == 0)
+        {
+            eof_ = true;
+        }
+        else if (begin_)
+        {
+            auto result = unicons::skip_bom(s.data(), s.data() + s.size());
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            std::size_t offset = result.it - s.data();
+            parser_.update(s.data()+offset,s.size()-offset);
+            begin_ = false;
+        }
+        else
+        {
+            parser_.update(s.data(),s.size());
+        }
+    }
+
+    void read_buffer(std::error_code& ec, std::false_type)
     {
         buffer_.clear();
         buffer_.resize(buffer_length_);
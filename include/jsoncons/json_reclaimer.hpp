@@ -0,0 +1,117 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_RECLAIMER_HPP
+#define JSONCONS_JSON_RECLAIMER_HPP
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <utility> // std::move
+
+namespace jsoncons {
+
+// Destroys json values on a background thread, so that the thread that is done with
+// a large value does not pay for freeing it. reclaim() moves the value to a queue and
+// returns at once. Values that hold no heap memory are left with the caller.
+//
+// The values must not share anything with values still in use on other threads,
+// e.g. an allocator that is not thread safe.
+
+template <class Json>
+class json_reclaimer
+{
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable idle_;
+    std::deque<Json> queue_;
+    bool busy_;
+    bool stop_;
+    std::thread thread_;
+
+    // Noncopyable and nonmoveable
+    json_reclaimer(const json_reclaimer&) = delete;
+    json_reclaimer& operator=(const json_reclaimer&) = delete;
+public:
+    json_reclaimer()
+        : busy_(false), stop_(false)
+    {
+        thread_ = std::thread([this]() {run();});
+    }
+
+    // Destroys the values still pending, then stops the thread
+
+    ~json_reclaimer() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_available_.notify_one();
+        thread_.join();
+    }
+
+    void reclaim(Json&& val)
+    {
+        if (!val.is_array() && !val.is_object() && !val.is_string() && !val.is_byte_string())
+        {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.emplace_back(std::move(val));
+        }
+        work_available_.notify_one();
+    }
+
+    // Number of values waiting to be destroyed, not counting one being destroyed
+
+    std::size_t pending()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size();
+    }
+
+    // Waits until all the values passed to reclaim have been destroyed
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this]() {return queue_.empty() && !busy_;});
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            work_available_.wait(lock, [this]() {return stop_ || !queue_.empty();});
+            if (queue_.empty())
+            {
+                return;
+            }
+            {
+                Json val(std::move(queue_.front()));
+                queue_.pop_front();
+                busy_ = true;
+                lock.unlock();
+            }
+            lock.lock();
+            busy_ = false;
+            if (queue_.empty())
+            {
+                idle_.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,921 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_TAPE_PARSER_HPP
+#define JSONCONS_JSON_TAPE_PARSER_HPP
+
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <system_error>
+#include <limits> // std::numeric_limits
+#include <functional> // std::function
+#include <algorithm> // std::find_if
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+    inline
+    int count_trailing_zeros64(uint64_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(mask);
+    #elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return static_cast<int>(index);
+    #else
+        int n = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    // Each bit of the result is the xor of all bits of x at or below it,
+    // so for a mask of quotes it is set from an opening quote up to,
+    // but not including, the closing quote
+    inline
+    uint64_t prefix_xor(uint64_t x)
+    {
+        x ^= x << 1;
+        x ^= x << 2;
+        x ^= x << 4;
+        x ^= x << 8;
+        x ^= x << 16;
+        x ^= x << 32;
+        return x;
+    }
+
+    struct structural_block_masks
+    {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t op;
+        uint64_t whitespace;
+    };
+
+    template <class CharT>
+    structural_block_masks classify_block(const CharT* p)
+    {
+        structural_block_masks masks = {0,0,0,0};
+        for (int i = 0; i < 64; ++i)
+        {
+            uint64_t bit = uint64_t(1) << i;
+            switch (p[i])
+            {
+                case '\"':
+                    masks.quote |= bit;
+                    break;
+                case '\\':
+                    masks.backslash |= bit;
+                    break;
+                case '{': case '}': case '[': case ']': case ':': case ',':
+                    masks.op |= bit;
+                    break;
+                case ' ': case '\t': case '\n': case '\r':
+                    masks.whitespace |= bit;
+                    break;
+                default:
+                    break;
+            }
+        }
+        return masks;
+    }
+
+#if defined(JSONCONS_HAS_SSE2)
+
+    inline
+    structural_block_masks classify_block(const char* p)
+    {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i lbrace = _mm_set1_epi8('{');
+        const __m128i rbrace = _mm_set1_epi8('}');
+        const __m128i lbracket = _mm_set1_epi8('[');
+        const __m128i rbracket = _mm_set1_epi8(']');
+        const __m128i colon = _mm_set1_epi8(':');
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+
+        structural_block_masks masks = {0,0,0,0};
+        for (int i = 0; i < 4; ++i)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16*i));
+            __m128i op = _mm_or_si128(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, lbrace), _mm_cmpeq_epi8(block, rbrace)),
+                                                   _mm_or_si128(_mm_cmpeq_epi8(block, lbracket), _mm_cmpeq_epi8(block, rbracket))),
+                                      _mm_or_si128(_mm_cmpeq_epi8(block, colon), _mm_cmpeq_epi8(block, comma)));
+            __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)),
+                                      _mm_or_si128(_mm_cmpeq_epi8(block, lf), _mm_cmpeq_epi8(block, cr)));
+            int shift = 16*i;
+            masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, quote)))) << shift;
+            masks.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, backslash)))) << shift;
+            masks.op |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(op))) << shift;
+            masks.whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(ws))) << shift;
+        }
+        return masks;
+    }
+
+#endif // JSONCONS_HAS_SSE2
+
+    // Stage one of the tape parser: finds the positions of all structural characters
+    // outside strings, all opening quotes, and the first character of every other
+    // token (numbers, literals, and anything invalid), 64 characters at a time.
+
+    template <class CharT,class Allocator>
+    void find_structural_indices(const CharT* data, std::size_t length,
+                                 std::vector<std::size_t,Allocator>& indices)
+    {
+        uint64_t prev_in_string = 0; // all ones if the previous block ended inside a string
+        bool prev_escaped = false;   // the previous block ended with an unescaped backslash
+        uint64_t prev_scalar = 0;    // the previous block ended inside a scalar token
+
+        CharT tail[64];
+        for (std::size_t base = 0; base < length; base += 64)
+        {
+            const CharT* p = data + base;
+            if (length - base < 64)
+            {
+                std::size_t n = length - base;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    tail[i] = p[i];
+                }
+                for (std::size_t i = n; i < 64; ++i)
+                {
+                    tail[i] = ' ';
+                }
+                p = tail;
+            }
+            structural_block_masks masks = classify_block(p);
+
+            uint64_t escaped = prev_escaped ? 1 : 0;
+            uint64_t backslash = masks.backslash & ~escaped;
+            prev_escaped = false;
+            while (backslash != 0)
+            {
+                int i = count_trailing_zeros64(backslash);
+                backslash &= ~(uint64_t(1) << i);
+                if (i == 63)
+                {
+                    prev_escaped = true;
+                }
+                else
+                {
+                    escaped |= uint64_t(1) << (i+1);
+                    backslash &= ~(uint64_t(1) << (i+1));
+                }
+            }
+
+            uint64_t quote = masks.quote & ~escaped;
+            uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+            prev_in_string = (in_string >> 63) != 0 ? ~uint64_t(0) : 0;
+
+            uint64_t scalar = ~(masks.op | masks.whitespace | quote) & ~in_string;
+            uint64_t scalar_start = scalar & ~((scalar << 1) | prev_scalar);
+            prev_scalar = scalar >> 63;
+
+            uint64_t bits = (masks.op & ~in_string) | (quote & in_string) | scalar_start;
+            while (bits != 0)
+            {
+                indices.push_back(base + count_trailing_zeros64(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+} // namespace detail
+
+// basic_json_tape_parser parses a complete JSON text held in memory in two stages.
+// Stage one builds an index of the structural characters with SIMD bitmask operations,
+// stage two walks the index and emits the same basic_json_visitor events as basic_json_parser.
+// Errors are reported but not recovered from, and comments are not supported.
+
+template <class CharT, class TempAllocator = std::allocator<char>>
+class basic_json_tape_parser : public ser_context
+{
+public:
+    using char_type = CharT;
+    using string_view_type = typename basic_json_visitor<CharT>::string_view_type;
+private:
+    struct string_maps_to_double
+    {
+        string_view_type s;
+
+        bool operator()(const std::pair<string_view_type,double>& val) const
+        {
+            return val.first == s;
+        }
+    };
+
+    enum class structure_kind : uint8_t {object, array};
+
+    using temp_allocator_type = TempAllocator;
+    using char_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<CharT>;
+    using index_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<std::size_t>;
+    using structure_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<structure_kind>;
+
+    basic_json_decode_options<CharT> options_;
+
+    std::function<bool(json_errc,const ser_context&)> err_handler_;
+    const CharT* begin_input_;
+    const CharT* input_end_;
+    const CharT* input_ptr_;
+    bool more_;
+
+    std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type> string_buffer_;
+    jsoncons::detail::string_to_double to_double_;
+
+    std::vector<std::size_t,index_allocator_type> indices_;
+    std::vector<structure_kind,structure_allocator_type> structure_stack_;
+    std::vector<std::pair<string_view_type,double>> string_double_map_;
+
+    // Noncopyable and nonmoveable
+    basic_json_tape_parser(const basic_json_tape_parser&) = delete;
+    basic_json_tape_parser& operator=(const basic_json_tape_parser&) = delete;
+
+public:
+    basic_json_tape_parser(const TempAllocator& alloc = TempAllocator())
+        : basic_json_tape_parser(basic_json_decode_options<CharT>(), default_json_parsing(), alloc)
+    {
+    }
+
+    basic_json_tape_parser(std::function<bool(json_errc,const ser_context&)> err_handler,
+                           const TempAllocator& alloc = TempAllocator())
+        : basic_json_tape_parser(basic_json_decode_options<CharT>(), err_handler, alloc)
+    {
+    }
+
+    basic_json_tape_parser(const basic_json_decode_options<CharT>& options,
+                           const TempAllocator& alloc = TempAllocator())
+        : basic_json_tape_parser(options, default_json_parsing(), alloc)
+    {
+    }
+
+    basic_json_tape_parser(const basic_json_decode_options<CharT>& options,
+                           std::function<bool(json_errc,const ser_context&)> err_handler,
+                           const TempAllocator& alloc = TempAllocator())
+       : options_(options),
+         err_handler_(err_handler),
+         begin_input_(nullptr),
+         input_end_(nullptr),
+         input_ptr_(nullptr),
+         more_(true),
+         string_buffer_(alloc),
+         indices_(alloc),
+         structure_stack_(alloc)
+    {
+        if (options_.enable_str_to_nan())
+        {
+            string_double_map_.emplace_back(options_.nan_to_str(),std::nan(""));
+        }
+        if (options_.enable_str_to_inf())
+        {
+            string_double_map_.emplace_back(options_.inf_to_str(),std::numeric_limits<double>::infinity());
+        }
+        if (options_.enable_str_to_neginf())
+        {
+            string_double_map_.emplace_back(options_.neginf_to_str(),-std::numeric_limits<double>::infinity());
+        }
+    }
+
+    ~basic_json_tape_parser() noexcept
+    {
+    }
+
+    void parse(const string_view_type& sv, basic_json_visitor<CharT>& visitor)
+    {
+        std::error_code ec;
+        parse(sv, visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line(),column()));
+        }
+    }
+
+    void parse(const string_view_type& sv, basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        begin_input_ = sv.data();
+        input_end_ = sv.data() + sv.size();
+        input_ptr_ = begin_input_;
+        more_ = true;
+        indices_.clear();
+        structure_stack_.clear();
+
+        jsoncons::detail::find_structural_indices(sv.data(), sv.size(), indices_);
+        walk_indices(visitor, ec);
+    }
+
+    std::size_t line() const override
+    {
+        std::size_t line = 1;
+        for (const CharT* p = begin_input_; p < input_ptr_; ++p)
+        {
+            if (*p == '\n' || (*p == '\r' && (p + 1 == input_end_ || *(p + 1) != '\n')))
+            {
+                ++line;
+            }
+        }
+        return line;
+    }
+
+    std::size_t column() const override
+    {
+        const CharT* p = input_ptr_;
+        while (p > begin_input_ && *(p - 1) != '\n' && *(p - 1) != '\r')
+        {
+            --p;
+        }
+        return (input_ptr_ - p) + 1;
+    }
+
+private:
+
+    void report_error(json_errc errc, std::error_code& ec)
+    {
+        err_handler_(errc, *this);
+        ec = errc;
+        more_ = false;
+    }
+
+    // Stage two: a non-recursive walk over the structural index. A visitor that asks for no more
+    // events once the root value is complete, as json_decoder does, does not stop the check for
+    // trailing input.
+
+    void walk_indices(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        const std::size_t* it = indices_.data();
+        const std::size_t* end = indices_.data() + indices_.size();
+
+        if (it == end)
+        {
+            input_ptr_ = input_end_;
+            report_error(json_errc::unexpected_eof, ec);
+            return;
+        }
+
+value:
+        input_ptr_ = begin_input_ + *it;
+        switch (*input_ptr_)
+        {
+            case '{':
+                if (JSONCONS_UNLIKELY(structure_stack_.size() >= static_cast<std::size_t>(options_.max_nesting_depth())))
+                {
+                    report_error(json_errc::max_nesting_depth_exceeded, ec);
+                    return;
+                }
+                structure_stack_.push_back(structure_kind::object);
+                more_ = visitor.begin_object(semantic_tag::none, *this, ec);
+                if (JSONCONS_UNLIKELY(ec || !more_)) return;
+                if (++it == end) goto eof;
+                input_ptr_ = begin_input_ + *it;
+                if (*input_ptr_ == '}')
+                {
+                    structure_stack_.pop_back();
+                    more_ = visitor.end_object(*this, ec);
+                    if (JSONCONS_UNLIKELY(ec || (!more_ && !structure_stack_.empty()))) return;
+                    goto after_value;
+                }
+                goto member_name;
+            case '[':
+                if (JSONCONS_UNLIKELY(structure_stack_.size() >= static_cast<std::size_t>(options_.max_nesting_depth())))
+                {
+                    report_error(json_errc::max_nesting_depth_exceeded, ec);
+                    return;
+                }
+                structure_stack_.push_back(structure_kind::array);
+                more_ = visitor.begin_array(semantic_tag::none, *this, ec);
+                if (JSONCONS_UNLIKELY(ec || !more_)) return;
+                if (++it == end) goto eof;
+                input_ptr_ = begin_input_ + *it;
+                if (*input_ptr_ == ']')
+                {
+                    structure_stack_.pop_back();
+                    more_ = visitor.end_array(*this, ec);
+                    if (JSONCONS_UNLIKELY(ec || (!more_ && !structure_stack_.empty()))) return;
+                    goto after_value;
+                }
+                goto value;
+            case '\"':
+                parse_string(visitor, false, ec);
+                if (JSONCONS_UNLIKELY(ec || (!more_ && !structure_stack_.empty()))) return;
+                goto after_value;
+            case '-':
+            case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
+                parse_number(visitor, ec);
+                if (JSONCONS_UNLIKELY(ec || (!more_ && !structure_stack_.empty()))) return;
+                goto after_value;
+            case 't':
+                parse_literal("true", 4, ec);
+                if (ec) return;
+                more_ = visitor.bool_value(true, semantic_tag::none, *this, ec);
+                if (JSONCONS_UNLIKELY(ec || (!more_ && !structure_stack_.empty()))) return;
+                goto after_value;
+            case 'f':
+                parse_literal("false", 5, ec);
+                if (ec) return;
+                more_ = visitor.bool_value(false, semantic_tag::none, *this, ec);
+                if (JSONCONS_UNLIKELY(ec || (!more_ && !structure_stack_.empty()))) return;
+                goto after_value;
+            case 'n':
+                parse_literal("null", 4, ec);
+                if (ec) return;
+                more_ = visitor.null_value(semantic_tag::none, *this, ec);
+                if (JSONCONS_UNLIKELY(ec || (!more_ && !structure_stack_.empty()))) return;
+                goto after_value;
+            case ']':
+                report_error(structure_stack_.empty() ? json_errc::unexpected_right_bracket : json_errc::extra_comma, ec);
+                return;
+            case '}':
+                report_error(structure_stack_.empty() ? json_errc::unexpected_right_brace : json_errc::expected_value, ec);
+                return;
+            case '/':
+                report_error(json_errc::illegal_comment, ec);
+                return;
+            case '\'':
+                report_error(json_errc::single_quote, ec);
+                return;
+            default:
+                report_error(is_control_character(*input_ptr_) ? json_errc::illegal_control_character :
+                             structure_stack_.empty() ? json_errc::invalid_json_text : json_errc::expected_value, ec);
+                return;
+        }
+
+member_name:
+        switch (*input_ptr_)
+        {
+            case '\"':
+                parse_string(visitor, true, ec);
+                if (JSONCONS_UNLIKELY(ec || !more_)) return;
+                break;
+            case '}':
+                report_error(json_errc::extra_comma, ec);
+                return;
+            case '\'':
+                report_error(json_errc::single_quote, ec);
+                return;
+            case '/':
+                report_error(json_errc::illegal_comment, ec);
+                return;
+            default:
+                report_error(json_errc::expected_name, ec);
+                return;
+        }
+        if (++it == end) goto eof;
+        input_ptr_ = begin_input_ + *it;
+        if (*input_ptr_ != ':')
+        {
+            report_error(*input_ptr_ == '/' ? json_errc::illegal_comment : json_errc::expected_colon, ec);
+            return;
+        }
+        if (++it == end) goto eof;
+        goto value;
+
+after_value:
+        ++it;
+        if (structure_stack_.empty())
+        {
+            visitor.flush();
+            if (it != end)
+            {
+                input_ptr_ = begin_input_ + *it;
+                report_error(json_errc::extra_character, ec);
+            }
+            else
+            {
+                input_ptr_ = input_end_;
+            }
+            return;
+        }
+        if (it == end) goto eof;
+        input_ptr_ = begin_input_ + *it;
+        if (structure_stack_.back() == structure_kind::object)
+        {
+            switch (*input_ptr_)
+            {
+                case ',':
+                    if (++it == end) goto eof;
+                    input_ptr_ = begin_input_ + *it;
+                    goto member_name;
+                case '}':
+                    structure_stack_.pop_back();
+                    more_ = visitor.end_object(*this, ec);
+                    if (JSONCONS_UNLIKELY(ec || (!more_ && !structure_stack_.empty()))) return;
+                    goto after_value;
+                case ']':
+                    report_error(json_errc::expected_comma_or_right_brace, ec);
+                    return;
+                default:
+                    report_error(*input_ptr_ == '/' ? json_errc::illegal_comment : json_errc::expected_comma_or_right_brace, ec);
+                    return;
+            }
+        }
+        else
+        {
+            switch (*input_ptr_)
+            {
+                case ',':
+                    if (++it == end) goto eof;
+                    goto value;
+                case ']':
+                    structure_stack_.pop_back();
+                    more_ = visitor.end_array(*this, ec);
+                    if (JSONCONS_UNLIKELY(ec || (!more_ && !structure_stack_.empty()))) return;
+                    goto after_value;
+                case '}':
+                    report_error(json_errc::expected_comma_or_right_bracket, ec);
+                    return;
+                default:
+                    report_error(*input_ptr_ == '/' ? json_errc::illegal_comment : json_errc::expected_comma_or_right_bracket, ec);
+                    return;
+            }
+        }
+
+eof:
+        input_ptr_ = input_end_;
+        report_error(json_errc::unexpected_eof, ec);
+    }
+
+    static bool is_control_character(CharT c)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+        return static_cast<uchar_type>(c) < 0x20;
+    }
+
+    // A token ends at whitespace, a structural character or the end of input
+    bool at_token_end(const CharT* p) const
+    {
+        if (p == input_end_)
+        {
+            return true;
+        }
+        switch (*p)
+        {
+            case ' ': case '\t': case '\n': case '\r':
+            case '{': case '}': case '[': case ']': case ':': case ',':
+            case '\"':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void parse_literal(const char* literal, std::size_t length, std::error_code& ec)
+    {
+        const CharT* p = input_ptr_;
+        for (std::size_t i = 0; i < length; ++i, ++p)
+        {
+            if (p == input_end_)
+            {
+                input_ptr_ = p;
+                report_error(json_errc::unexpected_eof, ec);
+                return;
+            }
+            if (*p != literal[i])
+            {
+                input_ptr_ = p;
+                report_error(json_errc::invalid_value, ec);
+                return;
+            }
+        }
+        if (!at_token_end(p))
+        {
+            input_ptr_ = p;
+            report_error(json_errc::invalid_value, ec);
+        }
+    }
+
+    void parse_number(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        const CharT* p = input_ptr_;
+        bool is_negative = false;
+        bool is_integer = true;
+
+        if (*p == '-')
+        {
+            is_negative = true;
+            ++p;
+        }
+        if (p == input_end_ || !(*p >= '0' && *p <= '9'))
+        {
+            input_ptr_ = p;
+            report_error(p == input_end_ ? json_errc::unexpected_eof : json_errc::invalid_number, ec);
+            return;
+        }
+        if (*p == '0')
+        {
+            ++p;
+            if (p != input_end_ && *p >= '0' && *p <= '9')
+            {
+                input_ptr_ = p;
+                report_error(json_errc::leading_zero, ec);
+                return;
+            }
+        }
+        else
+        {
+            while (p != input_end_ && *p >= '0' && *p <= '9')
+            {
+                ++p;
+            }
+        }
+        if (p != input_end_ && *p == '.')
+        {
+            is_integer = false;
+            ++p;
+            if (p == input_end_ || !(*p >= '0' && *p <= '9'))
+            {
+                input_ptr_ = p;
+                report_error(p == input_end_ ? json_errc::unexpected_eof : json_errc::invalid_number, ec);
+                return;
+            }
+            while (p != input_end_ && *p >= '0' && *p <= '9')
+            {
+                ++p;
+            }
+        }
+        if (p != input_end_ && (*p == 'e' || *p == 'E'))
+        {
+            is_integer = false;
+            ++p;
+            if (p != input_end_ && (*p == '+' || *p == '-'))
+            {
+                ++p;
+            }
+            if (p == input_end_ || !(*p >= '0' && *p <= '9'))
+            {
+                input_ptr_ = p;
+                report_error(p == input_end_ ? json_errc::unexpected_eof : json_errc::invalid_number, ec);
+                return;
+            }
+            while (p != input_end_ && *p >= '0' && *p <= '9')
+            {
+                ++p;
+            }
+        }
+        if (!at_token_end(p))
+        {
+            input_ptr_ = p;
+            report_error(json_errc::invalid_number, ec);
+            return;
+        }
+
+        const CharT* first = input_ptr_;
+        std::size_t length = p - first;
+        if (is_integer)
+        {
+            if (is_negative)
+            {
+                auto result = jsoncons::detail::integer_from_json<int64_t>(first, length);
+                if (result)
+                {
+                    more_ = visitor.int64_value(result.value(), semantic_tag::none, *this, ec);
+                }
+                else // Must be overflow
+                {
+                    more_ = visitor.string_value(string_view_type(first, length), semantic_tag::bigint, *this, ec);
+                }
+            }
+            else
+            {
+                auto result = jsoncons::detail::integer_from_json<uint64_t>(first, length);
+                if (result)
+                {
+                    more_ = visitor.uint64_value(result.value(), semantic_tag::none, *this, ec);
+                }
+                else // Must be overflow
+                {
+                    more_ = visitor.string_value(string_view_type(first, length), semantic_tag::bigint, *this, ec);
+                }
+            }
+            return;
+        }
+
+        if (options_.lossless_number())
+        {
+            string_buffer_.clear();
+            for (const CharT* q = first; q != p; ++q)
+            {
+                string_buffer_.push_back(*q == '.' ? static_cast<CharT>(to_double_.get_decimal_point()) : *q);
+            }
+            more_ = visitor.string_value(string_buffer_, semantic_tag::bigdec, *this, ec);
+            return;
+        }
+        if (options_.lazy_number())
+        {
+            more_ = visitor.double_text_value(string_view_type(first, length), semantic_tag::none, *this, ec);
+            return;
+        }
+        // The number is validated and complete in the input, so it is converted in place
+        double d;
+        if (!jsoncons::detail::decimal_to_double(first, length, static_cast<CharT>('.'), d))
+        {
+            report_error(json_errc::invalid_number, ec);
+            return;
+        }
+        more_ = visitor.double_value(d, semantic_tag::none, *this, ec);
+    }
+
+    void parse_string(basic_json_visitor<CharT>& visitor, bool is_key, std::error_code& ec)
+    {
+        const CharT* sb = input_ptr_ + 1;
+        const CharT* p = sb;
+        bool buffered = false;
+
+        for (;;)
+        {
+            p = jsoncons::detail::find_string_special(p, input_end_);
+            if (p == input_end_)
+            {
+                input_ptr_ = p;
+                report_error(json_errc::unexpected_eof, ec);
+                return;
+            }
+            if (*p == '\"')
+            {
+                break;
+            }
+            if (*p != '\\')
+            {
+                input_ptr_ = p;
+                switch (*p)
+                {
+                    case '\t': case '\n': case '\r':
+                        report_error(json_errc::illegal_character_in_string, ec);
+                        break;
+                    default:
+                        report_error(json_errc::illegal_control_character, ec);
+                        break;
+                }
+                return;
+            }
+            if (!buffered)
+            {
+                string_buffer_.clear();
+                buffered = true;
+            }
+            string_buffer_.append(sb, p - sb);
+            ++p;
+            if (p == input_end_)
+            {
+                input_ptr_ = p;
+                report_error(json_errc::unexpected_eof, ec);
+                return;
+            }
+            switch (*p)
+            {
+                case '\"': string_buffer_.push_back('\"'); ++p; break;
+                case '\\': string_buffer_.push_back('\\'); ++p; break;
+                case '/': string_buffer_.push_back('/'); ++p; break;
+                case 'b': string_buffer_.push_back('\b'); ++p; break;
+                case 'f': string_buffer_.push_back('\f'); ++p; break;
+                case 'n': string_buffer_.push_back('\n'); ++p; break;
+                case 'r': string_buffer_.push_back('\r'); ++p; break;
+                case 't': string_buffer_.push_back('\t'); ++p; break;
+                case 'u':
+                {
+                    ++p;
+                    uint32_t cp = 0;
+                    if (!read_hex4(p, cp, ec))
+                    {
+                        return;
+                    }
+                    if (unicons::is_high_surrogate(cp))
+                    {
+                        if (input_end_ - p < 2 || *p != '\\' || *(p + 1) != 'u')
+                        {
+                            input_ptr_ = p;
+                            report_error(json_errc::expected_codepoint_surrogate_pair, ec);
+                            return;
+                        }
+                        p += 2;
+                        uint32_t cp2 = 0;
+                        if (!read_hex4(p, cp2, ec))
+                        {
+                            return;
+                        }
+                        cp = 0x10000 + ((cp & 0x3FF) << 10) + (cp2 & 0x3FF);
+                    }
+                    unicons::convert(&cp, &cp + 1, std::back_inserter(string_buffer_));
+                    break;
+                }
+                default:
+                    input_ptr_ = p;
+                    report_error(json_errc::illegal_escaped_character, ec);
+                    return;
+            }
+            sb = p;
+        }
+
+        string_view_type sv;
+        if (buffered)
+        {
+            string_buffer_.append(sb, p - sb);
+            sv = string_view_type(string_buffer_.data(), string_buffer_.length());
+        }
+        else
+        {
+            sv = string_view_type(sb, p - sb);
+        }
+        input_ptr_ = p + 1;
+
+        auto result = unicons::validate(sv.data(), sv.data() + sv.size());
+        if (result.ec != unicons::conv_errc())
+        {
+            report_error(translate_conv_errc(result.ec), ec);
+            return;
+        }
+
+        if (is_key)
+        {
+            more_ = visitor.key(sv, *this, ec);
+        }
+        else
+        {
+            auto it = std::find_if(string_double_map_.begin(), string_double_map_.end(), string_maps_to_double{ sv });
+            if (it != string_double_map_.end())
+            {
+                more_ = visitor.double_value(it->second, semantic_tag::none, *this, ec);
+            }
+            else
+            {
+                more_ = visitor.string_value(sv, semantic_tag::none, *this, ec);
+            }
+        }
+    }
+
+    bool read_hex4(const CharT*& p, uint32_t& cp, std::error_code& ec)
+    {
+        for (int i = 0; i < 4; ++i, ++p)
+        {
+            if (p == input_end_)
+            {
+                input_ptr_ = p;
+                report_error(json_errc::unexpected_eof, ec);
+                return false;
+            }
+            CharT c = *p;
+            cp *= 16;
+            if (c >= '0' && c <= '9')
+            {
+                cp += c - '0';
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                cp += c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                cp += c - 'A' + 10;
+            }
+            else
+            {
+                input_ptr_ = p;
+                report_error(json_errc::invalid_hex_escape_sequence, ec);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static json_errc translate_conv_errc(unicons::conv_errc result)
+    {
+        switch (result)
+        {
+            case unicons::conv_errc::over_long_utf8_sequence:
+                return json_errc::over_long_utf8_sequence;
+            case unicons::conv_errc::unpaired_high_surrogate:
+                return json_errc::unpaired_high_surrogate;
+            case unicons::conv_errc::expected_continuation_byte:
+                return json_errc::expected_continuation_byte;
+            case unicons::conv_errc::illegal_surrogate_value:
+                return json_errc::illegal_surrogate_value;
+            default:
+                return json_errc::illegal_codepoint;
+        }
+    }
+};
+
+using json_tape_parser = basic_json_tape_parser<char>;
+using wjson_tape_parser = basic_json_tape_parser<wchar_t>;
+
+}
+
+#endif
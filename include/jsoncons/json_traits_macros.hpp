@@ -11,12 +11,15 @@
 #include <iterator> // std::iterator_traits, std::input_iterator_tag
 #include <jsoncons/config/jsoncons_config.hpp> // JSONCONS_EXPAND, JSONCONS_QUOTE
 #include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/detail/perfect_hash.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <limits> // std::numeric_limits
 #include <string>
 #include <type_traits> // std::enable_if
 #include <utility>
 #include <jsoncons/json_type_traits.hpp>
+#include <jsoncons/ser_traits.hpp>
+#include <jsoncons/deser_traits.hpp>
 
 namespace jsoncons
 {
@@ -28,6 +31,7 @@ namespace jsoncons
     template <class Json>
     struct json_traits_helper
     {
+        using char_type = typename Json::char_type; 
         using string_view_type = typename Json::string_view_type; 
 
         template <class U> 
@@ -40,6 +44,15 @@ namespace jsoncons
             val = j.at(key).template as<U>(); 
         } 
         template <class U> 
+        static void set_udt_member(const Json&, const U&) 
+        { 
+        } 
+        template <class U> 
+        static void set_udt_member(const Json& j, U& val) 
+        { 
+            val = j.template as<U>(); 
+        } 
+        template <class U> 
         static void set_optional_json_member(const string_view_type& key, const std::shared_ptr<U>& val, Json& j) 
         { 
             if (val) j.try_emplace(key, val); 
@@ -59,6 +72,72 @@ namespace jsoncons
         { 
             j.try_emplace(key, val); 
         } 
+
+        // Streaming counterparts of the above, for ser_traits and deser_traits
+
+        template <class U> 
+        static bool has_member_value(const std::shared_ptr<U>& val) 
+        { 
+            return val != nullptr; 
+        } 
+        template <class U> 
+        static bool has_member_value(const std::unique_ptr<U>& val) 
+        { 
+            return val != nullptr; 
+        } 
+        template <class U> 
+        static bool has_member_value(const jsoncons::optional<U>& val) 
+        { 
+            return val.has_value(); 
+        } 
+        template <class U> 
+        static bool has_member_value(const U&) 
+        { 
+            return true; 
+        } 
+        template <class U> 
+        static void serialize_member(const string_view_type& key, const U& val, 
+                                     basic_json_visitor<char_type>& encoder, const Json& context_j, std::error_code& ec) 
+        { 
+            encoder.key(key, ser_context(), ec); 
+            if (ec) return; 
+            ser_traits<U,char_type>::serialize(val, encoder, context_j, ec); 
+        } 
+        template <class U> 
+        static void serialize_optional_member(const string_view_type& key, const U& val, 
+                                              basic_json_visitor<char_type>& encoder, const Json& context_j, std::error_code& ec) 
+        { 
+            if (has_member_value(val)) serialize_member(key, val, encoder, context_j, ec); 
+        } 
+        template <class U,class TempAllocator> 
+        static void deserialize_member(basic_staj_reader<char_type>& reader, json_decoder<Json,TempAllocator>& decoder, 
+                                       const U&, std::error_code& ec) 
+        { 
+            skip_member(reader, decoder, ec); 
+        } 
+        template <class U,class TempAllocator> 
+        static void deserialize_member(basic_staj_reader<char_type>& reader, json_decoder<Json,TempAllocator>& decoder, 
+                                       U& val, std::error_code& ec) 
+        { 
+            val = deser_traits<U,char_type>::deserialize(reader, decoder, ec); 
+        } 
+        // Reads past the value of a member that is not declared, or that has been read already
+        template <class TempAllocator> 
+        static void skip_member(basic_staj_reader<char_type>& reader, json_decoder<Json,TempAllocator>&, 
+                                std::error_code& ec) 
+        { 
+            reader.skip(ec); 
+        } 
+        // Throws what basic_json::at throws for a mandatory member that cannot be found, 
+        // so that deserialize reports the same errors as as() 
+        static void report_missing_member(bool is_object, const string_view_type& key) 
+        { 
+            if (is_object) 
+            { 
+                JSONCONS_THROW(key_not_found(key.data(), key.length())); 
+            } 
+            JSONCONS_THROW(not_an_object(key.data(), key.length())); 
+        } 
     };
 }
 
@@ -81,7 +160,7 @@ namespace jsoncons
 #define JSONCONS_VARIADIC_REP_OF_50(Call, P1, P2, P3, P4, ...)    JSONCONS_EXPAND_CALL5(Call, P1, P2, P3, P4, 50) JSONCONS_EXPAND(JSONCONS_VARIADIC_REP_OF_49(Call, P1, P2, P3, __VA_ARGS__))
 #define JSONCONS_VARIADIC_REP_OF_49(Call, P1, P2, P3, P4, ...)    JSONCONS_EXPAND_CALL5(Call, P1, P2, P3, P4, 49) JSONCONS_EXPAND(JSONCONS_VARIADIC_REP_OF_48(Call, P1, P2, P3, __VA_ARGS__))
 #define JSONCONS_VARIADIC_REP_OF_48(Call, P1, P2, P3, P4, ...)    JSONCONS_EXPAND_CALL5(Call, P1, P2, P3, P4, 48) JSONCONS_EXPAND(JSONCONS_VARIADIC_REP_OF_47(Call, P1, P2, P3, __VA_ARGS__))
-#define JSONCONS_VARIADIC_REP_OF_47(Call, P1, P2, P3, P4, ...)    JSONCONS_EXPAND_CALL5(Call, P1, P2, P3, P4, 47, ) JSONCONS_EXPAND(JSONCONS_VARIADIC_REP_OF_46(Call, P1, P2, P3, __VA_ARGS__))
+#define JSONCONS_VARIADIC_REP_OF_47(Call, P1, P2, P3, P4, ...)    JSONCONS_EXPAND_CALL5(Call, P1, P2, P3, P4, 47) JSONCONS_EXPAND(JSONCONS_VARIADIC_REP_OF_46(Call, P1, P2, P3, __VA_ARGS__))
 #define JSONCONS_VARIADIC_REP_OF_46(Call, P1, P2, P3, P4, ...)    JSONCONS_EXPAND_CALL5(Call, P1, P2, P3, P4, 46) JSONCONS_EXPAND(JSONCONS_VARIADIC_REP_OF_45(Call, P1, P2, P3, __VA_ARGS__))
 #define JSONCONS_VARIADIC_REP_OF_45(Call, P1, P2, P3, P4, ...)    JSONCONS_EXPAND_CALL5(Call, P1, P2, P3, P4, 45) JSONCONS_EXPAND(JSONCONS_VARIADIC_REP_OF_44(Call, P1, P2, P3, __VA_ARGS__))
 #define JSONCONS_VARIADIC_REP_OF_44(Call, P1, P2, P3, P4, ...)    JSONCONS_EXPAND_CALL5(Call, P1, P2, P3, P4, 44) JSONCONS_EXPAND(JSONCONS_VARIADIC_REP_OF_43(Call, P1, P2, P3, __VA_ARGS__))
@@ -225,6 +304,34 @@ namespace jsoncons
 #define JSONCONS_ALL_TO_JSON_LAST(Prefix, P2, P3, Member, Count) \
     ajson.try_emplace(json_traits_macro_names<char_type,value_type>::Member##_str(char_type{}), aval.Member);
 
+#define JSONCONS_MEMBER_NAME(Prefix, P2, P3, Member, Count) json_traits_macro_names<char_type,value_type>::Member##_str(char_type{}),
+#define JSONCONS_MEMBER_NAME_LAST(Prefix, P2, P3, Member, Count) json_traits_macro_names<char_type,value_type>::Member##_str(char_type{})
+
+#define JSONCONS_AS_MEMBER(Prefix, P2, P3, Member, Count) JSONCONS_AS_MEMBER_LAST(Prefix, P2, P3, Member, Count)
+#define JSONCONS_AS_MEMBER_LAST(Prefix, P2, P3, Member, Count) \
+    case (num_params-Count): json_traits_helper<Json>::set_udt_member(member.value(), aval.Member); break;
+
+#define JSONCONS_MEMBER_COUNT(Prefix, P2, P3, Member, Count) JSONCONS_MEMBER_COUNT_LAST(Prefix, P2, P3, Member, Count)
+#define JSONCONS_MEMBER_COUNT_LAST(Prefix, P2, P3, Member, Count) \
+    if ((num_params-Count) < num_mandatory_params2 || json_traits_helper<Json>::has_member_value(aval.Member)) ++length;
+
+#define JSONCONS_SERIALIZE_MEMBER(Prefix, P2, P3, Member, Count) JSONCONS_SERIALIZE_MEMBER_LAST(Prefix, P2, P3, Member, Count)
+#define JSONCONS_SERIALIZE_MEMBER_LAST(Prefix, P2, P3, Member, Count) if ((num_params-Count) < num_mandatory_params2) \
+    {json_traits_helper<Json>::serialize_member(json_traits_macro_names<char_type,value_type>::Member##_str(char_type{}), aval.Member, encoder, context_j, ec);} \
+    else {json_traits_helper<Json>::serialize_optional_member(json_traits_macro_names<char_type,value_type>::Member##_str(char_type{}), aval.Member, encoder, context_j, ec);} \
+    if (ec) return;
+
+#define JSONCONS_DESERIALIZE_MEMBER(Prefix, P2, P3, Member, Count) JSONCONS_DESERIALIZE_MEMBER_LAST(Prefix, P2, P3, Member, Count)
+#define JSONCONS_DESERIALIZE_MEMBER_LAST(Prefix, P2, P3, Member, Count) \
+    case (num_params-Count): json_traits_helper<Json>::deserialize_member(reader, decoder, aval.Member, ec); break;
+
+#define JSONCONS_REPORT_MISSING_MEMBER(Prefix, P2, P3, Member, Count) JSONCONS_REPORT_MISSING_MEMBER_LAST(Prefix, P2, P3, Member, Count)
+#define JSONCONS_REPORT_MISSING_MEMBER_LAST(Prefix, P2, P3, Member, Count) \
+    if ((num_params-Count) < num_mandatory_params2 && (found & (uint64_t(1) << (num_params-Count))) == 0) \
+    {json_traits_helper<Json>::report_missing_member(is_object, json_traits_macro_names<char_type,value_type>::Member##_str(char_type{}));}
+
+// Generates, besides json_type_traits, ser_traits and deser_traits specializations that write and read 
+// the members directly to and from a visitor and a staj reader, without an intermediate basic_json
 #define JSONCONS_MEMBER_TRAITS_BASE(AsT,ToJ,NumTemplateParams,ValueType,NumMandatoryParams1,NumMandatoryParams2, ...)  \
 namespace jsoncons \
 { \
@@ -246,12 +353,34 @@ namespace jsoncons \
         static bool is(const Json& ajson) noexcept \
         { \
             if (!ajson.is_object()) return false; \
-            JSONCONS_VARIADIC_REP_N(JSONCONS_IS, ,,, __VA_ARGS__)\
-            return true; \
+            const uint64_t mandatory = (uint64_t(1) << num_mandatory_params1) - 1; \
+            uint64_t found = 0; \
+            for (const auto& member : ajson.object_range()) \
+            { \
+                found |= uint64_t(1) << member_index(member.key()); \
+            } \
+            return (found & mandatory) == mandatory; \
         } \
         static value_type as(const Json& ajson) \
         { \
             value_type aval{}; \
+            if (ajson.is_object()) \
+            { \
+                const uint64_t mandatory = (uint64_t(1) << num_mandatory_params2) - 1; \
+                uint64_t found = 0; \
+                for (const auto& member : ajson.object_range()) \
+                { \
+                    std::size_t index = member_index(member.key()); \
+                    switch (index) \
+                    { \
+                        JSONCONS_VARIADIC_REP_N(JSONCONS_AS_MEMBER, ,,, __VA_ARGS__) \
+                        default: break; \
+                    } \
+                    found |= uint64_t(1) << index; \
+                } \
+                if ((found & mandatory) == mandatory) return aval; \
+            } \
+            /* Reports the missing member, or that ajson is not an object */ \
             JSONCONS_VARIADIC_REP_N(AsT, ,,, __VA_ARGS__) \
             return aval; \
         } \
@@ -261,6 +390,88 @@ namespace jsoncons \
             JSONCONS_VARIADIC_REP_N(ToJ, ,,, __VA_ARGS__) \
             return ajson; \
         } \
+        /* The index of the member with this name in declaration order, or num_params */ \
+        static std::size_t member_index(const string_view_type& name) \
+        { \
+            static const jsoncons::detail::perfect_hash_index<char_type> index{JSONCONS_VARIADIC_REP_N(JSONCONS_MEMBER_NAME, ,,, __VA_ARGS__)}; \
+            return index.find(name.data(), name.size()); \
+        } \
+        static void serialize(const value_type& aval, basic_json_visitor<char_type>& encoder, const Json& context_j, std::error_code& ec) \
+        { \
+            std::size_t length = 0; \
+            JSONCONS_VARIADIC_REP_N(JSONCONS_MEMBER_COUNT, ,,, __VA_ARGS__) \
+            encoder.begin_object(length, semantic_tag::none, ser_context(), ec); \
+            if (ec) return; \
+            JSONCONS_VARIADIC_REP_N(JSONCONS_SERIALIZE_MEMBER, ,,, __VA_ARGS__) \
+            encoder.end_object(ser_context(), ec); \
+        } \
+        template <class TempAllocator> \
+        static value_type deserialize(basic_staj_reader<char_type>& reader, json_decoder<Json,TempAllocator>& decoder, std::error_code& ec) \
+        { \
+            value_type aval{}; \
+            uint64_t found = 0; \
+            if (reader.current().event_type() != staj_event_type::begin_object) \
+            { \
+                const bool is_object = false; \
+                JSONCONS_VARIADIC_REP_N(JSONCONS_REPORT_MISSING_MEMBER, ,,, __VA_ARGS__) \
+                json_traits_helper<Json>::skip_member(reader, decoder, ec); \
+                return aval; \
+            } \
+            reader.next(ec); \
+            while (!ec && reader.current().event_type() != staj_event_type::end_object) \
+            { \
+                if (reader.current().event_type() != staj_event_type::key) \
+                { \
+                    ec = json_errc::expected_name; \
+                    return aval; \
+                } \
+                std::size_t index = member_index(reader.current().template get<string_view_type>()); \
+                reader.next(ec); \
+                if (ec) return aval; \
+                if (index < num_params && (found & (uint64_t(1) << index)) == 0) \
+                { \
+                    switch (index) \
+                    { \
+                        JSONCONS_VARIADIC_REP_N(JSONCONS_DESERIALIZE_MEMBER, ,,, __VA_ARGS__) \
+                        default: break; \
+                    } \
+                    found |= uint64_t(1) << index; \
+                } \
+                else \
+                { \
+                    /* Not declared, or repeated, the first of repeated members is kept as when decoding to basic_json */ \
+                    json_traits_helper<Json>::skip_member(reader, decoder, ec); \
+                } \
+                if (ec) return aval; \
+                reader.next(ec); \
+            } \
+            if (!ec) \
+            { \
+                const bool is_object = true; \
+                JSONCONS_VARIADIC_REP_N(JSONCONS_REPORT_MISSING_MEMBER, ,,, __VA_ARGS__) \
+            } \
+            return aval; \
+        } \
+    }; \
+    template <class ChT JSONCONS_GENERATE_TPL_PARAMS(JSONCONS_GENERATE_MORE_TPL_PARAM, NumTemplateParams)> \
+    struct ser_traits<ValueType JSONCONS_GENERATE_TPL_ARGS(JSONCONS_GENERATE_TPL_ARG, NumTemplateParams),ChT> \
+    { \
+        using value_type = ValueType JSONCONS_GENERATE_TPL_ARGS(JSONCONS_GENERATE_TPL_ARG, NumTemplateParams); \
+        template <class Json> \
+        static void serialize(const value_type& val, basic_json_visitor<ChT>& encoder, const Json& context_j, std::error_code& ec) \
+        { \
+            json_type_traits<Json,value_type>::serialize(val, encoder, context_j, ec); \
+        } \
+    }; \
+    template <class ChT JSONCONS_GENERATE_TPL_PARAMS(JSONCONS_GENERATE_MORE_TPL_PARAM, NumTemplateParams)> \
+    struct deser_traits<ValueType JSONCONS_GENERATE_TPL_ARGS(JSONCONS_GENERATE_TPL_ARG, NumTemplateParams),ChT> \
+    { \
+        using value_type = ValueType JSONCONS_GENERATE_TPL_ARGS(JSONCONS_GENERATE_TPL_ARG, NumTemplateParams); \
+        template <class Json,class TempAllocator> \
+        static value_type deserialize(basic_staj_reader<ChT>& reader, json_decoder<Json,TempAllocator>& decoder, std::error_code& ec) \
+        { \
+            return json_type_traits<Json,value_type>::deserialize(reader, decoder, ec); \
+        } \
     }; \
 } \
   /**/
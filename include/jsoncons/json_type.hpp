@@ -36,7 +36,12 @@ namespace jsoncons {
         byte_string_value = 0x08,
         array_value = 0x09,
         empty_object_value = 0x0a,
-        object_value = 0x0b
+        object_value = 0x0b,
+        // The text of a number with a fraction or exponent, converted to double when accessed
+        short_double_text_value = 0x0c,
+        long_double_text_value = 0x0d,
+        // A homogeneous array of numbers, held contiguously
+        typed_array_value = 0x0e
     };
 
 } // jsoncons
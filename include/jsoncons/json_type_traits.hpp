@@ -28,6 +28,7 @@
 #include <functional>
 #include <memory>
 #include <jsoncons/convert_error.hpp>
+#include <jsoncons/typed_array_view.hpp>
 
 namespace jsoncons {
 
@@ -88,10 +89,37 @@ namespace detail {
     template<class Json, class T>
     struct is_compatible_array_type<Json,T, 
         typename std::enable_if<!std::is_same<T,typename Json::array>::value &&
+        !jsoncons::detail::is_typed_array_span<T>::value &&
         jsoncons::detail::is_list_like<T>::value && 
         !is_json_type_traits_unspecialized<Json,typename std::iterator_traits<typename T::iterator>::value_type>::value
     >::type> : std::true_type {};
 
+    // True if every element of the array j is a T. The elements of a typed array are 
+    // read one at a time, rather than built as basic_json values all at once
+    template<class T, class Json>
+    bool is_array_of(const Json& j)
+    {
+        if (j.is_typed_array())
+        {
+            for (std::size_t i = 0; i < j.size(); ++i)
+            {
+                if (!j.template at<Json>(i).template is<T>())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        for (const auto& item : j.array_range())
+        {
+            if (!item.template is<T>())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
 } // namespace detail
 
     // is_json_type_traits_specialized
@@ -369,19 +397,7 @@ namespace detail {
 
         static bool is(const Json& j) noexcept
         {
-            bool result = j.is_array();
-            if (result)
-            {
-                for (auto e : j.array_range())
-                {
-                    if (!e.template is<value_type>())
-                    {
-                        result = false;
-                        break;
-                    }
-                }
-            }
-            return result;
+            return j.is_array() && jsoncons::detail::is_array_of<value_type>(j);
         }
 
         template <class Ty = value_type>
@@ -392,9 +408,9 @@ namespace detail {
             {
                 T result;
                 visit_reserve_(typename std::integral_constant<bool, jsoncons::detail::has_reserve<T>::value>::type(),result,j.size());
-                for (const auto& item : j.array_range())
+                for (std::size_t i = 0; i < j.size(); ++i)
                 {
-                    result.push_back(item.template as<value_type>());
+                    result.push_back(j.template at<value_type>(i));
                 }
 
                 return result;
@@ -413,9 +429,9 @@ namespace detail {
             {
                 T result;
                 visit_reserve_(typename std::integral_constant<bool, jsoncons::detail::has_reserve<T>::value>::type(),result,j.size());
-                for (const auto& item : j.array_range())
+                for (std::size_t i = 0; i < j.size(); ++i)
                 {
-                    result.push_back(item.template as<value_type>());
+                    result.push_back(j.template at<value_type>(i));
                 }
 
                 return result;
@@ -694,19 +710,7 @@ namespace detail {
 
         static bool is(const Json& j) noexcept
         {
-            bool result = j.is_array() && j.size() == N;
-            if (result)
-            {
-                for (auto e : j.array_range())
-                {
-                    if (!e.template is<value_type>())
-                    {
-                        result = false;
-                        break;
-                    }
-                }
-            }
-            return result;
+            return j.is_array() && j.size() == N && jsoncons::detail::is_array_of<value_type>(j);
         }
 
         static std::array<E, N> as(const Json& j)
@@ -715,7 +719,7 @@ namespace detail {
             JSONCONS_ASSERT(j.size() == N);
             for (size_t i = 0; i < N; i++)
             {
-                buff[i] = j[i].template as<E>();
+                buff[i] = j.template at<E>(i);
             }
             return buff;
         }
@@ -995,6 +999,35 @@ namespace detail
         }
     };
 
+    // A view of the numbers of a typed array, see basic_json::is_typed_array
+
+    template<class Json, class T>
+    struct json_type_traits<Json, span<const T>,
+                            typename std::enable_if<jsoncons::detail::typed_array_element<T>::value>::type>
+    {
+        using allocator_type = typename Json::allocator_type;
+
+    public:
+        static bool is(const Json& j) noexcept
+        {
+            return j.is_typed_array() && j.as_typed_array_view().type() == jsoncons::detail::typed_array_element<T>::array_type;
+        }
+        
+        static span<const T> as(const Json& j)
+        {
+            if (!is(j))
+            {
+                JSONCONS_THROW(ser_error(convert_errc::json_not_typed_array));
+            }
+            return j.as_typed_array_view().data(jsoncons::detail::typed_array_element<T>::arg());
+        }
+        
+        static Json to_json(const span<const T>& val, const allocator_type& alloc = allocator_type())
+        {
+            return Json(typed_array_arg, typed_array_view(val.data(), val.size()), semantic_tag::none, alloc);
+        }
+    };
+
     // basic_bignum
 
     template<class Json, class Allocator>
@@ -1054,19 +1087,7 @@ namespace detail
 
         static bool is(const Json& j) noexcept
         {
-            bool result = j.is_array();
-            if (result)
-            {
-                for (auto e : j.array_range())
-                {
-                    if (!e.template is<T>())
-                    {
-                        result = false;
-                        break;
-                    }
-                }
-            }
-            return result;
+            return j.is_array() && jsoncons::detail::is_array_of<T>(j);
         }
         
         static std::valarray<T> as(const Json& j)
@@ -1076,7 +1097,7 @@ namespace detail
                 std::valarray<T> v(j.size());
                 for (size_t i = 0; i < j.size(); ++i)
                 {
-                    v[i] = j[i].template as<T>();
+                    v[i] = j.template at<T>(i);
                 }
                 return v;
             }
@@ -9,12 +9,14 @@
 
 #include <string>
 #include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_error.hpp>
 #include <jsoncons/bignum.hpp>
 #include <jsoncons/ser_context.hpp>
 #include <jsoncons/json_options.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/tag_type.hpp>
 #include <jsoncons/byte_string.hpp>
+#include <jsoncons/detail/decimal_to_double.hpp>
 
 namespace jsoncons {
 
@@ -233,6 +235,19 @@ namespace jsoncons {
             return more;
         }
 
+        bool double_text_value(const string_view_type& text, 
+                               semantic_tag tag = semantic_tag::none, 
+                               const ser_context& context=ser_context())
+        {
+            std::error_code ec;
+            bool more = visit_double_text(text, tag, context, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec, context.line(), context.column()));
+            }
+            return more;
+        }
+
         bool begin_object(semantic_tag tag,
                           const ser_context& context,
                           std::error_code& ec)
@@ -344,6 +359,14 @@ namespace jsoncons {
             return visit_double(value, tag, context, ec);
         }
 
+        bool double_text_value(const string_view_type& text, 
+                               semantic_tag tag, 
+                               const ser_context& context,
+                               std::error_code& ec)
+        {
+            return visit_double_text(text, tag, context, ec);
+        }
+
         template <class T>
         bool typed_array(const span<T>& data, 
                          semantic_tag tag=semantic_tag::none,
@@ -666,6 +689,24 @@ namespace jsoncons {
                                const ser_context& context,
                                std::error_code& ec) = 0;
 
+        // The text of a JSON number with a fraction or exponent, passed on unconverted
+        // so that a visitor that only stores or writes it can avoid the conversion.
+        // The default converts it and calls visit_double.
+
+        virtual bool visit_double_text(const string_view_type& text, 
+                                       semantic_tag tag,
+                                       const ser_context& context,
+                                       std::error_code& ec)
+        {
+            double value;
+            if (!jsoncons::detail::decimal_to_double(text.data(), text.length(), static_cast<char_type>('.'), value))
+            {
+                ec = json_errc::invalid_number;
+                return false;
+            }
+            return visit_double(value, tag, context, ec);
+        }
+
         virtual bool visit_typed_array(const span<const uint8_t>& s, 
                                     semantic_tag tag,
                                     const ser_context& context, 
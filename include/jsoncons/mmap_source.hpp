@@ -0,0 +1,535 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MMAP_SOURCE_HPP
+#define JSONCONS_MMAP_SOURCE_HPP
+
+#include <string>
+#include <vector>
+#include <cstring> // std::memcpy
+#include <cstdint>
+#include <fstream> // std::ifstream
+#include <utility> // std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/byte_string.hpp> // jsoncons::byte_traits
+
+// Define JSONCONS_NO_MMAP to read the whole file into memory instead of mapping it
+
+#if !defined(JSONCONS_NO_MMAP)
+#  if defined(_WIN32)
+#    define JSONCONS_HAS_WIN32_MMAP 1
+#    if !defined(WIN32_LEAN_AND_MEAN)
+#      define WIN32_LEAN_AND_MEAN
+#    endif
+#    if !defined(NOMINMAX)
+#      define NOMINMAX
+#    endif
+#    include <windows.h>
+#  elif defined(__unix__) || defined(__APPLE__)
+#    define JSONCONS_HAS_POSIX_MMAP 1
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <fcntl.h>
+#    include <unistd.h>
+#  endif
+#endif
+
+namespace jsoncons {
+
+namespace detail {
+
+    // A read-only view of a whole file. The file is memory mapped where the platform
+    // supports it, with a hint that it will be read sequentially, and otherwise read
+    // into memory.
+
+    class file_mapping
+    {
+        const uint8_t* data_;
+        std::size_t size_;
+        bool is_error_;
+    #if defined(JSONCONS_HAS_WIN32_MMAP)
+        HANDLE file_;
+        HANDLE mapping_;
+    #elif !defined(JSONCONS_HAS_POSIX_MMAP)
+        std::vector<uint8_t> buffer_;
+    #endif
+
+        // Noncopyable
+        file_mapping(const file_mapping&) = delete;
+        file_mapping& operator=(const file_mapping&) = delete;
+    public:
+        file_mapping()
+            : data_(nullptr), size_(0), is_error_(false)
+    #if defined(JSONCONS_HAS_WIN32_MMAP)
+              , file_(INVALID_HANDLE_VALUE), mapping_(nullptr)
+    #endif
+        {
+        }
+
+        explicit file_mapping(const std::string& path)
+            : file_mapping()
+        {
+            open(path);
+        }
+
+        file_mapping(file_mapping&& other) noexcept
+            : file_mapping()
+        {
+            swap(other);
+        }
+
+        ~file_mapping() noexcept
+        {
+            close();
+        }
+
+        file_mapping& operator=(file_mapping&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        const uint8_t* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool is_error() const
+        {
+            return is_error_;
+        }
+
+        void swap(file_mapping& other) noexcept
+        {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(is_error_, other.is_error_);
+        #if defined(JSONCONS_HAS_WIN32_MMAP)
+            std::swap(file_, other.file_);
+            std::swap(mapping_, other.mapping_);
+        #elif !defined(JSONCONS_HAS_POSIX_MMAP)
+            buffer_.swap(other.buffer_);
+        #endif
+        }
+
+    private:
+    #if defined(JSONCONS_HAS_POSIX_MMAP)
+        void open(const std::string& path)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+            {
+                is_error_ = true;
+                return;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == -1)
+            {
+                ::close(fd);
+                is_error_ = true;
+                return;
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ > 0)
+            {
+                void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED)
+                {
+                    size_ = 0;
+                    is_error_ = true;
+                }
+                else
+                {
+                    ::madvise(p, size_, MADV_SEQUENTIAL);
+                    data_ = static_cast<const uint8_t*>(p);
+                }
+            }
+            // The mapping stays valid after the descriptor is closed
+            ::close(fd);
+        }
+
+        void close() noexcept
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(const_cast<uint8_t*>(data_), size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+    #elif defined(JSONCONS_HAS_WIN32_MMAP)
+        void open(const std::string& path)
+        {
+            file_ = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file_ == INVALID_HANDLE_VALUE)
+            {
+                is_error_ = true;
+                return;
+            }
+            LARGE_INTEGER file_size;
+            if (!::GetFileSizeEx(file_, &file_size))
+            {
+                close();
+                is_error_ = true;
+                return;
+            }
+            size_ = static_cast<std::size_t>(file_size.QuadPart);
+            if (size_ > 0)
+            {
+                mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                const void* p = mapping_ != nullptr ? ::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+                if (p == nullptr)
+                {
+                    close();
+                    is_error_ = true;
+                    return;
+                }
+                data_ = static_cast<const uint8_t*>(p);
+            }
+        }
+
+        void close() noexcept
+        {
+            if (data_ != nullptr)
+            {
+                ::UnmapViewOfFile(data_);
+                data_ = nullptr;
+            }
+            if (mapping_ != nullptr)
+            {
+                ::CloseHandle(mapping_);
+                mapping_ = nullptr;
+            }
+            if (file_ != INVALID_HANDLE_VALUE)
+            {
+                ::CloseHandle(file_);
+                file_ = INVALID_HANDLE_VALUE;
+            }
+            size_ = 0;
+        }
+    #else
+        void open(const std::string& path)
+        {
+            std::ifstream is(path, std::ios::binary);
+            if (!is)
+            {
+                is_error_ = true;
+                return;
+            }
+            buffer_.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+            if (is.bad())
+            {
+                is_error_ = true;
+                return;
+            }
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+        }
+
+        void close() noexcept
+        {
+        }
+    #endif
+    };
+
+} // namespace detail
+
+    // Sources that read a whole file through a memory mapping. Besides the usual
+    // source operations, read_buffer() hands out the unread part of the mapping
+    // without copying it, which basic_json_reader and basic_json_cursor use to
+    // give the parser the whole file in one update.
+
+    template <class CharT>
+    class mmap_source
+    {
+    public:
+        using value_type = CharT;
+        using traits_type = std::char_traits<CharT>;
+    private:
+        detail::file_mapping mapping_;
+        const value_type* data_;
+        const value_type* input_ptr_;
+        const value_type* input_end_;
+        bool eof_;
+
+        // Noncopyable
+        mmap_source(const mmap_source&) = delete;
+        mmap_source& operator=(const mmap_source&) = delete;
+    public:
+        mmap_source()
+            : data_(nullptr), input_ptr_(nullptr), input_end_(nullptr), eof_(true)
+        {
+        }
+
+        explicit mmap_source(const std::string& path)
+            : mapping_(path),
+              data_(reinterpret_cast<const value_type*>(mapping_.data())),
+              input_ptr_(data_),
+              input_end_(data_ + mapping_.size()/sizeof(value_type)),
+              eof_(input_ptr_ == input_end_)
+        {
+        }
+
+        mmap_source(mmap_source&& other) noexcept
+            : data_(nullptr), input_ptr_(nullptr), input_end_(nullptr), eof_(true)
+        {
+            swap(other);
+        }
+
+        mmap_source& operator=(mmap_source&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        bool eof() const
+        {
+            return eof_;
+        }
+
+        bool is_error() const
+        {
+            return mapping_.is_error();
+        }
+
+        std::size_t position() const
+        {
+            return (input_ptr_ - data_) + 1;
+        }
+
+        std::size_t get(value_type& c)
+        {
+            if (input_ptr_ < input_end_)
+            {
+                c = *input_ptr_++;
+                return 1;
+            }
+            else
+            {
+                eof_ = true;
+                input_ptr_ = input_end_;
+                return 0;
+            }
+        }
+
+        int get()
+        {
+            if (input_ptr_ < input_end_)
+            {
+                return *input_ptr_++;
+            }
+            else
+            {
+                eof_ = true;
+                input_ptr_ = input_end_;
+                return traits_type::eof();
+            }
+        }
+
+        void ignore(std::size_t count)
+        {
+            std::size_t len;
+            if ((std::size_t)(input_end_ - input_ptr_) < count)
+            {
+                len = input_end_ - input_ptr_;
+                eof_ = true;
+            }
+            else
+            {
+                len = count;
+            }
+            input_ptr_ += len;
+        }
+
+        int peek()
+        {
+            return input_ptr_ < input_end_ ? *input_ptr_ : traits_type::eof();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len;
+            if ((std::size_t)(input_end_ - input_ptr_) < length)
+            {
+                len = input_end_ - input_ptr_;
+                eof_ = true;
+            }
+            else
+            {
+                len = length;
+            }
+            std::memcpy(p, input_ptr_, len*sizeof(value_type));
+            input_ptr_  += len;
+            return len;
+        }
+
+        // Returns the unread input, which stays valid for the lifetime of the source
+        span<const value_type> read_buffer()
+        {
+            span<const value_type> s(input_ptr_, input_end_ - input_ptr_);
+            input_ptr_ = input_end_;
+            eof_ = true;
+            return s;
+        }
+    private:
+        void swap(mmap_source& other) noexcept
+        {
+            mapping_.swap(other.mapping_);
+            std::swap(data_,other.data_);
+            std::swap(input_ptr_,other.input_ptr_);
+            std::swap(input_end_,other.input_end_);
+            std::swap(eof_,other.eof_);
+        }
+    };
+
+    class binary_mmap_source
+    {
+    public:
+        typedef uint8_t value_type;
+        using traits_type = byte_traits;
+    private:
+        detail::file_mapping mapping_;
+        const value_type* input_ptr_;
+        const value_type* input_end_;
+        bool eof_;
+
+        // Noncopyable
+        binary_mmap_source(const binary_mmap_source&) = delete;
+        binary_mmap_source& operator=(const binary_mmap_source&) = delete;
+    public:
+        binary_mmap_source()
+            : input_ptr_(nullptr), input_end_(nullptr), eof_(true)
+        {
+        }
+
+        explicit binary_mmap_source(const std::string& path)
+            : mapping_(path),
+              input_ptr_(mapping_.data()),
+              input_end_(mapping_.data() + mapping_.size()),
+              eof_(input_ptr_ == input_end_)
+        {
+        }
+
+        binary_mmap_source(binary_mmap_source&& other) noexcept
+            : input_ptr_(nullptr), input_end_(nullptr), eof_(true)
+        {
+            swap(other);
+        }
+
+        binary_mmap_source& operator=(binary_mmap_source&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        bool eof() const
+        {
+            return eof_;
+        }
+
+        bool is_error() const
+        {
+            return mapping_.is_error();
+        }
+
+        std::size_t position() const
+        {
+            return (input_ptr_ - mapping_.data()) + 1;
+        }
+
+        std::size_t get(value_type& c)
+        {
+            if (input_ptr_ < input_end_)
+            {
+                c = *input_ptr_++;
+                return 1;
+            }
+            else
+            {
+                eof_ = true;
+                input_ptr_ = input_end_;
+                return 0;
+            }
+        }
+
+        int get()
+        {
+            if (input_ptr_ < input_end_)
+            {
+                return *input_ptr_++;
+            }
+            else
+            {
+                eof_ = true;
+                input_ptr_ = input_end_;
+                return traits_type::eof();
+            }
+        }
+
+        void ignore(std::size_t count)
+        {
+            std::size_t len;
+            if ((std::size_t)(input_end_ - input_ptr_) < count)
+            {
+                len = input_end_ - input_ptr_;
+                eof_ = true;
+            }
+            else
+            {
+                len = count;
+            }
+            input_ptr_ += len;
+        }
+
+        int peek()
+        {
+            return input_ptr_ < input_end_ ? *input_ptr_ : traits_type::eof();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len;
+            if ((std::size_t)(input_end_ - input_ptr_) < length)
+            {
+                len = input_end_ - input_ptr_;
+                eof_ = true;
+            }
+            else
+            {
+                len = length;
+            }
+            std::memcpy(p, input_ptr_, len);
+            input_ptr_  += len;
+            return len;
+        }
+
+        // Returns the unread input, which stays valid for the lifetime of the source
+        span<const value_type> read_buffer()
+        {
+            span<const value_type> s(input_ptr_, input_end_ - input_ptr_);
+            input_ptr_ = input_end_;
+            eof_ = true;
+            return s;
+        }
+    private:
+        void swap(binary_mmap_source& other) noexcept
+        {
+            mapping_.swap(other.mapping_);
+            std::swap(input_ptr_,other.input_ptr_);
+            std::swap(input_end_,other.input_end_);
+            std::swap(eof_,other.eof_);
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
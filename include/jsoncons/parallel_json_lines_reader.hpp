@@ -0,0 +1,350 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PARALLEL_JSON_LINES_READER_HPP
+#define JSONCONS_PARALLEL_JSON_LINES_READER_HPP
+
+#include <algorithm> // std::find
+#include <memory> // std::unique_ptr, std::shared_ptr
+#include <string>
+#include <system_error>
+#include <utility> // std::move
+#include <vector>
+#include <jsoncons/source.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons/parallel_read_options.hpp>
+#include <jsoncons/detail/ordered_task_pool.hpp>
+
+namespace jsoncons {
+
+// Reads newline delimited JSON (JSON Lines, NDJSON). The input is split into chunks at
+// line breaks, the chunks are parsed by a pool of worker threads, each with its own
+// parser and decoder, and the values are delivered in input order. Blank lines are skipped.
+// A line that fails to parse is reported with its line number, and reading can continue
+// with the next line.
+
+template <class Json,class Src=jsoncons::stream_source<typename Json::char_type>>
+class parallel_json_lines_reader
+{
+public:
+    using value_type = Json;
+    using char_type = typename Json::char_type;
+    using source_type = Src;
+private:
+    using string_type = std::basic_string<char_type>;
+
+    struct line_item
+    {
+        Json value;
+        std::error_code ec;
+        std::size_t line;
+        std::size_t column;
+
+        line_item(Json&& value, std::size_t line)
+            : value(std::move(value)), line(line), column(1)
+        {
+        }
+
+        line_item(std::error_code ec, std::size_t line, std::size_t column)
+            : ec(ec), line(line), column(column)
+        {
+        }
+    };
+
+    struct chunk_task
+    {
+        string_type text;
+    };
+
+    struct chunk_result
+    {
+        std::vector<line_item> items;
+        std::size_t line_count; // number of line breaks in the chunk
+
+        chunk_result()
+            : line_count(0)
+        {
+        }
+    };
+
+    using pool_type = detail::ordered_task_pool<chunk_task,chunk_result>;
+
+    source_type source_;
+    std::size_t chunk_length_;
+    std::size_t max_chunks_in_flight_;
+    string_type carry_;
+    bool begin_;
+    bool source_done_;
+    chunk_result current_;
+    std::size_t index_;
+    std::size_t first_line_;
+    std::size_t line_;
+    std::size_t column_;
+    std::error_code source_ec_; // A failure to read, reported after the lines read before it
+    std::size_t source_error_column_;
+    std::unique_ptr<pool_type> pool_; // last, so that the workers are joined first
+
+    // Noncopyable and nonmoveable
+    parallel_json_lines_reader(const parallel_json_lines_reader&) = delete;
+    parallel_json_lines_reader& operator=(const parallel_json_lines_reader&) = delete;
+
+public:
+    template <class Source>
+    explicit parallel_json_lines_reader(Source&& source,
+                                        const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(),
+                                        const parallel_read_options& parallel_options = parallel_read_options())
+        : source_(std::forward<Source>(source)),
+          chunk_length_(parallel_options.chunk_length()),
+          max_chunks_in_flight_(parallel_options.max_chunks_in_flight()),
+          begin_(true),
+          source_done_(false),
+          index_(0),
+          first_line_(1),
+          line_(0),
+          column_(0),
+          source_error_column_(0)
+    {
+        basic_json_decode_options<char_type> opts(options);
+        pool_.reset(new pool_type(parallel_options.num_threads(), [opts]() -> typename pool_type::worker_function
+        {
+            auto parser = std::make_shared<basic_json_parser<char_type>>(opts);
+            auto decoder = std::make_shared<json_decoder<Json>>();
+            return [parser,decoder](chunk_task& task, chunk_result& result)
+            {
+                parse_chunk(*parser, *decoder, task.text, result);
+            };
+        }));
+    }
+
+    // Reads the next value. Returns false at the end of the input, or if the next
+    // line could not be parsed, in which case ec is set and line() and column()
+    // give the location of the error. Reading may continue past a parse error.
+    // A failure to read the source is reported after the values read before it,
+    // and ends the input.
+
+    bool read_next(Json& value, std::error_code& ec)
+    {
+        while (index_ == current_.items.size())
+        {
+            fill();
+            if (pool_->pending() == 0)
+            {
+                if (source_ec_)
+                {
+                    line_ = first_line_ + current_.line_count;
+                    column_ = source_error_column_;
+                    ec = source_ec_;
+                    source_ec_ = std::error_code();
+                }
+                return false;
+            }
+            first_line_ += current_.line_count;
+            current_ = pool_->take();
+            index_ = 0;
+        }
+
+        line_item& item = current_.items[index_++];
+        line_ = first_line_ + item.line - 1;
+        column_ = item.column;
+        if (item.ec)
+        {
+            ec = item.ec;
+            return false;
+        }
+        value = std::move(item.value);
+        return true;
+    }
+
+    bool read_next(Json& value)
+    {
+        std::error_code ec;
+        bool result = read_next(value, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line_,column_));
+        }
+        return result;
+    }
+
+    // Reads the next value and replays it to visitor
+
+    bool read_next(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        Json value;
+        if (!read_next(value, ec))
+        {
+            return false;
+        }
+        value.dump(visitor, ec);
+        return !ec;
+    }
+
+    bool read_next(basic_json_visitor<char_type>& visitor)
+    {
+        std::error_code ec;
+        bool result = read_next(visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line_,column_));
+        }
+        return result;
+    }
+
+    // Line of the value or error last returned by read_next
+
+    std::size_t line() const
+    {
+        return line_;
+    }
+
+    std::size_t column() const
+    {
+        return column_;
+    }
+
+    std::size_t num_threads() const
+    {
+        return pool_->num_threads();
+    }
+
+private:
+    // Reads ahead until max_chunks_in_flight chunks are pending or the source is exhausted
+
+    void fill()
+    {
+        while (!source_done_ && pool_->pending() < max_chunks_in_flight_)
+        {
+            chunk_task task;
+            std::error_code ec;
+            read_chunk(task.text, ec);
+            if (!task.text.empty())
+            {
+                pool_->submit(std::move(task));
+            }
+            if (ec)
+            {
+                source_ec_ = ec;
+                source_done_ = true;
+            }
+        }
+    }
+
+    // Reads at least chunk_length characters, or to the end of the source,
+    // and keeps the part after the last line break for the next chunk. On
+    // failure, text keeps the complete lines read before it, and the failure
+    // is located after the rest.
+
+    void read_chunk(string_type& text, std::error_code& ec)
+    {
+        text.swap(carry_);
+        carry_.clear();
+        while (true)
+        {
+            std::size_t old_length = text.size();
+            text.resize(old_length + chunk_length_);
+            std::size_t n = source_.read(&text[old_length], chunk_length_);
+            text.resize(old_length + n);
+            if (begin_ && !text.empty())
+            {
+                auto result = unicons::skip_bom(text.data(), text.data() + text.size());
+                if (result.ec != unicons::encoding_errc())
+                {
+                    ec = result.ec;
+                    source_error_column_ = 1;
+                    text.clear();
+                    return;
+                }
+                text.erase(0, result.it - text.data());
+                old_length = 0;
+                begin_ = false;
+            }
+            if (source_.is_error())
+            {
+                ec = json_errc::source_error;
+                std::size_t pos = text.rfind('\n');
+                std::size_t length = pos != string_type::npos ? pos + 1 : 0;
+                source_error_column_ = text.size() - length + 1;
+                text.resize(length);
+                return;
+            }
+            if (source_.eof())
+            {
+                source_done_ = true;
+                return;
+            }
+            // The carried over text has no line break, only the new text needs searching
+            std::size_t pos = text.rfind('\n');
+            if (pos != string_type::npos && pos >= old_length)
+            {
+                carry_.assign(text, pos + 1, string_type::npos);
+                text.resize(pos + 1);
+                return;
+            }
+        }
+    }
+
+    static bool is_blank(const char_type* first, const char_type* last)
+    {
+        for (; first != last; ++first)
+        {
+            switch (*first)
+            {
+                case ' ':
+                case '\t':
+                case '\r':
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    static void parse_chunk(basic_json_parser<char_type>& parser,
+                            json_decoder<Json>& decoder,
+                            const string_type& text,
+                            chunk_result& result)
+    {
+        const char_type* p = text.data();
+        const char_type* end = text.data() + text.size();
+        std::size_t line = 0;
+        while (p < end)
+        {
+            ++line;
+            const char_type* eol = std::find(p, end, '\n');
+            if (!is_blank(p, eol))
+            {
+                std::error_code ec;
+                parser.reset();
+                parser.update(p, eol - p);
+                parser.finish_parse(decoder, ec);
+                if (!ec)
+                {
+                    parser.check_done(ec);
+                }
+                if (ec)
+                {
+                    result.items.emplace_back(ec, line, parser.column());
+                    decoder.reset();
+                }
+                else
+                {
+                    result.items.emplace_back(decoder.get_result(), line);
+                }
+            }
+            p = eol == end ? end : eol + 1;
+        }
+        result.line_count = line;
+    }
+};
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,58 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PARALLEL_PARSE_HPP
+#define JSONCONS_PARALLEL_PARSE_HPP
+
+#include <cstddef>
+#include <string>
+#include <jsoncons/json.hpp>
+#include <jsoncons/decode_json.hpp>
+#include <jsoncons/mmap_source.hpp>
+#include <jsoncons/detail/parallel_array_parser.hpp>
+
+namespace jsoncons {
+
+    // parse_parallel
+
+    // Parses a large top level array on up to num_threads threads, 0 meaning
+    // std::thread::hardware_concurrency(). Anything else, and input with errors or comments,
+    // is parsed sequentially, with the same result and errors as Json::parse. It lives in its
+    // own header, like parallel_json_lines_reader, so that only its users need threads.
+
+    template <class Json>
+    Json parse_parallel(const basic_string_view<typename Json::char_type>& s, std::size_t num_threads = 0,
+                        const basic_json_decode_options<typename Json::char_type>& options = basic_json_decode_options<typename Json::char_type>())
+    {
+        Json val;
+        if (num_threads != 1 && detail::parse_array_in_parallel(s.data(), s.size(), options, num_threads, val))
+        {
+            return val;
+        }
+        return Json::parse(s, options);
+    }
+
+    // From a file, which is memory mapped
+
+    template <class Json>
+    Json parse_parallel(file_path_arg_t, const std::string& path, std::size_t num_threads = 0,
+                        const basic_json_decode_options<typename Json::char_type>& options = basic_json_decode_options<typename Json::char_type>())
+    {
+        using char_type = typename Json::char_type;
+
+        mmap_source<char_type> source(path);
+        if (source.is_error())
+        {
+            // Reports the error as decode_json does
+            return decode_json<Json>(file_path_arg, path, options);
+        }
+        auto buffer = source.read_buffer();
+        return parse_parallel<Json>(basic_string_view<char_type>(buffer.data(), buffer.size()), num_threads, options);
+    }
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PARALLEL_READ_OPTIONS_HPP
+#define JSONCONS_PARALLEL_READ_OPTIONS_HPP
+
+#include <cstddef>
+#include <thread>
+
+namespace jsoncons {
+
+class parallel_read_options
+{
+    std::size_t num_threads_;
+    std::size_t chunk_length_;
+    std::size_t max_chunks_in_flight_;
+public:
+    static constexpr std::size_t default_chunk_length = 1024*1024;
+
+    parallel_read_options()
+        : num_threads_(0),
+          chunk_length_(default_chunk_length),
+          max_chunks_in_flight_(0)
+    {
+    }
+
+    // Number of worker threads, defaults to std::thread::hardware_concurrency()
+
+    std::size_t num_threads() const
+    {
+        if (num_threads_ != 0)
+        {
+            return num_threads_;
+        }
+        std::size_t n = std::thread::hardware_concurrency();
+        return n != 0 ? n : 1;
+    }
+
+    parallel_read_options& num_threads(std::size_t value)
+    {
+        num_threads_ = value;
+        return *this;
+    }
+
+    // Approximate size of the chunks handed to the workers. A chunk always ends on
+    // an item boundary, so it is longer when a single item is longer than this.
+
+    std::size_t chunk_length() const
+    {
+        return chunk_length_;
+    }
+
+    parallel_read_options& chunk_length(std::size_t value)
+    {
+        chunk_length_ = value != 0 ? value : 1;
+        return *this;
+    }
+
+    // Upper bound on chunks read from the source but not yet consumed, defaults to
+    // twice the number of threads. Reading stops until the consumer catches up,
+    // which bounds memory use to roughly max_chunks_in_flight*chunk_length
+    // plus the decoded values of those chunks.
+
+    std::size_t max_chunks_in_flight() const
+    {
+        return max_chunks_in_flight_ != 0 ? max_chunks_in_flight_ : 2*num_threads();
+    }
+
+    parallel_read_options& max_chunks_in_flight(std::size_t value)
+    {
+        max_chunks_in_flight_ = value;
+        return *this;
+    }
+};
+
+} // namespace jsoncons
+
+#endif
@@ -238,6 +238,74 @@ namespace jsoncons {
         }
     };
 
+    // std::shared_ptr, std::unique_ptr and jsoncons::optional, an empty one is written as null
+
+    namespace detail
+    {
+        template <class T, class CharT, class Json>
+        void serialize_nullable(const T* ptr, 
+                                basic_json_visitor<CharT>& encoder, 
+                                const Json& context_j, 
+                                std::error_code& ec)
+        {
+            if (ptr != nullptr)
+            {
+                ser_traits<T,CharT>::serialize(*ptr, encoder, context_j, ec);
+            }
+            else
+            {
+                encoder.null_value(semantic_tag::none, ser_context(), ec);
+            }
+        }
+    } // namespace detail
+
+    template <class T, class CharT>
+    struct ser_traits<std::shared_ptr<T>,CharT,
+        typename std::enable_if<!is_json_type_traits_declared<std::shared_ptr<T>>::value &&
+                                !std::is_polymorphic<T>::value
+    >::type>
+    {
+        template <class Json>
+        static void serialize(const std::shared_ptr<T>& val, 
+                              basic_json_visitor<CharT>& encoder, 
+                              const Json& context_j, 
+                              std::error_code& ec)
+        {
+            jsoncons::detail::serialize_nullable(val.get(), encoder, context_j, ec);
+        }
+    };
+
+    template <class T, class CharT>
+    struct ser_traits<std::unique_ptr<T>,CharT,
+        typename std::enable_if<!is_json_type_traits_declared<std::unique_ptr<T>>::value &&
+                                !std::is_polymorphic<T>::value
+    >::type>
+    {
+        template <class Json>
+        static void serialize(const std::unique_ptr<T>& val, 
+                              basic_json_visitor<CharT>& encoder, 
+                              const Json& context_j, 
+                              std::error_code& ec)
+        {
+            jsoncons::detail::serialize_nullable(val.get(), encoder, context_j, ec);
+        }
+    };
+
+    template <class T, class CharT>
+    struct ser_traits<jsoncons::optional<T>,CharT,
+        typename std::enable_if<!is_json_type_traits_declared<jsoncons::optional<T>>::value
+    >::type>
+    {
+        template <class Json>
+        static void serialize(const jsoncons::optional<T>& val, 
+                              basic_json_visitor<CharT>& encoder, 
+                              const Json& context_j, 
+                              std::error_code& ec)
+        {
+            jsoncons::detail::serialize_nullable(val.has_value() ? std::addressof(*val) : nullptr, encoder, context_j, ec);
+        }
+    };
+
     // vector like
     template <class T, class CharT>
     struct ser_traits<T,CharT,
@@ -655,6 +655,18 @@ namespace jsoncons {
         }
     };
 
+    // Sources that hold all of their input in memory may provide read_buffer(), 
+    // which returns the unread input without copying it and consumes it
+
+    template <class Source, class Enable=void>
+    struct has_read_buffer : std::false_type {};
+
+    template <class Source>
+    struct has_read_buffer<Source,
+                           typename std::enable_if<std::is_same<decltype(std::declval<Source&>().read_buffer()),
+                                                                span<const typename Source::value_type>>::value>::type> 
+        : std::true_type {};
+
     template <class Source>
     struct source_reader
     {
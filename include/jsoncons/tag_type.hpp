@@ -31,6 +31,13 @@ struct result_allocator_arg_t
 
 constexpr result_allocator_arg_t result_allocator_arg{};
 
+struct file_path_arg_t
+{
+    explicit file_path_arg_t() = default; 
+};
+
+constexpr file_path_arg_t file_path_arg{};
+
 struct half_arg_t
 {
     explicit half_arg_t() = default; 
@@ -38,6 +45,13 @@ struct half_arg_t
 
 constexpr half_arg_t half_arg{};
 
+struct double_text_arg_t
+{
+    explicit double_text_arg_t() = default; 
+};
+
+constexpr double_text_arg_t double_text_arg{};
+
 struct json_array_arg_t
 {
     explicit json_array_arg_t() = default; 
@@ -59,6 +73,13 @@ struct byte_string_arg_t
 
 constexpr byte_string_arg_t byte_string_arg{};
 
+struct typed_array_arg_t
+{
+    explicit typed_array_arg_t() = default; 
+};
+
+constexpr typed_array_arg_t typed_array_arg{};
+
 enum class semantic_tag : uint8_t 
 {
     none = 0,
@@ -21,7 +21,8 @@ enum class bson_errc
     max_nesting_depth_exceeded,
     string_length_is_non_positive,
     length_is_negative,
-    unknown_type
+    unknown_type,
+    invalid_document_size
 };
 
 class bson_error_category_impl
@@ -50,6 +51,8 @@ public:
                 return "Request for the length of a binary returned a negative result";
             case bson_errc::unknown_type:
                 return "An unknown type was found in the stream";
+            case bson_errc::invalid_document_size:
+                return "The size of a document or array does not match its contents";
             default:
                 return "Unknown BSON parser error";
         }
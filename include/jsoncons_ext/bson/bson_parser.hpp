@@ -178,6 +178,35 @@ public:
         }
     }
 
+    // Skips the elements of the document or array that was just begun without reporting them, 
+    // so that the next call to parse reports its end. The document size that precedes the 
+    // elements gives the position of its terminating null byte.
+    void skip_nested(std::error_code& ec)
+    {
+        const parse_state& state = state_stack_.back();
+        JSONCONS_ASSERT(state.mode == parse_mode::document || state.mode == parse_mode::array);
+
+        // The size includes itself and the terminating null byte, 
+        // and is stored as int32_t, so a negative size looks very large
+        if (state.length < 5 || state.length > static_cast<std::size_t>((std::numeric_limits<int32_t>::max)()))
+        {
+            ec = bson_errc::invalid_document_size;
+            return;
+        }
+        std::size_t length = state.length - 5;
+        std::size_t position = source_.position();
+        source_.ignore(length);
+        if (source_.position() - position != length)
+        {
+            ec = bson_errc::unexpected_eof;
+            return;
+        }
+        if (source_.peek() != 0x00)
+        {
+            ec = bson_errc::invalid_document_size;
+        }
+    }
+
 private:
 
     void begin_document(json_visitor& visitor, std::error_code& ec)
@@ -221,10 +250,10 @@ private:
             return;
         }
         const uint8_t* endp;
-        /* auto len = */ jsoncons::detail::little_to_native<int32_t>(buf, buf+sizeof(int32_t),&endp);
+        auto length = jsoncons::detail::little_to_native<int32_t>(buf, buf+sizeof(int32_t),&endp);
 
         more_ = visitor.begin_array(semantic_tag::none, *this, ec);
-        state_stack_.emplace_back(parse_mode::array,0);
+        state_stack_.emplace_back(parse_mode::array,length);
     }
 
     void end_array(json_visitor& visitor, std::error_code& ec)
@@ -288,9 +317,9 @@ private:
                     return;
                 }
 
-                std::vector<char> s;
+                text_buffer_.clear();
                 std::size_t size = static_cast<std::size_t>(len-1);
-                if (source_reader<Src>::read(source_,s,size) != size)
+                if (source_reader<Src>::read(source_,text_buffer_,size) != size)
                 {
                     ec = bson_errc::unexpected_eof;
                     return;
@@ -301,13 +330,13 @@ private:
                     ec = bson_errc::unexpected_eof;
                     return;
                 }
-                auto result = unicons::validate(s.begin(),s.end());
+                auto result = unicons::validate(text_buffer_.begin(),text_buffer_.end());
                 if (result.ec != unicons::conv_errc())
                 {
                     ec = bson_errc::invalid_utf8_text_string;
                     return;
                 }
-                more_ = visitor.string_value(basic_string_view<char>(s.data(),s.size()), semantic_tag::none, *this, ec);
+                more_ = visitor.string_value(basic_string_view<char>(text_buffer_.data(),text_buffer_.length()), semantic_tag::none, *this, ec);
                 break;
             }
             case jsoncons::bson::detail::bson_format::document_cd: 
@@ -163,6 +163,33 @@ public:
         read_next(ec);
     }
 
+    void skip() override
+    {
+        std::error_code ec;
+        skip(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    void skip(std::error_code& ec) override
+    {
+        if (event_handler_.event().event_type() != staj_event_type::begin_object &&
+            event_handler_.event().event_type() != staj_event_type::begin_array)
+        {
+            return;
+        }
+        if (event_handler_.in_available() || !parser_.can_skip_nested())
+        {
+            basic_staj_reader<char_type>::skip(ec);
+            return;
+        }
+        parser_.skip_nested(ec);
+        if (ec) return;
+        read_next(ec);
+    }
+
     void read_next(std::error_code& ec)
     {
         if (event_handler_.in_available())
@@ -82,6 +82,145 @@ size_t min_length_for_stringref(uint64_t index)
     return n;
 }
 
+
+enum class cbor_scan_result {complete, incomplete, malformed};
+
+// Finds the end of the data item that starts at first without decoding it. Returns
+// incomplete if the item extends past last, and malformed if a header is not well formed,
+// in which case the decoder is left to report the error.
+
+inline
+cbor_scan_result scan_cbor_item(const uint8_t* first, const uint8_t* last, const uint8_t*& end)
+{
+    const std::size_t indefinite = (std::numeric_limits<std::size_t>::max)();
+
+    // Data items still to be read at each level of nesting
+    std::vector<std::size_t> remaining;
+    remaining.push_back(1);
+
+    const uint8_t* p = first;
+    while (!remaining.empty())
+    {
+        if (remaining.back() == 0)
+        {
+            remaining.pop_back();
+            continue;
+        }
+        if (p == last)
+        {
+            return cbor_scan_result::incomplete;
+        }
+        uint8_t initial_byte = *p++;
+        if (initial_byte == 0xff)
+        {
+            if (remaining.back() != indefinite)
+            {
+                return cbor_scan_result::malformed;
+            }
+            remaining.pop_back();
+            continue;
+        }
+        if (remaining.back() != indefinite)
+        {
+            --remaining.back();
+        }
+
+        auto major_type = static_cast<cbor_major_type>(initial_byte >> 5);
+        uint8_t info = initial_byte & 0x1f;
+        uint64_t val = 0;
+        bool is_indefinite = false;
+        if (info < 24)
+        {
+            val = info;
+        }
+        else if (info <= 27)
+        {
+            std::size_t n = std::size_t(1) << (info - 24);
+            if (static_cast<std::size_t>(last - p) < n)
+            {
+                return cbor_scan_result::incomplete;
+            }
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                val = (val << 8) | p[i];
+            }
+            p += n;
+        }
+        else if (info == additional_info::indefinite_length)
+        {
+            switch (major_type)
+            {
+                case cbor_major_type::byte_string:
+                case cbor_major_type::text_string:
+                case cbor_major_type::array:
+                case cbor_major_type::map:
+                    is_indefinite = true;
+                    break;
+                default:
+                    return cbor_scan_result::malformed;
+            }
+        }
+        else
+        {
+            return cbor_scan_result::malformed;
+        }
+
+        switch (major_type)
+        {
+            case cbor_major_type::byte_string:
+            case cbor_major_type::text_string:
+                if (is_indefinite)
+                {
+                    remaining.push_back(indefinite);
+                }
+                else
+                {
+                    if (static_cast<uint64_t>(last - p) < val)
+                    {
+                        return cbor_scan_result::incomplete;
+                    }
+                    p += static_cast<std::size_t>(val);
+                }
+                break;
+            case cbor_major_type::array:
+                if (is_indefinite)
+                {
+                    remaining.push_back(indefinite);
+                }
+                else if (val > 0)
+                {
+                    if (val >= indefinite)
+                    {
+                        return cbor_scan_result::malformed;
+                    }
+                    remaining.push_back(static_cast<std::size_t>(val));
+                }
+                break;
+            case cbor_major_type::map:
+                if (is_indefinite)
+                {
+                    remaining.push_back(indefinite);
+                }
+                else if (val > 0)
+                {
+                    if (val >= indefinite/2)
+                    {
+                        return cbor_scan_result::malformed;
+                    }
+                    remaining.push_back(2*static_cast<std::size_t>(val));
+                }
+                break;
+            case cbor_major_type::semantic_tag:
+                remaining.push_back(1);
+                break;
+            default:
+                break;
+        }
+    }
+    end = p;
+    return cbor_scan_result::complete;
+}
+
 }}}
 
 #endif
@@ -361,9 +361,196 @@ public:
             }
         }
     }
+
+    // Whether skip_nested can skip the array or map that was just begun. Strings in a stringref 
+    // namespace that encloses it must be read to number them, and a multi-dimensional array 
+    // is reported from its shape.
+    bool can_skip_nested() const
+    {
+        if (!stringref_map_stack_.empty() && !state_stack_.back().pop_stringref_map_stack)
+        {
+            return false;
+        }
+        switch (state_stack_.back().mode)
+        {
+            case parse_mode::array:
+            case parse_mode::indefinite_array:
+            case parse_mode::map_key:
+            case parse_mode::indefinite_map_key:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Skips the items of the array or map that was just begun without reporting them, so that 
+    // the next call to parse reports its end. Strings are skipped by their length, and nested 
+    // arrays and maps by their counts or break codes, nothing is decoded.
+    void skip_nested(std::error_code& ec)
+    {
+        JSONCONS_ASSERT(can_skip_nested());
+        const std::size_t indefinite = (std::numeric_limits<std::size_t>::max)();
+
+        // The number of items left in each array or map being skipped
+        std::vector<std::size_t> counts;
+        parse_state& state = state_stack_.back();
+        switch (state.mode)
+        {
+            case parse_mode::array:
+                counts.push_back(state.length - state.index);
+                state.index = state.length;
+                break;
+            case parse_mode::map_key:
+                counts.push_back(2*(state.length - state.index));
+                state.index = state.length;
+                break;
+            default:
+                counts.push_back(indefinite);
+                break;
+        }
+
+        while (!counts.empty())
+        {
+            if (counts.back() == 0)
+            {
+                counts.pop_back();
+                continue;
+            }
+            int c = source_.peek();
+            if (c == Src::traits_type::eof())
+            {
+                ec = cbor_errc::unexpected_eof;
+                more_ = false;
+                return;
+            }
+            if (counts.back() == indefinite)
+            {
+                if (c == 0xff)
+                {
+                    if (counts.size() == 1)
+                    {
+                        return; // parse reads the break and reports the end
+                    }
+                    source_.ignore(1);
+                    counts.pop_back();
+                    continue;
+                }
+            }
+            else
+            {
+                --counts.back();
+            }
+
+            uint8_t info = get_additional_information_value((uint8_t)c);
+            switch (get_major_type((uint8_t)c))
+            {
+                case jsoncons::cbor::detail::cbor_major_type::semantic_tag:
+                    get_uint64_value(ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    if (counts.back() != indefinite)
+                    {
+                        ++counts.back(); // the tagged item follows
+                    }
+                    break;
+                case jsoncons::cbor::detail::cbor_major_type::byte_string:
+                case jsoncons::cbor::detail::cbor_major_type::text_string:
+                    if (info == jsoncons::cbor::detail::additional_info::indefinite_length)
+                    {
+                        source_.ignore(1);
+                        counts.push_back(indefinite); // definite length chunks up to a break
+                    }
+                    else
+                    {
+                        std::size_t length = get_size(ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                        skip_bytes(length, ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                    }
+                    break;
+                case jsoncons::cbor::detail::cbor_major_type::array:
+                case jsoncons::cbor::detail::cbor_major_type::map:
+                {
+                    if (JSONCONS_UNLIKELY(nesting_depth_ + static_cast<int>(counts.size()) > options_.max_nesting_depth()))
+                    {
+                        ec = cbor_errc::max_nesting_depth_exceeded;
+                        more_ = false;
+                        return;
+                    }
+                    if (info == jsoncons::cbor::detail::additional_info::indefinite_length)
+                    {
+                        source_.ignore(1);
+                        counts.push_back(indefinite);
+                        break;
+                    }
+                    std::size_t length = get_size(ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    if (get_major_type((uint8_t)c) == jsoncons::cbor::detail::cbor_major_type::map)
+                    {
+                        if (length > indefinite/2 - 1)
+                        {
+                            ec = cbor_errc::number_too_large;
+                            more_ = false;
+                            return;
+                        }
+                        length *= 2;
+                    }
+                    counts.push_back(length);
+                    break;
+                }
+                case jsoncons::cbor::detail::cbor_major_type::simple:
+                    if (info >= 0x1c)
+                    {
+                        ec = cbor_errc::unknown_type;
+                        more_ = false;
+                        return;
+                    }
+                    get_uint64_value(ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    break;
+                default: // integers
+                    get_uint64_value(ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    break;
+            }
+        }
+    }
 private:
+    void skip_bytes(std::size_t length, std::error_code& ec)
+    {
+        std::size_t position = source_.position();
+        source_.ignore(length);
+        if (source_.position() - position != length)
+        {
+            ec = cbor_errc::unexpected_eof;
+            more_ = false;
+        }
+    }
+
     void read_item(json_visitor& visitor, std::error_code& ec)
     {
+        if (source_.is_error())
+        {
+            ec = cbor_errc::source_error;
+            return;
+        }   
         read_tags(ec);
         if (ec)
         {
@@ -15,6 +15,7 @@
 #include <jsoncons/json.hpp>
 #include <jsoncons/json_filter.hpp>
 #include <jsoncons/deser_traits.hpp>
+#include <jsoncons/mmap_source.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons_ext/cbor/cbor_reader.hpp>
 #include <jsoncons_ext/cbor/cbor_cursor.hpp>
@@ -51,6 +52,37 @@ namespace cbor {
         return val;
     }
 
+    // From a file, which is memory mapped
+
+    template<class T>
+    typename std::enable_if<is_basic_json<T>::value,T>::type 
+    decode_cbor(file_path_arg_t, const std::string& path, 
+                const cbor_decode_options& options = cbor_decode_options())
+    {
+        jsoncons::json_decoder<T> decoder;
+        auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
+        basic_cbor_reader<binary_mmap_source> reader(binary_mmap_source(path), adaptor, options);
+        reader.read();
+        return decoder.get_result();
+    }
+
+    template<class T>
+    typename std::enable_if<!is_basic_json<T>::value,T>::type 
+    decode_cbor(file_path_arg_t, const std::string& path, 
+                const cbor_decode_options& options = cbor_decode_options())
+    {
+        basic_cbor_cursor<binary_mmap_source> cursor(binary_mmap_source(path), options);
+        json_decoder<basic_json<char,sorted_policy>> decoder{};
+
+        std::error_code ec;
+        T val = deser_traits<T,char>::deserialize(cursor, decoder, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec, cursor.context().line(), cursor.context().column()));
+        }
+        return val;
+    }
+
     template<class T>
     typename std::enable_if<is_basic_json<T>::value,T>::type 
     decode_cbor(std::istream& is, 
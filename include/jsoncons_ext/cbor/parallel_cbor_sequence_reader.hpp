@@ -0,0 +1,333 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_PARALLEL_CBOR_SEQUENCE_READER_HPP
+#define JSONCONS_CBOR_PARALLEL_CBOR_SEQUENCE_READER_HPP
+
+#include <algorithm> // std::max
+#include <memory> // std::unique_ptr, std::shared_ptr
+#include <system_error>
+#include <utility> // std::move
+#include <vector>
+#include <jsoncons/json.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/parallel_read_options.hpp>
+#include <jsoncons/detail/ordered_task_pool.hpp>
+#include <jsoncons_ext/cbor/cbor_error.hpp>
+#include <jsoncons_ext/cbor/cbor_detail.hpp>
+#include <jsoncons_ext/cbor/cbor_options.hpp>
+#include <jsoncons_ext/cbor/cbor_parser.hpp>
+
+namespace jsoncons { namespace cbor {
+
+// Reads a CBOR sequence (RFC 8742), data items concatenated with no delimiter. The input
+// is split into chunks at item boundaries, found by scanning the item headers, the chunks
+// are decoded by a pool of worker threads, and the values are delivered in input order.
+// An item that fails to decode is reported with its position, and reading can continue
+// with the next item. A malformed item header ends the sequence, since the items after
+// it cannot be located.
+
+template <class Json,class Src=jsoncons::binary_stream_source>
+class parallel_cbor_sequence_reader
+{
+public:
+    using value_type = Json;
+    using source_type = Src;
+private:
+    using buffer_type = std::vector<uint8_t>;
+
+    struct sequence_item
+    {
+        Json value;
+        std::error_code ec;
+        std::size_t position;
+
+        sequence_item(Json&& value, std::size_t position)
+            : value(std::move(value)), position(position)
+        {
+        }
+
+        sequence_item(std::error_code ec, std::size_t position)
+            : ec(ec), position(position)
+        {
+        }
+    };
+
+    struct chunk_task
+    {
+        buffer_type data;
+    };
+
+    struct chunk_result
+    {
+        std::vector<sequence_item> items;
+        std::size_t length;
+
+        chunk_result()
+            : length(0)
+        {
+        }
+    };
+
+    using pool_type = jsoncons::detail::ordered_task_pool<chunk_task,chunk_result>;
+
+    source_type source_;
+    std::size_t chunk_length_;
+    std::size_t max_chunks_in_flight_;
+    buffer_type carry_;
+    bool source_done_;
+    chunk_result current_;
+    std::size_t index_;
+    std::size_t first_position_;
+    std::size_t position_;
+    std::error_code source_ec_; // A failure to read, reported after the items read before it
+    std::size_t source_error_offset_; // Bytes read past the last complete item
+    std::unique_ptr<pool_type> pool_; // last, so that the workers are joined first
+
+    // Noncopyable and nonmoveable
+    parallel_cbor_sequence_reader(const parallel_cbor_sequence_reader&) = delete;
+    parallel_cbor_sequence_reader& operator=(const parallel_cbor_sequence_reader&) = delete;
+
+public:
+    template <class Source>
+    explicit parallel_cbor_sequence_reader(Source&& source,
+                                           const cbor_decode_options& options = cbor_decode_options(),
+                                           const parallel_read_options& parallel_options = parallel_read_options())
+        : source_(std::forward<Source>(source)),
+          chunk_length_(parallel_options.chunk_length()),
+          max_chunks_in_flight_(parallel_options.max_chunks_in_flight()),
+          source_done_(false),
+          index_(0),
+          first_position_(0),
+          position_(0),
+          source_error_offset_(0)
+    {
+        cbor_decode_options opts(options);
+        pool_.reset(new pool_type(parallel_options.num_threads(), [opts]() -> typename pool_type::worker_function
+        {
+            auto decoder = std::make_shared<json_decoder<Json>>();
+            return [opts,decoder](chunk_task& task, chunk_result& result)
+            {
+                decode_chunk(opts, *decoder, task.data, result);
+            };
+        }));
+    }
+
+    // Reads the next value. Returns false at the end of the input, or if the next
+    // item could not be decoded, in which case ec is set and position() gives
+    // the location of the error. Reading may continue past a decode error.
+    // A failure to read the source is reported after the values read before it,
+    // and ends the input.
+
+    bool read_next(Json& value, std::error_code& ec)
+    {
+        while (index_ == current_.items.size())
+        {
+            fill();
+            if (pool_->pending() == 0)
+            {
+                if (source_ec_)
+                {
+                    position_ = first_position_ + current_.length + source_error_offset_;
+                    ec = source_ec_;
+                    source_ec_ = std::error_code();
+                }
+                return false;
+            }
+            first_position_ += current_.length;
+            current_ = pool_->take();
+            index_ = 0;
+        }
+
+        sequence_item& item = current_.items[index_++];
+        position_ = first_position_ + item.position;
+        if (item.ec)
+        {
+            ec = item.ec;
+            return false;
+        }
+        value = std::move(item.value);
+        return true;
+    }
+
+    bool read_next(Json& value)
+    {
+        std::error_code ec;
+        bool result = read_next(value, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,position_));
+        }
+        return result;
+    }
+
+    // Reads the next value and replays it to visitor
+
+    bool read_next(json_visitor& visitor, std::error_code& ec)
+    {
+        Json value;
+        if (!read_next(value, ec))
+        {
+            return false;
+        }
+        value.dump(visitor, ec);
+        return !ec;
+    }
+
+    bool read_next(json_visitor& visitor)
+    {
+        std::error_code ec;
+        bool result = read_next(visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,position_));
+        }
+        return result;
+    }
+
+    // Offset of the first byte of the value last returned by read_next,
+    // or the position of the error reported by it
+
+    std::size_t position() const
+    {
+        return position_;
+    }
+
+    std::size_t num_threads() const
+    {
+        return pool_->num_threads();
+    }
+
+private:
+    // Reads ahead until max_chunks_in_flight chunks are pending or the source is exhausted
+
+    void fill()
+    {
+        while (!source_done_ && pool_->pending() < max_chunks_in_flight_)
+        {
+            chunk_task task;
+            std::error_code ec;
+            read_chunk(task.data, ec);
+            if (!task.data.empty())
+            {
+                pool_->submit(std::move(task));
+            }
+            if (ec)
+            {
+                source_ec_ = ec;
+                source_done_ = true;
+            }
+        }
+    }
+
+    // Reads at least chunk_length bytes, or to the end of the source, and keeps
+    // the trailing incomplete item for the next chunk. On failure, data keeps
+    // the complete items read before it, and the failure is located after the rest.
+
+    void read_chunk(buffer_type& data, std::error_code& ec)
+    {
+        data.swap(carry_);
+        carry_.clear();
+        while (true)
+        {
+            // An item longer than the chunk length is read in growing steps,
+            // so that its header is rescanned only a few times
+            std::size_t length = (std::max)(chunk_length_, data.size());
+            std::size_t old_size = data.size();
+            data.resize(old_size + length);
+            std::size_t n = source_.read(data.data() + old_size, length);
+            data.resize(old_size + n);
+
+            const uint8_t* first = data.data();
+            const uint8_t* last = data.data() + data.size();
+            const uint8_t* boundary = first;
+            bool malformed = false;
+            while (boundary < last && !malformed)
+            {
+                const uint8_t* end;
+                auto result = detail::scan_cbor_item(boundary, last, end);
+                if (result == detail::cbor_scan_result::complete)
+                {
+                    boundary = end;
+                }
+                else
+                {
+                    malformed = result == detail::cbor_scan_result::malformed;
+                    break;
+                }
+            }
+
+            if (source_.is_error())
+            {
+                ec = cbor_errc::source_error;
+                // Past a malformed item the decoder reports it first
+                if (!malformed)
+                {
+                    source_error_offset_ = static_cast<std::size_t>(last - boundary);
+                    data.resize(boundary - first);
+                }
+                return;
+            }
+
+            // Past a malformed item, or at the end, the rest goes to the decoder as is
+            if (malformed || source_.eof())
+            {
+                source_done_ = true;
+                return;
+            }
+            if (boundary > first)
+            {
+                carry_.assign(boundary, last);
+                data.resize(boundary - first);
+                return;
+            }
+        }
+    }
+
+    static void decode_chunk(const cbor_decode_options& options,
+                             json_decoder<Json>& decoder,
+                             const buffer_type& data,
+                             chunk_result& result)
+    {
+        std::size_t offset = 0;
+        while (offset < data.size())
+        {
+            basic_cbor_parser<bytes_source> parser(bytes_source(data.data() + offset, data.size() - offset), options);
+            std::size_t base = offset;
+            while (offset < data.size())
+            {
+                std::error_code ec;
+                parser.reset();
+                parser.parse(decoder, ec);
+                if (ec)
+                {
+                    result.items.emplace_back(ec, base + parser.column());
+                    decoder.reset();
+                    break;
+                }
+                result.items.emplace_back(decoder.get_result(), offset);
+                // The parser's position is one past the offset of the next byte
+                offset = base + parser.column() - 1;
+            }
+            if (offset < data.size())
+            {
+                // Resume with the item after the one that failed, if its extent is known
+                const uint8_t* end;
+                if (detail::scan_cbor_item(data.data() + offset, data.data() + data.size(), end) != detail::cbor_scan_result::complete)
+                {
+                    break;
+                }
+                offset = end - data.data();
+            }
+        }
+        result.length = data.size();
+    }
+};
+
+}}
+
+#endif
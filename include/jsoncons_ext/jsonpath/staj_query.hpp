@@ -0,0 +1,915 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSONPATH_STAJ_QUERY_HPP
+#define JSONCONS_JSONPATH_STAJ_QUERY_HPP
+
+#include <string>
+#include <vector>
+#include <memory> // std::unique_ptr
+#include <limits> // std::numeric_limits
+#include <algorithm> // std::find
+#include <system_error>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/staj_reader.hpp>
+#include <jsoncons_ext/jsonpath/json_query.hpp>
+
+namespace jsoncons { namespace jsonpath {
+
+    // staj_query
+
+    // Evaluates a JSONPath expression over the events of a staj_reader, without reading the
+    // document into memory. The path is compiled into a list of steps, and the document is walked
+    // with the set of steps that are yet to be applied at each level, like a nondeterministic
+    // automaton. Values that no step can select anything in are passed over with skip, a value
+    // is read into memory only if it is selected, if a filter has to be applied to it, or if its
+    // length or a string's characters are to be selected, and reading stops as soon as no step
+    // can select anything further on. Each selected location is reported once, where json_query
+    // leaves out union results equal in value to an earlier one, and reports a location reached
+    // through nested recursive descents more than once.
+
+    template <class Json>
+    class staj_query
+    {
+    public:
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = typename Json::string_view_type;
+        using reader_type = basic_staj_reader<char_type>;
+    private:
+        static constexpr std::size_t npos = (std::numeric_limits<std::size_t>::max)();
+
+        struct name_type
+        {
+            string_type name;
+            std::size_t index; // The array index the name denotes, or npos
+        };
+
+        struct slice_type
+        {
+            std::size_t start;
+            std::size_t end; // npos if the slice runs to the end of the array
+            std::size_t step;
+        };
+
+        struct step_type
+        {
+            bool recursive;
+            bool wildcard;
+            bool has_filter;
+            std::vector<name_type> names;
+            std::vector<slice_type> slices;
+            detail::jsonpath_filter_expr<Json> filter;
+
+            step_type()
+                : recursive(false), wildcard(false), has_filter(false)
+            {
+            }
+        };
+
+        struct frame_type
+        {
+            std::vector<std::size_t> states; // The steps to apply to the members or elements
+            bool object;
+            std::size_t index;
+            std::size_t path_length;
+            std::size_t limit; // The members still to be selected, or the array index past the last one, or npos
+        };
+
+        // The filter expressions hold pointers to the operators in the resources
+        std::unique_ptr<detail::jsonpath_resources<Json>> resources_;
+        std::vector<step_type> steps_;
+        std::vector<frame_type> stack_;
+        string_type path_;
+        string_type name_;
+        json_decoder<Json> decoder_;
+    public:
+        explicit staj_query(const string_view_type& path)
+            : resources_(jsoncons::make_unique<detail::jsonpath_resources<Json>>())
+        {
+            std::error_code ec;
+            std::size_t position = 0;
+            compile(path, position, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(jsonpath_error(ec, position));
+            }
+        }
+
+        staj_query(const string_view_type& path, std::error_code& ec)
+            : resources_(jsoncons::make_unique<detail::jsonpath_resources<Json>>())
+        {
+            std::size_t position = 0;
+            JSONCONS_TRY
+            {
+                compile(path, position, ec);
+            }
+            JSONCONS_CATCH(...)
+            {
+                ec = jsonpath_errc::invalid_filter;
+            }
+        }
+
+        // Reads the document that begins at the current event of the reader, and for each value
+        // the path selects calls f(location, value), where location is the normalized path of
+        // the value. The values are reported in the order in which they appear in the document.
+        template <class Callback>
+        void evaluate(reader_type& reader, Callback f)
+        {
+            std::error_code ec;
+            evaluate(reader, f, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec, reader.context().line(), reader.context().column()));
+            }
+        }
+
+        template <class Callback>
+        void evaluate(reader_type& reader, Callback f, std::error_code& ec)
+        {
+            stack_.clear();
+            path_.clear();
+            path_.push_back('$');
+
+            std::vector<std::size_t> states;
+            bool matched = false;
+            advance(0, states, matched);
+            value(reader, std::move(states), matched, std::vector<std::size_t>(), f, ec);
+            while (!ec && !exhausted())
+            {
+                reader.next(ec);
+                if (ec)
+                {
+                    return;
+                }
+                frame_type& top = stack_.back();
+                staj_event_type event_type = reader.current().event_type();
+                if (event_type == staj_event_type::end_object || event_type == staj_event_type::end_array)
+                {
+                    stack_.pop_back();
+                    continue;
+                }
+
+                states.clear();
+                matched = false;
+                std::vector<std::size_t> filters;
+                path_.resize(top.path_length);
+                if (top.object)
+                {
+                    // The states depend on whether the value is a string, which the next event tells
+                    auto name = reader.current().template get<string_view_type>();
+                    name_.assign(name.data(), name.size());
+                    append_name(name);
+                    reader.next(ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    bool descend = reader.current().event_type() != staj_event_type::string_value;
+                    if (member_states(top.states, name_, states, matched, descend) && top.limit != npos)
+                    {
+                        --top.limit;
+                    }
+                }
+                else
+                {
+                    bool descend = event_type != staj_event_type::string_value;
+                    element_states(top.states, top.index, states, matched, filters, descend);
+                    append_index(top.index);
+                    ++top.index;
+                }
+                value(reader, std::move(states), matched, filters, f, ec);
+            }
+        }
+
+        // Reads the document that begins at the current event of the reader, and returns an
+        // array of the values the path selects, or of their normalized paths
+        Json evaluate(reader_type& reader, result_type result_t = result_type::value)
+        {
+            Json result = typename Json::array();
+            if (result_t == result_type::value)
+            {
+                evaluate(reader, [&](const string_view_type&, const Json& val)
+                {
+                    result.push_back(val);
+                });
+            }
+            else
+            {
+                evaluate(reader, [&](const string_view_type& location, const Json&)
+                {
+                    result.push_back(location);
+                });
+            }
+            return result;
+        }
+    private:
+        void compile(const string_view_type& path, std::size_t& position, std::error_code& ec)
+        {
+            const char_type* begin = path.data();
+            const char_type* end = path.data() + path.size();
+            const char_type* p = begin;
+
+            // The root may be left out, as in json_query
+            skip_space(p, end);
+            bool implicit_root = p != end && *p != '$';
+            if (!implicit_root && p != end)
+            {
+                ++p;
+            }
+            while (true)
+            {
+                skip_space(p, end);
+                if (p == end)
+                {
+                    break;
+                }
+                step_type step;
+                if (implicit_root)
+                {
+                    compile_name(p, end, step, ec);
+                    implicit_root = false;
+                }
+                else if (*p == '.')
+                {
+                    ++p;
+                    if (p != end && *p == '.')
+                    {
+                        step.recursive = true;
+                        ++p;
+                    }
+                    skip_space(p, end);
+                    if (p != end && *p == '[' && step.recursive)
+                    {
+                        compile_brackets(begin, p, end, step, ec);
+                    }
+                    else
+                    {
+                        compile_name(p, end, step, ec);
+                    }
+                }
+                else if (*p == '[')
+                {
+                    compile_brackets(begin, p, end, step, ec);
+                }
+                else
+                {
+                    ec = jsonpath_errc::expected_separator;
+                }
+                if (ec)
+                {
+                    position = static_cast<std::size_t>(p - begin) + 1;
+                    return;
+                }
+                steps_.push_back(std::move(step));
+            }
+        }
+
+        // Compiles a wildcard or a quoted or unquoted name following a dot
+        void compile_name(const char_type*& p, const char_type* end, step_type& step, std::error_code& ec)
+        {
+            if (p != end && *p == '*')
+            {
+                step.wildcard = true;
+                ++p;
+            }
+            else if (p != end && (*p == '\'' || *p == '\"'))
+            {
+                compile_quoted_name(p, end, step, ec);
+            }
+            else
+            {
+                string_type name;
+                while (p != end && *p != '.' && *p != '[' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+                {
+                    name.push_back(*p);
+                    ++p;
+                }
+                if (name.empty())
+                {
+                    ec = jsonpath_errc::expected_name;
+                    return;
+                }
+                add_name(step, std::move(name));
+            }
+        }
+
+        void compile_quoted_name(const char_type*& p, const char_type* end, step_type& step, std::error_code& ec)
+        {
+            char_type quote = *p++;
+            string_type name;
+            while (p != end && *p != quote)
+            {
+                if (*p == '\\' && p + 1 != end)
+                {
+                    ++p;
+                }
+                name.push_back(*p);
+                ++p;
+            }
+            if (p == end)
+            {
+                ec = jsonpath_errc::unexpected_end_of_input;
+                return;
+            }
+            ++p;
+            add_name(step, std::move(name));
+        }
+
+        // Compiles a bracketed union of names, indices, slices, a wildcard and a filter
+        void compile_brackets(const char_type* begin, const char_type*& p, const char_type* end,
+                              step_type& step, std::error_code& ec)
+        {
+            ++p;
+            while (true)
+            {
+                skip_space(p, end);
+                if (p == end)
+                {
+                    ec = jsonpath_errc::expected_right_bracket;
+                    return;
+                }
+                switch (*p)
+                {
+                    case '*':
+                        step.wildcard = true;
+                        ++p;
+                        break;
+                    case '\'':
+                    case '\"':
+                        compile_quoted_name(p, end, step, ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                        break;
+                    case '?':
+                    {
+                        if (step.has_filter)
+                        {
+                            ec = jsonpath_errc::unsupported_in_stream;
+                            return;
+                        }
+                        // A path from the root in the filter would be evaluated against an empty object,
+                        // the document is not in memory
+                        detail::jsonpath_filter_parser<Json> parser(1, static_cast<std::size_t>(p - begin) + 1);
+                        step.filter = parser.parse(*resources_, Json(), p, end, &p);
+                        step.has_filter = true;
+                        break;
+                    }
+                    case '-':
+                        ec = jsonpath_errc::unsupported_in_stream;
+                        return;
+                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
+                    case ':':
+                    {
+                        const char_type* first = p;
+                        std::size_t start = 0;
+                        bool has_start = compile_integer(p, end, start, ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                        if (p == end || *p != ':')
+                        {
+                            add_name(step, string_type(first, p));
+                            break;
+                        }
+                        ++p;
+                        slice_type slice{has_start ? start : 0, npos, 1};
+                        if (!compile_integer(p, end, slice.end, ec))
+                        {
+                            slice.end = npos;
+                        }
+                        if (!ec && p != end && *p == ':')
+                        {
+                            ++p;
+                            if (compile_integer(p, end, slice.step, ec) && slice.step == 0)
+                            {
+                                ec = jsonpath_errc::expected_slice_step;
+                            }
+                        }
+                        if (ec)
+                        {
+                            return;
+                        }
+                        step.slices.push_back(slice);
+                        break;
+                    }
+                    default:
+                    {
+                        // An unquoted name, a path in a union is not supported
+                        string_type name;
+                        while (p != end && *p != ',' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+                        {
+                            if (*p == '.' || *p == '[' || *p == '@' || *p == '$')
+                            {
+                                ec = jsonpath_errc::unsupported_in_stream;
+                                return;
+                            }
+                            name.push_back(*p);
+                            ++p;
+                        }
+                        if (name.empty())
+                        {
+                            ec = jsonpath_errc::expected_name;
+                            return;
+                        }
+                        add_name(step, std::move(name));
+                        break;
+                    }
+                }
+                skip_space(p, end);
+                if (p == end)
+                {
+                    ec = jsonpath_errc::expected_right_bracket;
+                    return;
+                }
+                if (*p == ']')
+                {
+                    ++p;
+                    return;
+                }
+                if (*p != ',')
+                {
+                    ec = jsonpath_errc::expected_right_bracket;
+                    return;
+                }
+                ++p;
+            }
+        }
+
+        // Reads an unsigned integer, returns false if there is none. Negative indices and steps
+        // count from the end of an array, which is not known until it has been read.
+        static bool compile_integer(const char_type*& p, const char_type* end, std::size_t& value, std::error_code& ec)
+        {
+            if (p != end && *p == '-')
+            {
+                ec = jsonpath_errc::unsupported_in_stream;
+                return false;
+            }
+            if (p == end || *p < '0' || *p > '9')
+            {
+                return false;
+            }
+            value = 0;
+            while (p != end && *p >= '0' && *p <= '9')
+            {
+                if (value > (npos - 9) / 10)
+                {
+                    ec = jsonpath_errc::unsupported_in_stream;
+                    return false;
+                }
+                value = value*10 + static_cast<std::size_t>(*p - '0');
+                ++p;
+            }
+            return true;
+        }
+
+        static void skip_space(const char_type*& p, const char_type* end)
+        {
+            while (p != end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+            {
+                ++p;
+            }
+        }
+
+        static void add_name(step_type& step, string_type&& name)
+        {
+            std::size_t index = to_index(name);
+            step.names.push_back(name_type{std::move(name), index});
+        }
+
+        // The array index a name denotes, or npos if it is not one
+        static std::size_t to_index(const string_type& name)
+        {
+            if (name.empty() || (name.size() > 1 && name[0] == '0'))
+            {
+                return npos;
+            }
+            std::size_t index = 0;
+            for (auto c : name)
+            {
+                if (c < '0' || c > '9' || index > (npos - 9) / 10)
+                {
+                    return npos;
+                }
+                index = index*10 + static_cast<std::size_t>(c - '0');
+            }
+            return index;
+        }
+
+        static bool selects_member(const step_type& step, const string_view_type& name)
+        {
+            if (step.wildcard)
+            {
+                return true;
+            }
+            for (const auto& item : step.names)
+            {
+                if (string_view_type(item.name) == name)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static bool selects_element(const step_type& step, std::size_t index)
+        {
+            if (step.wildcard)
+            {
+                return true;
+            }
+            for (const auto& item : step.names)
+            {
+                if (item.index == index)
+                {
+                    return true;
+                }
+            }
+            for (const auto& slice : step.slices)
+            {
+                if (index >= slice.start && index < slice.end && (index - slice.start) % slice.step == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static bool selects_length(const step_type& step)
+        {
+            for (const auto& item : step.names)
+            {
+                if (string_view_type(item.name) == detail::length_literal<char_type>())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static bool selects_char(const step_type& step)
+        {
+            for (const auto& item : step.names)
+            {
+                if (item.index != npos)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // The length of an array and the chars and length of a string are selected from the value in
+        // memory, an array's length is not known before its end
+        bool needs_value(const std::vector<std::size_t>& states, staj_event_type event_type) const
+        {
+            for (auto state : states)
+            {
+                const step_type& step = steps_[state];
+                if (event_type == staj_event_type::begin_array && selects_length(step))
+                {
+                    return true;
+                }
+                if (event_type == staj_event_type::string_value && (selects_length(step) || selects_char(step)))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool test(std::size_t state, const Json& val)
+        {
+            bool result = steps_[state].filter.exists(*resources_, val);
+            resources_->temp_json_values_.clear();
+            return result;
+        }
+
+        // Adds the state to those of a value, the value is selected if it is past the last step
+        void advance(std::size_t state, std::vector<std::size_t>& states, bool& matched) const
+        {
+            if (state == steps_.size())
+            {
+                matched = true;
+            }
+            else if (std::find(states.begin(), states.end(), state) == states.end())
+            {
+                states.push_back(state);
+            }
+        }
+
+        // Computes the states of a member, returns true if one of the steps names it. Recursive 
+        // descent does not descend into a string, as in json_query, so unless descend is true 
+        // the member keeps only the recursive steps that begin at it.
+        bool member_states(const std::vector<std::size_t>& parent, const string_view_type& name,
+                           std::vector<std::size_t>& states, bool& matched, bool descend) const
+        {
+            bool named = false;
+            for (auto state : parent)
+            {
+                const step_type& step = steps_[state];
+                if (step.recursive && descend)
+                {
+                    advance(state, states, matched);
+                }
+                if (selects_member(step, name))
+                {
+                    named = true;
+                    advance(state + 1, states, matched);
+                }
+            }
+            return named;
+        }
+
+        // Computes the states of an element, and the filters that are to be applied to it
+        void element_states(const std::vector<std::size_t>& parent, std::size_t index,
+                            std::vector<std::size_t>& states, bool& matched,
+                            std::vector<std::size_t>& filters, bool descend) const
+        {
+            for (auto state : parent)
+            {
+                const step_type& step = steps_[state];
+                if (step.recursive && descend)
+                {
+                    advance(state, states, matched);
+                }
+                if (selects_element(step, index))
+                {
+                    advance(state + 1, states, matched);
+                }
+                else if (step.has_filter)
+                {
+                    filters.push_back(state);
+                }
+            }
+        }
+
+        bool has_filter(const std::vector<std::size_t>& states) const
+        {
+            for (auto state : states)
+            {
+                if (steps_[state].has_filter)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // The number of members the states can still select, or for an array the index past the
+        // last element they can select, npos if there is no such bound
+        std::size_t limit(const std::vector<std::size_t>& states, bool object) const
+        {
+            std::size_t result = 0;
+            for (auto state : states)
+            {
+                const step_type& step = steps_[state];
+                if (step.recursive || step.wildcard || step.has_filter)
+                {
+                    return npos;
+                }
+                if (object)
+                {
+                    result += step.names.size();
+                }
+                else
+                {
+                    for (const auto& item : step.names)
+                    {
+                        if (item.index != npos && item.index >= result)
+                        {
+                            result = item.index + 1;
+                        }
+                    }
+                    for (const auto& slice : step.slices)
+                    {
+                        if (slice.end == npos)
+                        {
+                            return npos;
+                        }
+                        if (slice.end > result)
+                        {
+                            result = slice.end;
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        // True if no frame can select anything further on
+        bool exhausted() const
+        {
+            for (auto it = stack_.rbegin(); it != stack_.rend(); ++it)
+            {
+                if (it->object ? it->limit != 0 : it->index < it->limit)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void append_name(const string_view_type& name)
+        {
+            path_.push_back('[');
+            path_.push_back('\'');
+            path_.append(name.data(), name.size());
+            path_.push_back('\'');
+            path_.push_back(']');
+        }
+
+        void append_index(std::size_t index)
+        {
+            path_.push_back('[');
+            jsoncons::detail::write_integer(index, path_);
+            path_.push_back(']');
+        }
+
+        // Handles the value at the current event of the reader, and leaves the reader at its last
+        // event, or at its first if it is an object or array that is to be walked
+        template <class Callback>
+        void value(reader_type& reader, std::vector<std::size_t>&& states, bool matched,
+                   const std::vector<std::size_t>& filters, Callback& f, std::error_code& ec)
+        {
+            staj_event_type event_type = reader.current().event_type();
+            // A filter applied to an object tests the object itself
+            if (matched || !filters.empty() || (event_type == staj_event_type::begin_object && has_filter(states))
+                || needs_value(states, event_type))
+            {
+                decoder_.reset();
+                reader.read(decoder_, ec);
+                if (ec)
+                {
+                    return;
+                }
+                Json val = decoder_.get_result();
+                for (auto state : filters)
+                {
+                    if (test(state, val))
+                    {
+                        advance(state + 1, states, matched);
+                    }
+                }
+                deliver(val, states, matched, f);
+            }
+            else if (states.empty())
+            {
+                reader.skip(ec);
+            }
+            else if (event_type == staj_event_type::begin_object || event_type == staj_event_type::begin_array)
+            {
+                bool object = event_type == staj_event_type::begin_object;
+                std::size_t bound = limit(states, object);
+                stack_.push_back(frame_type{std::move(states), object, 0, path_.size(), bound});
+            }
+        }
+
+        // Applies the states to a value that has been read into memory
+        template <class Callback>
+        void deliver(const Json& val, std::vector<std::size_t>& states, bool matched, Callback& f)
+        {
+            if (val.is_object())
+            {
+                for (std::size_t i = 0; i < states.size(); ++i)
+                {
+                    std::size_t state = states[i];
+                    if (steps_[state].has_filter && test(state, val))
+                    {
+                        advance(state + 1, states, matched);
+                    }
+                }
+            }
+            if (matched)
+            {
+                f(string_view_type(path_), val);
+            }
+            if (states.empty())
+            {
+                return;
+            }
+
+            std::size_t length = path_.size();
+            if (val.is_object())
+            {
+                for (const auto& member : val.object_range())
+                {
+                    std::vector<std::size_t> children;
+                    bool child_matched = false;
+                    member_states(states, member.key(), children, child_matched, !member.value().is_string());
+                    if (child_matched || !children.empty())
+                    {
+                        append_name(member.key());
+                        deliver(member.value(), children, child_matched, f);
+                        path_.resize(length);
+                    }
+                }
+            }
+            else if (val.is_array())
+            {
+                std::size_t index = 0;
+                for (const auto& item : val.array_range())
+                {
+                    std::vector<std::size_t> children;
+                    std::vector<std::size_t> filters;
+                    bool child_matched = false;
+                    element_states(states, index, children, child_matched, filters, !item.is_string());
+                    for (auto state : filters)
+                    {
+                        if (test(state, item))
+                        {
+                            advance(state + 1, children, child_matched);
+                        }
+                    }
+                    if (child_matched || !children.empty())
+                    {
+                        append_index(index);
+                        deliver(item, children, child_matched, f);
+                        path_.resize(length);
+                    }
+                    ++index;
+                }
+                deliver_length(val.size(), states, f);
+            }
+            else if (val.is_string())
+            {
+                // A char is selected by its index, as an element is, but not by a slice or wildcard
+                auto sv = val.as_string_view();
+                std::vector<std::size_t> indices;
+                for (auto state : states)
+                {
+                    for (const auto& item : steps_[state].names)
+                    {
+                        if (item.index != npos && std::find(indices.begin(), indices.end(), item.index) == indices.end())
+                        {
+                            indices.push_back(item.index);
+                        }
+                    }
+                }
+                std::sort(indices.begin(), indices.end());
+                for (auto index : indices)
+                {
+                    auto sequence = unicons::sequence_at(sv.data(), sv.data() + sv.size(), index);
+                    if (sequence.length() == 0)
+                    {
+                        break;
+                    }
+                    std::vector<std::size_t> children;
+                    bool child_matched = false;
+                    for (auto state : states)
+                    {
+                        for (const auto& item : steps_[state].names)
+                        {
+                            if (item.index == index)
+                            {
+                                advance(state + 1, children, child_matched);
+                            }
+                        }
+                    }
+                    append_index(index);
+                    deliver(Json(sequence.begin(), sequence.length()), children, child_matched, f);
+                    path_.resize(length);
+                }
+                deliver_length(unicons::u32_length(sv.begin(), sv.end()), states, f);
+            }
+        }
+
+        // Applies the states that name length to the length of an array or string, the length of
+        // an empty one is not selected, as in json_query
+        template <class Callback>
+        void deliver_length(std::size_t count, const std::vector<std::size_t>& states, Callback& f)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            std::vector<std::size_t> children;
+            bool child_matched = false;
+            for (auto state : states)
+            {
+                if (selects_length(steps_[state]))
+                {
+                    advance(state + 1, children, child_matched);
+                }
+            }
+            if (child_matched || !children.empty())
+            {
+                std::size_t length = path_.size();
+                append_name(detail::length_literal<char_type>());
+                deliver(Json(count), children, child_matched, f);
+                path_.resize(length);
+            }
+        }
+    };
+
+} // namespace jsonpath
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,485 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSONPOINTER_JSON_PTR_EXTRACTOR_HPP
+#define JSONCONS_JSONPOINTER_JSON_PTR_EXTRACTOR_HPP
+
+#include <string>
+#include <vector>
+#include <limits> // std::numeric_limits
+#include <system_error>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/staj_reader.hpp>
+#include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
+
+namespace jsoncons { namespace jsonpointer {
+
+    // json_ptr_extractor
+
+    // Reads the values at a set of JSON Pointers from a cursor. The pointers are merged into a
+    // tree of tokens, and the document is walked along it. Values that no pointer leads into
+    // are passed over with skip, and reading stops as soon as no pointer can match anything
+    // further on. A token consisting of '*' alone matches every member or element.
+
+    template <class Json>
+    class json_ptr_extractor
+    {
+    public:
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = typename Json::string_view_type;
+        using reader_type = basic_staj_reader<char_type>;
+    private:
+        static constexpr std::size_t npos = (std::numeric_limits<std::size_t>::max)();
+
+        struct child_type
+        {
+            string_type name;
+            std::size_t index; // The array index the name denotes, or npos
+            std::size_t node;
+        };
+
+        struct node_type
+        {
+            std::vector<child_type> children;
+            std::size_t wildcard;
+            std::vector<std::size_t> pointers; // The pointers that end here
+            std::vector<std::size_t> closes; // The pointers that are done when this node is
+            bool concrete; // Not below a wildcard
+            bool closed;
+
+            node_type(bool concrete)
+                : wildcard(npos), concrete(concrete), closed(false)
+            {
+            }
+        };
+
+        struct frame_type
+        {
+            std::vector<std::size_t> nodes;
+            bool object;
+            std::size_t index;
+            std::size_t path_length;
+        };
+
+        std::size_t size_;
+        std::vector<node_type> nodes_;
+        std::size_t remaining_;
+        std::vector<frame_type> stack_;
+        string_type path_;
+        json_decoder<Json> decoder_;
+    public:
+        explicit json_ptr_extractor(const std::vector<string_type>& pointers)
+            : size_(0), remaining_(0)
+        {
+            std::error_code ec;
+            compile(pointers, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(jsonpointer_error(ec));
+            }
+        }
+
+        json_ptr_extractor(const std::vector<string_type>& pointers, std::error_code& ec)
+            : size_(0), remaining_(0)
+        {
+            compile(pointers, ec);
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        // Reads the document that begins at the current event of the reader, and for each value
+        // at one of the pointers calls f(i, location, value), where i is the position of the
+        // pointer and location the JSON Pointer of the value.
+        template <class Callback>
+        typename std::enable_if<!std::is_base_of<basic_json_visitor<char_type>,Callback>::value>::type
+        extract(reader_type& reader, Callback f)
+        {
+            std::error_code ec;
+            extract(reader, f, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec, reader.context().line(), reader.context().column()));
+            }
+        }
+
+        template <class Callback>
+        typename std::enable_if<!std::is_base_of<basic_json_visitor<char_type>,Callback>::value>::type
+        extract(reader_type& reader, Callback f, std::error_code& ec)
+        {
+            walk(reader, [&](const std::vector<std::size_t>& nodes, std::error_code& ec)
+            {
+                decoder_.reset();
+                reader.read(decoder_, ec);
+                if (ec)
+                {
+                    return;
+                }
+                Json value = decoder_.get_result();
+                deliver(value, nodes, f);
+            }, ec);
+        }
+
+        // Reads the document that begins at the current event of the reader, and sends each value
+        // at one of the pointers to the visitor. A value inside one that has been sent is not sent
+        // again on its own.
+        void extract(reader_type& reader, basic_json_visitor<char_type>& visitor)
+        {
+            std::error_code ec;
+            extract(reader, visitor, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec, reader.context().line(), reader.context().column()));
+            }
+        }
+
+        void extract(reader_type& reader, basic_json_visitor<char_type>& visitor, std::error_code& ec)
+        {
+            walk(reader, [&](const std::vector<std::size_t>&, std::error_code& ec)
+            {
+                // The events are forwarded one at a time, the visitor does not say where the value ends
+                std::size_t level = 0;
+                while (true)
+                {
+                    staj_to_saj_event(reader.current(), visitor, reader.context(), ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    switch (reader.current().event_type())
+                    {
+                        case staj_event_type::begin_object:
+                        case staj_event_type::begin_array:
+                            ++level;
+                            break;
+                        case staj_event_type::end_object:
+                        case staj_event_type::end_array:
+                            --level;
+                            break;
+                        default:
+                            break;
+                    }
+                    if (level == 0)
+                    {
+                        return;
+                    }
+                    reader.next(ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                }
+            }, ec);
+        }
+    private:
+        void compile(const std::vector<string_type>& pointers, std::error_code& ec)
+        {
+            size_ = pointers.size();
+            nodes_.emplace_back(true);
+            for (std::size_t i = 0; i < pointers.size(); ++i)
+            {
+                const string_type& s = pointers[i];
+                std::size_t current = 0;
+                std::size_t closing = 0;
+                auto p = s.begin();
+                while (p != s.end())
+                {
+                    if (*p != '/')
+                    {
+                        ec = jsonpointer_errc::expected_slash;
+                        return;
+                    }
+                    ++p;
+                    string_type token;
+                    while (p != s.end() && *p != '/')
+                    {
+                        if (*p == '~')
+                        {
+                            ++p;
+                            if (p == s.end() || (*p != '0' && *p != '1'))
+                            {
+                                ec = jsonpointer_errc::expected_0_or_1;
+                                return;
+                            }
+                            token.push_back(*p == '0' ? '~' : '/');
+                        }
+                        else
+                        {
+                            token.push_back(*p);
+                        }
+                        ++p;
+                    }
+                    current = add_child(current, token);
+                    if (nodes_[current].concrete)
+                    {
+                        closing = current;
+                    }
+                }
+                nodes_[current].pointers.push_back(i);
+                nodes_[closing].closes.push_back(i);
+            }
+            remaining_ = pointers.size();
+        }
+
+        std::size_t add_child(std::size_t parent, const string_type& token)
+        {
+            bool concrete = nodes_[parent].concrete;
+            if (token.size() == 1 && token[0] == '*')
+            {
+                if (nodes_[parent].wildcard == npos)
+                {
+                    nodes_[parent].wildcard = nodes_.size();
+                    nodes_.emplace_back(false);
+                }
+                return nodes_[parent].wildcard;
+            }
+            for (const auto& child : nodes_[parent].children)
+            {
+                if (child.name == token)
+                {
+                    return child.node;
+                }
+            }
+            std::size_t node = nodes_.size();
+            nodes_[parent].children.push_back(child_type{token, to_index(token), node});
+            nodes_.emplace_back(concrete);
+            return node;
+        }
+
+        // The array index a token denotes, or npos if it is not one
+        static std::size_t to_index(const string_type& token)
+        {
+            if (token.empty() || (token.size() > 1 && token[0] == '0'))
+            {
+                return npos;
+            }
+            std::size_t index = 0;
+            for (auto c : token)
+            {
+                if (c < '0' || c > '9' || index > (npos - 9) / 10)
+                {
+                    return npos;
+                }
+                index = index*10 + static_cast<std::size_t>(c - '0');
+            }
+            return index;
+        }
+
+        // Marks the node and the concrete nodes below it as done, a value at any of them has
+        // been read or can no longer be
+        void close(std::size_t node)
+        {
+            node_type& n = nodes_[node];
+            if (!n.concrete || n.closed)
+            {
+                return;
+            }
+            n.closed = true;
+            remaining_ -= n.closes.size();
+            for (const auto& child : n.children)
+            {
+                close(child.node);
+            }
+        }
+
+        void close(const std::vector<std::size_t>& nodes)
+        {
+            for (auto node : nodes)
+            {
+                close(node);
+            }
+        }
+
+        void member_nodes(const std::vector<std::size_t>& nodes, const string_view_type& name,
+                          std::vector<std::size_t>& result) const
+        {
+            for (auto node : nodes)
+            {
+                const node_type& n = nodes_[node];
+                for (const auto& child : n.children)
+                {
+                    if (string_view_type(child.name) == name)
+                    {
+                        result.push_back(child.node);
+                    }
+                }
+                if (n.wildcard != npos)
+                {
+                    result.push_back(n.wildcard);
+                }
+            }
+        }
+
+        void element_nodes(const std::vector<std::size_t>& nodes, std::size_t index,
+                           std::vector<std::size_t>& result) const
+        {
+            for (auto node : nodes)
+            {
+                const node_type& n = nodes_[node];
+                for (const auto& child : n.children)
+                {
+                    if (child.index == index)
+                    {
+                        result.push_back(child.node);
+                    }
+                }
+                if (n.wildcard != npos)
+                {
+                    result.push_back(n.wildcard);
+                }
+            }
+        }
+
+        bool has_pointers(const std::vector<std::size_t>& nodes) const
+        {
+            for (auto node : nodes)
+            {
+                if (!nodes_[node].pointers.empty())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void append_index(std::size_t index)
+        {
+            path_.push_back('/');
+            jsoncons::detail::write_integer(index, path_);
+        }
+
+        // Walks the document, calling match for each value at one or more of the pointers,
+        // which must read past it
+        template <class Match>
+        void walk(reader_type& reader, Match match, std::error_code& ec)
+        {
+            for (auto& n : nodes_)
+            {
+                n.closed = false;
+            }
+            remaining_ = size_;
+            stack_.clear();
+            path_.clear();
+
+            value(reader, std::vector<std::size_t>{0}, match, ec);
+            while (!ec && !stack_.empty() && remaining_ > 0)
+            {
+                reader.next(ec);
+                if (ec)
+                {
+                    return;
+                }
+                frame_type& top = stack_.back();
+                staj_event_type event_type = reader.current().event_type();
+                if (event_type == staj_event_type::end_object || event_type == staj_event_type::end_array)
+                {
+                    close(top.nodes);
+                    stack_.pop_back();
+                    continue;
+                }
+                std::vector<std::size_t> nodes;
+                path_.resize(top.path_length);
+                if (top.object)
+                {
+                    auto name = reader.current().template get<string_view_type>();
+                    member_nodes(top.nodes, name, nodes);
+                    path_.push_back('/');
+                    escape(name, path_);
+                    reader.next(ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                }
+                else
+                {
+                    element_nodes(top.nodes, top.index, nodes);
+                    append_index(top.index);
+                    ++top.index;
+                }
+                value(reader, std::move(nodes), match, ec);
+            }
+        }
+
+        template <class Match>
+        void value(reader_type& reader, std::vector<std::size_t>&& nodes, Match match, std::error_code& ec)
+        {
+            if (nodes.empty())
+            {
+                reader.skip(ec);
+                return;
+            }
+            if (has_pointers(nodes))
+            {
+                match(nodes, ec);
+                close(nodes);
+                return;
+            }
+            staj_event_type event_type = reader.current().event_type();
+            if (event_type == staj_event_type::begin_object || event_type == staj_event_type::begin_array)
+            {
+                stack_.push_back(frame_type{std::move(nodes), event_type == staj_event_type::begin_object, 0, path_.size()});
+            }
+            else
+            {
+                close(nodes);
+            }
+        }
+
+        // Calls f for the pointers that end at the nodes, and for those that continue below them
+        template <class Callback>
+        void deliver(const Json& value, const std::vector<std::size_t>& nodes, Callback& f)
+        {
+            for (auto node : nodes)
+            {
+                for (auto i : nodes_[node].pointers)
+                {
+                    f(i, string_view_type(path_), value);
+                }
+            }
+            std::size_t length = path_.size();
+            if (value.is_object())
+            {
+                for (const auto& member : value.object_range())
+                {
+                    std::vector<std::size_t> children;
+                    member_nodes(nodes, member.key(), children);
+                    if (!children.empty())
+                    {
+                        path_.push_back('/');
+                        escape(member.key(), path_);
+                        deliver(member.value(), children, f);
+                        path_.resize(length);
+                    }
+                }
+            }
+            else if (value.is_array())
+            {
+                std::size_t index = 0;
+                for (const auto& item : value.array_range())
+                {
+                    std::vector<std::size_t> children;
+                    element_nodes(nodes, index, children);
+                    if (!children.empty())
+                    {
+                        append_index(index);
+                        deliver(item, children, f);
+                        path_.resize(length);
+                    }
+                    ++index;
+                }
+            }
+        }
+    };
+
+} // namespace jsonpointer
+} // namespace jsoncons
+
+#endif
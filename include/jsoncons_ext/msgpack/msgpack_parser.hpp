@@ -178,7 +178,138 @@ public:
             }
         }
     }
+
+    // Skips the items of the array or map that was just begun without reporting them, so that 
+    // the next call to parse reports its end. Strings and binary values are skipped by their 
+    // length, and nested arrays and maps add their counts to the number of items left.
+    void skip_nested(std::error_code& ec)
+    {
+        parse_state& state = state_stack_.back();
+        JSONCONS_ASSERT(state.mode == parse_mode::array || state.mode == parse_mode::map_key);
+        uint64_t count = state.length - state.index;
+        if (state.mode == parse_mode::map_key)
+        {
+            count *= 2;
+        }
+        state.index = state.length;
+
+        while (count > 0)
+        {
+            --count;
+            uint8_t type{};
+            if (source_.get(type) == 0)
+            {
+                ec = msgpack_errc::unexpected_eof;
+                return;
+            }
+            std::size_t length = 0;
+            if (type <= 0x7f || type >= 0xe0) // fixint
+            {
+                continue;
+            }
+            else if (type <= 0x8f) // fixmap
+            {
+                count += 2*(type & 0x0f);
+                continue;
+            }
+            else if (type <= 0x9f) // fixarray
+            {
+                count += type & 0x0f;
+                continue;
+            }
+            else if (type <= 0xbf) // fixstr
+            {
+                length = type & 0x1f;
+            }
+            else
+            {
+                switch (type)
+                {
+                    case jsoncons::msgpack::detail::msgpack_format::nil_cd: 
+                    case jsoncons::msgpack::detail::msgpack_format::true_cd:
+                    case jsoncons::msgpack::detail::msgpack_format::false_cd:
+                        continue;
+                    case jsoncons::msgpack::detail::msgpack_format::uint8_cd: 
+                    case jsoncons::msgpack::detail::msgpack_format::int8_cd: 
+                        length = 1;
+                        break;
+                    case jsoncons::msgpack::detail::msgpack_format::uint16_cd: 
+                    case jsoncons::msgpack::detail::msgpack_format::int16_cd: 
+                        length = 2;
+                        break;
+                    case jsoncons::msgpack::detail::msgpack_format::uint32_cd: 
+                    case jsoncons::msgpack::detail::msgpack_format::int32_cd: 
+                    case jsoncons::msgpack::detail::msgpack_format::float32_cd: 
+                        length = 4;
+                        break;
+                    case jsoncons::msgpack::detail::msgpack_format::uint64_cd: 
+                    case jsoncons::msgpack::detail::msgpack_format::int64_cd: 
+                    case jsoncons::msgpack::detail::msgpack_format::float64_cd: 
+                        length = 8;
+                        break;
+                    case jsoncons::msgpack::detail::msgpack_format::str8_cd: 
+                    case jsoncons::msgpack::detail::msgpack_format::bin8_cd: 
+                        length = read_length<int8_t>(ec);
+                        break;
+                    case jsoncons::msgpack::detail::msgpack_format::str16_cd: 
+                    case jsoncons::msgpack::detail::msgpack_format::bin16_cd: 
+                        length = read_length<int16_t>(ec);
+                        break;
+                    case jsoncons::msgpack::detail::msgpack_format::str32_cd: 
+                    case jsoncons::msgpack::detail::msgpack_format::bin32_cd: 
+                        length = read_length<int32_t>(ec);
+                        break;
+                    case jsoncons::msgpack::detail::msgpack_format::array16_cd: 
+                        count += read_length<int16_t>(ec);
+                        break;
+                    case jsoncons::msgpack::detail::msgpack_format::array32_cd: 
+                        count += read_length<int32_t>(ec);
+                        break;
+                    case jsoncons::msgpack::detail::msgpack_format::map16_cd: 
+                        count += 2*uint64_t(read_length<int16_t>(ec));
+                        break;
+                    case jsoncons::msgpack::detail::msgpack_format::map32_cd: 
+                        count += 2*uint64_t(read_length<int32_t>(ec));
+                        break;
+                    default:
+                        ec = msgpack_errc::unknown_type;
+                        break;
+                }
+                if (ec)
+                {
+                    return;
+                }
+            }
+            std::size_t position = source_.position();
+            source_.ignore(length);
+            if (source_.position() - position != length)
+            {
+                ec = msgpack_errc::unexpected_eof;
+                return;
+            }
+        }
+    }
 private:
+    // Reads a length that follows a type code, signed as parse_item reads it
+    template <class T>
+    std::size_t read_length(std::error_code& ec)
+    {
+        uint8_t buf[sizeof(T)];
+        if (source_.read(buf, sizeof(T)) != sizeof(T))
+        {
+            ec = msgpack_errc::unexpected_eof;
+            return 0;
+        }
+        const uint8_t* endp;
+        T len = jsoncons::detail::big_to_native<T>(buf,buf+sizeof(buf),&endp);
+        if (len < 0)
+        {
+            ec = msgpack_errc::length_is_negative;
+            return 0;
+        }
+        return static_cast<std::size_t>(len);
+    }
+
 
     void parse_item(json_visitor& visitor, std::error_code& ec)
     {
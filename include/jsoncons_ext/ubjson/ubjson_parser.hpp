@@ -297,7 +297,232 @@ public:
             }
         }
     }
+
+    // Skips the items of the array or object that was just begun without reporting them, so 
+    // that the next call to parse reports its end. Strings are skipped by their length, and 
+    // strongly typed arrays of fixed size values in a single step.
+    void skip_nested(std::error_code& ec)
+    {
+        std::vector<skip_frame> frames;
+        parse_state& state = state_stack_.back();
+        switch (state.mode)
+        {
+            case parse_mode::array:
+            case parse_mode::strongly_typed_array:
+            case parse_mode::map_key:
+            case parse_mode::strongly_typed_map_key:
+            {
+                bool object = state.mode == parse_mode::map_key || state.mode == parse_mode::strongly_typed_map_key;
+                frames.emplace_back(object, false, state.length - state.index, state.type);
+                state.index = state.length;
+                break;
+            }
+            case parse_mode::indefinite_array:
+                frames.emplace_back(false, true, 0, 0);
+                break;
+            case parse_mode::indefinite_map_key:
+                frames.emplace_back(true, true, 0, 0);
+                break;
+            default:
+                JSONCONS_UNREACHABLE();
+                break;
+        }
+
+        while (!frames.empty())
+        {
+            skip_frame& frame = frames.back();
+            if (frame.indefinite)
+            {
+                int c = source_.peek();
+                if (c == Src::traits_type::eof())
+                {
+                    ec = ubjson_errc::unexpected_eof;
+                    return;
+                }
+                if (c == (frame.object ? jsoncons::ubjson::detail::ubjson_format::end_object_marker 
+                                       : jsoncons::ubjson::detail::ubjson_format::end_array_marker))
+                {
+                    if (frames.size() == 1)
+                    {
+                        return; // parse reads the marker and reports the end
+                    }
+                    source_.ignore(1);
+                    frames.pop_back();
+                    continue;
+                }
+            }
+            else if (frame.count == 0)
+            {
+                frames.pop_back();
+                continue;
+            }
+            else if (!frame.object && fixed_size(frame.type) >= 0)
+            {
+                std::size_t length = frame.count * fixed_size(frame.type);
+                frame.count = 0;
+                skip_bytes(length, ec);
+                if (ec)
+                {
+                    return;
+                }
+                continue;
+            }
+            else
+            {
+                --frame.count;
+            }
+
+            if (frame.object)
+            {
+                std::size_t length = get_length(ec);
+                if (ec)
+                {
+                    ec = ubjson_errc::key_expected;
+                    return;
+                }
+                skip_bytes(length, ec);
+                if (ec)
+                {
+                    return;
+                }
+            }
+            uint8_t type = frame.type;
+            if (type == 0 && source_.get(type) == 0)
+            {
+                ec = ubjson_errc::unexpected_eof;
+                return;
+            }
+            skip_value(type, frames, ec);
+            if (ec)
+            {
+                return;
+            }
+        }
+    }
 private:
+    struct skip_frame
+    {
+        bool object;
+        bool indefinite;
+        std::size_t count;
+        uint8_t type;
+
+        skip_frame(bool object, bool indefinite, std::size_t count, uint8_t type)
+            : object(object), indefinite(indefinite), count(count), type(type)
+        {
+        }
+    };
+
+    // The size of a value of this type following the type marker, or -1 if it varies
+    static int fixed_size(uint8_t type)
+    {
+        switch (type)
+        {
+            case jsoncons::ubjson::detail::ubjson_format::null_type: 
+            case jsoncons::ubjson::detail::ubjson_format::no_op_type: 
+            case jsoncons::ubjson::detail::ubjson_format::true_type:
+            case jsoncons::ubjson::detail::ubjson_format::false_type:
+                return 0;
+            case jsoncons::ubjson::detail::ubjson_format::int8_type: 
+            case jsoncons::ubjson::detail::ubjson_format::uint8_type: 
+            case jsoncons::ubjson::detail::ubjson_format::char_type: 
+                return 1;
+            case jsoncons::ubjson::detail::ubjson_format::int16_type: 
+                return 2;
+            case jsoncons::ubjson::detail::ubjson_format::int32_type: 
+            case jsoncons::ubjson::detail::ubjson_format::float32_type: 
+                return 4;
+            case jsoncons::ubjson::detail::ubjson_format::int64_type: 
+            case jsoncons::ubjson::detail::ubjson_format::float64_type: 
+                return 8;
+            default:
+                return -1;
+        }
+    }
+
+    // Skips a value of this type, pushing a frame if it begins an array or object
+    void skip_value(uint8_t type, std::vector<skip_frame>& frames, std::error_code& ec)
+    {
+        int size = fixed_size(type);
+        if (size >= 0)
+        {
+            skip_bytes(size, ec);
+            return;
+        }
+        switch (type)
+        {
+            case jsoncons::ubjson::detail::ubjson_format::string_type: 
+            case jsoncons::ubjson::detail::ubjson_format::high_precision_number_type: 
+            {
+                std::size_t length = get_length(ec);
+                if (ec)
+                {
+                    return;
+                }
+                skip_bytes(length, ec);
+                break;
+            }
+            case jsoncons::ubjson::detail::ubjson_format::start_array_marker: 
+            case jsoncons::ubjson::detail::ubjson_format::start_object_marker: 
+            {
+                if (JSONCONS_UNLIKELY(nesting_depth_ + static_cast<int>(frames.size()) > options_.max_nesting_depth()))
+                {
+                    ec = ubjson_errc::max_nesting_depth_exceeded;
+                    return;
+                }
+                bool object = type == jsoncons::ubjson::detail::ubjson_format::start_object_marker;
+                uint8_t item_type = 0;
+                if (source_.peek() == jsoncons::ubjson::detail::ubjson_format::type_marker)
+                {
+                    source_.ignore(1);
+                    if (source_.get(item_type) == 0)
+                    {
+                        ec = ubjson_errc::unexpected_eof;
+                        return;
+                    }
+                    if (source_.peek() != jsoncons::ubjson::detail::ubjson_format::count_marker)
+                    {
+                        ec = ubjson_errc::count_required_after_type;
+                        return;
+                    }
+                }
+                if (source_.peek() == jsoncons::ubjson::detail::ubjson_format::count_marker)
+                {
+                    source_.ignore(1);
+                    std::size_t length = get_length(ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    if (length > options_.max_items())
+                    {
+                        ec = ubjson_errc::max_items_exceeded;
+                        return;
+                    }
+                    frames.emplace_back(object, false, length, item_type);
+                }
+                else
+                {
+                    frames.emplace_back(object, true, 0, 0);
+                }
+                break;
+            }
+            default:
+                ec = ubjson_errc::unknown_type;
+                break;
+        }
+    }
+
+    void skip_bytes(std::size_t length, std::error_code& ec)
+    {
+        std::size_t position = source_.position();
+        source_.ignore(length);
+        if (source_.position() - position != length)
+        {
+            ec = ubjson_errc::unexpected_eof;
+        }
+    }
+
     void read_type_and_value(json_visitor& visitor, std::error_code& ec)
     {
         if (source_.is_error())
@@ -0,0 +1,210 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    template <class Json>
+    std::string to_text(const Json& j)
+    {
+        std::string s;
+        j.dump(s);
+        return s;
+    }
+}
+
+TEST_CASE("arena allocate")
+{
+    SECTION("alignment")
+    {
+        arena a(64);
+        void* p1 = a.allocate(1, 1);
+        void* p2 = a.allocate(8, 8);
+        void* p3 = a.allocate(3, 1);
+        void* p4 = a.allocate(16, 16);
+
+        CHECK(p1 != nullptr);
+        CHECK(reinterpret_cast<std::uintptr_t>(p2) % 8 == 0);
+        CHECK(p3 != p2);
+        CHECK(reinterpret_cast<std::uintptr_t>(p4) % 16 == 0);
+        CHECK(a.bytes_allocated() == 28);
+    }
+
+    SECTION("larger than a block")
+    {
+        arena a(16);
+        char* p = static_cast<char*>(a.allocate(1000, 1));
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            p[i] = 'a';
+        }
+        char* q = static_cast<char*>(a.allocate(10, 1));
+        CHECK((q + 10 <= p || q >= p + 1000));
+        CHECK(a.bytes_allocated() == 1010);
+    }
+
+    SECTION("from buffer")
+    {
+        alignas(16) char buffer[256];
+        arena a(buffer, sizeof(buffer));
+        char* p = static_cast<char*>(a.allocate(100, 1));
+        CHECK(p == buffer);
+        char* q = static_cast<char*>(a.allocate(200, 1));
+        CHECK((q < buffer || q >= buffer + sizeof(buffer)));
+
+        a.release();
+        CHECK(a.bytes_allocated() == 0);
+        CHECK(a.allocate(1, 1) == buffer);
+    }
+
+    SECTION("too large")
+    {
+        arena a;
+        CHECK_THROWS_AS(a.allocate((std::numeric_limits<std::size_t>::max)() - 4, 8), std::bad_alloc);
+        CHECK(a.bytes_allocated() == 0);
+    }
+}
+
+TEST_CASE("arena_allocator")
+{
+    arena a1;
+    arena a2;
+
+    arena_allocator<char> alloc1(a1);
+    arena_allocator<int> alloc2(alloc1);
+    arena_allocator<char> alloc3(a2);
+
+    CHECK(alloc1 == alloc2);
+    CHECK(alloc1 != alloc3);
+    CHECK(alloc2.resource() == &a1);
+    CHECK(arena_allocator<char>().resource() == nullptr);
+    CHECK(arena_allocator<char>() != alloc1);
+
+    int* p = alloc2.allocate(4);
+    CHECK(reinterpret_cast<std::uintptr_t>(p) % alignof(int) == 0);
+    alloc2.deallocate(p, 4);
+    CHECK(a1.bytes_allocated() == 4*sizeof(int));
+    CHECK(a2.bytes_allocated() == 0);
+
+    CHECK_THROWS_AS(alloc2.allocate((std::numeric_limits<std::size_t>::max)()/2), std::bad_alloc);
+    CHECK_THROWS_AS(arena_allocator<int>().allocate((std::numeric_limits<std::size_t>::max)()/2), std::bad_alloc);
+}
+
+TEST_CASE("arena_json parse")
+{
+    std::string s = R"(
+{
+    "books" : [
+        {"title" : "Pulp", "author" : "Charles Bukowski", "price" : 22.48},
+        {"title" : "A long title, long enough not to be stored inline", "price" : 10},
+        {"title" : "Sword of Honour", "tags" : ["war", "novel"], "isbn" : null}
+    ],
+    "count" : 3
+}
+    )";
+
+    SECTION("from string")
+    {
+        arena a;
+        arena_json j = arena_json::parse(result_allocator_arg, a, s);
+
+        CHECK(a.bytes_allocated() > 0);
+        REQUIRE(j.is_object());
+        CHECK(j["count"].as<int>() == 3);
+        CHECK(j["books"].size() == 3);
+        CHECK(j["books"][0]["author"].as<std::string>() == "Charles Bukowski");
+        CHECK(j["books"][1]["title"].as<std::string>() == "A long title, long enough not to be stored inline");
+        CHECK(j["books"][2]["tags"][1].as<std::string>() == "novel");
+        CHECK(j.get_allocator() == arena_allocator<char>(a));
+
+        json expected = json::parse(s);
+        CHECK(json::parse(to_text(j)) == expected);
+    }
+
+    SECTION("from stream")
+    {
+        arena a;
+        std::istringstream is(s);
+        arena_ojson j = arena_ojson::parse(result_allocator_arg, a, is);
+
+        REQUIRE(j.is_object());
+        CHECK(j.object_range().begin()->key() == "books");
+        CHECK(j["books"][0]["price"].as<double>() == 22.48);
+        CHECK(ojson::parse(to_text(j)) == ojson::parse(s));
+    }
+
+    SECTION("with a decoder")
+    {
+        arena a;
+        json_decoder<arena_json> decoder(result_allocator_arg, a);
+        json_reader reader(s, decoder);
+        reader.read();
+        arena_json j = decoder.get_result();
+
+        CHECK(j["books"].size() == 3);
+        CHECK(j["books"][0].get_allocator() == arena_allocator<char>(a));
+    }
+
+    SECTION("invalid input")
+    {
+        arena a;
+        REQUIRE_THROWS_AS(arena_json::parse(result_allocator_arg, a, "[1,2"), ser_error);
+    }
+}
+
+TEST_CASE("arena_json modify")
+{
+    arena a;
+    arena_json j = arena_json::parse(result_allocator_arg, a, R"({"a":[1,2,3],"b":{"c":"d"}})");
+
+    j["a"].push_back(4);
+    j["a"].erase(j["a"].array_range().begin());
+    j.insert_or_assign("e", "a string long enough to be allocated from the arena");
+    j["b"].erase("c");
+
+    arena_json k = j;
+    k["a"][0] = 10;
+
+    CHECK(to_text(j) == R"({"a":[2,3,4],"b":{},"e":"a string long enough to be allocated from the arena"})");
+    CHECK(k["a"][0].as<int>() == 10);
+    CHECK(k.get_allocator() == j.get_allocator());
+}
+
+TEST_CASE("arena_json without an arena")
+{
+    arena_json j(json_array_arg);
+    j.push_back("a string long enough to be allocated on the heap");
+    j.emplace_back(json_object_arg);
+    j[1].insert_or_assign("a", 1);
+
+    arena_json k(j);
+    CHECK(k.get_allocator().resource() == nullptr);
+    CHECK(to_text(k) == R"(["a string long enough to be allocated on the heap",{"a":1}])");
+}
+
+TEST_CASE("arena_json with values from another allocator")
+{
+    // Values without an arena own heap memory, and must be destroyed with the arena's 
+    // arrays and objects that they have been moved into (checked when built with sanitizers)
+    arena a;
+    {
+        arena_json j = arena_json::parse(result_allocator_arg, a, R"({"a":[1,2],"b":{}})");
+
+        j["a"].push_back(arena_json("a string long enough to be allocated on the heap"));
+        arena_json c(json_array_arg);
+        c.push_back("another string long enough to be allocated on the heap");
+        j["b"].try_emplace("c", std::move(c));
+        j["d"] = arena_json(json_object_arg, {{"e", arena_json("a third string long enough for the heap")}});
+
+        CHECK(to_text(j) == R"({"a":[1,2,"a string long enough to be allocated on the heap"],"b":{"c":["another string long enough to be allocated on the heap"]},"d":{"e":"a third string long enough for the heap"}})");
+    }
+}
@@ -249,6 +249,19 @@ TEST_CASE("test shift left")
         x.dump(s);
         CHECK(s == "1267650600228229401496703205377");
     }
+    SECTION("shift by more than 32 bits carries across words")
+    {
+        bignum n("18446744073709551615"); // 2^64 - 1
+        n <<= 40;
+        std::string s;
+        n.dump(s);
+        CHECK(s == "20282409603651670422847739658240");
+
+        n >>= 70;
+        s.clear();
+        n.dump(s);
+        CHECK(s == "17179869183");
+    }
 }
 
 TEST_CASE("times 10")
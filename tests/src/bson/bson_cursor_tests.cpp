@@ -9,6 +9,7 @@
 #include <jsoncons_ext/bson/bson_cursor.hpp>
 #include <jsoncons_ext/bson/bson.hpp>
 #include <catch/catch.hpp>
+#include "../cursor_skip_helpers.hpp"
 #include <sstream>
 #include <vector>
 #include <utility>
@@ -77,3 +78,73 @@ TEST_CASE("bson_cursor reputon test")
     }
 }
 
+TEST_CASE("bson_cursor skip")
+{
+    ojson j = ojson::parse(R"(
+{
+    "a" : 0.5,
+    "b" : {"s" : "x]}", "n" : [1.5,2.5,-3.5,true,false,null,{"k":[[],{}]}], "e" : {}},
+    "c" : [["a","b"],{"c":[1.5,[2.5,[3.5]]]}],
+    "d" : [],
+    "z" : "end"
+}
+)");
+    j["b"].insert_or_assign("bytes", ojson(byte_string_arg, std::vector<uint8_t>{1,2,3}));
+    std::vector<std::string> expected = {"a","0.5","b","{}","c","[]","d","[]","z","end","end"};
+
+    SECTION("bytes source")
+    {
+        std::vector<uint8_t> data;
+        bson::encode_bson(j, data);
+
+        bson::bson_bytes_cursor cursor(data);
+        CHECK(skip_containers(cursor) == expected);
+    }
+
+    SECTION("stream source")
+    {
+        std::vector<uint8_t> data;
+        bson::encode_bson(j, data);
+        std::string s(data.begin(), data.end());
+        std::istringstream is(s);
+
+        bson::bson_stream_cursor cursor(is);
+        CHECK(skip_containers(cursor) == expected);
+    }
+
+    SECTION("unexpected end of input")
+    {
+        std::vector<uint8_t> data;
+        bson::encode_bson(j, data);
+        data.resize(data.size()/2);
+
+        bson::bson_bytes_cursor cursor(data);
+        cursor.next(); // "a"
+        cursor.next(); // 0.5
+        cursor.next(); // "b"
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == bson::bson_errc::unexpected_eof);
+    }
+
+    SECTION("invalid document size")
+    {
+        std::vector<uint8_t> data;
+        bson::encode_bson(j, data);
+        // "b" follows the double "a", its size is at offset 18
+        REQUIRE(data[15] == 0x03);
+        data[18] = 4; data[19] = 0; data[20] = 0; data[21] = 0;
+
+        bson::bson_bytes_cursor cursor(data);
+        cursor.next(); // "a"
+        cursor.next(); // 0.5
+        cursor.next(); // "b"
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == bson::bson_errc::invalid_document_size);
+    }
+}
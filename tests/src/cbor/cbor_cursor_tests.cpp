@@ -9,6 +9,7 @@
 #include <jsoncons_ext/cbor/cbor_cursor.hpp>
 #include <jsoncons_ext/cbor/cbor.hpp>
 #include <catch/catch.hpp>
+#include "../cursor_skip_helpers.hpp"
 #include <sstream>
 #include <vector>
 #include <utility>
@@ -259,3 +260,106 @@ TEST_CASE("cbor_cursor with filter tests")
     CHECK(cursor.done());
 }
 
+TEST_CASE("cbor_cursor skip")
+{
+    ojson j = ojson::parse(R"(
+{
+    "a" : 1,
+    "b" : {"s" : "end", "n" : [1,2.5,-3,true,false,null,{"k":[[],{}]}], "e" : {}, "t" : "end"},
+    "c" : [["a","b"],{"c":[1,[2,[3]]]}],
+    "d" : [],
+    "z" : "end"
+}
+)");
+    j["b"].insert_or_assign("bytes", ojson(byte_string_arg, std::vector<uint8_t>{1,2,3}));
+    j["b"].insert_or_assign("time", ojson(1431027667, semantic_tag::timestamp));
+    j["b"].insert_or_assign("big", ojson::parse("18446744073709551616"));
+    std::vector<std::string> expected = {"a","1","b","{}","c","[]","d","[]","z","end","end"};
+
+    SECTION("definite lengths")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data);
+
+        cbor::cbor_bytes_cursor cursor(data);
+        CHECK(skip_containers(cursor) == expected);
+    }
+
+    SECTION("stream source")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data);
+        std::string s(data.begin(), data.end());
+        std::istringstream is(s);
+
+        cbor::cbor_stream_cursor cursor(is);
+        CHECK(skip_containers(cursor) == expected);
+    }
+
+    SECTION("indefinite lengths")
+    {
+        const std::vector<uint8_t> data = {
+            0xbf, // map(*)
+                0x61,'a',0x01,
+                0x61,'b',0x9f, // array(*)
+                    0x7f,0x62,'x','y',0x61,'z',0xff, // text(*)
+                    0x5f,0x41,0x01,0xff, // bytes(*)
+                    0xc1,0x1a,0x55,0x4b,0xbf,0xd3, // tag(1) uint32
+                    0xbf,0x61,'k',0x80,0xff,
+                    0xf9,0x3c,0x00, // half
+                    0xff,
+                0x61,'c',0xa1,0x61,'k',0x9f,0x01,0x82,0x02,0x03,0xff,
+                0x61,'z',0x63,'e','n','d',
+            0xff
+        };
+        std::vector<std::string> expected2 = {"a","1","b","[]","c","{}","z","end","end"};
+
+        cbor::cbor_bytes_cursor cursor(data);
+        CHECK(skip_containers(cursor) == expected2);
+    }
+
+    SECTION("packed strings")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data, cbor::cbor_options().pack_strings(true));
+
+        cbor::cbor_bytes_cursor cursor(data);
+        CHECK(skip_containers(cursor) == expected);
+    }
+
+    SECTION("typed array")
+    {
+        std::vector<float> v = {1.0f, 2.0f, 3.0f};
+        std::vector<uint8_t> data;
+        cbor::cbor_bytes_encoder encoder(data, cbor::cbor_options().use_typed_arrays(true));
+        encoder.begin_object();
+        encoder.key("a");
+        encoder.uint64_value(1);
+        encoder.key("b");
+        encoder.typed_array(span<const float>(v));
+        encoder.key("z");
+        encoder.string_value("end");
+        encoder.end_object();
+        encoder.flush();
+
+        cbor::cbor_bytes_cursor cursor(data);
+        CHECK(skip_containers(cursor) == std::vector<std::string>{"a","1","b","[]","z","end","end"});
+    }
+
+    SECTION("unexpected end of input")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data);
+        data.resize(data.size()/2);
+
+        cbor::cbor_bytes_cursor cursor(data);
+        cursor.next(); // "a"
+        cursor.next(); // 1
+        cursor.next(); // "b"
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == cbor::cbor_errc::unexpected_eof);
+    }
+}
@@ -0,0 +1,259 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/cbor/parallel_cbor_sequence_reader.hpp>
+#include <catch/catch.hpp>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+using namespace jsoncons::cbor;
+
+namespace {
+
+    void append_item(std::vector<uint8_t>& seq, const json& j)
+    {
+        std::vector<uint8_t> v;
+        encode_cbor(j, v);
+        seq.insert(seq.end(), v.begin(), v.end());
+    }
+
+    std::string to_stream_data(const std::vector<uint8_t>& v)
+    {
+        return std::string(v.begin(), v.end());
+    }
+
+    // Serves its bytes, then fails, returning the last of the bytes with the failure
+    class failing_source
+    {
+        std::vector<uint8_t> data_;
+        std::size_t position_;
+        bool error_;
+    public:
+        using value_type = uint8_t;
+
+        failing_source(const std::vector<uint8_t>& data)
+            : data_(data), position_(0), error_(false)
+        {
+        }
+
+        bool eof() const
+        {
+            return error_;
+        }
+
+        bool is_error() const
+        {
+            return error_;
+        }
+
+        std::size_t read(uint8_t* p, std::size_t length)
+        {
+            std::size_t n = (std::min)(length, data_.size() - position_);
+            if (n > 0)
+            {
+                std::memcpy(p, data_.data() + position_, n);
+            }
+            position_ += n;
+            if (n < length)
+            {
+                error_ = true;
+            }
+            return n;
+        }
+    };
+
+} // namespace
+
+TEST_CASE("scan_cbor_item tests")
+{
+    auto scan = [](const std::vector<uint8_t>& v, std::size_t& length) 
+    {
+        const uint8_t* end = nullptr;
+        auto result = jsoncons::cbor::detail::scan_cbor_item(v.data(), v.data() + v.size(), end);
+        length = result == jsoncons::cbor::detail::cbor_scan_result::complete ? end - v.data() : 0;
+        return result;
+    };
+    using jsoncons::cbor::detail::cbor_scan_result;
+    std::size_t length;
+
+    SECTION("definite length items")
+    {
+        std::vector<uint8_t> v;
+        encode_cbor(json::parse(R"({"a":[1,2,{"b":"text"}],"c":1.5,"d":-1000000})"), v);
+        std::vector<uint8_t> w(v);
+        w.push_back(0x01);
+        CHECK(scan(w, length) == cbor_scan_result::complete);
+        CHECK(length == v.size());
+
+        for (std::size_t i = 0; i < v.size(); ++i)
+        {
+            std::vector<uint8_t> prefix(v.begin(), v.begin() + i);
+            CHECK(scan(prefix, length) == cbor_scan_result::incomplete);
+        }
+    }
+
+    SECTION("indefinite length items and tags")
+    {
+        // tag 1, [_ "a", (_ h'01', h'02'), {_ 1: 2}]
+        std::vector<uint8_t> v = {0xc1,0x9f,0x61,'a',0x5f,0x41,0x01,0x41,0x02,0xff,0xbf,0x01,0x02,0xff,0xff};
+        CHECK(scan(v, length) == cbor_scan_result::complete);
+        CHECK(length == v.size());
+        v.pop_back();
+        CHECK(scan(v, length) == cbor_scan_result::incomplete);
+    }
+
+    SECTION("malformed items")
+    {
+        CHECK(scan({0x1c}, length) == cbor_scan_result::malformed);
+        CHECK(scan({0xff}, length) == cbor_scan_result::malformed);
+        CHECK(scan({0x1f}, length) == cbor_scan_result::malformed);
+        CHECK(scan({0x82,0x01,0xff}, length) == cbor_scan_result::malformed);
+    }
+}
+
+TEST_CASE("parallel_cbor_sequence_reader tests")
+{
+    SECTION("values are delivered in input order")
+    {
+        const std::size_t count = 3000;
+        std::vector<uint8_t> seq;
+        std::vector<std::size_t> offsets;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            offsets.push_back(seq.size());
+            json j(json_object_arg);
+            j["id"] = i;
+            j["name"] = "item" + std::to_string(i);
+            j["values"] = json::parse("[1,2.5,true,null]");
+            append_item(seq, j);
+        }
+        std::istringstream is(to_stream_data(seq));
+
+        parallel_read_options parallel_options;
+        parallel_options.num_threads(4)
+                        .chunk_length(100)
+                        .max_chunks_in_flight(3);
+        parallel_cbor_sequence_reader<json> reader(is, cbor_decode_options(), parallel_options);
+
+        std::size_t n = 0;
+        json val;
+        while (reader.read_next(val))
+        {
+            CHECK(val["id"].as<std::size_t>() == n);
+            CHECK(val["name"].as<std::string>() == "item" + std::to_string(n));
+            CHECK(reader.position() == offsets[n]);
+            ++n;
+        }
+        CHECK(n == count);
+    }
+
+    SECTION("item longer than chunk length")
+    {
+        std::vector<uint8_t> seq;
+        std::string long_string(5000, 'x');
+        append_item(seq, json(1));
+        append_item(seq, json(long_string));
+        seq.insert(seq.end(), {0x9f,0x01,0x02,0xff});
+        append_item(seq, json(2));
+        std::istringstream is(to_stream_data(seq));
+
+        parallel_read_options parallel_options;
+        parallel_options.num_threads(2).chunk_length(8);
+        parallel_cbor_sequence_reader<json> reader(is, cbor_decode_options(), parallel_options);
+
+        std::vector<json> values;
+        json val;
+        while (reader.read_next(val))
+        {
+            values.push_back(std::move(val));
+        }
+        REQUIRE(values.size() == 4);
+        CHECK(values[0].as<int>() == 1);
+        CHECK(values[1].as<std::string>() == long_string);
+        CHECK(values[2] == json::parse("[1,2]"));
+        CHECK(values[3].as<int>() == 2);
+    }
+
+    SECTION("decode error, reading continues")
+    {
+        std::vector<uint8_t> seq;
+        append_item(seq, json(1));
+        seq.insert(seq.end(), {0x62,'a',0xff}); // invalid UTF-8
+        append_item(seq, json(2));
+        std::istringstream is(to_stream_data(seq));
+        parallel_cbor_sequence_reader<json> reader(is);
+
+        json val;
+        std::error_code ec;
+        REQUIRE(reader.read_next(val, ec));
+        CHECK(val.as<int>() == 1);
+        CHECK_FALSE(reader.read_next(val, ec));
+        CHECK(ec == cbor_errc::invalid_utf8_text_string);
+        ec.clear();
+        REQUIRE(reader.read_next(val, ec));
+        CHECK(val.as<int>() == 2);
+        CHECK_FALSE(reader.read_next(val, ec));
+        CHECK_FALSE(ec);
+    }
+
+    SECTION("source error after the values read before it")
+    {
+        std::vector<uint8_t> seq;
+        for (int i = 0; i < 100; ++i)
+        {
+            append_item(seq, json(i));
+        }
+        std::size_t complete = seq.size();
+        seq.insert(seq.end(), {0x83,0x01});
+        parallel_read_options parallel_options;
+        parallel_options.num_threads(3).chunk_length(16);
+        parallel_cbor_sequence_reader<json,failing_source> reader(seq, cbor_decode_options(), parallel_options);
+
+        int n = 0;
+        json val;
+        std::error_code ec;
+        while (reader.read_next(val, ec))
+        {
+            CHECK(val.as<int>() == n);
+            ++n;
+        }
+        CHECK(n == 100);
+        CHECK(ec == cbor_errc::source_error);
+        CHECK(reader.position() == complete + 2);
+        ec.clear();
+        CHECK_FALSE(reader.read_next(val, ec));
+        CHECK_FALSE(ec);
+    }
+
+    SECTION("malformed header and truncated item end the sequence")
+    {
+        std::vector<uint8_t> seq;
+        append_item(seq, json(1));
+        seq.push_back(0xff); // break outside an indefinite length item
+        append_item(seq, json(2));
+        std::istringstream is(to_stream_data(seq));
+        parallel_cbor_sequence_reader<json> reader(is);
+
+        json val;
+        REQUIRE(reader.read_next(val));
+        REQUIRE_THROWS_AS(reader.read_next(val), ser_error);
+        CHECK_FALSE(reader.read_next(val));
+
+        std::vector<uint8_t> truncated;
+        append_item(truncated, json(1));
+        truncated.insert(truncated.end(), {0x83,0x01});
+        std::istringstream is2(to_stream_data(truncated));
+        parallel_cbor_sequence_reader<json> reader2(is2);
+
+        std::error_code ec;
+        REQUIRE(reader2.read_next(val, ec));
+        CHECK_FALSE(reader2.read_next(val, ec));
+        CHECK(ec == cbor_errc::unexpected_eof);
+    }
+}
@@ -0,0 +1,357 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    using compact_json = basic_json<char,compact_value_policy<sorted_policy>>;
+    using compact_ojson = basic_json<char,compact_value_policy<preserve_order_policy>>;
+
+    std::string to_text(const compact_json& j)
+    {
+        std::string s;
+        j.dump(s);
+        return s;
+    }
+
+    // Allocations made by misaligned_allocator, of any type, and not yet freed
+    std::size_t misaligned_outstanding = 0;
+
+    // Hands out addresses that are 4 bytes off 8 byte alignment
+    template <class T>
+    struct misaligned_allocator
+    {
+        using value_type = T;
+
+        misaligned_allocator() = default;
+
+        template <class U>
+        misaligned_allocator(const misaligned_allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            char* p = static_cast<char*>(::operator new(n*sizeof(T) + 8));
+            ++misaligned_outstanding;
+            return reinterpret_cast<T*>(p + 4);
+        }
+
+        void deallocate(T* p, std::size_t) noexcept
+        {
+            ::operator delete(reinterpret_cast<char*>(p) - 4);
+            --misaligned_outstanding;
+        }
+
+        friend bool operator==(const misaligned_allocator&, const misaligned_allocator&) noexcept
+        {
+            return true;
+        }
+
+        friend bool operator!=(const misaligned_allocator&, const misaligned_allocator&) noexcept
+        {
+            return false;
+        }
+    };
+}
+
+TEST_CASE("compact_value_policy size")
+{
+    CHECK(sizeof(compact_json) == 8);
+    CHECK(sizeof(compact_ojson) == 8);
+}
+
+TEST_CASE("compact_value_policy scalars")
+{
+    SECTION("null, bool and empty object")
+    {
+        compact_json a = compact_json::null();
+        compact_json b(true);
+        compact_json c(false);
+        compact_json d;
+
+        CHECK(a.is_null());
+        CHECK(a.storage() == storage_kind::null_value);
+        CHECK(b.as<bool>());
+        CHECK_FALSE(c.as<bool>());
+        CHECK(d.storage() == storage_kind::empty_object_value);
+        CHECK(d.empty());
+        CHECK(d == compact_json::parse("{}"));
+    }
+
+    SECTION("doubles")
+    {
+        const double values[] = {0.0, -0.0, 1.5, -1e300, 5e-324, std::numeric_limits<double>::max(),
+                                 std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+        for (double x : values)
+        {
+            compact_json j(x);
+            CHECK(j.storage() == storage_kind::double_value);
+            CHECK(j.tag() == semantic_tag::none);
+            CHECK(j.as<double>() == x);
+            CHECK(std::signbit(j.as<double>()) == std::signbit(x));
+        }
+
+        // NaNs with the sign bit set share their bits with the other values, they are boxed
+        double nan = -std::numeric_limits<double>::quiet_NaN();
+        compact_json j(nan);
+        CHECK(j.storage() == storage_kind::double_value);
+        CHECK(std::isnan(j.as<double>()));
+        CHECK(std::signbit(j.as<double>()));
+
+        compact_json k(1.5, semantic_tag::timestamp);
+        CHECK(k.tag() == semantic_tag::timestamp);
+        CHECK(k.as<double>() == 1.5);
+    }
+
+    SECTION("integers in and out of the payload")
+    {
+        const int64_t limit = int64_t(1) << 44;
+        const int64_t values[] = {0, 1, -1, limit - 1, -limit, limit, -limit - 1,
+                                  (std::numeric_limits<int64_t>::max)(), (std::numeric_limits<int64_t>::min)()};
+        for (int64_t x : values)
+        {
+            compact_json j(x);
+            CHECK(j.storage() == storage_kind::int64_value);
+            CHECK(j.as<int64_t>() == x);
+            CHECK(j == compact_json::parse(json(x).to_string()));
+        }
+
+        const uint64_t uvalues[] = {0, (uint64_t(1) << 45) - 1, uint64_t(1) << 45, (std::numeric_limits<uint64_t>::max)()};
+        for (uint64_t x : uvalues)
+        {
+            compact_json j(x);
+            CHECK(j.storage() == storage_kind::uint64_value);
+            CHECK(j.as<uint64_t>() == x);
+        }
+
+        compact_json k(int64_t(-5), semantic_tag::timestamp);
+        CHECK(k.tag() == semantic_tag::timestamp);
+        CHECK(k.as<int>() == -5);
+    }
+
+    SECTION("half")
+    {
+        compact_json j(half_arg, 0x3e00);
+        CHECK(j.storage() == storage_kind::half_value);
+        CHECK(j.as<double>() == 1.5);
+        CHECK(j == compact_json(1.5));
+    }
+}
+
+TEST_CASE("compact_value_policy strings")
+{
+    const std::string values[] = {"", "a", "abcd", "abcde", "hello world", std::string(1000, 'x')};
+    for (const auto& s : values)
+    {
+        compact_json j(s);
+        CHECK(j.is_string());
+        CHECK(j.as<std::string>() == s);
+        CHECK(j.as_string_view() == string_view(s));
+        CHECK(std::string(j.as_cstring()) == s);
+        CHECK(j.empty() == s.empty());
+        CHECK(j.storage() == (s.length() <= 4 ? storage_kind::short_string_value : storage_kind::long_string_value));
+
+        compact_json k(j);
+        CHECK(k == j);
+        CHECK(k.as<std::string>() == s);
+    }
+
+    compact_json a("2020-01-01T00:00:00Z", semantic_tag::datetime);
+    CHECK(a.tag() == semantic_tag::datetime);
+    compact_json b("uri", semantic_tag::uri);
+    CHECK(b.tag() == semantic_tag::uri);
+    CHECK(b.as<std::string>() == "uri");
+
+    compact_json c("abc");
+    CHECK(c < compact_json("abd"));
+    CHECK(c != compact_json("abcde"));
+}
+
+TEST_CASE("compact_value_policy containers")
+{
+    std::string input = R"({"a":1,"b":[true,null,-2.5,"text",{"c":"long enough string"}],"d":{},"e":12345678901234567890})";
+    compact_json j = compact_json::parse(input);
+    json expected = json::parse(input);
+
+    CHECK(j.size() == 4);
+    CHECK(j["b"].size() == 5);
+    CHECK(j["b"][4]["c"].as<std::string>() == "long enough string");
+    CHECK(j["e"].as<uint64_t>() == 12345678901234567890ull);
+    CHECK(to_text(j) == expected.to_string());
+
+    SECTION("modifying")
+    {
+        j["b"].push_back(42);
+        j["b"][0] = "replaced";
+        j.insert_or_assign("f", compact_json(json_array_arg, {1, 2, 3}));
+        j.erase("a");
+
+        CHECK(j["b"].size() == 6);
+        CHECK(j["b"][0].as<std::string>() == "replaced");
+        CHECK(j["b"][5].as<int>() == 42);
+        CHECK(j["f"].size() == 3);
+        CHECK_FALSE(j.contains("a"));
+    }
+
+    SECTION("copies and moves")
+    {
+        compact_json k(j);
+        CHECK(k == j);
+        k["b"][1] = 7;
+        CHECK(k != j);
+        CHECK(j["b"][1].is_null());
+
+        compact_json m(std::move(k));
+        CHECK(m["b"][1].as<int>() == 7);
+
+        compact_json n;
+        n = m;
+        CHECK(n == m);
+        n = std::move(m);
+        CHECK(n["b"][1].as<int>() == 7);
+
+        n.swap(j);
+        CHECK(n["b"][1].is_null());
+        CHECK(j["b"][1].as<int>() == 7);
+    }
+
+    SECTION("tagged containers")
+    {
+        compact_json arr(json_array_arg, semantic_tag::multi_dim_row_major);
+        arr.push_back(1);
+        CHECK(arr.tag() == semantic_tag::multi_dim_row_major);
+        CHECK(arr.storage() == storage_kind::array_value);
+        compact_json copy(arr);
+        CHECK(copy.tag() == semantic_tag::multi_dim_row_major);
+    }
+
+    SECTION("deeply nested")
+    {
+        std::string deep(100000, '[');
+        deep.append(100000, ']');
+        json_options options;
+        options.max_nesting_depth(200000);
+        compact_json k = compact_json::parse(deep, options);
+        CHECK(k.is_array());
+    }
+}
+
+TEST_CASE("compact_value_policy boxed values")
+{
+    std::vector<uint8_t> bytes = {1, 2, 3, 4, 5};
+    compact_json a(byte_string_arg, bytes, semantic_tag::base64);
+    CHECK(a.storage() == storage_kind::byte_string_value);
+    CHECK(a.tag() == semantic_tag::base64);
+    CHECK(a.as<std::vector<uint8_t>>() == bytes);
+    CHECK(a.as<std::string>() == "AQIDBAU=");
+
+    compact_json b(a);
+    CHECK(b == a);
+
+    std::vector<float> v = {1.5f, 2.0f};
+    compact_json c(typed_array_arg, typed_array_view(v.data(), v.size()));
+    CHECK(c.is_typed_array());
+    CHECK(c.size() == 2);
+    CHECK(c[1].as<double>() == 2.0);
+    c.push_back(3);
+    CHECK(c.storage() == storage_kind::array_value);
+    CHECK(c.size() == 3);
+
+    json_options options;
+    options.lazy_number(true);
+    compact_json d = compact_json::parse("[1.5,2.0e10,3.14159265358979]", options);
+    CHECK(d[0].storage() == storage_kind::short_double_text_value);
+    CHECK(d[1].storage() == storage_kind::short_double_text_value);
+    CHECK(d[1].as<double>() == 2.0e10);
+    CHECK(d[2].storage() == storage_kind::long_double_text_value);
+    CHECK(d[2].as<double>() == 3.14159265358979);
+    CHECK(to_text(d) == "[1.5,2.0e10,3.14159265358979]");
+}
+
+TEST_CASE("compact_value_policy with addresses that cannot be held")
+{
+    using misaligned_json = basic_json<char,compact_value_policy<sorted_policy>,misaligned_allocator<char>>;
+
+    std::size_t outstanding = misaligned_outstanding;
+    CHECK_THROWS_AS(misaligned_json(json_array_arg), std::runtime_error);
+    CHECK_THROWS_AS(misaligned_json(json_object_arg), std::runtime_error);
+    CHECK_THROWS_AS(misaligned_json(uint64_t(1) << 60), std::runtime_error);
+    CHECK(misaligned_outstanding == outstanding);
+
+    misaligned_json j(1.5);
+    CHECK(j.as<double>() == 1.5);
+}
+
+TEST_CASE("compact_value_policy agrees with the default layout")
+{
+    std::string input = R"([{"name":"first","values":[1,-1,0.25,1e100,18446744073709551615],"ok":true},
+                            {"name":"second","values":[],"ok":false,"missing":null}])";
+    compact_json j = compact_json::parse(input);
+    json expected = json::parse(input);
+
+    CHECK(to_text(j) == expected.to_string());
+    CHECK(j.hash_code() == expected.hash_code());
+
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(j, data);
+    std::vector<uint8_t> expected_data;
+    cbor::encode_cbor(expected, expected_data);
+    CHECK(data == expected_data);
+
+    compact_json k = cbor::decode_cbor<compact_json>(data);
+    CHECK(k == j);
+}
+
+TEST_CASE("compact_value_policy with other policies")
+{
+    using cow_json = basic_json<char,compact_value_policy<copy_on_write_policy<sorted_policy>>>;
+    using small_json = basic_json<char,compact_value_policy<small_buffer_policy<sorted_policy>>>;
+    using hashed_json = basic_json<char,compact_value_policy<cached_hash_policy<sorted_policy>>>;
+
+    SECTION("copy_on_write_policy")
+    {
+        cow_json j = cow_json::parse(R"({"a":[1,2,3],"b":"a long string"})");
+        cow_json k(j);
+        k["a"].push_back(4);
+
+        CHECK(j["a"].size() == 3);
+        CHECK(k["a"].size() == 4);
+        CHECK(k["b"] == j["b"]);
+    }
+
+    SECTION("small_buffer_policy")
+    {
+        small_json j = small_json::parse(R"([1,[2,3],{"a":"b"}])");
+        CHECK(j[1][1].as<int>() == 3);
+        CHECK(j[2]["a"].as<std::string>() == "b");
+    }
+
+    SECTION("cached_hash_policy")
+    {
+        std::string doc = "[";
+        for (int i = 0; i < 50; ++i)
+        {
+            doc += (i == 0 ? "" : ",");
+            doc += std::to_string(i);
+        }
+        doc += "]";
+
+        hashed_json j = hashed_json::parse(doc);
+        const hashed_json& cj = j;
+        std::size_t h = cj.hash_code();
+        CHECK(h == json::parse(doc).hash_code());
+        j[0] = 100;
+        CHECK(cj.hash_code() != h);
+    }
+}
@@ -0,0 +1,132 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonpath/json_query.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    using cow_json = basic_json<char,copy_on_write_policy<sorted_policy>>;
+    using cow_ojson = basic_json<char,copy_on_write_policy<preserve_order_policy>>;
+
+    const std::string doc = R"(
+{
+    "name" : "A name that is long enough to be allocated on the heap",
+    "values" : [1, 2, [3, 4]],
+    "nested" : {"a" : {"b" : "c"}}
+}
+    )";
+}
+
+TEST_CASE("copy_on_write_policy copies share")
+{
+    const cow_json j = cow_json::parse(doc);
+    const cow_json k(j);
+
+    CHECK(&k["values"].array_value() == &j["values"].array_value());
+    CHECK(&k["nested"].object_value() == &j["nested"].object_value());
+    CHECK(k["name"].as_string_view().data() == j["name"].as_string_view().data());
+    CHECK(k == j);
+}
+
+TEST_CASE("copy_on_write_policy mutation")
+{
+    SECTION("modify a copy")
+    {
+        cow_json j = cow_json::parse(doc);
+        cow_json k(j);
+
+        k["values"][2].push_back(5);
+        k["nested"]["a"]["b"] = "d";
+        k.insert_or_assign("extra", true);
+
+        CHECK(j == cow_json::parse(doc));
+        CHECK(k["values"][2].size() == 3);
+        CHECK(k["nested"]["a"]["b"].as<std::string>() == "d");
+        CHECK(k.contains("extra"));
+        CHECK_FALSE(j.contains("extra"));
+
+        // Untouched parts are still shared
+        const cow_json& cj = j;
+        const cow_json& ck = k;
+        CHECK(ck["values"][0] == cj["values"][0]);
+        CHECK(ck["name"].as_string_view().data() == cj["name"].as_string_view().data());
+    }
+
+    SECTION("modify the original")
+    {
+        cow_ojson j = cow_ojson::parse(doc);
+        cow_ojson k(j);
+
+        j["values"].erase(j["values"].array_range().begin());
+        j.erase("nested");
+
+        CHECK(k == cow_ojson::parse(doc));
+        CHECK(j["values"].size() == 2);
+        CHECK_FALSE(j.contains("nested"));
+    }
+
+    SECTION("assignment")
+    {
+        cow_json j = cow_json::parse(doc);
+        cow_json k;
+        k = j;
+        k["values"] = cow_json(json_array_arg);
+        CHECK(j["values"].size() == 3);
+        CHECK(k["values"].empty());
+    }
+
+    SECTION("destroy shared nested values")
+    {
+        cow_json k;
+        {
+            cow_json j = cow_json::parse(doc);
+            k = j.at("nested");
+        }
+        CHECK(k["a"]["b"].as<std::string>() == "c");
+    }
+}
+
+TEST_CASE("copy_on_write_policy json_query")
+{
+    cow_json j = cow_json::parse(doc);
+    cow_json result = jsonpath::json_query(j, "$.nested.a");
+
+    REQUIRE(result.size() == 1);
+    CHECK(result[0]["b"].as<std::string>() == "c");
+}
+
+TEST_CASE("copy_on_write_policy across threads")
+{
+    const cow_json j = cow_json::parse(doc);
+
+    std::vector<std::thread> threads;
+    std::vector<std::size_t> sizes(4);
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        threads.emplace_back([&j,&sizes,i]()
+        {
+            for (std::size_t n = 0; n < 1000; ++n)
+            {
+                cow_json k(j);
+                k["values"].push_back(n);
+                sizes[i] = k["values"].size();
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    for (auto size : sizes)
+    {
+        CHECK(size == 4);
+    }
+    CHECK(j == cow_json::parse(doc));
+}
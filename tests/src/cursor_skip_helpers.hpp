@@ -0,0 +1,49 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#ifndef CURSOR_SKIP_HELPERS_HPP
+#define CURSOR_SKIP_HELPERS_HPP
+
+#include <jsoncons/staj_reader.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+// Skips the values of every member other than "a" and "z", and records what is left.
+// The cursor tests of each format use it on a document with those members.
+template <class Cursor>
+std::vector<std::string> skip_containers(Cursor& cursor)
+{
+    using jsoncons::staj_event_type;
+
+    std::vector<std::string> seen;
+    REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+    cursor.next();
+    while (!cursor.done())
+    {
+        const auto& event = cursor.current();
+        switch (event.event_type())
+        {
+            case staj_event_type::begin_object:
+                cursor.skip();
+                CHECK(cursor.current().event_type() == staj_event_type::end_object);
+                seen.push_back("{}");
+                break;
+            case staj_event_type::begin_array:
+                cursor.skip();
+                CHECK(cursor.current().event_type() == staj_event_type::end_array);
+                seen.push_back("[]");
+                break;
+            case staj_event_type::end_object:
+                seen.push_back("end");
+                break;
+            default:
+                seen.push_back(event.template get<std::string>());
+                break;
+        }
+        cursor.next();
+    }
+    return seen;
+}
+
+#endif
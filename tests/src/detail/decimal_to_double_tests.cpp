@@ -0,0 +1,127 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <catch/catch.hpp>
+#include <jsoncons/detail/decimal_to_double.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace {
+
+    double to_double(const std::string& s)
+    {
+        double d = -1;
+        bool ok = jsoncons::detail::decimal_to_double(s.data(), s.length(), '.', d);
+        CHECK(ok);
+        return d;
+    }
+
+    bool same_bits(double a, double b)
+    {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+
+} // namespace
+
+TEST_CASE("jsoncons::detail::decimal_to_double tests")
+{
+    SECTION("simple values")
+    {
+        CHECK(to_double("0") == 0.0);
+        CHECK(same_bits(to_double("-0.0"), -0.0));
+        CHECK(to_double("1") == 1.0);
+        CHECK(to_double("-1.5") == -1.5);
+        CHECK(to_double("+2.5e1") == 25.0);
+        CHECK(to_double("0.1") == 0.1);
+        CHECK(to_double("123456789.123456789") == 123456789.123456789);
+        CHECK(to_double("1.15507e-173") == 1.15507e-173);
+        CHECK(to_double("1E22") == 1e22);
+        CHECK(to_double("5.") == 5.0);
+        CHECK(to_double(".5") == 0.5);
+    }
+
+    SECTION("hard cases")
+    {
+        CHECK(to_double("2.2250738585072011e-308") == 2.2250738585072011e-308);
+        CHECK(to_double("2.2250738585072012e-308") == 2.2250738585072012e-308);
+        CHECK(to_double("7.2057594037927933e+16") == 7.2057594037927933e+16);
+        CHECK(to_double("9007199254740993") == 9007199254740992.0);
+        CHECK(to_double("9007199254740995") == 9007199254740996.0);
+        CHECK(to_double("1.7976931348623157e308") == (std::numeric_limits<double>::max)());
+        CHECK(to_double("4.9406564584124654e-324") == std::numeric_limits<double>::denorm_min());
+        CHECK(to_double("2.4703282292062328e-324") == std::numeric_limits<double>::denorm_min());
+        CHECK(to_double("2.4703282292062327e-324") == 0.0);
+        // Halfway between 1 and the next double, followed by digits that decide the rounding
+        CHECK(to_double("1.00000000000000011102230246251565404236316680908203125") == 1.0);
+        CHECK(to_double("1.00000000000000011102230246251565404236316680908203126") == std::nextafter(1.0, 2.0));
+        CHECK(to_double("9007199254740993.0000000000000000000000000000001") == 9007199254740994.0);
+    }
+
+    SECTION("overflow and underflow")
+    {
+        CHECK(to_double("1e309") == std::numeric_limits<double>::infinity());
+        CHECK(to_double("-1e400") == -std::numeric_limits<double>::infinity());
+        CHECK(to_double("1.7976931348623159e308") == std::numeric_limits<double>::infinity());
+        CHECK(to_double("1e-400") == 0.0);
+        CHECK(same_bits(to_double("-1e-400"), -0.0));
+        CHECK(to_double("0e999999999") == 0.0);
+    }
+
+    SECTION("decimal point")
+    {
+        double d = 0;
+        CHECK(jsoncons::detail::decimal_to_double("1,25", 4, ',', d));
+        CHECK(d == 1.25);
+    }
+
+    SECTION("not a plain decimal number")
+    {
+        double d = 0;
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("", 0, '.', d));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("-", 1, '.', d));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double(".", 1, '.', d));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("1e", 2, '.', d));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("1x", 2, '.', d));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("inf", 3, '.', d));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("0x10", 4, '.', d));
+    }
+
+    SECTION("wide characters")
+    {
+        double d = 0;
+        CHECK(jsoncons::detail::decimal_to_double(L"-3.25e2", 7, L'.', d));
+        CHECK(d == -325.0);
+    }
+
+    SECTION("agrees with strtod")
+    {
+        std::mt19937_64 gen(2020);
+        std::uniform_int_distribution<uint64_t> bits;
+        std::uniform_int_distribution<int> precision(1, 25);
+        char buffer[100];
+        for (int i = 0; i < 20000; ++i)
+        {
+            uint64_t u = bits(gen);
+            double x;
+            std::memcpy(&x, &u, sizeof(x));
+            if (!std::isfinite(x))
+            {
+                continue;
+            }
+            int length = snprintf(buffer, sizeof(buffer), "%.*e", precision(gen), x);
+            double expected = strtod(buffer, nullptr);
+            double actual = 0;
+            REQUIRE(jsoncons::detail::decimal_to_double(buffer, static_cast<std::size_t>(length), '.', actual));
+            if (!same_bits(actual, expected))
+            {
+                FAIL(buffer);
+            }
+        }
+    }
+}
+
@@ -0,0 +1,102 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <catch/catch.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+#include <string>
+
+TEST_CASE("jsoncons::detail::find_string_special tests")
+{
+    SECTION("no special characters")
+    {
+        std::string s(100, 'a');
+        const char* last = s.data() + s.size();
+        CHECK(jsoncons::detail::find_string_special(s.data(), last) == last);
+    }
+    SECTION("special character at every offset")
+    {
+        const std::string specials = std::string("\"\\\t\n\r", 5) + std::string(1, '\0') + "\x1f";
+        for (char c : specials)
+        {
+            for (std::size_t n = 1; n <= 70; ++n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    std::string s(n, 'x');
+                    s[i] = c;
+                    const char* p = jsoncons::detail::find_string_special(s.data(), s.data() + s.size());
+                    CHECK(p - s.data() == static_cast<std::ptrdiff_t>(i));
+                }
+            }
+        }
+    }
+    SECTION("non-ASCII bytes are not special")
+    {
+        std::string s(40, '\xe9');
+        s.push_back(' ');
+        s.push_back('\x7f');
+        s.push_back('\x20');
+        const char* last = s.data() + s.size();
+        CHECK(jsoncons::detail::find_string_special(s.data(), last) == last);
+    }
+    SECTION("wide characters")
+    {
+        std::wstring s(40, L'\x4e2d');
+        s[33] = L'"';
+        CHECK(jsoncons::detail::find_string_special(s.data(), s.data() + s.size()) - s.data() == 33);
+    }
+}
+
+TEST_CASE("jsoncons::detail::skip_whitespace_run tests")
+{
+    SECTION("agrees with scalar on every prefix")
+    {
+        const char pieces[] = {' ', '\t', '\n', '\r'};
+        std::string s;
+        unsigned seed = 12345;
+        for (std::size_t i = 0; i < 200; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            s.push_back(pieces[(seed >> 16) % 4]);
+        }
+        s.push_back('x');
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {
+            std::string t = s.substr(i);
+            const char* last = t.data() + t.size();
+
+            std::size_t lines1 = 0;
+            const char* begin1 = t.data();
+            const char* p1 = jsoncons::detail::scalar_skip_whitespace_run(t.data(), last, lines1, begin1);
+
+            std::size_t lines2 = 0;
+            const char* begin2 = t.data();
+            const char* p2 = jsoncons::detail::skip_whitespace_run(t.data(), last, lines2, begin2);
+
+            CHECK(p1 == p2);
+            CHECK(*p1 == 'x');
+            CHECK(lines1 == lines2);
+            CHECK(begin1 == begin2);
+        }
+    }
+    SECTION("trailing carriage return is not consumed")
+    {
+        std::string s(20, ' ');
+        s.push_back('\r');
+        std::size_t lines = 0;
+        const char* begin = s.data();
+        const char* p = jsoncons::detail::skip_whitespace_run(s.data(), s.data() + s.size(), lines, begin);
+        CHECK(p == s.data() + 20);
+        CHECK(lines == 0);
+    }
+    SECTION("carriage return line feed counts once")
+    {
+        std::string s = std::string(17, ' ') + "\r\n" + std::string(17, ' ') + "\r\r\n\n  x";
+        std::size_t lines = 0;
+        const char* begin = s.data();
+        const char* p = jsoncons::detail::skip_whitespace_run(s.data(), s.data() + s.size(), lines, begin);
+        CHECK(*p == 'x');
+        CHECK(lines == 4);
+        CHECK(p - begin == 2);
+    }
+}
@@ -6,6 +6,8 @@
 #include <catch/catch.hpp>
 #include <iostream>
 #include <cstdio>
+#include <cstring>
+#include <random>
 
 using namespace jsoncons;
 
@@ -98,3 +100,62 @@ TEST_CASE("test grisu3")
     check_dtoa(0.000071, {"7.1e-05"}); 
 }
 
+
+TEST_CASE("test schubfach")
+{
+    SECTION("values that grisu3 rejects")
+    {
+        char buffer[100];
+        int length = 0;
+        int k = 0;
+        // grisu3 cannot decide the shortest representation of these
+        CHECK_FALSE(jsoncons::detail::grisu3(1.0e23, buffer, &length, &k));
+
+        std::string s;
+        CHECK(jsoncons::detail::dtoa_general(1.0e23, '.', s));
+        CHECK(s == "1e+23");
+        s.clear();
+        CHECK(jsoncons::detail::dtoa_general(5e-324, '.', s));
+        CHECK(s == "5e-324");
+        s.clear();
+        CHECK(jsoncons::detail::dtoa_general(1.7976931348623157e308, '.', s));
+        CHECK(s == "1.7976931348623157e+308");
+        s.clear();
+        CHECK(jsoncons::detail::dtoa_fixed(1.0e23, '.', s));
+        CHECK(s == "100000000000000000000000.0");
+    }
+
+    SECTION("shortest round trip, same digits as grisu3")
+    {
+        std::mt19937_64 gen(2020);
+        for (int i = 0; i < 100000; ++i)
+        {
+            uint64_t u = gen() & 0x7fffffffffffffff;
+            double x;
+            std::memcpy(&x, &u, sizeof(x));
+            if (!std::isfinite(x) || x == 0)
+            {
+                continue;
+            }
+            char buffer1[100];
+            int length1 = 0;
+            int k1 = 0;
+            jsoncons::detail::schubfach(x, buffer1, &length1, &k1);
+            REQUIRE(length1 <= 17);
+
+            std::string s(buffer1, length1);
+            s.append("e");
+            s.append(std::to_string(k1));
+            CHECK(strtod(s.c_str(), nullptr) == x);
+
+            char buffer2[100];
+            int length2 = 0;
+            int k2 = 0;
+            if (jsoncons::detail::grisu3(x, buffer2, &length2, &k2))
+            {
+                CHECK(std::string(buffer1, length1) == std::string(buffer2, length2));
+                CHECK(k1 == k2);
+            }
+        }
+    }
+}
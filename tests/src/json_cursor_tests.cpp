@@ -8,6 +8,7 @@
 #include <jsoncons/json_encoder.hpp>
 #include <jsoncons/json_cursor.hpp>
 #include <catch/catch.hpp>
+#include "cursor_skip_helpers.hpp"
 #include <sstream>
 #include <vector>
 #include <utility>
@@ -463,5 +464,107 @@ TEST_CASE("json_cursor with filter tests")
     CHECK(reader.done());
 }
 
+TEST_CASE("json_cursor skip")
+{
+    std::string input = R"(
+{
+    "a" : 1,
+    "b" : {"s" : "x]}\"{[\\", "n" : [1,2.5,-3,true,false,null,{"k":[[],{}]}], "e" : {}},
+    "c" : [["a","b"],{"c":[1,[2,[3]]]}],
+    "d" : [],
+    "z" : "end"
+}
+)";
+    std::vector<std::string> expected = {"a","1","b","{}","c","[]","d","[]","z","end","end"};
+
+    SECTION("string source")
+    {
+        json_cursor cursor(input);
+        CHECK(skip_containers(cursor) == expected);
+    }
 
+    SECTION("stream source")
+    {
+        std::istringstream is(input);
+        json_cursor cursor(is);
+        CHECK(skip_containers(cursor) == expected);
+    }
 
+    SECTION("stream source longer than the buffer")
+    {
+        std::string long_input = R"({"a":1,"b":[)";
+        for (std::size_t i = 0; i < 10000; ++i)
+        {
+            long_input.append("{\"s\":\"]\\r\\n\"},\r\n");
+        }
+        long_input.append(R"("\\"],"z":"end"})");
+        std::vector<std::string> long_expected = {"a","1","b","[]","z","end","end"};
+
+        std::istringstream is(long_input);
+        json_cursor cursor(is);
+        CHECK(skip_containers(cursor) == long_expected);
+        CHECK(cursor.context().line() == 10001);
+    }
+
+    SECTION("line and column after skip")
+    {
+        json_cursor cursor(input);
+        cursor.next(); // "a"
+        cursor.next(); // 1
+        cursor.next(); // "b"
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        CHECK(cursor.current().event_type() == staj_event_type::end_object);
+        CHECK(cursor.context().line() == 4);
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == "c");
+        CHECK(cursor.context().line() == 5);
+    }
+
+    SECTION("skip a scalar")
+    {
+        json_cursor cursor(input);
+        cursor.next();
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::uint64_value);
+        cursor.skip();
+        CHECK(cursor.current().get<int>() == 1);
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == "b");
+    }
+
+    SECTION("skip the root")
+    {
+        json_cursor cursor(input);
+        cursor.skip();
+        CHECK(cursor.current().event_type() == staj_event_type::end_object);
+        cursor.next();
+        CHECK(cursor.done());
+    }
+
+    SECTION("comments in the skipped value")
+    {
+        std::string commented = R"({"a":1,"b":[1, // ]}
+/* "]
+}* */ 2, 3/4],"c":{"d":[/**/]/*}*/},
+"z":"end"})";
+        std::vector<std::string> commented_expected = {"a","1","b","[]","c","{}","z","end","end"};
+
+        json_cursor cursor(commented);
+        CHECK(skip_containers(cursor) == commented_expected);
+        CHECK(cursor.context().line() == 4);
+    }
+
+    SECTION("unexpected end of input")
+    {
+        std::string truncated = R"({"a":{"b":[1,2,"]}"])";
+        json_cursor cursor(truncated);
+        cursor.next();
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == json_errc::unexpected_eof);
+    }
+}
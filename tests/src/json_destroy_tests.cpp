@@ -0,0 +1,122 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reclaimer.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <utility>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Far deeper than the stack would allow a recursive destructor to go
+    const std::size_t deep = 1000000;
+
+    template <class Json>
+    Json make_nested_arrays(std::size_t depth)
+    {
+        Json j(json_array_arg);
+        j.push_back(1);
+        for (std::size_t i = 0; i < depth; ++i)
+        {
+            Json outer(json_array_arg);
+            outer.push_back(std::move(j));
+            outer.push_back("a string long enough to be allocated on the heap");
+            j = std::move(outer);
+        }
+        return j;
+    }
+
+    template <class Json>
+    Json make_nested_objects(std::size_t depth)
+    {
+        Json j(json_object_arg);
+        j.insert_or_assign("leaf", true);
+        for (std::size_t i = 0; i < depth; ++i)
+        {
+            Json outer(json_object_arg);
+            outer.insert_or_assign("a", 1);
+            outer.insert_or_assign("b", std::move(j));
+            j = std::move(outer);
+        }
+        return j;
+    }
+}
+
+TEST_CASE("destroy deeply nested values")
+{
+    SECTION("arrays")
+    {
+        json j = make_nested_arrays<json>(deep);
+        CHECK(j.size() == 2);
+    }
+    SECTION("objects")
+    {
+        json j = make_nested_objects<json>(deep);
+        CHECK(j.size() == 2);
+    }
+    SECTION("ojson objects")
+    {
+        ojson j = make_nested_objects<ojson>(deep);
+        CHECK(j.size() == 2);
+    }
+    SECTION("arrays and objects")
+    {
+        json j(json_array_arg);
+        for (std::size_t i = 0; i < deep; ++i)
+        {
+            json outer(json_object_arg);
+            outer.try_emplace("a", json_array_arg);
+            outer["a"].push_back(std::move(j));
+            j = std::move(outer);
+        }
+        CHECK(j.size() == 1);
+    }
+}
+
+TEST_CASE("destroy keeps siblings")
+{
+    json j = json::parse(R"([[1,[2,[3]]],{"a":{"b":[4]}},[]])");
+    json k = j[1];
+    j = json::null();
+    CHECK(k == json::parse(R"({"a":{"b":[4]}})"));
+}
+
+TEST_CASE("json_reclaimer")
+{
+    SECTION("reclaim")
+    {
+        json_reclaimer<json> reclaimer;
+
+        json j = make_nested_arrays<json>(deep);
+        reclaimer.reclaim(std::move(j));
+        CHECK(j.is_null());
+
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            reclaimer.reclaim(json::parse(R"({"a":[1,2,3],"b":"a string long enough to be allocated on the heap"})"));
+        }
+        reclaimer.wait();
+        CHECK(reclaimer.pending() == 0);
+    }
+
+    SECTION("values without heap memory are not taken")
+    {
+        json_reclaimer<json> reclaimer;
+        json j(10);
+        reclaimer.reclaim(std::move(j));
+        CHECK(j == json(10));
+        CHECK(reclaimer.pending() == 0);
+    }
+
+    SECTION("pending values are destroyed by the destructor")
+    {
+        json_reclaimer<ojson> reclaimer;
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            reclaimer.reclaim(make_nested_objects<ojson>(1000));
+        }
+    }
+}
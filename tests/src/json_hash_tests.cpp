@@ -0,0 +1,147 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("json hash agrees with operator==")
+{
+    SECTION("numbers")
+    {
+        json a(int64_t(10));
+        json b(uint64_t(10));
+        json c(10.0);
+        json d(half_arg, 0x4900); // 10.0
+        json e = json::parse("10.0");
+
+        CHECK(a == b);
+        CHECK(a.hash_code() == b.hash_code());
+        CHECK(a == c);
+        CHECK(a.hash_code() == c.hash_code());
+        CHECK(c == d);
+        CHECK(c.hash_code() == d.hash_code());
+        CHECK(c == e);
+        CHECK(c.hash_code() == e.hash_code());
+
+        CHECK(json(0.0).hash_code() == json(-0.0).hash_code());
+        CHECK(json(1).hash_code() != json(2).hash_code());
+    }
+
+    SECTION("strings and other scalars")
+    {
+        std::string s(100, 'x');
+        CHECK(json("abc").hash_code() == json(std::string("abc")).hash_code());
+        CHECK(json(s).hash_code() == json(s.c_str()).hash_code());
+        CHECK(json("abc").hash_code() != json("abd").hash_code());
+        CHECK(json("1").hash_code() != json(1).hash_code());
+        CHECK(json(true).hash_code() != json(false).hash_code());
+        CHECK(json::null().hash_code() == json(null_type()).hash_code());
+
+        std::vector<uint8_t> bytes = {1,2,3};
+        CHECK(json(byte_string_arg, bytes).hash_code() == json(byte_string_arg, bytes).hash_code());
+    }
+
+    SECTION("arrays are ordered")
+    {
+        json a = json::parse("[1,2,3]");
+        json b = json::parse("[1.0,2,3]");
+        json c = json::parse("[3,2,1]");
+
+        CHECK(a.hash_code() == b.hash_code());
+        CHECK(a.hash_code() != c.hash_code());
+        CHECK(json(json_array_arg).hash_code() != json().hash_code());
+    }
+
+    SECTION("objects are unordered")
+    {
+        using unordered_json = basic_json<char,unordered_policy>;
+
+        unordered_json a = unordered_json::parse(R"({"first":1,"second":[true,null],"third":"x"})");
+        unordered_json b = unordered_json::parse(R"({"third":"x","first":1,"second":[true,null]})");
+        unordered_json c = unordered_json::parse(R"({"third":"x","first":2,"second":[true,null]})");
+
+        REQUIRE(a == b);
+        CHECK(a.hash_code() == b.hash_code());
+        CHECK(a.hash_code() != c.hash_code());
+
+        json d = json::parse(R"({"third":"x","first":1,"second":[true,null]})");
+        CHECK(d.hash_code() == a.hash_code());
+
+        json empty;
+        CHECK(empty.hash_code() == json::parse("{}").hash_code());
+    }
+
+    SECTION("typed arrays")
+    {
+        std::vector<float> v = {1.5f, 2.0f, -3.25f};
+        json a(typed_array_arg, typed_array_view(v.data(), v.size()));
+        json b = json::parse("[1.5, 2, -3.25]");
+
+        REQUIRE(a == b);
+        CHECK(a.hash_code() == b.hash_code());
+    }
+}
+
+TEST_CASE("std::hash<json>")
+{
+    std::unordered_set<json> set;
+    set.insert(json::parse(R"({"a":1,"b":[1,2]})"));
+    set.insert(json::parse(R"({"b":[1.0,2],"a":1})"));
+    set.insert(json::parse(R"([1,2])"));
+    set.insert(json(1));
+    set.insert(json(uint64_t(1)));
+
+    CHECK(set.size() == 3);
+    CHECK(std::hash<json>()(json("abc")) == json("abc").hash_code());
+}
+
+TEST_CASE("cached_hash_policy")
+{
+    using cached_json = basic_json<char,cached_hash_policy<sorted_policy>>;
+
+    std::string doc = "[";
+    for (int i = 0; i < 100; ++i)
+    {
+        doc += (i == 0 ? "" : ",");
+        doc += R"({"id":)" + std::to_string(i) + R"(,"tags":["a","b"]})";
+    }
+    doc += "]";
+
+    cached_json j = cached_json::parse(doc);
+    const cached_json& cj = j;
+    const json plain = json::parse(doc);
+
+    std::size_t h = cj.hash_code();
+    CHECK(h == plain.hash_code());
+    CHECK(cj.hash_code() == h);
+
+    SECTION("modifying an element")
+    {
+        j[50]["id"] = 500;
+        CHECK(cj.hash_code() != h);
+        j[50]["id"] = 50;
+        CHECK(cj.hash_code() == h);
+    }
+
+    SECTION("appending")
+    {
+        j.push_back(cached_json());
+        CHECK(cj.hash_code() != h);
+        j.erase(j.array_range().end() - 1);
+        CHECK(cj.hash_code() == h);
+    }
+
+    SECTION("copies")
+    {
+        cached_json k(j);
+        CHECK(k.hash_code() == h);
+        k[0]["tags"].push_back("c");
+        CHECK(k.hash_code() != h);
+        CHECK(cj.hash_code() == h);
+    }
+}
@@ -8,6 +8,7 @@
 #include <sstream>
 #include <vector>
 #include <utility>
+#include <tuple>
 #include <ctime>
 
 using namespace jsoncons;
@@ -237,3 +238,28 @@ TEST_CASE("test_positive_integer_overflow")
 
 
 
+
+TEST_CASE("test_illegal_character_in_string_position")
+{
+    // The column reported is one past the offending character
+    std::vector<std::tuple<std::string,std::error_code,std::size_t>> inputs = {
+        std::make_tuple(std::string("[\"abc\x01" "def\"]"), make_error_code(json_errc::illegal_control_character), 7),
+        std::make_tuple(std::string("{\"a\":\"0123456789\x02\"}"), make_error_code(json_errc::illegal_control_character), 18),
+        std::make_tuple(std::string("[\"ab\tc\"]"), make_error_code(json_errc::illegal_character_in_string), 6),
+        std::make_tuple(std::string("[1,\n \"a\tb\"]"), make_error_code(json_errc::illegal_character_in_string), 5)
+    };
+    for (const auto& item : inputs)
+    {
+        std::size_t column = 0;
+        JSONCONS_TRY
+        {
+            json::parse(std::get<0>(item));
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            CHECK(e.code() == std::get<1>(item));
+            column = e.column();
+        }
+        CHECK(column == std::get<2>(item));
+    }
+}
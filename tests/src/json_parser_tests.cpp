@@ -277,3 +277,38 @@ TEST_CASE("test_incremental_parsing")
 
 
 
+
+TEST_CASE("test_whitespace_line_and_column")
+{
+    std::string indent(20, ' ');
+    std::string input = "[\r\n" + indent + "1,\r\n\r\n" + indent + "\t2,\n\r" + indent + "\r\n" + indent + "x]";
+
+    // Reference line and column of the 'x'
+    std::size_t expected_line = 1;
+    std::size_t expected_column = 1;
+    for (std::size_t i = 0; input[i] != 'x'; ++i)
+    {
+        if (input[i] == '\n' || (input[i] == '\r' && input[i+1] != '\n'))
+        {
+            ++expected_line;
+            expected_column = 1;
+        }
+        else
+        {
+            ++expected_column;
+        }
+    }
+
+    for (std::size_t i = 1; i < input.size(); ++i)
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_reader reader(is, decoder);
+        reader.buffer_length(i);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::expected_value);
+        CHECK(reader.line() == expected_line);
+        CHECK(reader.column() == expected_column);
+    }
+}
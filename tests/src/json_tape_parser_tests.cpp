@@ -0,0 +1,445 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_encoder.hpp>
+#include <jsoncons/json_tape_parser.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <utility>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string parse_events(const std::string& input, bool use_tape, std::error_code& ec)
+    {
+        std::string buffer;
+        json_options options;
+        options.escape_all_non_ascii(true);
+        json_compressed_string_encoder encoder(buffer, options);
+        if (use_tape)
+        {
+            json_tape_parser parser;
+            parser.parse(input, encoder, ec);
+        }
+        else
+        {
+            json_parser parser{strict_json_parsing()};
+            parser.update(input);
+            parser.finish_parse(encoder, ec);
+            if (!ec)
+            {
+                parser.check_done(ec);
+            }
+        }
+        return buffer;
+    }
+
+}
+
+TEST_CASE("json_tape_parser same events as json_parser")
+{
+    std::string long_string(150, 'x');
+    std::vector<std::string> inputs = {
+        "{}", "[]", "0", "-0", "\"\"", "true", "false", "null", " \r\n 17 \n",
+        "[1,-2,3.5,-4.25e10,5E-3,18446744073709551615,18446744073709551616,-9223372036854775809]",
+        "{\"a\":{\"b\":[1,{\"c\":null}],\"d\":\"e\"},\"f\":[[],{},[[]]]}",
+        "[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\",\"\\u00e9\\u4e2d\\ud83d\\ude00\"]",
+        "{\"" + long_string + "\":\"" + long_string + "\\\"" + long_string + "\"}",
+        "[\"\\\\\",\"\\\\\\\\\",\"a\\\\\\\"b\"]",
+        "  [ 1 , 2 ,\t3 ]\r\n",
+        "[\"\xe4\xb8\xad\xe6\x96\x87\",\"caf\xc3\xa9\"]"
+    };
+    for (const auto& input : inputs)
+    {
+        std::error_code ec1;
+        std::error_code ec2;
+        std::string expected = parse_events(input, false, ec1);
+        std::string actual = parse_events(input, true, ec2);
+        CHECK_FALSE(ec1);
+        CHECK_FALSE(ec2);
+        CHECK(expected == actual);
+    }
+}
+
+TEST_CASE("json_tape_parser large document")
+{
+    std::ostringstream os;
+    os << "[";
+    for (std::size_t i = 0; i < 2000; ++i)
+    {
+        if (i > 0) os << ",\n  ";
+        os << "{\"id\":" << i << ",\"name\":\"item \\\"" << i << "\\\"\",\"price\":" << i << ".25,\"tags\":[\"a\",\"b\"],\"ok\":" << (i % 2 == 0 ? "true" : "false") << "}";
+    }
+    os << "]";
+    std::string input = os.str();
+
+    std::error_code ec1;
+    std::error_code ec2;
+    CHECK(parse_events(input, false, ec1) == parse_events(input, true, ec2));
+    CHECK_FALSE(ec1);
+    CHECK_FALSE(ec2);
+}
+
+TEST_CASE("json_tape_parser errors")
+{
+    std::vector<std::pair<std::string,json_errc>> inputs = {
+        {"", json_errc::unexpected_eof},
+        {"[1,2", json_errc::unexpected_eof},
+        {"[\"abc", json_errc::unexpected_eof},
+        {"[1,]", json_errc::extra_comma},
+        {"{\"a\":1,}", json_errc::extra_comma},
+        {"{\"a\" 1}", json_errc::expected_colon},
+        {"{1:1}", json_errc::expected_name},
+        {"[1 2]", json_errc::expected_comma_or_right_bracket},
+        {"{\"a\":1 \"b\":2}", json_errc::expected_comma_or_right_brace},
+        {"[01]", json_errc::leading_zero},
+        {"[1.]", json_errc::invalid_number},
+        {"[1x]", json_errc::invalid_number},
+        {"[tru]", json_errc::invalid_value},
+        {"[truex]", json_errc::invalid_value},
+        {"[\"a\\x\"]", json_errc::illegal_escaped_character},
+        {"[\"\\u12G4\"]", json_errc::invalid_hex_escape_sequence},
+        {"[\"a\tb\"]", json_errc::illegal_character_in_string},
+        {"[\"a\x01" "b\"]", json_errc::illegal_control_character},
+        {"[1] 2", json_errc::extra_character},
+        {"[1 /* comment */]", json_errc::illegal_comment}
+    };
+    for (const auto& item : inputs)
+    {
+        std::error_code ec;
+        parse_events(item.first, true, ec);
+        CHECK(ec == item.second);
+    }
+}
+
+TEST_CASE("json_tape_parser max_nesting_depth")
+{
+    json_options options;
+    options.max_nesting_depth(3);
+
+    std::string buffer;
+    json_compressed_string_encoder encoder(buffer);
+    json_tape_parser parser(options);
+
+    std::error_code ec;
+    parser.parse("[[[1]]]", encoder, ec);
+    CHECK_FALSE(ec);
+
+    parser.parse("[[[[1]]]]", encoder, ec);
+    CHECK(ec == json_errc::max_nesting_depth_exceeded);
+}
+
+TEST_CASE("json::parse with use_tape_parser")
+{
+    json_options options;
+    options.use_tape_parser(true);
+
+    SECTION("valid input")
+    {
+        std::string input = "{\"a\":[1,2.5,\"three\",true,null],\"b\":{\"c\":-4}}";
+        CHECK(json::parse(input, options) == json::parse(input));
+    }
+    SECTION("lossless_number")
+    {
+        options.lossless_number(true);
+        json j = json::parse("[1.50]", options);
+        CHECK(j[0].tag() == semantic_tag::bigdec);
+        CHECK(j[0].as<std::string>() == "1.50");
+    }
+    SECTION("comments fall back to json_parser")
+    {
+        json j = json::parse("[1, /* comment */ 2]", options);
+        CHECK(j.size() == 2);
+    }
+    SECTION("errors are reported like json_parser")
+    {
+        std::string input = "{\n  \"a\":1,\n  \"b\" 2\n}";
+        std::size_t line = 0;
+        std::size_t column = 0;
+        JSONCONS_TRY
+        {
+            json::parse(input, options);
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            CHECK(e.code() == json_errc::expected_colon);
+            line = e.line();
+            column = e.column();
+        }
+        CHECK(line == 3);
+        CHECK(column == 7);
+    }
+}
+
+TEST_CASE("json::parse with use_tape_parser rejects what json_parser rejects")
+{
+    // Once the root value is complete json_decoder asks for no more events, the trailing
+    // input must still be checked
+    std::vector<std::string> files = {
+        "JSONTestSuite/n_array_1_true_without_comma.json",
+        "JSONTestSuite/n_array_a_invalid_utf8.json",
+        "JSONTestSuite/n_array_colon_instead_of_comma.json",
+        "JSONTestSuite/n_array_comma_after_close.json",
+        "JSONTestSuite/n_array_comma_and_number.json",
+        "JSONTestSuite/n_array_double_comma.json",
+        "JSONTestSuite/n_array_double_extra_comma.json",
+        "JSONTestSuite/n_array_extra_close.json",
+        "JSONTestSuite/n_array_extra_comma.json",
+        "JSONTestSuite/n_array_incomplete.json",
+        "JSONTestSuite/n_array_incomplete_invalid_value.json",
+        "JSONTestSuite/n_array_inner_array_no_comma.json",
+        "JSONTestSuite/n_array_invalid_utf8.json",
+        "JSONTestSuite/n_array_items_separated_by_semicolon.json",
+        "JSONTestSuite/n_array_just_comma.json",
+        "JSONTestSuite/n_array_just_minus.json",
+        "JSONTestSuite/n_array_missing_value.json",
+        "JSONTestSuite/n_array_newlines_unclosed.json",
+        "JSONTestSuite/n_array_number_and_comma.json",
+        "JSONTestSuite/n_array_number_and_several_commas.json",
+        "JSONTestSuite/n_array_spaces_vertical_tab_formfeed.json",
+        "JSONTestSuite/n_array_star_inside.json",
+        "JSONTestSuite/n_array_unclosed.json",
+        "JSONTestSuite/n_array_unclosed_trailing_comma.json",
+        "JSONTestSuite/n_array_unclosed_with_new_lines.json",
+        "JSONTestSuite/n_array_unclosed_with_object_inside.json",
+        "JSONTestSuite/n_incomplete_false.json",
+        "JSONTestSuite/n_incomplete_null.json",
+        "JSONTestSuite/n_incomplete_true.json",
+        "JSONTestSuite/n_multidigit_number_then_00.json",
+        "JSONTestSuite/n_number_++.json",
+        "JSONTestSuite/n_number_+1.json",
+        "JSONTestSuite/n_number_+Inf.json",
+        "JSONTestSuite/n_number_-01.json",
+        "JSONTestSuite/n_number_-1.0..json",
+        "JSONTestSuite/n_number_-2..json",
+        "JSONTestSuite/n_number_-NaN.json",
+        "JSONTestSuite/n_number_.-1.json",
+        "JSONTestSuite/n_number_.2e-3.json",
+        "JSONTestSuite/n_number_0.1.2.json",
+        "JSONTestSuite/n_number_0.3e+.json",
+        "JSONTestSuite/n_number_0.3e.json",
+        "JSONTestSuite/n_number_0.e1.json",
+        "JSONTestSuite/n_number_0_capital_E+.json",
+        "JSONTestSuite/n_number_0_capital_E.json",
+        "JSONTestSuite/n_number_0e+.json",
+        "JSONTestSuite/n_number_0e.json",
+        "JSONTestSuite/n_number_1.0e+.json",
+        "JSONTestSuite/n_number_1.0e-.json",
+        "JSONTestSuite/n_number_1.0e.json",
+        "JSONTestSuite/n_number_1_000.json",
+        "JSONTestSuite/n_number_1eE2.json",
+        "JSONTestSuite/n_number_2.e+3.json",
+        "JSONTestSuite/n_number_2.e-3.json",
+        "JSONTestSuite/n_number_2.e3.json",
+        "JSONTestSuite/n_number_9.e+.json",
+        "JSONTestSuite/n_number_Inf.json",
+        "JSONTestSuite/n_number_NaN.json",
+        "JSONTestSuite/n_number_U+FF11_fullwidth_digit_one.json",
+        "JSONTestSuite/n_number_expression.json",
+        "JSONTestSuite/n_number_hex_1_digit.json",
+        "JSONTestSuite/n_number_hex_2_digits.json",
+        "JSONTestSuite/n_number_infinity.json",
+        "JSONTestSuite/n_number_invalid+-.json",
+        "JSONTestSuite/n_number_invalid-negative-real.json",
+        "JSONTestSuite/n_number_invalid-utf-8-in-bigger-int.json",
+        "JSONTestSuite/n_number_invalid-utf-8-in-exponent.json",
+        "JSONTestSuite/n_number_invalid-utf-8-in-int.json",
+        "JSONTestSuite/n_number_minus_infinity.json",
+        "JSONTestSuite/n_number_minus_sign_with_trailing_garbage.json",
+        "JSONTestSuite/n_number_minus_space_1.json",
+        "JSONTestSuite/n_number_neg_int_starting_with_zero.json",
+        "JSONTestSuite/n_number_neg_real_without_int_part.json",
+        "JSONTestSuite/n_number_neg_with_garbage_at_end.json",
+        "JSONTestSuite/n_number_real_garbage_after_e.json",
+        "JSONTestSuite/n_number_real_with_invalid_utf8_after_e.json",
+        "JSONTestSuite/n_number_real_without_fractional_part.json",
+        "JSONTestSuite/n_number_starting_with_dot.json",
+        "JSONTestSuite/n_number_with_alpha.json",
+        "JSONTestSuite/n_number_with_alpha_char.json",
+        "JSONTestSuite/n_number_with_leading_zero.json",
+        "JSONTestSuite/n_object_bad_value.json",
+        "JSONTestSuite/n_object_bracket_key.json",
+        "JSONTestSuite/n_object_comma_instead_of_colon.json",
+        "JSONTestSuite/n_object_double_colon.json",
+        "JSONTestSuite/n_object_emoji.json",
+        "JSONTestSuite/n_object_garbage_at_end.json",
+        "JSONTestSuite/n_object_key_with_single_quotes.json",
+        "JSONTestSuite/n_object_lone_continuation_byte_in_key_and_trailing_comma.json",
+        "JSONTestSuite/n_object_missing_colon.json",
+        "JSONTestSuite/n_object_missing_key.json",
+        "JSONTestSuite/n_object_missing_semicolon.json",
+        "JSONTestSuite/n_object_missing_value.json",
+        "JSONTestSuite/n_object_no-colon.json",
+        "JSONTestSuite/n_object_non_string_key.json",
+        "JSONTestSuite/n_object_non_string_key_but_huge_number_instead.json",
+        "JSONTestSuite/n_object_repeated_null_null.json",
+        "JSONTestSuite/n_object_several_trailing_commas.json",
+        "JSONTestSuite/n_object_single_quote.json",
+        "JSONTestSuite/n_object_trailing_comma.json",
+        "JSONTestSuite/n_object_trailing_comment.json",
+        "JSONTestSuite/n_object_trailing_comment_open.json",
+        "JSONTestSuite/n_object_trailing_comment_slash_open.json",
+        "JSONTestSuite/n_object_trailing_comment_slash_open_incomplete.json",
+        "JSONTestSuite/n_object_two_commas_in_a_row.json",
+        "JSONTestSuite/n_object_unquoted_key.json",
+        "JSONTestSuite/n_object_unterminated-value.json",
+        "JSONTestSuite/n_object_with_single_string.json",
+        "JSONTestSuite/n_object_with_trailing_garbage.json",
+        "JSONTestSuite/n_single_space.json",
+        "JSONTestSuite/n_string_1_surrogate_then_escape.json",
+        "JSONTestSuite/n_string_1_surrogate_then_escape_u.json",
+        "JSONTestSuite/n_string_1_surrogate_then_escape_u1.json",
+        "JSONTestSuite/n_string_1_surrogate_then_escape_u1x.json",
+        "JSONTestSuite/n_string_accentuated_char_no_quotes.json",
+        "JSONTestSuite/n_string_backslash_00.json",
+        "JSONTestSuite/n_string_escape_x.json",
+        "JSONTestSuite/n_string_escaped_backslash_bad.json",
+        "JSONTestSuite/n_string_escaped_ctrl_char_tab.json",
+        "JSONTestSuite/n_string_escaped_emoji.json",
+        "JSONTestSuite/n_string_incomplete_escape.json",
+        "JSONTestSuite/n_string_incomplete_escaped_character.json",
+        "JSONTestSuite/n_string_incomplete_surrogate.json",
+        "JSONTestSuite/n_string_incomplete_surrogate_escape_invalid.json",
+        "JSONTestSuite/n_string_invalid-utf-8-in-escape.json",
+        "JSONTestSuite/n_string_invalid_backslash_esc.json",
+        "JSONTestSuite/n_string_invalid_unicode_escape.json",
+        "JSONTestSuite/n_string_invalid_utf8_after_escape.json",
+        "JSONTestSuite/n_string_leading_uescaped_thinspace.json",
+        "JSONTestSuite/n_string_no_quotes_with_bad_escape.json",
+        "JSONTestSuite/n_string_single_doublequote.json",
+        "JSONTestSuite/n_string_single_quote.json",
+        "JSONTestSuite/n_string_single_string_no_double_quotes.json",
+        "JSONTestSuite/n_string_start_escape_unclosed.json",
+        "JSONTestSuite/n_string_unescaped_crtl_char.json",
+        "JSONTestSuite/n_string_unescaped_newline.json",
+        "JSONTestSuite/n_string_unescaped_tab.json",
+        "JSONTestSuite/n_string_unicode_CapitalU.json",
+        "JSONTestSuite/n_string_with_trailing_garbage.json",
+        "JSONTestSuite/n_structure_100000_opening_arrays.json",
+        "JSONTestSuite/n_structure_U+2060_word_joined.json",
+        "JSONTestSuite/n_structure_UTF8_BOM_no_data.json",
+        "JSONTestSuite/n_structure_angle_bracket_..json",
+        "JSONTestSuite/n_structure_angle_bracket_null.json",
+        "JSONTestSuite/n_structure_array_trailing_garbage.json",
+        "JSONTestSuite/n_structure_array_with_extra_array_close.json",
+        "JSONTestSuite/n_structure_array_with_unclosed_string.json",
+        "JSONTestSuite/n_structure_ascii-unicode-identifier.json",
+        "JSONTestSuite/n_structure_capitalized_True.json",
+        "JSONTestSuite/n_structure_close_unopened_array.json",
+        "JSONTestSuite/n_structure_comma_instead_of_closing_brace.json",
+        "JSONTestSuite/n_structure_double_array.json",
+        "JSONTestSuite/n_structure_end_array.json",
+        "JSONTestSuite/n_structure_incomplete_UTF8_BOM.json",
+        "JSONTestSuite/n_structure_lone-invalid-utf-8.json",
+        "JSONTestSuite/n_structure_lone-open-bracket.json",
+        "JSONTestSuite/n_structure_no_data.json",
+        "JSONTestSuite/n_structure_null-byte-outside-string.json",
+        "JSONTestSuite/n_structure_number_with_trailing_garbage.json",
+        "JSONTestSuite/n_structure_object_followed_by_closing_object.json",
+        "JSONTestSuite/n_structure_object_unclosed_no_value.json",
+        "JSONTestSuite/n_structure_object_with_comment.json",
+        "JSONTestSuite/n_structure_object_with_trailing_garbage.json",
+        "JSONTestSuite/n_structure_open_array_apostrophe.json",
+        "JSONTestSuite/n_structure_open_array_comma.json",
+        "JSONTestSuite/n_structure_open_array_object.json",
+        "JSONTestSuite/n_structure_open_array_open_object.json",
+        "JSONTestSuite/n_structure_open_array_open_string.json",
+        "JSONTestSuite/n_structure_open_array_string.json",
+        "JSONTestSuite/n_structure_open_object.json",
+        "JSONTestSuite/n_structure_open_object_close_array.json",
+        "JSONTestSuite/n_structure_open_object_comma.json",
+        "JSONTestSuite/n_structure_open_object_open_array.json",
+        "JSONTestSuite/n_structure_open_object_open_string.json",
+        "JSONTestSuite/n_structure_open_object_string_with_apostrophes.json",
+        "JSONTestSuite/n_structure_open_open.json",
+        "JSONTestSuite/n_structure_single_eacute.json",
+        "JSONTestSuite/n_structure_single_star.json",
+        "JSONTestSuite/n_structure_trailing_#.json",
+        "JSONTestSuite/n_structure_uescaped_LF_before_string.json",
+        "JSONTestSuite/n_structure_unclosed_array.json",
+        "JSONTestSuite/n_structure_unclosed_array_partial_null.json",
+        "JSONTestSuite/n_structure_unclosed_array_unfinished_false.json",
+        "JSONTestSuite/n_structure_unclosed_array_unfinished_true.json",
+        "JSONTestSuite/n_structure_unclosed_object.json",
+        "JSONTestSuite/n_structure_unicode-identifier.json",
+        "JSONTestSuite/n_structure_whitespace_U+2060_word_joiner.json",
+        "JSONTestSuite/n_structure_whitespace_formfeed.json",
+        "JSON_checker/fail1.json",
+        "JSON_checker/fail2.json",
+        "JSON_checker/fail3.json",
+        "JSON_checker/fail4.json",
+        "JSON_checker/fail5.json",
+        "JSON_checker/fail6.json",
+        "JSON_checker/fail7.json",
+        "JSON_checker/fail8.json",
+        "JSON_checker/fail9.json",
+        "JSON_checker/fail10.json",
+        "JSON_checker/fail11.json",
+        "JSON_checker/fail12.json",
+        "JSON_checker/fail13.json",
+        "JSON_checker/fail14.json",
+        "JSON_checker/fail15.json",
+        "JSON_checker/fail16.json",
+        "JSON_checker/fail17.json",
+        "JSON_checker/fail18.json",
+        "JSON_checker/fail19.json",
+        "JSON_checker/fail20.json",
+        "JSON_checker/fail21.json",
+        "JSON_checker/fail22.json",
+        "JSON_checker/fail23.json",
+        "JSON_checker/fail24.json",
+        "JSON_checker/fail25.json",
+        "JSON_checker/fail26.json",
+        "JSON_checker/fail27.json",
+        "JSON_checker/fail28.json",
+        "JSON_checker/fail29.json",
+        "JSON_checker/fail30.json",
+        "JSON_checker/fail31.json",
+        "JSON_checker/fail32.json",
+        "JSON_checker/fail33.json"
+    };
+
+    json_options options;
+    options.use_tape_parser(true);
+
+    for (const auto& file : files)
+    {
+        std::ifstream is("./input/" + file, std::ios::binary);
+        REQUIRE(is);
+        std::ostringstream os;
+        os << is.rdbuf();
+        std::string input = os.str();
+
+        std::error_code expected;
+        JSONCONS_TRY
+        {
+            json::parse(input, strict_json_parsing());
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            expected = e.code();
+        }
+
+        std::error_code ec;
+        JSONCONS_TRY
+        {
+            json::parse(input, options, strict_json_parsing());
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            ec = e.code();
+        }
+        INFO(file);
+        CHECK(ec == expected);
+    }
+
+    CHECK_THROWS_AS(json::parse("[1]]", options, strict_json_parsing()), ser_error);
+    CHECK_THROWS_AS(json::parse("{\"a\":1} x", options, strict_json_parsing()), ser_error);
+    CHECK_THROWS_AS(json::parse("\"abc\"garbage", options, strict_json_parsing()), ser_error);
+    CHECK_THROWS_AS(json::parse("[1,2] // c", options, strict_json_parsing()), ser_error);
+    CHECK_THROWS_AS(json::parse("[1,2] // c", options), ser_error);
+}
@@ -473,6 +473,61 @@ namespace json_type_traits_macro_tests
         std::unique_ptr<std::string> field11;
         jsoncons::optional<std::string> field12;
     };
+
+    // As many members as the traits macros support
+    struct wide_record
+    {
+        int order_id;
+        int order_name;
+        int order_code;
+        int order_status;
+        int order_count;
+        int order_amount;
+        int order_created;
+        int order_updated;
+        int order_note;
+        int order_flag;
+        int customer_id;
+        int customer_name;
+        int customer_code;
+        int customer_status;
+        int customer_count;
+        int customer_amount;
+        int customer_created;
+        int customer_updated;
+        int customer_note;
+        int customer_flag;
+        int shipping_id;
+        int shipping_name;
+        int shipping_code;
+        int shipping_status;
+        int shipping_count;
+        int shipping_amount;
+        int shipping_created;
+        int shipping_updated;
+        int shipping_note;
+        int shipping_flag;
+        int billing_id;
+        int billing_name;
+        int billing_code;
+        int billing_status;
+        int billing_count;
+        int billing_amount;
+        int billing_created;
+        int billing_updated;
+        int billing_note;
+        int billing_flag;
+        int item_id;
+        int item_name;
+        int item_code;
+        int item_status;
+        int item_count;
+        int item_amount;
+        int item_created;
+        int item_updated;
+        int item_note;
+        int item_flag;
+    };
 } // namespace json_type_traits_macro_tests
  
 namespace ns = json_type_traits_macro_tests;
@@ -506,6 +561,19 @@ JSONCONS_N_MEMBER_TRAITS(ns::smart_pointer_and_optional_test1,6,
                          field1,field2,field3,field4,field5,field6,
                          field7,field8,field9,field10,field11,field12)
 
+// The first 40 members mandatory
+JSONCONS_N_MEMBER_TRAITS(ns::wide_record,40,
+                         order_id,order_name,order_code,order_status,order_count,
+                         order_amount,order_created,order_updated,order_note,order_flag,
+                         customer_id,customer_name,customer_code,customer_status,customer_count,
+                         customer_amount,customer_created,customer_updated,customer_note,customer_flag,
+                         shipping_id,shipping_name,shipping_code,shipping_status,shipping_count,
+                         shipping_amount,shipping_created,shipping_updated,shipping_note,shipping_flag,
+                         billing_id,billing_name,billing_code,billing_status,billing_count,
+                         billing_amount,billing_created,billing_updated,billing_note,billing_flag,
+                         item_id,item_name,item_code,item_status,item_count,
+                         item_amount,item_created,item_updated,item_note,item_flag)
+
 void test_is_json_type_traits_declared(std::true_type)
 {
 }
@@ -589,6 +657,26 @@ TEST_CASE("JSONCONS_ALL_MEMBER_TRAITS tests")
         CHECK(val.title == book.title);
         CHECK(val.price == Approx(book.price).epsilon(0.001));
     }
+
+    SECTION("members that are not declared are skipped")
+    {
+        std::string s = R"(
+{
+    "reviews" : [{"text" : "]}", "stars" : [5,{"x":[]}]}],
+    "author" : "Haruki Murakami",
+    "publisher" : {"name" : "Vintage", "address" : {}},
+    "title" : "Kafka on the Shore",
+    "pages" : 505,
+    "price" : 25.17
+}
+        )";
+
+        ns::book1a val = decode_json<ns::book1a>(s);
+
+        CHECK(val.author == book.author);
+        CHECK(val.title == book.title);
+        CHECK(val.price == Approx(book.price).epsilon(0.001));
+    }
 }
 
 TEST_CASE("JSONCONS_N_MEMBER_TRAITS with optional tests")
@@ -1323,3 +1411,71 @@ TEST_CASE("JSONCONS_N_MEMBER_TRAITS pointer and optional test")
         CHECK_FALSE(other.field12);
     }
 }
+
+TEST_CASE("JSONCONS_N_MEMBER_TRAITS with 50 members")
+{
+    const std::vector<std::string> names = {"order_id", "order_name", "order_code", "order_status", "order_count", "order_amount", "order_created", "order_updated", "order_note", "order_flag", "customer_id", "customer_name", "customer_code", "customer_status", "customer_count", "customer_amount", "customer_created", "customer_updated", "customer_note", "customer_flag", "shipping_id", "shipping_name", "shipping_code", "shipping_status", "shipping_count", "shipping_amount", "shipping_created", "shipping_updated", "shipping_note", "shipping_flag", "billing_id", "billing_name", "billing_code", "billing_status", "billing_count", "billing_amount", "billing_created", "billing_updated", "billing_note", "billing_flag", "item_id", "item_name", "item_code", "item_status", "item_count", "item_amount", "item_created", "item_updated", "item_note", "item_flag"};
+
+    json j;
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        j.try_emplace(names[i], static_cast<int>(i));
+    }
+
+    SECTION("member_index")
+    {
+        using traits = json_type_traits<json,ns::wide_record>;
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            CHECK(traits::member_index(names[i]) == i);
+        }
+        CHECK(traits::member_index("") == 50);
+        CHECK(traits::member_index("order_i") == 50);
+        CHECK(traits::member_index("order_idx") == 50);
+        CHECK(traits::member_index("item_flag ") == 50);
+    }
+
+    SECTION("as and to_json")
+    {
+        CHECK(j.is<ns::wide_record>());
+        auto val = j.as<ns::wide_record>();
+        CHECK(val.order_id == 0);
+        CHECK(val.customer_status == 13);
+        CHECK(val.item_flag == 49);
+        CHECK(json(val) == j);
+    }
+
+    SECTION("optional members and unknown members")
+    {
+        json k(j);
+        k.erase("item_id");
+        k.erase("item_flag");
+        k.try_emplace("extra", "ignored");
+        CHECK(k.is<ns::wide_record>());
+        auto val = k.as<ns::wide_record>();
+        CHECK(val.item_id == 0);
+        CHECK(val.item_flag == 0);
+        CHECK(val.item_note == 48);
+    }
+
+    SECTION("missing mandatory member")
+    {
+        json k(j);
+        k.erase("billing_note");
+        CHECK_FALSE(k.is<ns::wide_record>());
+        CHECK_THROWS(k.as<ns::wide_record>());
+        CHECK_THROWS(json(json_array_arg).as<ns::wide_record>());
+    }
+
+    SECTION("decode_json")
+    {
+        std::string s;
+        j.dump(s);
+        auto val = decode_json<ns::wide_record>(s);
+        CHECK(val.shipping_amount == 25);
+
+        std::string t;
+        encode_json(val, t);
+        CHECK(json::parse(t) == j);
+    }
+}
@@ -0,0 +1,331 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons_ext/jsonpath/staj_query.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <utility>
+
+using namespace jsoncons;
+using namespace jsoncons::jsonpath;
+
+namespace {
+
+    const std::string store_text = R"(
+    {
+        "store": {
+            "book": [
+                {
+                    "category": "reference",
+                    "author": "Nigel Rees",
+                    "title": "Sayings of the Century",
+                    "price": 8.95
+                },
+                {
+                    "category": "fiction",
+                    "author": "Evelyn Waugh",
+                    "title": "Sword of Honour",
+                    "price": 12.99
+                },
+                {
+                    "category": "fiction",
+                    "author": "Herman Melville",
+                    "title": "Moby Dick",
+                    "isbn": "0-553-21311-3",
+                    "price": 8.99
+                },
+                {
+                    "category": "fiction",
+                    "author": "J. R. R. Tolkien",
+                    "title": "The Lord of the Rings",
+                    "isbn": "0-395-19395-8",
+                    "price": 22.99
+                }
+            ],
+            "bicycle": {
+                "color": "red",
+                "price": 19.95
+            }
+        }
+    }
+    )";
+
+    std::vector<std::string> sorted(const json& a)
+    {
+        std::vector<std::string> result;
+        for (const auto& item : a.array_range())
+        {
+            result.push_back(item.to_string());
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // For paths that select no location twice, and no equal values in a union
+    void check_agrees(const std::string& text, const std::vector<std::string>& paths)
+    {
+        json doc = json::parse(text);
+        for (const auto& path : paths)
+        {
+            INFO(path);
+            json_cursor cursor(text);
+            staj_query<json> query(path);
+
+            json values = query.evaluate(cursor);
+            CHECK(sorted(values) == sorted(json_query(doc, path)));
+
+            json_cursor cursor2(text);
+            json locations = query.evaluate(cursor2, result_type::path);
+            CHECK(sorted(locations) == sorted(json_query(doc, path, result_type::path)));
+        }
+    }
+}
+
+TEST_CASE("staj_query agrees with json_query")
+{
+    std::vector<std::string> paths = {
+        "$",
+        "$.store.book[0].title",
+        "$['store']['book'][1]['author']",
+        "$.store.*",
+        "$.store.book[*].author",
+        "$.store.book[0,2].title",
+        "$.store.book[1:3].title",
+        "$.store.book[:2].price",
+        "$.store.book[1:].price",
+        "$.store.book[::2].title",
+        "$..author",
+        "$..price",
+        "$..book[2]",
+        "$..book[?(@.isbn)].title",
+        "$.store.book[?(@.price < 10)].title",
+        "$..book[?(@.category == 'fiction' && @.price > 20)]",
+        "$..[?(@.color)]",
+        "$.store.bicycle[?(@.color == 'red')].price",
+        "$..*",
+        "$.store.book[*]",
+        "$.nothing.here",
+        "$.store.book[10]",
+        "store.book.0.title",
+        "$[store][book][1][author]",
+        "$. store . book [2] . 'title'",
+        "$..[\"price\"]",
+        "$.store.book.length",
+        "$.store.book[0].author[1]",
+        "$.store.bicycle.color.length"
+    };
+    check_agrees(store_text, paths);
+
+    std::string text = R"({"a":[1,2,3,4],"s":"abc","e":[],"t":"","o":{"length":5,"s":"x\u00e9y"},"n":[["ab"],"cd"]})";
+    std::vector<std::string> length_paths = {
+        "$.a.length",
+        "$['a']['length']",
+        "$.s[1]",
+        "$.s[0,2]",
+        "$.s[5]",
+        "$.s.length",
+        "$.e.length",
+        "$.t.length",
+        "$.t[0]",
+        "$.o.length",
+        "$.o.s[1]",
+        "$.o.s.length",
+        "$.s[1][0]",
+        "$..length",
+        "$..[1]",
+        "$.n[0][0][1]",
+        "$..s[1]",
+        "$..s.length",
+        "$.a[0,length]",
+        "$.s..length",
+        "$.s[*]",
+        "$.s[0:2]",
+        "$..[0]"
+    };
+    check_agrees(text, length_paths);
+}
+
+TEST_CASE("staj_query reports each location once")
+{
+    SECTION("union of equal values")
+    {
+        std::string text = R"(["",null,[4,4,{}]])";
+        staj_query<json> query("$..[0,1]");
+
+        json_cursor cursor(text);
+        CHECK(query.evaluate(cursor) == json::parse(R"(["",null,4,4])"));
+        json_cursor cursor2(text);
+        CHECK(query.evaluate(cursor2, result_type::path) == json::parse(R"(["$[0]","$[1]","$[2][0]","$[2][1]"])"));
+
+        // json_query leaves out the second 4
+        CHECK(json_query(json::parse(text), "$..[0,1]").size() == 3);
+    }
+    SECTION("union naming a location twice")
+    {
+        std::string text = R"([1,2])";
+        json_cursor cursor(text);
+        staj_query<json> query("$[0,1,0]");
+        CHECK(query.evaluate(cursor) == json::parse("[1,2]"));
+    }
+    SECTION("nested recursive descent")
+    {
+        std::string text = R"({"a":{"a":{"b":1}}})";
+        staj_query<json> query("$..a..b");
+
+        json_cursor cursor(text);
+        CHECK(query.evaluate(cursor) == json::parse("[1]"));
+        json_cursor cursor2(text);
+        CHECK(query.evaluate(cursor2, result_type::path) == json::parse(R"(["$['a']['a']['b']"])"));
+
+        // json_query reaches $['a']['a']['b'] through both a's
+        CHECK(json_query(json::parse(text), "$..a..b") == json::parse("[1,1]"));
+    }
+}
+
+TEST_CASE("staj_query tests")
+{
+    SECTION("values are reported in document order")
+    {
+        std::string text = R"({"a":{"x":1,"b":{"x":2}},"c":[{"x":3},{"y":{"x":4}}],"x":5})";
+        json_cursor cursor(text);
+
+        std::vector<std::pair<std::string,json>> results;
+        staj_query<json> query("$..x");
+        query.evaluate(cursor, [&](const string_view& location, const json& value)
+        {
+            results.emplace_back(std::string(location), value);
+        });
+
+        REQUIRE(results.size() == 5);
+        CHECK(results[0].first == "$['a']['x']");
+        CHECK(results[0].second == json(1));
+        CHECK(results[1].first == "$['a']['b']['x']");
+        CHECK(results[2].first == "$['c'][0]['x']");
+        CHECK(results[3].first == "$['c'][1]['y']['x']");
+        CHECK(results[4].first == "$['x']");
+        CHECK(results[4].second == json(5));
+    }
+
+    SECTION("a selected value is reported before those inside it")
+    {
+        std::string text = R"({"a":{"a":{"a":1}}})";
+        json_cursor cursor(text);
+
+        json locations = staj_query<json>("$..a").evaluate(cursor, result_type::path);
+        REQUIRE(locations.size() == 3);
+        CHECK(locations[0].as<std::string>() == "$['a']");
+        CHECK(locations[1].as<std::string>() == "$['a']['a']");
+        CHECK(locations[2].as<std::string>() == "$['a']['a']['a']");
+    }
+
+    SECTION("only the selected values are read")
+    {
+        // The filter is applied to each element on its own, the array is never read in full
+        std::string text = R"({"log":[{"level":"info","n":1},{"level":"error","n":2},{"level":"info","n":3},{"level":"error","n":4}]})";
+        json_cursor cursor(text);
+
+        json values = staj_query<json>("$.log[?(@.level == 'error')].n").evaluate(cursor);
+        CHECK(values == json::parse("[2,4]"));
+    }
+
+    SECTION("stops reading once nothing more can be selected")
+    {
+        std::string text = R"({"a":[10,11,12,13],"b":1,"c":)";
+        json_cursor cursor(text);
+
+        json values = staj_query<json>("$.a[1:3]").evaluate(cursor);
+        CHECK(values == json::parse("[11,12]"));
+
+        json_cursor cursor2(text);
+        std::error_code ec;
+        staj_query<json>("$.a[1:3]").evaluate(cursor2, [](const string_view&, const json&){}, ec);
+        CHECK_FALSE(ec);
+
+        json_cursor cursor3(text);
+        staj_query<json>("$.c").evaluate(cursor3, [](const string_view&, const json&){}, ec);
+        CHECK(ec == json_errc::unexpected_eof);
+
+        json_cursor cursor4(text);
+        CHECK_THROWS_AS(staj_query<json>("$..b").evaluate(cursor4), ser_error);
+    }
+
+    SECTION("an index selects a member with the same name")
+    {
+        std::string text = R"({"0":"zero","1":[true,false]})";
+        json_cursor cursor(text);
+
+        json values = staj_query<json>("$[0]").evaluate(cursor);
+        CHECK(values == json::parse(R"(["zero"])"));
+
+        json_cursor cursor2(text);
+        values = staj_query<json>("$['1'][1]").evaluate(cursor2);
+        CHECK(values == json::parse("[false]"));
+    }
+
+    SECTION("the query can be used again")
+    {
+        staj_query<json> query("$.store.book[?(@.price > 10)].price");
+        for (int i = 0; i < 2; ++i)
+        {
+            json_cursor cursor(store_text);
+            CHECK(query.evaluate(cursor) == json::parse("[12.99,22.99]"));
+        }
+    }
+
+    SECTION("cbor")
+    {
+        json store = json::parse(store_text);
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(store, data);
+
+        cbor::cbor_bytes_cursor cursor(data);
+        json values = staj_query<json>("$.store.book[?(@.isbn)].author").evaluate(cursor);
+        CHECK(values == json::parse(R"(["Herman Melville","J. R. R. Tolkien"])"));
+    }
+
+    SECTION("invalid paths")
+    {
+        std::error_code ec;
+        staj_query<json> q1("$store", ec);
+        CHECK(ec == jsonpath_errc::expected_separator);
+
+        ec = std::error_code();
+        staj_query<json> q2("$.store.book[-1]", ec);
+        CHECK(ec == jsonpath_errc::unsupported_in_stream);
+
+        ec = std::error_code();
+        staj_query<json> q3("$.store.book[0:-1]", ec);
+        CHECK(ec == jsonpath_errc::unsupported_in_stream);
+
+        ec = std::error_code();
+        staj_query<json> q4("$.store.book[0", ec);
+        CHECK(ec == jsonpath_errc::expected_right_bracket);
+
+        ec = std::error_code();
+        staj_query<json> q5("$.store.book[::0]", ec);
+        CHECK(ec == jsonpath_errc::expected_slice_step);
+
+        ec = std::error_code();
+        staj_query<json> q6("$.", ec);
+        CHECK(ec == jsonpath_errc::expected_name);
+
+        ec = std::error_code();
+        staj_query<json> q7("$..[title,address.city]", ec);
+        CHECK(ec == jsonpath_errc::unsupported_in_stream);
+
+        ec = std::error_code();
+        staj_query<json> q8("$[,]", ec);
+        CHECK(ec == jsonpath_errc::expected_name);
+
+        ec = std::error_code();
+        staj_query<json> q9("$.store[book,]", ec);
+        CHECK(ec == jsonpath_errc::expected_name);
+
+        CHECK_THROWS_AS(staj_query<json>("$.store.book[?(@.price < 10]"), jsonpath_error);
+    }
+}
@@ -0,0 +1,188 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons_ext/jsonpointer/json_ptr_extractor.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    struct match
+    {
+        std::size_t index;
+        std::string location;
+        json value;
+    };
+
+    std::vector<match> extract_all(jsonpointer::json_ptr_extractor<json>& extractor, staj_reader& reader)
+    {
+        std::vector<match> matches;
+        extractor.extract(reader, [&](std::size_t index, const string_view& location, const json& value)
+        {
+            matches.push_back(match{index, std::string(location), value});
+        });
+        return matches;
+    }
+
+    const std::string order = R"(
+{
+    "meta" : {"id" : 17, "source" : "web"},
+    "items" : [
+        {"sku" : "a1", "price" : 10.5, "tags" : ["x", "]}"]},
+        {"sku" : "b2", "price" : 3, "tags" : []},
+        {"sku" : "c3", "tags" : [{}]}
+    ],
+    "a/b" : 1,
+    "m~n" : 2,
+    "total" : 13.5
+}
+    )";
+}
+
+TEST_CASE("json_ptr_extractor tests")
+{
+    SECTION("names, indices and wildcards")
+    {
+        jsonpointer::json_ptr_extractor<json> extractor({"/meta/id", "/items/*/price", "/items/1/sku", "/total"});
+        CHECK(extractor.size() == 4);
+
+        json_cursor cursor(order);
+        auto matches = extract_all(extractor, cursor);
+
+        REQUIRE(matches.size() == 5);
+        CHECK(matches[0].index == 0);
+        CHECK(matches[0].location == "/meta/id");
+        CHECK(matches[0].value == json(17));
+        CHECK(matches[1].index == 1);
+        CHECK(matches[1].location == "/items/0/price");
+        CHECK(matches[1].value == json(10.5));
+        CHECK(matches[2].location == "/items/1/sku");
+        CHECK(matches[2].value == json("b2"));
+        CHECK(matches[3].location == "/items/1/price");
+        CHECK(matches[3].value == json(3));
+        CHECK(matches[4].index == 3);
+        CHECK(matches[4].value == json(13.5));
+    }
+
+    SECTION("a pointer inside another")
+    {
+        jsonpointer::json_ptr_extractor<json> extractor({"/items/0", "/items/*/tags/1", ""});
+
+        json_cursor cursor(order);
+        auto matches = extract_all(extractor, cursor);
+
+        REQUIRE(matches.size() == 3);
+        CHECK(matches[0].index == 2);
+        CHECK(matches[0].location == "");
+        CHECK(matches[0].value == json::parse(order));
+        CHECK(matches[1].location == "/items/0");
+        CHECK(matches[1].value["sku"] == json("a1"));
+        CHECK(matches[2].index == 1);
+        CHECK(matches[2].location == "/items/0/tags/1");
+        CHECK(matches[2].value == json("]}"));
+    }
+
+    SECTION("escaped names")
+    {
+        jsonpointer::json_ptr_extractor<json> extractor({"/m~0n", "/a~1b"});
+
+        json_cursor cursor(order);
+        auto matches = extract_all(extractor, cursor);
+
+        REQUIRE(matches.size() == 2);
+        CHECK(matches[0].index == 1);
+        CHECK(matches[0].location == "/a~1b");
+        CHECK(matches[1].index == 0);
+        CHECK(matches[1].location == "/m~0n");
+        CHECK(matches[1].value == json(2));
+    }
+
+    SECTION("indices that do not match")
+    {
+        jsonpointer::json_ptr_extractor<json> extractor({"/items/01/sku", "/items/-", "/items/3", "/meta/id/x"});
+
+        json_cursor cursor(order);
+        CHECK(extract_all(extractor, cursor).empty());
+    }
+
+    SECTION("stops reading once every pointer is done")
+    {
+        std::string truncated = R"({"meta":{"id":17},"items":[{"price":1},{"price":2}],"rest":[1,2,)";
+        jsonpointer::json_ptr_extractor<json> extractor({"/meta/id", "/items/*/price"});
+
+        json_cursor cursor(truncated);
+        auto matches = extract_all(extractor, cursor);
+        REQUIRE(matches.size() == 3);
+        CHECK(matches[2].value == json(2));
+        CHECK_FALSE(cursor.done());
+
+        // A wildcard keeps the root open to the end
+        jsonpointer::json_ptr_extractor<json> extractor2({"/*/id"});
+        json_cursor cursor2(truncated);
+        std::error_code ec;
+        extractor2.extract(cursor2, [](std::size_t, const string_view&, const json&){}, ec);
+        CHECK(ec == json_errc::unexpected_eof);
+    }
+
+    SECTION("the extractor can be used again")
+    {
+        jsonpointer::json_ptr_extractor<json> extractor({"/meta/source"});
+        for (int i = 0; i < 2; ++i)
+        {
+            json_cursor cursor(order);
+            auto matches = extract_all(extractor, cursor);
+            REQUIRE(matches.size() == 1);
+            CHECK(matches[0].value == json("web"));
+        }
+    }
+
+    SECTION("visitor")
+    {
+        jsonpointer::json_ptr_extractor<json> extractor({"/items/*/tags", "/items/1"});
+
+        std::string s;
+        json_compressed_string_encoder encoder(s);
+        encoder.begin_array();
+        json_cursor cursor(order);
+        extractor.extract(cursor, encoder);
+        encoder.end_array();
+        encoder.flush();
+
+        CHECK(s == R"([["x","]}"],{"sku":"b2","price":3,"tags":[]},[{}]])");
+    }
+
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(ojson::parse(order), data);
+        jsonpointer::json_ptr_extractor<json> extractor({"/items/*/sku", "/total"});
+
+        cbor::cbor_bytes_cursor cursor(data);
+        auto matches = extract_all(extractor, cursor);
+        REQUIRE(matches.size() == 4);
+        CHECK(matches[2].value == json("c3"));
+        CHECK(matches[3].value == json(13.5));
+    }
+
+    SECTION("invalid pointers")
+    {
+        std::error_code ec;
+        jsonpointer::json_ptr_extractor<json> extractor1({"/a", "b"}, ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::expected_slash);
+
+        jsonpointer::json_ptr_extractor<json> extractor2({"/a~2"}, ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::expected_0_or_1);
+
+        CHECK_THROWS_AS(jsonpointer::json_ptr_extractor<json>({"/a~"}), jsonpointer::jsonpointer_error);
+    }
+}
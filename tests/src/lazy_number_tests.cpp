@@ -0,0 +1,138 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("lazy_number parse tests")
+{
+    const std::string s = R"([1.50,2.0e10,-0.000001234567890123456789,1e400,42,-7])";
+
+    SECTION("parser")
+    {
+        auto options = json_options{}.lazy_number(true);
+        json j = json::parse(s, options);
+
+        CHECK(j[0].is_double());
+        CHECK(j[0].is_number());
+        CHECK_FALSE(j[0].is_string());
+        CHECK(j[0].type() == json_type::double_value);
+        CHECK(j[0].as<double>() == 1.5);
+        CHECK(j[1].as<double>() == 2.0e10);
+        CHECK(j[1].as<int64_t>() == 20000000000);
+        CHECK(j[2].as<double>() == -0.000001234567890123456789);
+        CHECK(j[3].as<double>() == std::numeric_limits<double>::infinity());
+
+        // Integers are converted when parsed
+        CHECK(j[4].is_int64());
+        CHECK(j[4].as<int>() == 42);
+        CHECK(j[5].as<int>() == -7);
+
+        CHECK(j.to_string() == s);
+        CHECK(j[0].as_string() == "1.50");
+    }
+
+    SECTION("tape parser")
+    {
+        auto options = json_options{}.lazy_number(true).use_tape_parser(true);
+        json j = json::parse(s, options);
+
+        CHECK(j[0].is_double());
+        CHECK(j[2].as<double>() == -0.000001234567890123456789);
+        CHECK(j.to_string() == s);
+    }
+
+    SECTION("not requested")
+    {
+        json j = json::parse(s);
+        CHECK(j.to_string() != s);
+    }
+}
+
+TEST_CASE("lazy_number value tests")
+{
+    auto options = json_options{}.lazy_number(true);
+    json j = json::parse(R"({"short":0.25,"long":3.141592653589793238,"other":0.5})", options);
+
+    SECTION("comparison")
+    {
+        json expected = json::parse(R"({"short":0.25,"long":3.141592653589793238,"other":0.5})");
+        CHECK(j == expected);
+        CHECK(expected == j);
+        CHECK(j["short"] == json(0.25));
+        CHECK(j["short"] < j["other"]);
+        CHECK(j["short"] < json(1));
+        CHECK(json(0) < j["short"]);
+        CHECK_FALSE(j["short"] == json("0.25"));
+    }
+
+    SECTION("copy, move and swap")
+    {
+        json a = j["long"];
+        CHECK(a.as<double>() == 3.141592653589793238);
+        CHECK(a.to_string() == "3.141592653589793238");
+
+        json b = std::move(a);
+        CHECK(b.to_string() == "3.141592653589793238");
+
+        json c = j["short"];
+        swap(b, c);
+        CHECK(b.to_string() == "0.25");
+        CHECK(c.to_string() == "3.141592653589793238");
+
+        c = json("a string");
+        CHECK(c.as<std::string>() == "a string");
+    }
+
+    SECTION("pretty print")
+    {
+        std::ostringstream os;
+        os << pretty_print(j);
+        CHECK(os.str().find("3.141592653589793238") != std::string::npos);
+    }
+
+    SECTION("float format")
+    {
+        auto encode_options = json_options{}.float_format(float_chars_format::fixed).precision(2);
+        std::string s;
+        j["long"].dump(s, encode_options);
+        CHECK(s == "3.14");
+    }
+
+    SECTION("other encoders")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data);
+        json k = cbor::decode_cbor<json>(data);
+        CHECK(k["short"].is_double());
+        CHECK(k == j);
+    }
+}
+
+TEST_CASE("lazy_number visitor tests")
+{
+    SECTION("filter")
+    {
+        std::string s;
+        json_compressed_string_encoder encoder(s);
+        json_filter filter(encoder);
+        json_reader reader(std::string(R"([0.10,1E+2])"), filter, json_options{}.lazy_number(true));
+        reader.read();
+        CHECK(s == "[0.10,1E+2]");
+    }
+
+    SECTION("default conversion")
+    {
+        json_decoder<json> decoder;
+        basic_json_visitor<char>& visitor = decoder;
+        visitor.double_text_value("1.25");
+        CHECK(decoder.get_result().as<double>() == 1.25);
+        CHECK(decoder.get_result().to_string() == "1.25");
+    }
+}
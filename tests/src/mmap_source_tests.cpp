@@ -0,0 +1,154 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/mmap_source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    void write_file(const std::string& path, const std::string& s)
+    {
+        std::ofstream os(path, std::ios::binary);
+        os << s;
+    }
+
+    void write_file(const std::string& path, const std::vector<uint8_t>& v)
+    {
+        std::ofstream os(path, std::ios::binary);
+        os.write(reinterpret_cast<const char*>(v.data()), v.size());
+    }
+
+} // namespace
+
+TEST_CASE("mmap_source tests")
+{
+    SECTION("json_reader")
+    {
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(mmap_source<char>("./input/address-book.json"), decoder);
+        reader.read();
+
+        std::ifstream is("./input/address-book.json");
+        json expected = json::parse(is);
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("json_reader with BOM")
+    {
+        std::string path = "./mmap_source_bom.json";
+        write_file(path, "\xEF\xBB\xBF[1,2,3]");
+
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(mmap_source<char>(path), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == json::parse("[1,2,3]"));
+        std::remove(path.c_str());
+    }
+
+    SECTION("json_cursor")
+    {
+        std::string path = "./mmap_source_cursor.json";
+        write_file(path, "[1,\"two\",3.0]");
+
+        basic_json_cursor<char,mmap_source<char>> cursor{mmap_source<char>(path)};
+        std::vector<staj_event_type> events;
+        for (; !cursor.done(); cursor.next())
+        {
+            events.push_back(cursor.current().event_type());
+        }
+        REQUIRE(events.size() == 5);
+        CHECK(events[0] == staj_event_type::begin_array);
+        CHECK(events[2] == staj_event_type::string_value);
+        CHECK(events[4] == staj_event_type::end_array);
+        std::remove(path.c_str());
+    }
+
+    SECTION("decode_json from file")
+    {
+        json j = decode_json<json>(file_path_arg, "./input/address-book.json");
+        CHECK(j["address-book"].size() == 2);
+
+        std::string path = "./mmap_source_map.json";
+        write_file(path, "{\"a\":1,\"b\":2}");
+        auto m = decode_json<std::map<std::string,int>>(file_path_arg, path);
+        CHECK(m.size() == 2);
+        CHECK(m["b"] == 2);
+        std::remove(path.c_str());
+    }
+
+    SECTION("missing file")
+    {
+        mmap_source<char> source("./input/does-not-exist.json");
+        CHECK(source.is_error());
+
+        REQUIRE_THROWS_AS(decode_json<json>(file_path_arg, "./input/does-not-exist.json"), ser_error);
+        JSONCONS_TRY
+        {
+            decode_json<json>(file_path_arg, "./input/does-not-exist.json");
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            CHECK(e.code() == json_errc::source_error);
+        }
+    }
+
+    SECTION("empty file")
+    {
+        std::string path = "./mmap_source_empty.json";
+        write_file(path, std::string());
+
+        mmap_source<char> source(path);
+        CHECK_FALSE(source.is_error());
+        CHECK(source.eof());
+        CHECK(source.read_buffer().size() == 0);
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("binary_mmap_source tests")
+{
+    json expected = json::parse(R"({"a":[1,2.5,"three"],"b":null})");
+
+    SECTION("decode_cbor from file")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+        std::string path = "./mmap_source_test.cbor";
+        write_file(path, data);
+
+        CHECK(cbor::decode_cbor<json>(file_path_arg, path) == expected);
+
+        binary_mmap_source source(path);
+        CHECK(source.read_buffer().size() == data.size());
+        std::remove(path.c_str());
+
+        REQUIRE_THROWS_AS(cbor::decode_cbor<json>(file_path_arg, path), ser_error);
+    }
+
+    SECTION("msgpack_reader")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(expected, data);
+        std::string path = "./mmap_source_test.msgpack";
+        write_file(path, data);
+
+        json_decoder<json> decoder;
+        auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
+        msgpack::basic_msgpack_reader<binary_mmap_source> reader(binary_mmap_source(path), adaptor);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+        std::remove(path.c_str());
+    }
+}
@@ -9,6 +9,7 @@
 #include <jsoncons_ext/msgpack/msgpack_cursor.hpp>
 #include <jsoncons_ext/msgpack/msgpack.hpp>
 #include <catch/catch.hpp>
+#include "../cursor_skip_helpers.hpp"
 #include <sstream>
 #include <vector>
 #include <utility>
@@ -212,3 +213,78 @@ TEST_CASE("msgpack_cursor with filter tests")
     CHECK(cursor.done());
 }
 
+TEST_CASE("msgpack_cursor skip")
+{
+    ojson j = ojson::parse(R"(
+{
+    "a" : 1,
+    "b" : {"s" : "x]}", "n" : [1,2.5,-3,true,false,null,{"k":[[],{}]}], "e" : {}},
+    "c" : [["a","b"],{"c":[1,[2,[3]]]}],
+    "d" : [],
+    "z" : "end"
+}
+)");
+    j["b"].insert_or_assign("bytes", ojson(byte_string_arg, std::vector<uint8_t>{1,2,3}));
+    std::vector<std::string> expected = {"a","1","b","{}","c","[]","d","[]","z","end","end"};
+
+    SECTION("bytes source")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(j, data);
+
+        msgpack::msgpack_bytes_cursor cursor(data);
+        CHECK(skip_containers(cursor) == expected);
+    }
+
+    SECTION("stream source")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(j, data);
+        std::string s(data.begin(), data.end());
+        std::istringstream is(s);
+
+        msgpack::msgpack_stream_cursor cursor(is);
+        CHECK(skip_containers(cursor) == expected);
+    }
+
+    SECTION("unexpected end of input")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(j, data);
+        data.resize(data.size()/2);
+
+        msgpack::msgpack_bytes_cursor cursor(data);
+        cursor.next(); // "a"
+        cursor.next(); // 1
+        cursor.next(); // "b"
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == msgpack::msgpack_errc::unexpected_eof);
+    }
+
+    SECTION("16 and 32 bit lengths")
+    {
+        ojson k(json_object_arg);
+        k.insert_or_assign("a", 1);
+        ojson big(json_array_arg);
+        for (int i = 0; i < 70000; ++i)
+        {
+            big.push_back(i % 3 == 0 ? ojson(std::string(300, 'x')) : ojson(i));
+        }
+        ojson map(json_object_arg);
+        for (int i = 0; i < 20; ++i)
+        {
+            map.insert_or_assign(std::to_string(i), ojson(byte_string_arg, std::vector<uint8_t>(i == 19 ? 1000 : i*5, 0xff)));
+        }
+        big.push_back(map);
+        k.insert_or_assign("b", big);
+        k.insert_or_assign("z", "end");
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(k, data);
+
+        msgpack::msgpack_bytes_cursor cursor(data);
+        CHECK(skip_containers(cursor) == std::vector<std::string>{"a","1","b","[]","z","end","end"});
+    }
+}
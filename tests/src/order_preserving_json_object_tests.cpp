@@ -9,6 +9,8 @@
 #include <utility>
 #include <ctime>
 #include <map>
+#include <random>
+#include <string>
 #include <assert.h>
 
 using namespace jsoncons;
@@ -410,3 +412,110 @@ TEST_CASE("order preserving erase")
     }
 }
   
+
+TEST_CASE("order preserving large object")
+{
+    // Random edits applied to an ojson and to a vector of pairs, which 
+    // must agree on the order of the members after each step
+    typedef std::vector<std::pair<std::string,int>> model_type;
+
+    auto check = [](const ojson& o, const model_type& model)
+    {
+        REQUIRE(o.size() == model.size());
+        auto it = o.object_range().begin();
+        for (const auto& item : model)
+        {
+            CHECK(it->key() == item.first);
+            CHECK(it->value().as<int>() == item.second);
+            ++it;
+            CHECK(o.at(item.first).as<int>() == item.second);
+        }
+        CHECK_FALSE(o.contains("missing"));
+    };
+
+    auto find_in_model = [](const model_type& model, const std::string& key) -> std::size_t
+    {
+        std::size_t i = 0;
+        while (i < model.size() && model[i].first != key)
+        {
+            ++i;
+        }
+        return i;
+    };
+
+    std::mt19937 gen(7);
+    ojson o(json_object_arg);
+    model_type model;
+
+    for (int step = 0; step < 2000; ++step)
+    {
+        std::string key = "k" + std::to_string(gen() % 400);
+        int value = step;
+        std::size_t found = find_in_model(model, key);
+        switch (gen() % 5)
+        {
+            case 0:
+            case 1:
+            {
+                auto result = o.insert_or_assign(key, value);
+                CHECK(result.second == (found == model.size()));
+                if (found == model.size())
+                {
+                    model.emplace_back(key, value);
+                }
+                else
+                {
+                    model[found].second = value;
+                }
+                break;
+            }
+            case 2:
+            {
+                std::size_t pos = model.empty() ? 0 : gen() % model.size();
+                auto it = o.try_emplace(o.object_range().begin() + pos, key, value);
+                if (found == model.size())
+                {
+                    model.insert(model.begin() + pos, std::make_pair(key, value));
+                    CHECK(it->key() == key);
+                }
+                break;
+            }
+            case 3:
+            {
+                o.erase(key);
+                if (found != model.size())
+                {
+                    model.erase(model.begin() + found);
+                }
+                break;
+            }
+            case 4:
+            {
+                if (model.size() > 2 && step % 20 == 0)
+                {
+                    std::size_t first = gen() % (model.size() - 1);
+                    std::size_t last = first + 1 + gen() % (std::min)(std::size_t(10), model.size() - first - 1);
+                    o.erase(o.object_range().begin() + first, o.object_range().begin() + last);
+                    model.erase(model.begin() + first, model.begin() + last);
+                }
+                break;
+            }
+        }
+        if (step % 50 == 0)
+        {
+            check(o, model);
+        }
+    }
+    check(o, model);
+
+    SECTION("copy and swap")
+    {
+        ojson copy(o);
+        check(copy, model);
+        ojson other = ojson::parse(R"({"a":1})");
+        swap(copy, other);
+        check(other, model);
+        CHECK(copy.size() == 1);
+        CHECK(copy.contains("a"));
+    }
+}
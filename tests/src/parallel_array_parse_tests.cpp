@@ -0,0 +1,183 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/parallel_parse.hpp>
+#include <catch/catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_array_text(std::size_t count)
+    {
+        std::string s = "[\n";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.append(",\n");
+            }
+            s.append("  {\"id\":");
+            s.append(std::to_string(i));
+            s.append(",\"text\":\"a,b]c}\\\"\\\\\",\"nested\":[[1,2],{\"x\":[]}],\"d\":");
+            s.append(std::to_string(i));
+            s.append(".25}");
+        }
+        s.append("\n]\n");
+        return s;
+    }
+
+    json parse_in_parallel(const std::string& s, std::size_t num_threads, bool& parallel)
+    {
+        json result;
+        parallel = jsoncons::detail::parse_array_in_parallel(s.data(), s.size(), json_options(), num_threads, result, 1);
+        if (!parallel)
+        {
+            result = json::parse(s);
+        }
+        return result;
+    }
+
+} // namespace
+
+TEST_CASE("find_array_elements tests")
+{
+    std::vector<std::size_t> offsets;
+    const char* end = nullptr;
+
+    SECTION("commas and brackets in strings and nested values")
+    {
+        std::string s = R"([1, "a,]\"", [2,3], {"b":[4,5]}] )";
+        REQUIRE(jsoncons::detail::find_array_elements(s.data(), s.data() + s.size(), 1024, offsets, end));
+        REQUIRE(offsets.size() == 5);
+        CHECK(s.substr(offsets[0], offsets[1] - 1 - offsets[0]) == "1");
+        CHECK(s.substr(offsets[1], offsets[2] - 1 - offsets[1]) == R"( "a,]\"")");
+        CHECK(s.substr(offsets[2], offsets[3] - 1 - offsets[2]) == " [2,3]");
+        CHECK(s.substr(offsets[3], offsets[4] - 1 - offsets[3]) == R"( {"b":[4,5]})");
+        CHECK(end == s.data() + s.size() - 1);
+    }
+
+    SECTION("unbalanced or too deep")
+    {
+        std::string s1 = "[1,2";
+        CHECK_FALSE(jsoncons::detail::find_array_elements(s1.data(), s1.data() + s1.size(), 1024, offsets, end));
+        std::string s2 = "[1,2}";
+        CHECK_FALSE(jsoncons::detail::find_array_elements(s2.data(), s2.data() + s2.size(), 1024, offsets, end));
+        std::string s3 = "[\"abc]";
+        CHECK_FALSE(jsoncons::detail::find_array_elements(s3.data(), s3.data() + s3.size(), 1024, offsets, end));
+        std::string s4 = "[[[1]]]";
+        CHECK_FALSE(jsoncons::detail::find_array_elements(s4.data(), s4.data() + s4.size(), 2, offsets, end));
+        std::string s5 = "{\"a\":1}";
+        CHECK_FALSE(jsoncons::detail::find_array_elements(s5.data(), s5.data() + s5.size(), 1024, offsets, end));
+    }
+}
+
+TEST_CASE("parse_array_in_parallel tests")
+{
+    SECTION("same result as the sequential parser")
+    {
+        std::string s = make_array_text(1000);
+        json expected = json::parse(s);
+        for (std::size_t num_threads : {2, 3, 8})
+        {
+            bool parallel = false;
+            json j = parse_in_parallel(s, num_threads, parallel);
+            CHECK(parallel);
+            CHECK(j == expected);
+        }
+    }
+
+    SECTION("byte order mark and surrounding whitespace")
+    {
+        std::string s = "\xEF\xBB\xBF  [1, 2.5, \"x\", null, true, [], {}]  \r\n";
+        bool parallel = false;
+        json j = parse_in_parallel(s, 4, parallel);
+        CHECK(parallel);
+        CHECK(j == json::parse("[1, 2.5, \"x\", null, true, [], {}]"));
+    }
+
+    SECTION("declines input that the sequential parser must diagnose")
+    {
+        std::vector<std::string> inputs = {"[1,,2]", "[1,2,]", "[1 2,3]", "[1,2] 3", "[1,{\"a\" 1}]",
+                                           "[1,/*c*/2]", "[1,\"\x01\"]", "{\"a\":1,\"b\":2}", "1", "[]", "[1]"};
+        for (const auto& s : inputs)
+        {
+            json result;
+            CHECK_FALSE(jsoncons::detail::parse_array_in_parallel(s.data(), s.size(), json_options(), 4, result, 1));
+        }
+    }
+
+    SECTION("nesting depth counts the top level array")
+    {
+        std::string s = "[[1],[2]]";
+        json result;
+        CHECK(jsoncons::detail::parse_array_in_parallel(s.data(), s.size(), json_options().max_nesting_depth(2), 2, result, 1));
+        CHECK_FALSE(jsoncons::detail::parse_array_in_parallel(s.data(), s.size(), json_options().max_nesting_depth(1), 2, result, 1));
+    }
+}
+
+TEST_CASE("parse_parallel tests")
+{
+    std::string s = make_array_text(5000); // several hundred kilobytes
+    json expected = json::parse(s);
+
+    SECTION("from a string")
+    {
+        json j = parse_parallel<json>(s, 4);
+        CHECK(j == expected);
+    }
+
+    SECTION("hardware concurrency")
+    {
+        json j = parse_parallel<json>(s);
+        CHECK(j == expected);
+    }
+
+    SECTION("from a file")
+    {
+        std::string path = "./output/parallel_array_parse_test.json";
+        {
+            std::ofstream os(path, std::ios::binary);
+            os << s;
+        }
+        json j = parse_parallel<json>(file_path_arg, path, 4);
+        CHECK(j == expected);
+        std::remove(path.c_str());
+    }
+
+    SECTION("errors are reported as by the sequential parser")
+    {
+        std::string bad = s;
+        bad.insert(bad.find(",\n", bad.size() / 2) + 2, "}");
+        std::error_code expected_code;
+        std::size_t expected_line = 0;
+        std::size_t expected_column = 0;
+        try
+        {
+            json::parse(bad);
+        }
+        catch (const ser_error& e)
+        {
+            expected_code = e.code();
+            expected_line = e.line();
+            expected_column = e.column();
+        }
+        REQUIRE(expected_code);
+        try
+        {
+            parse_parallel<json>(bad, 4);
+            CHECK(false);
+        }
+        catch (const ser_error& e)
+        {
+            CHECK(e.code() == expected_code);
+            CHECK(e.line() == expected_line);
+            CHECK(e.column() == expected_column);
+        }
+    }
+}
@@ -0,0 +1,256 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/parallel_json_lines_reader.hpp>
+#include <catch/catch.hpp>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_json_lines(std::size_t count)
+    {
+        std::string s;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            s.append("{\"id\":");
+            s.append(std::to_string(i));
+            s.append(",\"name\":\"item");
+            s.append(std::to_string(i));
+            s.append("\",\"values\":[1,2.5,true,null]}\n");
+        }
+        return s;
+    }
+
+    // Serves its text, then fails, returning the last of the text with the failure
+    class failing_source
+    {
+        std::string text_;
+        std::size_t position_;
+        bool error_;
+    public:
+        using value_type = char;
+
+        failing_source(const std::string& text)
+            : text_(text), position_(0), error_(false)
+        {
+        }
+
+        bool eof() const
+        {
+            return error_;
+        }
+
+        bool is_error() const
+        {
+            return error_;
+        }
+
+        std::size_t read(char* p, std::size_t length)
+        {
+            std::size_t n = (std::min)(length, text_.size() - position_);
+            std::memcpy(p, text_.data() + position_, n);
+            position_ += n;
+            if (n < length)
+            {
+                error_ = true;
+            }
+            return n;
+        }
+    };
+
+} // namespace
+
+TEST_CASE("parallel_json_lines_reader tests")
+{
+    SECTION("values are delivered in input order")
+    {
+        const std::size_t count = 5000;
+        std::istringstream is(make_json_lines(count));
+
+        parallel_read_options parallel_options;
+        parallel_options.num_threads(4)
+                        .chunk_length(256)
+                        .max_chunks_in_flight(3);
+        parallel_json_lines_reader<json> reader(is, json_options(), parallel_options);
+        CHECK(reader.num_threads() == 4);
+
+        std::size_t n = 0;
+        json val;
+        while (reader.read_next(val))
+        {
+            CHECK(val["id"].as<std::size_t>() == n);
+            CHECK(val["name"].as<std::string>() == "item" + std::to_string(n));
+            CHECK(reader.line() == n+1);
+            ++n;
+        }
+        CHECK(n == count);
+    }
+
+    SECTION("blank lines, CRLF, no trailing line break")
+    {
+        std::string s = "[1,2]\r\n\r\n  \n\"a\"\n{}";
+        std::istringstream is(s);
+        parallel_json_lines_reader<ojson> reader(is);
+
+        ojson val;
+        REQUIRE(reader.read_next(val));
+        CHECK(val == ojson::parse("[1,2]"));
+        CHECK(reader.line() == 1);
+        REQUIRE(reader.read_next(val));
+        CHECK(val.as<std::string>() == "a");
+        CHECK(reader.line() == 4);
+        REQUIRE(reader.read_next(val));
+        CHECK(val == ojson(json_object_arg));
+        CHECK(reader.line() == 5);
+        CHECK_FALSE(reader.read_next(val));
+    }
+
+    SECTION("line longer than chunk length")
+    {
+        std::string long_string(10000, 'x');
+        std::string s = "1\n\"" + long_string + "\"\n2\n";
+        std::istringstream is(s);
+        parallel_read_options parallel_options;
+        parallel_options.num_threads(2).chunk_length(16);
+        parallel_json_lines_reader<json> reader(is, json_options(), parallel_options);
+
+        std::vector<json> values;
+        json val;
+        while (reader.read_next(val))
+        {
+            values.push_back(std::move(val));
+        }
+        REQUIRE(values.size() == 3);
+        CHECK(values[0].as<int>() == 1);
+        CHECK(values[1].as<std::string>() == long_string);
+        CHECK(values[2].as<int>() == 2);
+    }
+
+    SECTION("errors report line numbers and reading continues")
+    {
+        std::string s = make_json_lines(100);
+        s.append("{\"id\":100,}\n");
+        s.append(make_json_lines(10));
+        s.append("[1,2\n");
+        s.append("3 4\n");
+        std::istringstream is(s);
+        parallel_read_options parallel_options;
+        parallel_options.num_threads(3).chunk_length(64);
+        parallel_json_lines_reader<json> reader(is, json_options(), parallel_options);
+
+        std::size_t values = 0;
+        std::vector<std::pair<std::size_t,std::error_code>> errors;
+        json val;
+        while (true)
+        {
+            std::error_code ec;
+            if (reader.read_next(val, ec))
+            {
+                ++values;
+            }
+            else if (ec)
+            {
+                errors.emplace_back(reader.line(), ec);
+            }
+            else
+            {
+                break;
+            }
+        }
+        CHECK(values == 110);
+        REQUIRE(errors.size() == 3);
+        CHECK(errors[0].first == 101);
+        CHECK(errors[0].second == json_errc::extra_comma);
+        CHECK(errors[1].first == 112);
+        CHECK(errors[1].second == json_errc::unexpected_eof);
+        CHECK(errors[2].first == 113);
+        CHECK(errors[2].second == json_errc::extra_character);
+    }
+
+    SECTION("source error after the values read before it")
+    {
+        std::string s = make_json_lines(100);
+        s.append("{\"id\":");
+        parallel_read_options parallel_options;
+        parallel_options.num_threads(3).chunk_length(64);
+        parallel_json_lines_reader<json,failing_source> reader(s, json_options(), parallel_options);
+
+        std::size_t n = 0;
+        json val;
+        std::error_code ec;
+        while (reader.read_next(val, ec))
+        {
+            CHECK(val["id"].as<std::size_t>() == n);
+            ++n;
+        }
+        CHECK(n == 100);
+        CHECK(ec == json_errc::source_error);
+        CHECK(reader.line() == 101);
+        CHECK(reader.column() == 7);
+        ec.clear();
+        CHECK_FALSE(reader.read_next(val, ec));
+        CHECK_FALSE(ec);
+    }
+
+    SECTION("throwing read_next")
+    {
+        std::istringstream is("1\n2\n{\"a\"}\n");
+        parallel_json_lines_reader<json> reader(is);
+
+        json val;
+        CHECK(reader.read_next(val));
+        CHECK(reader.read_next(val));
+        REQUIRE_THROWS_AS(reader.read_next(val), ser_error);
+        CHECK(reader.line() == 3);
+        CHECK_FALSE(reader.read_next(val));
+    }
+
+    SECTION("visitor")
+    {
+        std::istringstream is("{\"a\":1}\n[true,null]\n");
+        parallel_json_lines_reader<json> reader(is);
+
+        std::vector<std::string> buffers;
+        while (true)
+        {
+            std::string buffer;
+            json_compressed_string_encoder encoder(buffer);
+            if (!reader.read_next(encoder))
+            {
+                break;
+            }
+            buffers.push_back(buffer);
+        }
+        REQUIRE(buffers.size() == 2);
+        CHECK(buffers[0] == "{\"a\":1}");
+        CHECK(buffers[1] == "[true,null]");
+    }
+
+    SECTION("wide characters")
+    {
+        std::wistringstream is(L"{\"a\":1}\n[\"b\"]\n");
+        parallel_json_lines_reader<wjson> reader(is);
+
+        wjson val;
+        REQUIRE(reader.read_next(val));
+        CHECK(val[L"a"].as<int>() == 1);
+        REQUIRE(reader.read_next(val));
+        CHECK(val[0].as<std::wstring>() == L"b");
+        CHECK_FALSE(reader.read_next(val));
+    }
+
+    SECTION("empty input")
+    {
+        std::istringstream is("");
+        parallel_json_lines_reader<json> reader(is);
+        json val;
+        CHECK_FALSE(reader.read_next(val));
+    }
+}
@@ -130,3 +130,49 @@ TEST_CASE("test_parse_big_string2")
 }
 
 
+TEST_CASE("test_parse_long_string")
+{
+    std::string content;
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+        content.push_back(static_cast<char>('a' + i % 26));
+    }
+    std::string input = "[\"" + content + "\",\"" + content + "\\\"" + content + "\"]";
+
+    SECTION("single buffer")
+    {
+        json j = json::parse(input);
+        CHECK(j[0].as<std::string>() == content);
+        CHECK(j[1].as<std::string>() == content + "\"" + content);
+    }
+    SECTION("chunked")
+    {
+        for (std::size_t i = 2; i < 70; i += 7)
+        {
+            std::istringstream is(input);
+            json_decoder<json> decoder;
+            json_reader reader(is, decoder);
+            reader.buffer_length(i);
+            reader.read_next();
+            REQUIRE(decoder.is_valid());
+            json j = decoder.get_result();
+            CHECK(j[0].as<std::string>() == content);
+            CHECK(j[1].as<std::string>() == content + "\"" + content);
+        }
+    }
+    SECTION("column of illegal control character")
+    {
+        auto error_column = [](const std::string& s) -> std::size_t
+        {
+            std::string bad = "\"" + s + "\x01\"";
+            std::error_code ec;
+            json_decoder<json> decoder;
+            json_reader reader(bad, decoder, strict_json_parsing());
+            reader.read(ec);
+            CHECK(ec == json_errc::illegal_control_character);
+            return reader.column();
+        };
+        CHECK(error_column(content) - error_column("") == content.size());
+    }
+}
+
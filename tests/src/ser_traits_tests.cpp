@@ -6,6 +6,7 @@
 #endif
 #include <catch/catch.hpp>
 #include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
 #include <vector>
 
 using jsoncons::json_type_traits;
@@ -13,6 +14,8 @@ using jsoncons::json;
 using jsoncons::wjson;
 using jsoncons::decode_json;
 using jsoncons::encode_json;
+using jsoncons::ser_error;
+namespace cbor = jsoncons::cbor;
 
 namespace ser_traits_tests {
 
@@ -31,11 +34,20 @@ namespace ser_traits_tests {
         {
         }
     };
+
+    struct edition
+    {
+        std::string isbn;
+        std::vector<book> books;
+        std::shared_ptr<std::string> publisher;
+        jsoncons::optional<int> year;
+    };
 } // namespace ser_traits_tests
 
 namespace ns = ser_traits_tests;
 
 JSONCONS_ALL_MEMBER_TRAITS(ns::book,author,title,price)
+JSONCONS_N_MEMBER_TRAITS(ns::edition,2,isbn,books,publisher,year)
 
 TEST_CASE("deser_traits string tests")
 {
@@ -130,3 +142,82 @@ TEST_CASE("deser_traits std::pair tests")
     }
 }
 
+
+TEST_CASE("member traits ser_traits and deser_traits")
+{
+    ns::edition val;
+    val.isbn = "0-19-853453-1";
+    val.books.emplace_back("Haruki Murakami","Kafka on the Shore",25.17);
+    val.books.emplace_back("Charles Bukowski","Pulp",22.48);
+    val.year = 2005;
+
+    SECTION("members are written in declaration order, empty optional members are left out")
+    {
+        std::string buf;
+        encode_json(val, buf);
+        CHECK(buf == R"({"isbn":"0-19-853453-1","books":[{"author":"Haruki Murakami","title":"Kafka on the Shore","price":25.17},)"
+                     R"({"author":"Charles Bukowski","title":"Pulp","price":22.48}],"year":2005})");
+    }
+
+    SECTION("round trip")
+    {
+        std::wstring buf;
+        encode_json(val, buf);
+        auto other = decode_json<ns::edition>(buf);
+
+        CHECK(other.isbn == val.isbn);
+        REQUIRE(other.books.size() == 2);
+        CHECK(other.books[1].title == "Pulp");
+        CHECK(other.books[1].price == 22.48);
+        CHECK_FALSE(other.publisher);
+        CHECK(other.year.has_value());
+        CHECK(*other.year == 2005);
+    }
+
+    SECTION("cbor")
+    {
+        val.publisher = std::make_shared<std::string>("Oxford");
+
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(val, data);
+        std::string buf;
+        encode_json(val, buf);
+        CHECK(cbor::decode_cbor<json>(data) == json::parse(buf));
+
+        auto other = cbor::decode_cbor<ns::edition>(data);
+        REQUIRE(other.publisher);
+        CHECK(*other.publisher == "Oxford");
+        CHECK(other.books[0].author == "Haruki Murakami");
+    }
+
+    SECTION("members in any order, unknown members are skipped")
+    {
+        std::string input = R"({"year":null,"unknown":{"a":[1,2,{"b":null}]},"books":[],"isbn":"x","more":1})";
+        auto other = decode_json<ns::edition>(input);
+        CHECK(other.isbn == "x");
+        CHECK(other.books.empty());
+        CHECK_FALSE(other.year.has_value());
+    }
+
+    SECTION("repeated members, the first is kept")
+    {
+        std::string input = R"({"isbn":"x","books":[],"isbn":"y","year":1,"year":2})";
+        auto other = decode_json<ns::edition>(input);
+        CHECK(other.isbn == "x");
+        REQUIRE(other.year.has_value());
+        CHECK(*other.year == 1);
+        CHECK(decode_json<json>(input)["isbn"].as<std::string>() == "x");
+    }
+
+    SECTION("errors are those of decoding through basic_json")
+    {
+        CHECK_THROWS_AS(decode_json<ns::edition>(std::string(R"({"books":[]})")), std::out_of_range);
+        CHECK_THROWS_WITH(decode_json<ns::edition>(std::string(R"({"books":[]})")), "Key 'isbn' not found");
+        CHECK_THROWS_WITH(decode_json<ns::book>(std::string(R"({"author":"a","title":"b"})")), "Key 'price' not found");
+        CHECK_THROWS_WITH(decode_json<ns::book>(std::wstring(LR"({"title":"b","price":1})")), "Key 'author' not found");
+        CHECK_THROWS_AS(decode_json<ns::edition>(std::string(R"(["x",[]])")), std::runtime_error);
+        CHECK_THROWS_WITH(decode_json<ns::edition>(std::string(R"(["x",[]])")), 
+                          "Attempting to access or modify 'isbn' on a value that is not an object");
+        CHECK_THROWS_AS(decode_json<ns::edition>(std::string(R"({"isbn":"x","books":[)")), ser_error);
+    }
+}
@@ -0,0 +1,155 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonpath/json_query.hpp>
+#include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
+#include <catch/catch.hpp>
+#include <map>
+#include <string>
+#include <utility>
+
+using namespace jsoncons;
+
+namespace {
+
+    using key_json = basic_json<char,shared_key_policy<sorted_policy>>;
+    using key_ojson = basic_json<char,shared_key_policy<preserve_order_policy>>;
+    using key_cow_json = basic_json<char,copy_on_write_policy<shared_key_policy<sorted_policy>>>;
+    using key_arena_json = basic_json<char,shared_key_policy<sorted_policy>,arena_allocator<char>>;
+
+    using shared_key = jsoncons::detail::shared_key<char>;
+
+    const std::string doc = R"(
+[
+    {"identifier" : 1, "a longer name than fits in a short string" : "x", "" : 0},
+    {"identifier" : 2, "a longer name than fits in a short string" : "y", "" : 1},
+    {"identifier" : 3, "a longer name than fits in a short string" : "z", "other" : {"identifier" : 4}}
+]
+    )";
+}
+
+TEST_CASE("shared_key")
+{
+    SECTION("construct and compare")
+    {
+        shared_key a("abc");
+        shared_key b(std::string("abc").data(), 3);
+        shared_key c(a);
+        shared_key empty;
+
+        CHECK(a.size() == 3);
+        CHECK(std::string(a.c_str()) == "abc");
+        CHECK(a == b);
+        CHECK_FALSE(a.shares_with(b));
+        CHECK(a.shares_with(c));
+        CHECK(a.data() == c.data());
+        CHECK(a == "abc");
+        CHECK(a == string_view("abc"));
+        CHECK(a < shared_key("abd"));
+        CHECK(string_view("ab") < a);
+        CHECK(empty.empty());
+        CHECK(empty == "");
+        CHECK(empty.c_str()[0] == 0);
+    }
+
+    SECTION("move and assign")
+    {
+        shared_key a("abc");
+        shared_key b(std::move(a));
+        CHECK(a.empty());
+        CHECK(b == "abc");
+
+        a = b;
+        CHECK(a.shares_with(b));
+        b = shared_key("def");
+        CHECK(a == "abc");
+        CHECK(b == "def");
+        a = std::move(b);
+        CHECK(a == "def");
+        CHECK(b.empty());
+    }
+}
+
+TEST_CASE("shared_key_policy")
+{
+    SECTION("decoded keys are shared")
+    {
+        const key_json j = key_json::parse(doc);
+
+        auto first = j[0].find("identifier");
+        auto second = j[1].find("identifier");
+        auto nested = j[2]["other"].find("identifier");
+        CHECK(first->key().shares_with(second->key()));
+        CHECK(first->key().shares_with(nested->key()));
+        CHECK(j[0].find("a longer name than fits in a short string")->key().shares_with(
+              j[2].find("a longer name than fits in a short string")->key()));
+        CHECK(j[1]["identifier"].as<int>() == 2);
+        CHECK(j[0][""].as<int>() == 0);
+
+        std::string s1;
+        std::string s2;
+        j.dump(s1);
+        json::parse(doc).dump(s2);
+        CHECK(s1 == s2);
+    }
+
+    SECTION("modify")
+    {
+        key_ojson j = key_ojson::parse(doc);
+        key_ojson& record = j[0];
+        record.insert_or_assign("identifier", 10);
+        record.try_emplace("new", true);
+        record.erase("");
+        CHECK(record["identifier"].as<int>() == 10);
+        CHECK(record.size() == 3);
+        CHECK((record.object_range().end()-1)->key() == "new");
+
+        key_ojson copy(j[1]);
+        CHECK(copy == j[1]);
+        CHECK(copy.object_range().begin()->key().shares_with(j[1].object_range().begin()->key()));
+    }
+
+    SECTION("conversions")
+    {
+        key_json j = key_json::parse(R"({"b":2,"a":1})");
+        auto m = j.as<std::map<std::string,int>>();
+        CHECK(m["a"] == 1);
+        CHECK(m["b"] == 2);
+
+        key_json k(m);
+        CHECK(k == j);
+    }
+
+    SECTION("jsonpath and jsonpointer")
+    {
+        key_json j = key_json::parse(doc);
+        key_json result = jsonpath::json_query(j, "$..identifier");
+        CHECK(result.size() == 4);
+        CHECK(jsonpointer::get(j, "/2/other/identifier").as<int>() == 4);
+    }
+
+    SECTION("with copy_on_write_policy")
+    {
+        key_cow_json j = key_cow_json::parse(doc);
+        key_cow_json k(j);
+        k[0].insert_or_assign("identifier", 10);
+        CHECK(j[0]["identifier"].as<int>() == 1);
+        CHECK(k[0]["identifier"].as<int>() == 10);
+    }
+
+    SECTION("with an arena")
+    {
+        // An arena_allocator<char> aligns only for char, the keys must still be aligned for their header
+        arena a;
+        key_arena_json j = key_arena_json::parse(result_allocator_arg, a, R"({"a":1,"bcd":2,"efghi":3})");
+        j.insert_or_assign("jk", 4);
+        CHECK(j["a"].as<int>() == 1);
+        CHECK(j["bcd"].as<int>() == 2);
+        CHECK(j["efghi"].as<int>() == 3);
+        CHECK(j["jk"].as<int>() == 4);
+
+        key_arena_json k = key_arena_json::parse(result_allocator_arg, a, doc);
+        CHECK(k[2]["other"]["identifier"].as<int>() == 4);
+    }
+}
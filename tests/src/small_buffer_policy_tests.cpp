@@ -0,0 +1,192 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/small_vector.hpp>
+#include <jsoncons_ext/jsonpath/json_query.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <utility>
+
+using namespace jsoncons;
+
+namespace {
+
+    using small_json = basic_json<char,small_buffer_policy<sorted_policy>>;
+    using small_ojson = basic_json<char,small_buffer_policy<preserve_order_policy>>;
+    using small_cow_json = basic_json<char,copy_on_write_policy<small_buffer_policy<sorted_policy>>>;
+
+    using small_vector = jsoncons::detail::small_vector<std::string,2>;
+
+    const std::string doc = R"(
+{
+    "point" : [1.5, 2.5],
+    "empty" : {},
+    "one" : {"x" : 1},
+    "values" : [1, 2, 3, 4, 5, 6, 7, 8, 9, 10],
+    "nested" : [[1], [2, 3], {"a" : [true, false]}],
+    "bytes" : "SGVsbG8"
+}
+    )";
+}
+
+TEST_CASE("small_vector")
+{
+    SECTION("elements in place")
+    {
+        small_vector v;
+        const std::string* inline_data = v.data();
+        v.push_back("a");
+        v.emplace_back("b");
+        CHECK(v.size() == 2);
+        CHECK(v.capacity() == 2);
+        CHECK(v.data() == inline_data);
+        CHECK(v.front() == "a");
+        CHECK(v.back() == "b");
+    }
+
+    SECTION("grow and shrink")
+    {
+        small_vector v;
+        const std::string* inline_data = v.data();
+        for (int i = 0; i < 10; ++i)
+        {
+            v.emplace_back(std::to_string(i));
+        }
+        CHECK(v.size() == 10);
+        CHECK(v.data() != inline_data);
+        CHECK(v[9] == "9");
+
+        v.erase(v.begin() + 1, v.end() - 1);
+        REQUIRE(v.size() == 2);
+        CHECK(v[0] == "0");
+        CHECK(v[1] == "9");
+        v.shrink_to_fit();
+        CHECK(v.data() == inline_data);
+        CHECK(v[1] == "9");
+    }
+
+    SECTION("push_back an element of a full vector")
+    {
+        small_vector v{"a string long enough to be allocated on the heap", "b"};
+        v.push_back(v[0]);
+        CHECK(v[2] == "a string long enough to be allocated on the heap");
+    }
+
+    SECTION("insert")
+    {
+        small_vector v{"a", "d"};
+        std::vector<std::string> w{"b", "c"};
+        auto it = v.insert(v.begin() + 1, w.begin(), w.end());
+        CHECK(*it == "b");
+        CHECK(v == small_vector({"a", "b", "c", "d"}));
+        it = v.emplace(v.begin(), "0");
+        CHECK(*it == "0");
+        CHECK(v == small_vector({"0", "a", "b", "c", "d"}));
+    }
+
+    SECTION("resize")
+    {
+        small_vector v;
+        v.resize(3, "x");
+        CHECK(v == small_vector({"x", "x", "x"}));
+        v.resize(1);
+        CHECK(v == small_vector({"x"}));
+        v.resize(2);
+        CHECK(v == small_vector({"x", ""}));
+    }
+
+    SECTION("copy, move and swap")
+    {
+        small_vector a{"a"};
+        small_vector b{"b", "c", "d"};
+
+        small_vector c(a);
+        small_vector d(std::move(b));
+        CHECK(c == small_vector({"a"}));
+        CHECK(d == small_vector({"b", "c", "d"}));
+        CHECK(b.empty());
+
+        c.swap(d);
+        CHECK(c == small_vector({"b", "c", "d"}));
+        CHECK(d == small_vector({"a"}));
+
+        a = c;
+        CHECK(a == c);
+        d = std::move(c);
+        CHECK(d == small_vector({"b", "c", "d"}));
+        CHECK(small_vector({"a"}) < small_vector({"a", "b"}));
+    }
+}
+
+TEST_CASE("small_buffer_policy")
+{
+    SECTION("parse and dump")
+    {
+        small_json j = small_json::parse(doc);
+        json expected = json::parse(doc);
+
+        std::string s1;
+        std::string s2;
+        j.dump(s1);
+        expected.dump(s2);
+        CHECK(s1 == s2);
+        CHECK(j["nested"][2]["a"][1].as<bool>() == false);
+    }
+
+    SECTION("preserve order")
+    {
+        small_ojson j = small_ojson::parse(doc);
+        small_ojson k(j);
+        CHECK(j == k);
+        CHECK(j.object_range().begin()->key() == "point");
+
+        k.erase("point");
+        k["one"].insert_or_assign("y", 2);
+        k["one"].insert_or_assign("z", 3);
+        CHECK(k["one"].size() == 3);
+        CHECK(j["one"].size() == 1);
+        CHECK(k.object_range().begin()->key() == "empty");
+    }
+
+    SECTION("modify")
+    {
+        small_json j = small_json::parse(doc);
+        small_json& point = j["point"];
+        point.push_back(3.5);
+        point.insert(point.array_range().begin(), 0.5);
+        CHECK(point.size() == 4);
+        CHECK(point[0].as<double>() == 0.5);
+        CHECK(point[3].as<double>() == 3.5);
+
+        point.erase(point.array_range().begin() + 1, point.array_range().end());
+        CHECK(point.size() == 1);
+
+        j["one"].erase("x");
+        CHECK(j["one"].empty());
+    }
+
+    SECTION("byte strings")
+    {
+        std::vector<uint8_t> bytes = {'H','e','l','l','o'};
+        small_json j(byte_string_arg, bytes);
+        CHECK(j.as<std::vector<uint8_t>>() == bytes);
+    }
+
+    SECTION("json_query")
+    {
+        small_json j = small_json::parse(doc);
+        small_json result = jsonpath::json_query(j, "$.nested[*].a");
+        REQUIRE(result.size() == 1);
+        CHECK(result[0].size() == 2);
+    }
+
+    SECTION("with copy_on_write_policy")
+    {
+        small_cow_json j = small_cow_json::parse(doc);
+        small_cow_json k(j);
+        k["point"].push_back(3.5);
+        CHECK(j["point"].size() == 2);
+        CHECK(k["point"].size() == 3);
+    }
+}
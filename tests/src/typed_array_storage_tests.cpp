@@ -0,0 +1,264 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <valarray>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::vector<uint8_t> typed_cbor(const std::vector<double>& v)
+    {
+        std::vector<uint8_t> data;
+        cbor::cbor_options options;
+        options.use_typed_arrays(true);
+        cbor::encode_cbor(v, data, options);
+        return data;
+    }
+}
+
+TEST_CASE("typed array storage from cbor")
+{
+    const std::vector<double> v = {1.5, -2.0, 1000.25, 0.0};
+    const std::vector<uint8_t> data = typed_cbor(v);
+
+    SECTION("numbers are kept contiguous")
+    {
+        json j = cbor::decode_cbor<json>(data);
+
+        CHECK(j.storage() == storage_kind::typed_array_value);
+        CHECK(j.type() == json_type::array_value);
+        CHECK(j.is_array());
+        CHECK(j.is_typed_array());
+        CHECK(j.size() == 4);
+        CHECK_FALSE(j.empty());
+
+        REQUIRE(j.is<span<const double>>());
+        CHECK_FALSE(j.is<span<const float>>());
+        auto s = j.as<span<const double>>();
+        CHECK(std::vector<double>(s.begin(), s.end()) == v);
+        CHECK(j.as<std::vector<double>>() == v);
+        CHECK_THROWS(j.as<span<const float>>());
+    }
+
+    SECTION("const element access")
+    {
+        const json j = cbor::decode_cbor<json>(data);
+
+        CHECK(j[1].as<double>() == -2.0);
+        CHECK(j.at(2).as<double>() == 1000.25);
+        CHECK(&j[0] == &j.at(0));
+        std::size_t count = 0;
+        for (const auto& item : j.array_range())
+        {
+            CHECK(item.as<double>() == v[count++]);
+        }
+        CHECK(count == v.size());
+        CHECK(j.is_typed_array());
+    }
+
+    SECTION("modifying makes an ordinary array")
+    {
+        json j = cbor::decode_cbor<json>(data);
+
+        j.push_back("last");
+
+        CHECK(j.storage() == storage_kind::array_value);
+        CHECK(j.size() == 5);
+        CHECK(j[0].as<double>() == 1.5);
+        CHECK(j[4].as<std::string>() == "last");
+    }
+
+    SECTION("round trip")
+    {
+        json j = cbor::decode_cbor<json>(data);
+
+        std::vector<uint8_t> out;
+        cbor::cbor_options options;
+        options.use_typed_arrays(true);
+        cbor::encode_cbor(j, out, options);
+        CHECK(out == data);
+
+        std::string s;
+        j.dump(s);
+        CHECK(s == "[1.5,-2.0,1000.25,0.0]");
+    }
+}
+
+TEST_CASE("typed array storage element access")
+{
+    std::vector<uint16_t> v(1000);
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = static_cast<uint16_t>(i*3);
+    }
+    const json j(typed_array_arg, typed_array_view(v.data(), v.size()));
+
+    SECTION("by reference")
+    {
+        const json& e1 = j.at(999);
+        const json& e2 = j[300];
+        CHECK(e1.as<int>() == 2997);
+        CHECK(e2.as<int>() == 900);
+        CHECK(j[0].as<int>() == 0);
+        CHECK(&j.at(999) == &e1);
+        CHECK(&j[300] == &e2);
+        CHECK_THROWS_AS(j.at(1000), std::out_of_range);
+
+        std::size_t count = 0;
+        for (const auto& item : j.array_range())
+        {
+            CHECK(item.as<uint16_t>() == v[count++]);
+        }
+        CHECK(count == v.size());
+        CHECK(e1.as<int>() == 2997);
+        CHECK(j.is_typed_array());
+    }
+
+    SECTION("by value")
+    {
+        CHECK(j.at<int>(999) == 2997);
+        CHECK(j.at<uint16_t>(1) == 3);
+        CHECK(j.at<std::string>(2) == "6");
+        CHECK_THROWS_AS(j.at<int>(1000), std::out_of_range);
+
+        json k = json::parse("[1,\"two\"]");
+        CHECK(k.at<int>(0) == 1);
+        CHECK(k.at<std::string>(1) == "two");
+    }
+
+    SECTION("conversions")
+    {
+        CHECK(j.as<std::vector<uint16_t>>() == v);
+        CHECK(j.is<std::vector<int>>());
+        CHECK_FALSE(j.is<std::vector<uint8_t>>());
+        CHECK_FALSE(j.is<std::vector<std::string>>());
+
+        const std::vector<int32_t> w = {-1, 2, -3};
+        json k(typed_array_arg, typed_array_view(w.data(), w.size()));
+        CHECK((k.is<std::array<int,3>>()));
+        CHECK_FALSE((k.is<std::array<int,2>>()));
+        CHECK((k.as<std::array<int,3>>() == std::array<int,3>{{-1, 2, -3}}));
+        CHECK(k.as<std::valarray<int>>()[2] == -3);
+    }
+}
+
+TEST_CASE("typed array storage equality")
+{
+    const std::vector<int16_t> v = {-1, 0, 300};
+
+    json a(typed_array_arg, typed_array_view(v.data(), v.size()));
+    json b(typed_array_arg, typed_array_view(v.data(), v.size()));
+    json c = json::parse("[-1, 0, 300]");
+    json d = json::parse("[-1, 0, 301]");
+
+    CHECK(a.is_typed_array());
+    CHECK(a == b);
+    CHECK(a == c);
+    CHECK(c == a);
+    CHECK(a != d);
+    CHECK(a < d);
+    CHECK_FALSE(d < a);
+    CHECK(c < d);
+    CHECK(json::parse("[-1, 0]") < a);
+    CHECK_FALSE(a < json::parse("[-1, 0]"));
+    CHECK(a < json::parse("[-1, 0, 300, 1]"));
+    CHECK_FALSE(a < c);
+    CHECK_FALSE(c < a);
+
+    json e(a);
+    CHECK(e.is_typed_array());
+    CHECK(e == a);
+
+    json f = json(span<const int16_t>(v.data(), v.size()));
+    CHECK(f.is_typed_array());
+    CHECK(f == a);
+}
+
+TEST_CASE("typed array storage equality of half elements")
+{
+    const std::vector<uint16_t> positive = {0x3c00, 0x0000}; // 1.0, +0.0
+    const std::vector<uint16_t> negative = {0x3c00, 0x8000}; // 1.0, -0.0
+    const std::vector<uint16_t> other = {0x3c00, 0x3c00}; // 1.0, 1.0
+
+    json a(typed_array_arg, typed_array_view(half_array_arg, positive.data(), positive.size()));
+    json b(typed_array_arg, typed_array_view(half_array_arg, negative.data(), negative.size()));
+    json c(typed_array_arg, typed_array_view(half_array_arg, other.data(), other.size()));
+
+    REQUIRE(a.is_typed_array());
+    REQUIRE(b.is_typed_array());
+    CHECK(a == b);
+    CHECK(b == a);
+    CHECK(a != c);
+    CHECK(a == json::parse("[1.0, -0.0]"));
+}
+
+TEST_CASE("typed array storage member values")
+{
+    const std::vector<float> v = {0.5f, 0.25f};
+
+    json j;
+    j["values"] = json(typed_array_arg, typed_array_view(v.data(), v.size()), semantic_tag::none);
+    j["name"] = "floats";
+
+    const json& cj = j;
+    CHECK(cj["values"].is_typed_array());
+    CHECK(cj["values"][1].as<double>() == 0.25);
+
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(j, data);
+    json k = cbor::decode_cbor<json>(data);
+    CHECK(k == j);
+}
+
+TEST_CASE("typed array storage with clamped tag")
+{
+    const std::vector<uint8_t> input = {
+        0xd8, // Tag
+            0x44, // Tag 68, uint8, Typed Array, clamped arithmetic
+        0x43, // Byte string value of length 3
+            0x00,0x01,0xff
+    };
+
+    json j = cbor::decode_cbor<json>(input);
+    CHECK(j.is_typed_array());
+    CHECK(j.tag() == semantic_tag::clamped);
+    CHECK(j[2].as<int>() == 255);
+    CHECK(j.tag() == semantic_tag::clamped);
+}
+
+TEST_CASE("typed array storage with other policies")
+{
+    using cow_json = basic_json<char,copy_on_write_policy<sorted_policy>>;
+    using small_ojson = basic_json<char,small_buffer_policy<preserve_order_policy>>;
+
+    const std::vector<double> v = {1.0, 2.0, 3.0};
+    const std::vector<uint8_t> data = typed_cbor(v);
+
+    SECTION("copy_on_write_policy")
+    {
+        cow_json j = cbor::decode_cbor<cow_json>(data);
+        cow_json k(j);
+        k.push_back(4.0);
+
+        CHECK(j.is_typed_array());
+        CHECK(j.size() == 3);
+        CHECK(k.size() == 4);
+        CHECK(j.as<std::vector<double>>() == v);
+    }
+
+    SECTION("small_buffer_policy")
+    {
+        small_ojson j = cbor::decode_cbor<small_ojson>(data);
+        CHECK(j.is_typed_array());
+        CHECK(j.as<span<const double>>().size() == 3);
+        CHECK(j[2].as<double>() == 3.0);
+    }
+}
@@ -9,6 +9,7 @@
 #include <jsoncons_ext/ubjson/ubjson_cursor.hpp>
 #include <jsoncons_ext/ubjson/ubjson.hpp>
 #include <catch/catch.hpp>
+#include "../cursor_skip_helpers.hpp"
 #include <sstream>
 #include <vector>
 #include <utility>
@@ -212,3 +213,70 @@ TEST_CASE("ubjson_cursor with filter tests")
     CHECK(cursor.done());
 }
 
+TEST_CASE("ubjson_cursor skip")
+{
+    ojson j = ojson::parse(R"(
+{
+    "a" : 1,
+    "b" : {"s" : "x]}", "n" : [1,2.5,-3,true,false,null,{"k":[[],{}]}], "e" : {}},
+    "c" : [["a","b"],{"c":[1,[2,[3]]]}],
+    "d" : [],
+    "z" : "end"
+}
+)");
+    std::vector<std::string> expected = {"a","1","b","{}","c","[]","d","[]","z","end","end"};
+
+    SECTION("bytes source")
+    {
+        std::vector<uint8_t> data;
+        ubjson::encode_ubjson(j, data);
+
+        ubjson::ubjson_bytes_cursor cursor(data);
+        CHECK(skip_containers(cursor) == expected);
+    }
+
+    SECTION("stream source")
+    {
+        std::vector<uint8_t> data;
+        ubjson::encode_ubjson(j, data);
+        std::string s(data.begin(), data.end());
+        std::istringstream is(s);
+
+        ubjson::ubjson_stream_cursor cursor(is);
+        CHECK(skip_containers(cursor) == expected);
+    }
+
+    SECTION("unexpected end of input")
+    {
+        std::vector<uint8_t> data;
+        ubjson::encode_ubjson(j, data);
+        data.resize(data.size()/2);
+
+        ubjson::ubjson_bytes_cursor cursor(data);
+        cursor.next(); // "a"
+        cursor.next(); // 1
+        cursor.next(); // "b"
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == ubjson::ubjson_errc::unexpected_eof);
+    }
+
+    SECTION("strongly typed and indefinite containers")
+    {
+        const std::vector<uint8_t> data = {
+            '{', // object without a count
+                'i',1,'a','U',1,
+                'i',1,'b','[','$','l','#','i',3, 0,0,0,1, 0,0,0,2, 0,0,0,3,
+                'i',1,'c','{','$','S','#','i',2, 'i',1,'x','i',2,'}',']', 'i',1,'y','U',0,
+                'i',1,'d','[', '[','$','Z','#','i',2, '{','#','i',1,'i',1,'k','[',']', 'H','i',3,'1','.','5', ']',
+                'i',1,'z','S','i',3,'e','n','d',
+            '}'
+        };
+        std::vector<std::string> expected2 = {"a","1","b","[]","c","{}","d","[]","z","end","end"};
+
+        ubjson::ubjson_bytes_cursor cursor(data);
+        CHECK(skip_containers(cursor) == expected2);
+    }
+}
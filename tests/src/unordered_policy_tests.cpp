@@ -0,0 +1,261 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+using ujson = basic_json<char,unordered_policy>;
+
+namespace {
+
+    std::string make_key(std::size_t i)
+    {
+        return "key" + std::to_string(i);
+    }
+
+    // Checks that every member can be found, and that no other key is found
+    void check_members(const ujson& j)
+    {
+        for (const auto& member : j.object_range())
+        {
+            auto it = j.find(member.key());
+            bool found = it != j.object_range().end();
+            REQUIRE(found);
+            CHECK(it->key() == member.key());
+            CHECK(it->value() == member.value());
+        }
+        CHECK_FALSE(j.contains("no such key"));
+    }
+}
+
+TEST_CASE("unordered_policy small and large objects")
+{
+    const std::size_t sizes[] = {0, 1, unordered_policy::hash_index_threshold, unordered_policy::hash_index_threshold + 1, 1000};
+
+    for (std::size_t n : sizes)
+    {
+        ujson j;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            j.insert_or_assign(make_key(i), i);
+        }
+        REQUIRE(j.size() == n);
+        check_members(j);
+
+        // Insertion order is kept
+        std::size_t i = 0;
+        for (const auto& member : j.object_range())
+        {
+            CHECK(member.key() == make_key(i));
+            CHECK(member.value().as<std::size_t>() == i);
+            ++i;
+        }
+
+        // Assigning to an existing key keeps its place
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            auto result = j.insert_or_assign(make_key(k), k + 1);
+            CHECK(result.second == false);
+        }
+        CHECK(j.size() == n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            CHECK(j.at(make_key(k)).as<std::size_t>() == k + 1);
+        }
+
+        auto result = j.try_emplace(make_key(n/2), 0);
+        CHECK(result.second == (n == 0));
+    }
+}
+
+TEST_CASE("unordered_policy erase")
+{
+    const std::size_t n = 100;
+    ujson j;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        j.try_emplace(make_key(i), i);
+    }
+
+    SECTION("erase by name")
+    {
+        for (std::size_t i = 0; i < n; i += 2)
+        {
+            j.erase(make_key(i));
+        }
+        CHECK(j.size() == n/2);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            CHECK(j.contains(make_key(i)) == (i % 2 == 1));
+        }
+        check_members(j);
+
+        // Down to linear search and back
+        for (std::size_t i = 1; i < n; i += 2)
+        {
+            j.erase(make_key(i));
+        }
+        CHECK(j.empty());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            j.try_emplace(make_key(i), i);
+        }
+        CHECK(j.size() == n);
+        check_members(j);
+    }
+
+    SECTION("erase by iterator")
+    {
+        j.erase(j.find(make_key(10)));
+        CHECK(j.size() == n - 1);
+        CHECK_FALSE(j.contains(make_key(10)));
+        check_members(j);
+    }
+
+    SECTION("erase range")
+    {
+        j.erase(j.object_range().begin() + 10, j.object_range().begin() + 95);
+        CHECK(j.size() == 15);
+        check_members(j);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            CHECK(j.contains(make_key(i)) == (i < 10 || i >= 95));
+        }
+    }
+
+    SECTION("clear")
+    {
+        j.clear();
+        CHECK(j.empty());
+        CHECK_FALSE(j.contains(make_key(0)));
+        j.try_emplace(make_key(0), 0);
+        CHECK(j.size() == 1);
+        check_members(j);
+    }
+}
+
+TEST_CASE("unordered_policy parse and compare")
+{
+    std::ostringstream os;
+    os << "{";
+    for (std::size_t i = 0; i < 50; ++i)
+    {
+        if (i > 0)
+        {
+            os << ",";
+        }
+        os << "\"" << make_key(49 - i) << "\":" << i;
+    }
+    os << "}";
+    const std::string s = os.str();
+
+    ujson j = ujson::parse(s);
+    json expected = json::parse(s);
+
+    SECTION("parse")
+    {
+        REQUIRE(j.size() == 50);
+        check_members(j);
+        CHECK(j.object_range().begin()->key() == make_key(49));
+        CHECK(j.to_string() == s);
+        CHECK(json::parse(j.to_string()) == expected);
+    }
+
+    SECTION("duplicate keys")
+    {
+        ujson k = ujson::parse(R"({"a":1,"b":2,"a":3})");
+        json l = json::parse(R"({"a":1,"b":2,"a":3})");
+        CHECK(k.size() == 2);
+        CHECK(k["a"].as<int>() == l["a"].as<int>());
+    }
+
+    SECTION("equality ignores order")
+    {
+        ujson k(json_object_arg);
+        for (std::size_t i = 0; i < 50; ++i)
+        {
+            k.insert_or_assign(make_key(i), 49 - i);
+        }
+        CHECK(k == j);
+        CHECK_FALSE(k < j);
+        CHECK_FALSE(j < k);
+
+        k[make_key(7)] = 100;
+        CHECK_FALSE(k == j);
+        CHECK((j < k) != (k < j));
+
+        k.erase(make_key(7));
+        CHECK_FALSE(k == j);
+        CHECK(k != j);
+    }
+
+    SECTION("copy, move and swap")
+    {
+        ujson k = j;
+        CHECK(k == j);
+        k.erase(make_key(0));
+        check_members(k);
+        CHECK(j.contains(make_key(0)));
+
+        ujson l = std::move(k);
+        check_members(l);
+        CHECK(l.size() == 49);
+
+        ujson m = ujson::parse(R"({"a":1})");
+        swap(l, m);
+        CHECK(m.size() == 49);
+        CHECK(l.size() == 1);
+        check_members(l);
+        check_members(m);
+    }
+}
+
+TEST_CASE("unordered_policy merge")
+{
+    ujson j;
+    ujson source;
+    for (std::size_t i = 0; i < 30; ++i)
+    {
+        j.try_emplace(make_key(i), 0);
+        source.try_emplace(make_key(i + 15), 1);
+    }
+
+    SECTION("merge")
+    {
+        j.merge(source);
+        CHECK(j.size() == 45);
+        CHECK(j[make_key(20)].as<int>() == 0);
+        CHECK(j[make_key(40)].as<int>() == 1);
+        check_members(j);
+    }
+
+    SECTION("merge with hint")
+    {
+        j.merge(j.object_range().begin(), std::move(source));
+        CHECK(j.size() == 45);
+        CHECK(j[make_key(20)].as<int>() == 0);
+        check_members(j);
+    }
+
+    SECTION("merge_or_update")
+    {
+        j.merge_or_update(source);
+        CHECK(j.size() == 45);
+        CHECK(j[make_key(20)].as<int>() == 1);
+        CHECK(j[make_key(10)].as<int>() == 0);
+        check_members(j);
+    }
+
+    SECTION("insert_or_assign with hint")
+    {
+        auto it = j.insert_or_assign(j.object_range().begin(), "new", 2);
+        CHECK(it->key() == "new");
+        CHECK(j.size() == 31);
+        check_members(j);
+    }
+}